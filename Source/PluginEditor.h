@@ -6,6 +6,8 @@
 #include "ui/BandControlsPanel.h"
 #include "ui/MetersComponent.h"
 #include "ui/CorrelationComponent.h"
+#include "ui/DiagnosticsPanel.h"
+#include "ui/FrameScheduler.h"
 #include "ui/Theme.h"
 #include "ui/LookAndFeel.h"
 #include "ui/SpectralDynamicsPanel.h"
@@ -13,7 +15,8 @@
 
 // Main plugin editor: orchestrates layout and connects UI to processor state.
 class EQProAudioProcessorEditor final : public juce::AudioProcessorEditor,
-                                        private juce::Timer
+                                        public FrameScheduler::Client,
+                                        private juce::ChangeListener
 {
 public:
     explicit EQProAudioProcessorEditor(EQProAudioProcessor&);
@@ -29,10 +32,17 @@ public:
 private:
     // Keep plugin editor in sync with host window bounds.
     bool syncToHostBounds();
-    // Periodic refresh for layout/params.
-    void timerCallback() override;
+    // Periodic refresh for layout/params (2 Hz housekeeping; keeps running while hidden).
+    int getFrameRateHz() const override { return 2; }
+    bool isVisualClient() const override { return false; }
+    juce::Rectangle<int> frameTick() override;
     // Refresh channel layout and labels.
     void refreshChannelLayout();
+    // Preset library index changed (message thread).
+    void changeListenerCallback(juce::ChangeBroadcaster*) override;
+    // Rebuild the preset list from the library's cached index, keeping the selection.
+    void refreshPresetBrowser();
+    void updateFavoriteToggle();
 
     EQProAudioProcessor& processorRef;
 
@@ -80,9 +90,20 @@ private:
     juce::Label analyzerRangeLabel;
     juce::Label analyzerSpeedLabel;
     juce::Label analyzerViewLabel;
+    juce::Label analyzerSourceLabel;
+    juce::Label analyzerOverlapLabel;
+    juce::Label analyzerAveragingLabel;
+    juce::Label analyzerSmoothingLabel;
+    juce::Label analyzerResolutionLabel;
     juce::ComboBox analyzerRangeBox;
     juce::ComboBox analyzerSpeedBox;
     juce::ComboBox analyzerViewBox;
+    juce::ComboBox analyzerSourceBox;
+    juce::ComboBox analyzerOverlapBox;
+    juce::ComboBox analyzerAveragingBox;
+    juce::ComboBox analyzerSmoothingBox;
+    juce::ComboBox analyzerResolutionBox;
+    juce::ToggleButton analyzerPeakHoldToggle;
     juce::ToggleButton analyzerFreezeToggle;
     juce::ToggleButton analyzerExternalToggle;
     juce::ToggleButton smartSoloToggle;
@@ -104,6 +125,8 @@ private:
     juce::TextButton pasteInstanceButton;
     juce::Label presetBrowserLabel;
     juce::ComboBox presetBrowserBox;
+    std::shared_ptr<const PresetLibrary::Index> presetIndex;
+    juce::File selectedPresetFile;
     juce::ToggleButton favoriteToggle;
     juce::TextButton refreshPresetsButton;
     std::unique_ptr<juce::FileChooser> saveChooser;
@@ -121,6 +144,9 @@ private:
     juce::ComboBox snapshotMenu;
     juce::TextButton snapshotRecallButton;
     juce::TextButton snapshotStoreButton;
+    juce::ComboBox snapshotMorphPairBox;
+    juce::Slider snapshotMorphSlider;
+    juce::ToggleButton snapshotMorphToggle;
     juce::Label correlationLabel;
     juce::ComboBox correlationBox;
     juce::Label layoutLabel;
@@ -131,6 +157,9 @@ private:
     BandControlsPanel bandControls;
     SpectralDynamicsPanel spectralPanel;
     CorrelationComponent correlation;
+    DiagnosticsPanel diagnostics;
+    // Declared after the components it ticks so it is destroyed first.
+    FrameScheduler frameScheduler { *this };
     // Layout chrome.
     juce::ResizableCornerComponent resizer { this, &resizeConstrainer };
     juce::ComponentBoundsConstrainer resizeConstrainer;
@@ -147,6 +176,8 @@ private:
     bool debugVisible = false;
     juce::String getDebugText() const;
     bool pendingWindowRescue = true;
+    // Band editing is locked while the snapshot morph replaces the live bands.
+    bool bandEditingLocked = false;
     int windowRescueTicks = 0;
 
     int selectedBand = 0;
@@ -173,11 +204,20 @@ private:
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> analyzerRangeAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> analyzerSpeedAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> analyzerViewAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> analyzerSourceAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> analyzerOverlapAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> analyzerAveragingAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> analyzerSmoothingAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> analyzerResolutionAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> analyzerPeakHoldAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> analyzerFreezeAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> analyzerExternalAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> midiLearnAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> smartSoloAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> midiTargetAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> snapshotMorphPairAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> snapshotMorphAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> snapshotMorphOnAttachment;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EQProAudioProcessorEditor)
 };
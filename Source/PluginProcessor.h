@@ -1,14 +1,25 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "dsp/CpuGovernor.h"
 #include "dsp/EqEngine.h"
 #include "dsp/ParamSnapshot.h"
+#include "dsp/SnapshotBuilder.h"
 #include "dsp/AnalyzerTap.h"
 #include "dsp/MeterTap.h"
+#include "ui/AnalyzerWorker.h"
+#include "util/ParameterHistory.h"
+#include "util/PresetLibrary.h"
+#include "util/StageProfiler.h"
+#include "util/TelemetryRing.h"
+#include <unordered_map>
+#include <vector>
 
 // Core audio processor: owns DSP engine, parameters, meters, and analyzers.
 class EQProAudioProcessor final : public juce::AudioProcessor,
-                                  private juce::Timer
+                                  private juce::Timer,
+                                  private juce::AudioProcessorListener,
+                                  private AnalyzerFrameSink
 {
 public:
     EQProAudioProcessor();
@@ -58,14 +69,32 @@ public:
     AudioFifo& getAnalyzerPostFifo();
     AudioFifo& getAnalyzerHarmonicFifo();  // v4.5 beta: FIFO for program + harmonics (red curve)
     AudioFifo& getAnalyzerExternalFifo();
+    // Sample rate of the analyzer FIFOs (after the taps' half-band decimation).
+    double getAnalyzerSampleRate() const;
+    // The FIFOs' only consumer; the editor's analyzer retains it while shown, telemetry export always.
+    AnalyzerWorker& getAnalyzerWorker();
+    // Shared-memory telemetry file (EQPRO_TELEMETRY=1), or an empty File when export is off.
+    juce::File getTelemetryFile() const;
+    // Per-stage audio thread timings (histograms, deadline overruns) for the diagnostics panel.
+    const StageProfiler& getProfiler() const;
+    // Features the CPU governor currently sheds, and its predicted load.
+    const eqdsp::CpuGovernor& getGovernor() const;
+    void resetProfiler();
+    // Writes the profiler report as JSON into the log folder and returns the file (empty on failure).
+    juce::File dumpProfile() const;
     // Current channel layout label helpers.
     std::vector<juce::String> getCurrentChannelNames() const;
     juce::String getCurrentLayoutDescription() const;
     // Meter state access.
     eqdsp::ChannelMeterState getMeterState(int channelIndex) const;
+    // All meter values from one audio block (levels, true peak, loudness, correlation).
+    bool getMeterSnapshot(eqdsp::MeterSnapshot& dest) const;
+    // Restart integrated loudness and true-peak max.
+    void resetLoudness();
     // Correlation/goniometer helpers.
     float getCorrelation() const;
-    int getGoniometerPoints(juce::Point<float>* dest, int maxPoints, int& writePos) const;
+    // Drains the goniometer point FIFO (mid/side pairs, oldest first); one UI consumer only.
+    int popGoniometerPoints(float* destMid, float* destSide, int maxPoints);
     juce::StringArray getCorrelationPairNames();
     void setCorrelationPairIndex(int index);
     int getCorrelationPairIndex() const;
@@ -84,14 +113,32 @@ public:
     float getLastProcessBand0GainDb() const;
     float getLastProcessBand0FreqHz() const;
     bool getLastProcessBand0Bypassed() const;
-    // Undo/redo manager for UI actions.
-    juce::UndoManager* getUndoManager();
+    // Undo/redo of parameter changes. One transaction per gesture (host/attachment gestures, or
+    // begin/endUndoGesture around editor drags); ungestured edits are grouped once they settle.
+    // Bulk restores (presets, snapshot recall, paste) are one transaction each. Message thread.
+    bool undo();
+    bool redo();
+    bool canUndo() const;
+    bool canRedo() const;
+    void beginUndoGesture(const juce::String& name);
+    void endUndoGesture();
+    // Oldest transactions are dropped beyond this size (default 4 MB, EQPRO_UNDO_MEMORY_KB).
+    void setUndoMemoryLimit(size_t bytes);
     // Preset browser helpers.
     void setPresetSelection(int index);
     int getPresetSelection() const;
     void setPresetApplyTarget(int index);
     int getPresetApplyTarget() const;
-    // Snapshot A/B/C/D helpers.
+    // Snapshot A/B/C/D slots (0..3) hold parameter vectors; recall is a bulk apply of the values
+    // that differ. With snapshotMorphOn, snapshotMorph blends band parameters from the first slot of
+    // snapshotMorphPair (0 %) to the second (100 %) instead of the live band settings.
+    static constexpr int kNumSnapshotSlots = 4;
+    void storeSnapshot(int slot);
+    void recallSnapshot(int slot);
+    bool hasSnapshot(int slot) const;
+    // True while the morph replaces the live bands (switch on, both slots stored; message thread).
+    // The editor locks band editing meanwhile, since edits would not be heard.
+    bool isSnapshotMorphActive() const;
     void storeSnapshotA();
     void storeSnapshotB();
     void recallSnapshotA();
@@ -111,7 +158,12 @@ public:
     // Instance clipboard helpers.
     void copyStateToClipboard();
     void pasteStateFromClipboard();
-    // Safe state replacement for preset loading.
+    // Preset library shared by all instances (indexing starts with the first editor).
+    PresetLibrary& getPresetLibrary();
+    // Applies an indexed preset's parameters through the bulk path; false if the entry is unreadable.
+    bool applyPreset(const PresetLibrary::Preset& preset);
+    // Bulk state restore (session load, presets, snapshots, paste): only changed values are applied,
+    // then one snapshot swap and one FIR rebuild follow. Recorded as one undo transaction.
     bool replaceStateSafely(const juce::ValueTree& newState);
     // Debug tone generator for calibration.
     void setDebugToneEnabled(bool enabled);
@@ -159,19 +211,57 @@ private:
     // Cache parameter pointers for low-overhead access.
     void initializeParamPointers();
     void timerCallback() override;
+    // Builds the next snapshot, swaps it in if it changed and schedules FIR rebuilds (message thread).
+    // immediateRebuild skips the drag debounce (bulk state restores).
+    void publishSnapshot(bool immediateRebuild);
     uint64_t buildSnapshot(eqdsp::ParamSnapshot& snapshot);
+    // Parameter vectors: denormalised values in host parameter order, NaN = leave unchanged.
+    std::vector<float> captureParameterValues() const;
+    std::vector<float> parameterValuesFromState(const juce::ValueTree& state) const;
+    // Writes the values that differ into the live tree (message thread).
+    void applyParameterValues(const std::vector<float>& values);
+    // Records an undo transaction (or resets history when undoName is empty), clamps the selection
+    // and publishes one snapshot after a bulk apply.
+    void finishBulkApply(const juce::String& undoName);
+    // Commits ungestured edits as their own transaction before the next one starts.
+    void commitPendingEdits();
+    // Timer: applies a pending history reset and groups ungestured edits once they settle.
+    void updateUndoHistory();
+    void audioProcessorParameterChanged(juce::AudioProcessor*, int, float) override {}
+    void audioProcessorChanged(juce::AudioProcessor*, const juce::AudioProcessorListener::ChangeDetails&) override {}
+    void audioProcessorParameterChangeGestureBegin(juce::AudioProcessor*, int parameterIndex) override;
+    void audioProcessorParameterChangeGestureEnd(juce::AudioProcessor*, int parameterIndex) override;
+    void writeSnapshotProperty(int slot);
+    void readSnapshotProperty(int slot);
+    // Sets the morph parameters of a slot's values to NaN so recalling it leaves them alone.
+    void excludeMorphParameters(std::vector<float>& values) const;
+    // Rebuilds the band tables of the current morph pair (message thread only).
+    void updateMorphEndpoints();
+    // Replaces the snapshot bands with the morph blend while snapshotMorphOn is set.
+    void applySnapshotMorph(eqdsp::ParamSnapshot& snapshot, int numChannels) const;
+    // Refresh channel labels and the per-channel loudness weights derived from them.
+    void refreshChannelNames();
     void verifyBandIndependence();
     void logBandVerify(const juce::String& message);
     void initLogging();
     void shutdownLogging();
 
     juce::AudioProcessorValueTreeState parameters;
-    juce::UndoManager undoManager;
+    ParameterHistory history;
+    int openUndoGestures = 0;
+    juce::String undoGestureName;
+    // Ungestured edits are committed once values stop changing for a few timer ticks.
+    static constexpr int kUndoIdleTicks = 5;
+    std::vector<float> undoPollValues;
+    int undoIdleTicks = 0;
+    std::atomic<bool> historyResetPending { false };
 
     std::array<std::array<BandParamPointers, ParamIDs::kBandsPerChannel>,
                ParamIDs::kMaxChannels>
         bandParamPointers {};
 
+    // The global fields of a ParamSnapshot, resolved once (see eqdsp::loadGlobalParams).
+    eqdsp::GlobalParamPointers<const std::atomic<float>*> globalParamPointers;
     std::atomic<float>* globalBypassParam = nullptr;
     std::atomic<float>* globalMixParam = nullptr;
     std::atomic<float>* phaseModeParam = nullptr;
@@ -185,16 +275,25 @@ private:
     std::atomic<float>* spectralAttackParam = nullptr;
     std::atomic<float>* spectralReleaseParam = nullptr;
     std::atomic<float>* spectralMixParam = nullptr;
+    std::atomic<float>* spectralLinkParam = nullptr;
+    std::atomic<float>* spectralBandsParam = nullptr;
     std::atomic<float>* characterModeParam = nullptr;
     std::atomic<float>* qModeParam = nullptr;
     std::atomic<float>* qModeAmountParam = nullptr;
     std::atomic<float>* analyzerExternalParam = nullptr;
+    std::atomic<float>* analyzerSourceParam = nullptr;
     std::atomic<float>* autoGainEnableParam = nullptr;
     std::atomic<float>* gainScaleParam = nullptr;
     std::atomic<float>* phaseInvertParam = nullptr;
     std::atomic<float>* midiLearnParam = nullptr;
     std::atomic<float>* midiTargetParam = nullptr;
     std::atomic<float>* smartSoloParam = nullptr;
+    std::atomic<float>* snapshotMorphParam = nullptr;
+    std::atomic<float>* snapshotMorphPairParam = nullptr;
+    std::atomic<float>* snapshotMorphOnParam = nullptr;
+    std::vector<std::atomic<float>*> orderedParamValues;
+    std::unordered_map<const std::atomic<float>*, size_t> paramIndexByValue;
+    juce::HashMap<juce::String, int> paramIndexById;
 
     bool verifyBands = false;
     bool verifyBandsDone = false;
@@ -207,6 +306,24 @@ private:
     eqdsp::AnalyzerTap analyzerHarmonicTap;  // v4.5 beta: Tap for program + harmonics curve (red)
     eqdsp::AnalyzerTap analyzerExternalTap;
     eqdsp::MeterTap meterTap;
+    // Declared after the taps whose FIFOs it drains.
+    std::unique_ptr<AnalyzerWorker> analyzerWorker;
+    // Telemetry export: the worker publishes each frame with the latest meters (worker thread).
+    void analyzerFrameReady(const AnalyzerFrame& frame) override;
+    // The export always carries pre and post, whatever the editor's view.
+    bool wantsCurve(AnalyzerCurve curve) const override
+    {
+        return curve == AnalyzerCurve::pre || curve == AnalyzerCurve::post;
+    }
+    // Analyzer settings used while no editor is open.
+    AnalyzerSettings makeTelemetrySettings() const;
+    TelemetryRing telemetryRing;
+    StageProfiler profiler;
+    // Audio thread only, apart from its atomic diagnostics.
+    eqdsp::CpuGovernor governor;
+    juce::SharedResourcePointer<PresetLibrary> presetLibrary;
+    Telemetry::Record telemetryRecord {};
+    eqdsp::MeterSnapshot telemetryMeters;
     eqdsp::ParamSnapshot snapshots[2];
     std::atomic<int> activeSnapshot { 0 };
     std::atomic<int> selectedBandIndex { 0 };
@@ -215,10 +332,28 @@ private:
     bool showPhasePreference = true;
     int presetSelection = 0;
     int presetApplyTarget = 0;
-    juce::String snapshotA;
-    juce::String snapshotB;
-    juce::String snapshotC;
-    juce::String snapshotD;
+    std::array<std::vector<float>, kNumSnapshotSlots> snapshotSlots;
+    using BandTable = std::array<std::array<eqdsp::BandSnapshot, ParamIDs::kBandsPerChannel>,
+                                 ParamIDs::kMaxChannels>;
+    struct MorphEndpoints
+    {
+        bool valid = false;
+        BandTable from {};
+        BandTable to {};
+    };
+    // Three slots so a second update can never overwrite the one the audio thread is reading: the
+    // message thread fills its write slot and swaps it into morphLatest (flagged fresh); the audio
+    // thread swaps its read slot for morphLatest only when fresh. The message thread itself reads
+    // the slot it published last.
+    static constexpr int kMorphFresh = 4;
+    MorphEndpoints morphEndpoints[3];
+    mutable std::atomic<int> morphLatest { 1 };
+    int morphWriteSlot = 0;
+    int morphPublishedSlot = 1;
+    mutable int morphReadSlot = 2;
+    int morphEndpointsPair = -1;
+    // Set by restores off the message thread; the timer rebuilds the endpoints.
+    std::atomic<bool> morphRefreshPending { false };
     bool darkTheme = true;
     int themeMode = 0;
     int correlationPairIndex = 0;
@@ -230,6 +365,8 @@ private:
     juce::String favoritePresets;
 
     double lastSampleRate = 0.0;
+    // lastSampleRate for the analyzer worker (telemetry records).
+    std::atomic<double> telemetrySampleRate { 0.0 };
     int lastMaxBlockSize = 0;
     uint64_t lastSnapshotHash = 0;
     int snapshotTick = 0;
@@ -242,10 +379,10 @@ private:
     juce::ThreadPool linearPhasePool { 1 };
     std::atomic<bool> linearJobRunning { false };
     std::atomic<int> pendingLatencySamples { -1 };
+    // Set by a restore off the message thread; the next timer tick publishes without debounce.
+    std::atomic<bool> bulkRestorePending { false };
     std::atomic<int> adaptiveQualityOffset { 0 };
     std::atomic<int> pendingAdaptiveQualityLog { 999 };
-    int cpuOverloadCounter = 0;
-    int cpuRecoverCounter = 0;
     std::atomic<int> lastProcessPhaseMode { 0 };
     std::atomic<int> lastProcessNumChannels { 0 };
     std::atomic<float> lastProcessGlobalMix { 1.0f };
@@ -1,17 +1,170 @@
 #include "AnalyzerTap.h"
 
+namespace
+{
+// Decimate until the analyzer rate is at or below this (keeps 20 kHz in band).
+constexpr double kMaxAnalyzerRate = 50000.0;
+}
+
 namespace eqdsp
 {
-void AnalyzerTap::prepare(int fifoSize)
+void AnalyzerTap::prepare(int fifoSize, double sampleRate, int numChannels)
+{
+    fifoChannels = juce::jlimit(1, ParamIDs::kMaxChannels, numChannels);
+    fifo.prepare(fifoSize, fifoChannels);
+
+    baseStages = 0;
+    double rate = sampleRate > 0.0 ? sampleRate : 48000.0;
+    while (rate > kMaxAnalyzerRate && baseStages < kMaxStages)
+    {
+        rate *= 0.5;
+        ++baseStages;
+    }
+    outputSampleRate.store(rate);
+
+    for (auto& chain : decimators)
+        for (auto& stage : chain)
+            stage.reset();
+    activeSource = static_cast<Source>(requestedSource.load(std::memory_order_relaxed));
+    activeChannel = requestedChannel.load(std::memory_order_relaxed);
+    activeFrames = 1;
+}
+
+void AnalyzerTap::setSource(Source source, int channel)
+{
+    requestedSource.store(static_cast<int>(source), std::memory_order_relaxed);
+    requestedChannel.store(channel, std::memory_order_relaxed);
+}
+
+void AnalyzerTap::setBlockStride(int stride)
+{
+    blockStride = juce::jmax(1, stride);
+}
+
+bool AnalyzerTap::takeBlock()
+{
+    if (blockStride <= 1)
+        return true;
+    strideCounter = (strideCounter + 1) % blockStride;
+    return strideCounter == 0;
+}
+
+void AnalyzerTap::applyPendingSource(int numChannels)
+{
+    const auto source = static_cast<Source>(requestedSource.load(std::memory_order_relaxed));
+    const int channel = requestedChannel.load(std::memory_order_relaxed);
+    const int frames = source == Source::powerSum ? juce::jmin(numChannels, fifoChannels) : 1;
+    if (source == activeSource && channel == activeChannel && frames == activeFrames)
+        return;
+
+    activeSource = source;
+    activeChannel = channel;
+    activeFrames = juce::jmax(1, frames);
+    for (auto& chain : decimators)
+        for (auto& stage : chain)
+            stage.reset();
+}
+
+void AnalyzerTap::pushBlock(const juce::AudioBuffer<float>& buffer, int numChannels, int extraStages)
+{
+    const int channels = juce::jmin(numChannels, buffer.getNumChannels(), ParamIDs::kMaxChannels);
+    const int samples = buffer.getNumSamples();
+    if (channels <= 0 || samples <= 0 || ! takeBlock())
+        return;
+
+    applyPendingSource(channels);
+    const int left = juce::jlimit(0, channels - 1, activeChannel);
+    const bool stereo = channels >= 2;
+
+    for (int start = 0; start < samples; start += kChunk)
+    {
+        const int count = juce::jmin(kChunk, samples - start);
+        float* dest = scratch[0].data();
+        switch (activeSource)
+        {
+            case Source::sum:
+            case Source::mid:
+            case Source::side:
+            {
+                const float* l = buffer.getReadPointer(0, start);
+                if (! stereo)
+                {
+                    // Mono: there is no side signal, and sum/mid are the channel itself.
+                    if (activeSource == Source::side)
+                        juce::FloatVectorOperations::clear(dest, count);
+                    else
+                        juce::FloatVectorOperations::copy(dest, l, count);
+                    break;
+                }
+                const float* r = buffer.getReadPointer(1, start);
+                if (activeSource == Source::side)
+                    juce::FloatVectorOperations::subtract(dest, l, r, count);
+                else
+                    juce::FloatVectorOperations::add(dest, l, r, count);
+                if (activeSource != Source::sum)
+                    juce::FloatVectorOperations::multiply(dest, 0.5f, count);
+                break;
+            }
+            case Source::powerSum:
+                for (int ch = 0; ch < activeFrames; ++ch)
+                    juce::FloatVectorOperations::copy(scratch[static_cast<size_t>(ch)].data(),
+                                                      buffer.getReadPointer(ch, start), count);
+                break;
+            case Source::channel:
+            default:
+                juce::FloatVectorOperations::copy(dest, buffer.getReadPointer(left, start), count);
+                break;
+        }
+        decimateAndPush(activeSource == Source::powerSum ? activeFrames : 1, count, extraStages);
+    }
+}
+
+void AnalyzerTap::push(const float* data, int numSamples, int extraStages)
 {
-    fifo.prepare(fifoSize);
+    if (data == nullptr || numSamples <= 0 || ! takeBlock())
+        return;
+
+    for (int start = 0; start < numSamples; start += kChunk)
+    {
+        const int count = juce::jmin(kChunk, numSamples - start);
+        juce::FloatVectorOperations::copy(scratch[0].data(), data + start, count);
+        decimateAndPush(1, count, extraStages);
+    }
 }
 
-void AnalyzerTap::push(const float* data, int numSamples)
+void AnalyzerTap::pushSilence(int numSamples, int extraStages)
 {
-    if (data == nullptr || numSamples <= 0)
+    if (! takeBlock())
         return;
-    fifo.push(data, numSamples);
+    for (int start = 0; start < numSamples; start += kChunk)
+    {
+        const int count = juce::jmin(kChunk, numSamples - start);
+        juce::FloatVectorOperations::clear(scratch[0].data(), count);
+        decimateAndPush(1, count, extraStages);
+    }
+}
+
+void AnalyzerTap::decimateAndPush(int frames, int numSamples, int extraStages)
+{
+    const int stages = juce::jlimit(0, kMaxStages, baseStages + extraStages);
+    const float* planes[ParamIDs::kMaxChannels] {};
+    int produced = numSamples;
+    for (int ch = 0; ch < frames; ++ch)
+    {
+        auto* data = scratch[static_cast<size_t>(ch)].data();
+        int count = numSamples;
+        for (int stage = 0; stage < stages; ++stage)
+            count = decimators[static_cast<size_t>(ch)][static_cast<size_t>(stage)].process(data, count);
+        produced = count;
+        planes[ch] = data;
+    }
+    if (produced > 0)
+        fifo.pushFrames(planes, frames, produced);
+}
+
+double AnalyzerTap::getOutputSampleRate() const
+{
+    return outputSampleRate.load();
 }
 
 AudioFifo& AnalyzerTap::getFifo()
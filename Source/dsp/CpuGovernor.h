@@ -0,0 +1,110 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <cstdint>
+#include "../util/StageProfiler.h"
+
+namespace eqdsp
+{
+// Predictive CPU budget governor (audio thread). Learns a per-stage cost model (ticks per sample,
+// mean and mean deviation) from the StageProfiler's block timings and predicts the load of the next
+// block against the host buffer's real-time budget. Under pressure it sheds features one step at a
+// time in a fixed priority order and restores them in reverse order once the predicted load with
+// the step restored stays low; the saving of each step is measured when it is applied, so recovery
+// is predicted rather than tried.
+//
+// Hysteresis: separate degrade/recover thresholds, a minimum dwell after every change, a long quiet
+// period before recovery, and a per-step back-off that doubles when a restored step has to be shed
+// again soon after. Bursty host load therefore settles on one level instead of toggling (each FIR
+// step is a full rebuild).
+class CpuGovernor
+{
+public:
+    // Degradation steps, shed in this order.
+    enum Step
+    {
+        analyzerThinning = 0, // analyzer taps fed every other block
+        meterTruePeak,        // meters use sample peak instead of 4x true peak
+        oversampling,         // realtime oversampling one factor lower
+        firLength1,           // linear-phase FIR one quality step shorter
+        firLength2,           // ... two steps shorter
+        numSteps
+    };
+
+    // What the engine currently runs; steps that would not save anything are skipped.
+    struct Context
+    {
+        int phaseMode = 0;
+        int oversamplingIndex = 0;
+    };
+
+    // Settings to apply after update().
+    struct Output
+    {
+        int analyzerStride = 1;
+        bool truePeak = true;
+        // Maximum realtime oversampling index (4 = unrestricted).
+        int oversamplingCap = 4;
+        // Linear-phase quality offset (0, -1, -2).
+        int firOffset = 0;
+    };
+
+    static const char* getStepName(int step);
+
+    void prepare(double sampleRate, int maxBlockSize);
+
+    // Audio thread, after StageProfiler::endBlock(). Returns true when the output changed.
+    bool update(const StageProfiler& profiler, int numSamples, const Context& context) noexcept;
+
+    const Output& getOutput() const noexcept { return output; }
+    // Any thread (diagnostics).
+    uint32_t getAppliedSteps() const noexcept { return appliedMask.load(std::memory_order_relaxed); }
+    float getPredictedLoad() const noexcept { return predictedLoad.load(std::memory_order_relaxed); }
+
+private:
+    // Load thresholds as a fraction of the block budget.
+    static constexpr double kDegradeLoad = 0.85;
+    static constexpr double kRecoverLoad = 0.60;
+    // Time constant of the cost model.
+    static constexpr double kModelSeconds = 0.5;
+    // Pressure has to persist this long before shedding.
+    static constexpr double kDegradeHoldSeconds = 0.1;
+    // Minimum time between any two changes; the model resettles after each one.
+    static constexpr double kDwellSeconds = 0.5;
+    static constexpr double kRecoverHoldSeconds = 3.0;
+    static constexpr double kMaxRecoverHoldSeconds = 60.0;
+    // A step shed again within this time of being restored doubles its recover hold.
+    static constexpr double kFlapWindowSeconds = 10.0;
+
+    struct Model
+    {
+        double mean = 0.0;
+        double deviation = 0.0;
+        bool primed = false;
+    };
+
+    bool isApplicable(int step, const Context& context) const noexcept;
+    // Estimated saving of a step in ticks per sample (measured, or a prior from its stages).
+    double estimatedSaving(int step) const noexcept;
+    void applyStep(int step, bool shed) noexcept;
+    void rebuildOutput() noexcept;
+
+    std::array<Model, StageProfiler::numStages> models {};
+    std::array<double, numSteps> measuredSaving {};
+    std::array<double, numSteps> costBeforeShed {};
+    std::array<double, numSteps> recoverHold {};
+    std::array<double, numSteps> restoredAt {};
+    uint32_t mask = 0;
+    int pendingMeasurement = -1;
+    double clockSeconds = 0.0;
+    double lastChangeSeconds = -1.0e9;
+    double pressureSeconds = 0.0;
+    double quietSeconds = 0.0;
+    double sampleRateHz = 48000.0;
+    Output output;
+
+    std::atomic<uint32_t> appliedMask { 0 };
+    std::atomic<float> predictedLoad { 0.0f };
+};
+} // namespace eqdsp
@@ -6,8 +6,11 @@
 #include "ParamSnapshot.h"
 #include "AnalyzerTap.h"
 #include "MeterTap.h"
+#include "Saturation.h"
 #include <vector>
 
+class StageProfiler;
+
 namespace eqdsp
 {
 // Central DSP engine: routes snapshots to IIR/FIR processing, meters, and taps.
@@ -28,13 +31,24 @@ public:
                  MeterTap& meterTap);
     // Rebuild FIR paths when parameters change.
     void updateLinearPhase(const ParamSnapshot& snapshot, double sampleRate);
+    // True once the convolvers run the impulses of the last rebuild (always true in realtime mode).
+    // Offline rendering pre-rolls silence until then.
+    bool isLinearPhaseReady(int numChannels) const;
 
     void setOversampling(int index);
+    // Total latency: EQ path (oversampling or FIR) plus the spectral stage.
     int getLatencySamples() const;
     void setDebugToneEnabled(bool enabled);
     void setDebugToneFrequency(float frequencyHz);
     void setAdaptiveQualityOffset(int offset);
     void setForceTestEnabled(bool enabled);
+    // Stage timings of process() go to this profiler (nullptr = off). Set before processing starts.
+    void setProfiler(StageProfiler* profilerIn);
+    // CPU governor hooks (audio thread, take effect on the next block). Lowering the oversampling
+    // cap crossfades to a pre-built lower factor and pads the difference, so the latency is unchanged.
+    void setOversamplingCap(int maxIndex);
+    // Realtime oversampling index of the last block (audio thread).
+    int getOversamplingIndex() const;
 
     EQDSP& getEqDsp();
     const EQDSP& getEqDsp() const;
@@ -45,50 +59,85 @@ public:
     int getLastRmsQuality() const;
 
 private:
+    // Latency of the EQ path alone (oversampling or FIR).
+    int getEqLatencySamples() const;
     // Hash helper to detect snapshot changes.
     uint64_t computeParamsHash(const ParamSnapshot& snapshot) const;
     // FIR rebuild path for linear phase processing.
     void rebuildLinearPhase(const ParamSnapshot& snapshot, int taps, int headSize, double sampleRate,
                             int effectiveQuality);
-    // Oversampling setup for non-realtime modes.
-    void updateOversampling(const ParamSnapshot& snapshot, double sampleRate, int maxBlockSize, int channels);
+    // Character-mode saturation over the first channels of target.
+    void applyCharacter(juce::AudioBuffer<float>& target, int channels, int numSamples,
+                        int characterMode);
+    // Realtime (phase mode 0) chain at one oversampling factor: the IIR EQ prepared at that rate
+    // and the delay that pads its latency up to the factor the quality setting requests.
+    struct RealtimePath
+    {
+        EQDSP eq;
+        juce::AudioBuffer<float> padBuffer;
+        int padWritePos = 0;
+        int padSamples = 0;
+        int index = -1;
+    };
+    // Selects the realtime oversampling factor for the quality setting and governor cap (audio
+    // thread, allocation-free: every factor is built in prepare()). A factor change starts the idle
+    // path with the active path's band state and crossfades to it.
+    void updateOversampling(const ParamSnapshot& snapshot);
+    // Runs one realtime path in place: oversample, EQ, character, downsample, latency pad.
+    void processRealtimePath(RealtimePath& path, juce::AudioBuffer<float>& target, int numChannels,
+                             int characterMode, const juce::AudioBuffer<float>* detectorBuffer,
+                             bool tapHarmonics);
+    // Delays the path output by its pad; the delay line keeps running when the pad changes.
+    void applyRealtimePad(RealtimePath& path, juce::AudioBuffer<float>& target, int numChannels);
     EQDSP eqDsp;
-    EQDSP eqDspOversampled;
+    std::array<RealtimePath, 2> realtimePaths;
+    int activeRealtimePath = 0;
+    // Input copy for the outgoing path while a factor switch crossfades.
+    juce::AudioBuffer<float> realtimeFadeBuffer;
+    // Crossfade progress; the incoming path stays silent for the hold (its latency) before the ramp.
+    int realtimeFadePosition = 0;
+    int realtimeFadeHoldSamples = 0;
+    int realtimeFadeTotalSamples = 0;
     LinearPhaseEQ linearPhaseEq;
     LinearPhaseEQ linearPhaseMsEq;
     SpectralDynamicsDSP spectralDsp;
+    // Linear quality index (High) from which the spectral stage uses 75% overlap Hann frames.
+    static constexpr int kSpectralHannQuality = 2;
+    int spectralFftOrder = 11;
 
     juce::AudioBuffer<float> dryBuffer;
     juce::AudioBuffer<float> dryDelayBuffer;
     int dryDelayWritePos = 0;
     int mixDelaySamples = 0;
     int mixDelayFadeSamplesRemaining = 0;
-    int maxDelaySamples = 8192;
-    juce::AudioBuffer<float> minPhaseBuffer;
+    // Longest FIR latency plus the longest spectral frame.
+    int maxDelaySamples = 8192 + SpectralDynamicsDSP::kMaxLatencySamples;
     juce::AudioBuffer<float> minPhaseDelayBuffer;
     int minPhaseDelayWritePos = 0;
     int minPhaseDelaySamples = 0;
     juce::AudioBuffer<float> calibBuffer;
-    juce::AudioBuffer<float> oversampledBuffer;
     juce::AudioBuffer<float> harmonicTapBuffer;
     juce::AudioBuffer<float> harmonicTapOversampledBuffer;
-    std::unique_ptr<juce::dsp::Oversampling<float>> oversampler;
+    // Realtime oversamplers by index (1 = 2x ... 4 = 16x); index 0 stays empty.
+    static constexpr int kMaxOversamplingIndex = 4;
+    std::array<std::unique_ptr<juce::dsp::Oversampling<float>>, kMaxOversamplingIndex + 1> oversamplers;
+    std::array<int, kMaxOversamplingIndex + 1> oversamplerLatencies {};
 
     juce::SmoothedValue<float> globalMixSmoothed;
     juce::SmoothedValue<float> outputTrimGainSmoothed;
     juce::SmoothedValue<float> autoGainSmoothed;
+    juce::SmoothedValue<float> forceTestGainSmoothed;
 
     int oversamplingIndex = 0;
     int oversamplingLatencySamples = 0;
-    int lastOversamplingIndex = -1;
-    double lastOversamplingSampleRate = 0.0;
-    int lastOversamplingBlockSize = 0;
-    int lastOversamplingChannels = 0;
+    int oversamplingCap = 4;
+    int preparedChannels = 0;
+    int oversampledBlockSize = 0;
     int maxPreparedBlockSize = 0;
     double sampleRateHz = 48000.0;
-    int meterSkipFactor = 1;
-    int meterSkipCounter = 0;
     std::atomic<bool> debugToneEnabled { false };
+    std::atomic<bool> forceTestEnabled { false };
+    StageProfiler* profiler = nullptr;
     double debugPhase = 0.0;
     double debugPhaseDelta = 0.0;
     int lastPhaseMode = 0;
@@ -103,6 +152,7 @@ private:
     std::vector<float> firImpulse;
     std::unique_ptr<juce::dsp::WindowingFunction<float>> firWindow;
     int firWindowMethod = -1;
+    int firWindowTaps = 0;
     std::atomic<float> lastPreRmsDb { -120.0f };
     std::atomic<float> lastPostRmsDb { -120.0f };
     std::atomic<int> lastRmsPhaseMode { 0 };
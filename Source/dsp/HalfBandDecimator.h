@@ -0,0 +1,29 @@
+#pragma once
+
+#include <array>
+
+namespace eqdsp
+{
+// Polyphase half-band FIR decimator (2:1) used by the analyzer taps.
+// Only the output phase is computed: the centre tap on one branch, the symmetric odd taps on the other.
+class HalfBandDecimator
+{
+public:
+    static constexpr int kTaps = 63;
+
+    // Clear history and phase.
+    void reset();
+    // Decimate in place; returns the number of output samples written to the start of data.
+    int process(float* data, int numSamples);
+
+private:
+    static constexpr int kCentre = (kTaps - 1) / 2;
+    // Nonzero taps on each side of the centre (odd offsets 1, 3, 5, ...).
+    static constexpr int kSideTaps = (kCentre + 1) / 2;
+
+    // Mirrored history so each output reads one contiguous window (oldest -> newest).
+    std::array<float, kTaps * 2> history {};
+    int writePos = 0;
+    bool outputPhase = false;
+};
+} // namespace eqdsp
@@ -152,4 +152,12 @@ void LinearPhaseEQ::setLatencySamples(int samples)
 {
     latencySamples = samples;
 }
+
+int LinearPhaseEQ::getActiveImpulseSize(int channelIndex) const
+{
+    if (channelIndex < 0 || channelIndex >= numChannels)
+        return 0;
+    const auto& convolver = convolutions[activeSet.load(std::memory_order_acquire)][static_cast<size_t>(channelIndex)];
+    return convolver != nullptr ? convolver->getCurrentIRSize() : 0;
+}
 } // namespace eqdsp
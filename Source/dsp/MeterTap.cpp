@@ -22,14 +22,34 @@ ChannelMeterState MeterTap::getState(int channel) const
     return meters.getChannelState(channel);
 }
 
+bool MeterTap::getSnapshot(MeterSnapshot& dest) const
+{
+    return meters.getSnapshot(dest);
+}
+
+void MeterTap::setLoudnessWeight(int channel, float weight)
+{
+    meters.setLoudnessWeight(channel, weight);
+}
+
+void MeterTap::requestLoudnessReset()
+{
+    meters.requestLoudnessReset();
+}
+
+void MeterTap::setTruePeakAllowed(bool allowed)
+{
+    meters.setTruePeakAllowed(allowed);
+}
+
 float MeterTap::getCorrelation() const
 {
     return meters.getCorrelation();
 }
 
-int MeterTap::copyScopePoints(juce::Point<float>* dest, int maxPoints, int& writePos) const
+int MeterTap::popScopePoints(float* destMid, float* destSide, int maxPoints)
 {
-    return meters.copyScopePoints(dest, maxPoints, writePos);
+    return meters.popScopePoints(destMid, destSide, maxPoints);
 }
 
 void MeterTap::setCorrelationPair(int channelA, int channelB)
@@ -55,6 +55,10 @@ struct ParamSnapshot
     float spectralAttackMs = 20.0f;
     float spectralReleaseMs = 200.0f;
     float spectralMix = 1.0f;
+    // 0 = independent, 1 = linked (sum), 2 = linked (max).
+    int spectralLink = 0;
+    // 0 = per bin, 1 = ERB bands, 2 = Bark bands.
+    int spectralBands = 0;
     bool autoGainEnabled = false;
     float gainScale = 1.0f;
     bool phaseInvert = false;
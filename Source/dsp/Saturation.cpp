@@ -0,0 +1,48 @@
+#include "Saturation.h"
+#include "../util/SimdSupport.h"
+
+namespace eqdsp
+{
+namespace Saturation
+{
+void processTanh(float* data, int numSamples, float drive, float outputGain) noexcept
+{
+    if (data == nullptr || numSamples <= 0)
+        return;
+
+    int i = 0;
+#if EQPRO_HAS_SSE2
+    const __m128 driveV = _mm_set1_ps(drive);
+    const __m128 gainV = _mm_set1_ps(outputGain);
+    const __m128 clipHi = _mm_set1_ps(kTanhClip);
+    const __m128 clipLo = _mm_set1_ps(-kTanhClip);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minusOne = _mm_set1_ps(-1.0f);
+    const __m128 n0 = _mm_set1_ps(135135.0f);
+    const __m128 n1 = _mm_set1_ps(17325.0f);
+    const __m128 n2 = _mm_set1_ps(378.0f);
+    const __m128 d1 = _mm_set1_ps(62370.0f);
+    const __m128 d2 = _mm_set1_ps(3150.0f);
+    const __m128 d3 = _mm_set1_ps(28.0f);
+    for (; i + 3 < numSamples; i += 4)
+    {
+        __m128 x = _mm_mul_ps(_mm_loadu_ps(data + i), driveV);
+        x = _mm_max_ps(clipLo, _mm_min_ps(clipHi, x));
+        const __m128 x2 = _mm_mul_ps(x, x);
+        __m128 num = _mm_add_ps(n2, x2);
+        num = _mm_add_ps(n1, _mm_mul_ps(x2, num));
+        num = _mm_mul_ps(x, _mm_add_ps(n0, _mm_mul_ps(x2, num)));
+        __m128 den = _mm_add_ps(d2, _mm_mul_ps(x2, d3));
+        den = _mm_add_ps(d1, _mm_mul_ps(x2, den));
+        den = _mm_add_ps(n0, _mm_mul_ps(x2, den));
+        __m128 y = _mm_div_ps(num, den);
+        y = _mm_max_ps(minusOne, _mm_min_ps(one, y));
+        _mm_storeu_ps(data + i, _mm_mul_ps(y, gainV));
+    }
+#endif
+    // Scalar tail (and the whole block on non-SSE targets, where it auto-vectorizes).
+    for (; i < numSamples; ++i)
+        data[i] = tanhRational(data[i] * drive) * outputGain;
+}
+} // namespace Saturation
+} // namespace eqdsp
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <cmath>
+#include <vector>
+#include "ParamSnapshot.h"
+
+// Parameter-to-snapshot helpers shared by the processor and the offline renderer.
+namespace eqdsp
+{
+// Default band frequencies (a bypassed band at its defaults stays bypassed).
+inline constexpr std::array<float, ParamIDs::kBandsPerChannel> kDefaultBandFreqs {
+    20.0f, 40.0f, 80.0f, 160.0f, 320.0f, 640.0f,
+    1250.0f, 2500.0f, 5000.0f, 10000.0f, 16000.0f, 24000.0f
+};
+
+// Parameter defaults (denormalised, as the parameters store them). createParameterLayout() declares
+// the parameters with these and the loaders below fall back to them, so a parameter missing from a
+// state reads the same in the plugin, a snapshot slot and the offline renderer. Off/zero defaults
+// are 0.
+inline constexpr float kDefaultGlobalMix = 100.0f;
+inline constexpr float kDefaultLinearQuality = 1.0f;
+inline constexpr float kDefaultQModeAmount = 50.0f;
+inline constexpr float kDefaultSpectralThresholdDb = -24.0f;
+inline constexpr float kDefaultSpectralRatio = 2.0f;
+inline constexpr float kDefaultSpectralAttackMs = 20.0f;
+inline constexpr float kDefaultSpectralReleaseMs = 200.0f;
+inline constexpr float kDefaultSpectralMix = 100.0f;
+inline constexpr float kDefaultGainScale = 100.0f;
+inline constexpr float kDefaultBandQ = 0.707f;
+inline constexpr float kDefaultBandBypass = 1.0f;
+inline constexpr float kDefaultBandSlope = 12.0f;
+inline constexpr float kDefaultBandMix = 100.0f;
+inline constexpr float kDefaultHarmonicMix = 100.0f;
+inline constexpr float kDefaultHarmonicBypass = 1.0f;
+inline constexpr float kDefaultDynThresholdDb = -24.0f;
+inline constexpr float kDefaultDynAttackMs = 20.0f;
+inline constexpr float kDefaultDynReleaseMs = 200.0f;
+inline constexpr float kDefaultDynAuto = 1.0f;
+
+// Reads one band through load(pointer, fallback), from the live parameters or a snapshot slot.
+template <typename Pointers, typename Load>
+void loadBandParams(const Pointers& ptrs, int band, Load&& load, BandSnapshot& dst)
+{
+    dst.frequencyHz = load(ptrs.frequency, kDefaultBandFreqs[static_cast<size_t>(band)]);
+    dst.gainDb = load(ptrs.gain, 0.0f);
+    dst.q = load(ptrs.q, kDefaultBandQ);
+    dst.type = static_cast<int>(load(ptrs.type, 0.0f));
+    dst.bypassed = load(ptrs.bypass, kDefaultBandBypass) > 0.5f;
+    dst.msTarget = static_cast<int>(load(ptrs.msTarget, 0.0f));
+    dst.slopeDb = load(ptrs.slope, kDefaultBandSlope);
+    dst.solo = load(ptrs.solo, 0.0f) > 0.5f;
+    dst.mix = load(ptrs.mix, kDefaultBandMix) / 100.0f;
+    dst.dynEnabled = load(ptrs.dynEnable, 0.0f) > 0.5f;
+    dst.dynMode = static_cast<int>(load(ptrs.dynMode, 0.0f));
+    dst.dynThresholdDb = load(ptrs.dynThreshold, kDefaultDynThresholdDb);
+    dst.dynAttackMs = load(ptrs.dynAttack, kDefaultDynAttackMs);
+    dst.dynReleaseMs = load(ptrs.dynRelease, kDefaultDynReleaseMs);
+    dst.dynAuto = load(ptrs.dynAuto, kDefaultDynAuto) > 0.5f;
+    dst.dynExternal = load(ptrs.dynExternal, 0.0f) > 0.5f;
+    // v4.4 beta: Harmonic parameters (per-band, independent for each of 12 bands)
+    dst.oddHarmonicDb = load(ptrs.odd, 0.0f);
+    dst.mixOdd = load(ptrs.mixOdd, kDefaultHarmonicMix) / 100.0f;
+    dst.evenHarmonicDb = load(ptrs.even, 0.0f);
+    dst.mixEven = load(ptrs.mixEven, kDefaultHarmonicMix) / 100.0f;
+    dst.harmonicBypassed = load(ptrs.harmonicBypass, kDefaultHarmonicBypass) > 0.5f;
+
+    // Auto-activate a band if parameters deviate from defaults.
+    if (dst.bypassed)
+    {
+        constexpr float kEps = 1.0e-3f;
+        const float defaultFreq = kDefaultBandFreqs[static_cast<size_t>(band)];
+        const bool isDefault =
+            std::abs(dst.frequencyHz - defaultFreq) < 0.01f
+            && std::abs(dst.gainDb) < kEps
+            && std::abs(dst.q - kDefaultBandQ) < kEps
+            && dst.type == 0
+            && std::abs(dst.slopeDb - kDefaultBandSlope) < kEps
+            && std::abs(dst.mix - kDefaultBandMix / 100.0f) < kEps
+            && dst.msTarget == 0
+            && !dst.solo;
+        if (! isDefault)
+            dst.bypassed = false;
+    }
+}
+
+// Global (non-band) parameters feeding a ParamSnapshot; Pointer is whatever load() reads.
+template <typename Pointer>
+struct GlobalParamPointers
+{
+    Pointer bypass = nullptr;
+    Pointer mix = nullptr;
+    Pointer phaseMode = nullptr;
+    Pointer linearQuality = nullptr;
+    Pointer linearWindow = nullptr;
+    Pointer outputTrim = nullptr;
+    Pointer characterMode = nullptr;
+    Pointer smartSolo = nullptr;
+    Pointer qMode = nullptr;
+    Pointer qModeAmount = nullptr;
+    Pointer spectralEnable = nullptr;
+    Pointer spectralThreshold = nullptr;
+    Pointer spectralRatio = nullptr;
+    Pointer spectralAttack = nullptr;
+    Pointer spectralRelease = nullptr;
+    Pointer spectralMix = nullptr;
+    Pointer spectralLink = nullptr;
+    Pointer spectralBands = nullptr;
+    Pointer autoGainEnable = nullptr;
+    Pointer gainScale = nullptr;
+    Pointer phaseInvert = nullptr;
+};
+
+// Resolves the global parameters through find(parameterID), e.g. APVTS::getRawParameterValue.
+template <typename Find>
+auto findGlobalParams(Find&& find)
+{
+    GlobalParamPointers<decltype(find(ParamIDs::globalBypass))> ptrs;
+    ptrs.bypass = find(ParamIDs::globalBypass);
+    ptrs.mix = find(ParamIDs::globalMix);
+    ptrs.phaseMode = find(ParamIDs::phaseMode);
+    ptrs.linearQuality = find(ParamIDs::linearQuality);
+    ptrs.linearWindow = find(ParamIDs::linearWindow);
+    ptrs.outputTrim = find(ParamIDs::outputTrim);
+    ptrs.characterMode = find(ParamIDs::characterMode);
+    ptrs.smartSolo = find(ParamIDs::smartSolo);
+    ptrs.qMode = find(ParamIDs::qMode);
+    ptrs.qModeAmount = find(ParamIDs::qModeAmount);
+    ptrs.spectralEnable = find(ParamIDs::spectralEnable);
+    ptrs.spectralThreshold = find(ParamIDs::spectralThreshold);
+    ptrs.spectralRatio = find(ParamIDs::spectralRatio);
+    ptrs.spectralAttack = find(ParamIDs::spectralAttack);
+    ptrs.spectralRelease = find(ParamIDs::spectralRelease);
+    ptrs.spectralMix = find(ParamIDs::spectralMix);
+    ptrs.spectralLink = find(ParamIDs::spectralLink);
+    ptrs.spectralBands = find(ParamIDs::spectralBands);
+    ptrs.autoGainEnable = find(ParamIDs::autoGainEnable);
+    ptrs.gainScale = find(ParamIDs::gainScale);
+    ptrs.phaseInvert = find(ParamIDs::phaseInvert);
+    return ptrs;
+}
+
+// Reads the global snapshot fields through load(pointer, fallback), like loadBandParams().
+template <typename Pointers, typename Load>
+void loadGlobalParams(const Pointers& ptrs, Load&& load, ParamSnapshot& dst)
+{
+    dst.globalBypass = load(ptrs.bypass, 0.0f) > 0.5f;
+    dst.globalMix = load(ptrs.mix, kDefaultGlobalMix) / 100.0f;
+    dst.phaseMode = static_cast<int>(load(ptrs.phaseMode, 0.0f));
+    // v4.6 beta: Quality is selectable in linear mode; oversampling follows it.
+    dst.linearQuality = static_cast<int>(load(ptrs.linearQuality, kDefaultLinearQuality));
+    dst.oversampling = dst.linearQuality;
+    dst.linearWindow = static_cast<int>(load(ptrs.linearWindow, 0.0f));
+    dst.outputTrimDb = load(ptrs.outputTrim, 0.0f);
+    dst.characterMode = static_cast<int>(load(ptrs.characterMode, 0.0f));
+    dst.smartSolo = load(ptrs.smartSolo, 0.0f) > 0.5f;
+    dst.qMode = static_cast<int>(load(ptrs.qMode, 0.0f));
+    dst.qModeAmount = load(ptrs.qModeAmount, kDefaultQModeAmount);
+    dst.spectralEnabled = load(ptrs.spectralEnable, 0.0f) > 0.5f;
+    dst.spectralThresholdDb = load(ptrs.spectralThreshold, kDefaultSpectralThresholdDb);
+    dst.spectralRatio = load(ptrs.spectralRatio, kDefaultSpectralRatio);
+    dst.spectralAttackMs = load(ptrs.spectralAttack, kDefaultSpectralAttackMs);
+    dst.spectralReleaseMs = load(ptrs.spectralRelease, kDefaultSpectralReleaseMs);
+    dst.spectralMix = load(ptrs.spectralMix, kDefaultSpectralMix) / 100.0f;
+    dst.spectralLink = static_cast<int>(load(ptrs.spectralLink, 0.0f));
+    dst.spectralBands = static_cast<int>(load(ptrs.spectralBands, 0.0f));
+    dst.autoGainEnabled = load(ptrs.autoGainEnable, 0.0f) > 0.5f;
+    dst.gainScale = load(ptrs.gainScale, kDefaultGainScale) / 100.0f;
+    dst.phaseInvert = load(ptrs.phaseInvert, 0.0f) > 0.5f;
+}
+
+// Band channel target choices (the band "ms" parameter), in parameter choice order.
+enum MsChoiceIndex
+{
+    kMsAll = 0,
+    kMsStereoFront,
+    kMsLeft,
+    kMsRight,
+    kMsMidFront,
+    kMsSideFront,
+    kMsCentre,
+    kMsLfe,
+    kMsStereoRear,
+    kMsLs,
+    kMsRs,
+    kMsMidRear,
+    kMsSideRear,
+    kMsStereoLateral,
+    kMsLrs,
+    kMsRrs,
+    kMsMidLateral,
+    kMsSideLateral,
+    kMsCs,
+    kMsStereoFrontWide,
+    kMsLw,
+    kMsRw,
+    kMsMidFrontWide,
+    kMsSideFrontWide,
+    kMsStereoTopFront,
+    kMsTfl,
+    kMsTfr,
+    kMsMidTopFront,
+    kMsSideTopFront,
+    kMsStereoTopRear,
+    kMsTrl,
+    kMsTrr,
+    kMsMidTopRear,
+    kMsSideTopRear,
+    kMsStereoTopMiddle,
+    kMsTml,
+    kMsTmr,
+    kMsMidTopMiddle,
+    kMsSideTopMiddle
+};
+
+// Resolves each band's channel target (read from sourceChannel) against the channel labels: fills
+// msTargets/bandChannelMasks and mirrors bands covering several channels from sourceChannel.
+// Missing labels fall back to all channels; M/S needs a pair. Used by the processor and the
+// offline renderer.
+void routeBands(ParamSnapshot& snapshot, const std::vector<juce::String>& channelNames, int sourceChannel);
+} // namespace eqdsp
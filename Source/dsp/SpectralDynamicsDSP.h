@@ -1,7 +1,9 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include <vector>
+#include "SpectralKernels.h"
 
 namespace eqdsp
 {
@@ -9,43 +11,135 @@ namespace eqdsp
 class SpectralDynamicsDSP
 {
 public:
-    // Prepare FFT buffers and state.
+    // Largest frame latency any configuration can report (fftOrder 13).
+    static constexpr int kMaxLatencySamples = 1 << 13;
+
+    enum class WindowType
+    {
+        // sqrt-Hann analysis + synthesis: COLA at 50% and 75% overlap.
+        sqrtHann,
+        // Hann analysis + synthesis: lower sidelobes, needs 75% overlap.
+        hann
+    };
+
+    // How channels share a detector (and therefore one gain curve).
+    enum class LinkMode
+    {
+        independent,
+        // Mean power across channels.
+        sum,
+        // Loudest channel per bin.
+        max
+    };
+
+    // Resolution of the gain computer.
+    enum class BandGrouping
+    {
+        bins,
+        erb,
+        bark
+    };
+
+    // Prepare FFT buffers and state (applies the frame configuration).
     void prepare(double sampleRate, int maxBlockSize, int channels);
     // Reset state.
     void reset();
-    // Enable/disable processing.
+    // Enable/disable processing; both directions crossfade instead of switching.
     void setEnabled(bool enabled);
     // Set detector and mix parameters.
     void setParams(float thresholdDb, float ratio, float attackMs, float releaseMs, float mix);
-    // Process buffer in-place.
+    // Set FFT order (8..13), overlap (2 = 50%, 4 = 75%) and window. The order takes effect on
+    // the next prepare(); overlap and window switch at runtime behind an effect crossfade.
+    void setFrameConfig(int fftOrder, int overlap, WindowType window);
+    // Set channel linking and band grouping; changing either restarts the gain envelopes.
+    void setDetection(LinkMode link, BandGrouping grouping);
+    // Process buffer in-place (wet and dry are both delayed by the frame latency).
+    // Call every block: once a disable crossfade has finished it only feeds the input delay line.
     void process(juce::AudioBuffer<float>& buffer);
+    // Latency to report to the host: fftSize while enabled or fading out, otherwise 0.
+    // Safe to read from any thread.
+    int getLatencySamples() const { return reportedLatency.load(std::memory_order_relaxed); }
 
 private:
-    struct ChannelState
+    void processFrames(int numChannels);
+    // Switch hop and windows to the requested overlap/window (no allocation).
+    void applyFrameConfig();
+    bool frameConfigPending() const
     {
-        std::vector<float> circular;
-        std::vector<float> ola;
-        std::vector<float> fftData;
-        std::vector<float> gainDb;
-        int writeIndex = 0;
-        int hopCounter = 0;
-    };
+        return requestedOverlap != activeOverlap || requestedWindow != activeWindow;
+    }
+    // Threshold offset and per-hop envelope coefficients.
+    void updateGainParams();
+    // Restart the overlap-add and envelopes and begin the enable crossfade.
+    void activate();
+    // Advance the input ring (dry delay) without processing, while inactive.
+    void writeInputRing(const juce::AudioBuffer<float>& buffer, int numChannels);
+    // Detector power for a link group (channels [first, first + count)).
+    const float* computeGroupPower(int firstChannel, int count);
 
     double sampleRateHz = 44100.0;
+    int requestedOrder = 11;
+    int requestedOverlap = 2;
+    WindowType requestedWindow = WindowType::sqrtHann;
+
+    int activeOverlap = 2;
+    WindowType activeWindow = WindowType::sqrtHann;
+
     int fftOrder = 11;
     int fftSize = 1 << 11;
     int hopSize = 1 << 10;
-    float normalization = 1.0f;
+    int numBins = (1 << 10) + 1;
+    int numPreparedChannels = 0;
     bool enabled = false;
 
+    // Enable/disable crossfade: align fades the (delayed) stage output against the undelayed
+    // input, effect fades the compression in once the overlap-add has been primed.
+    bool active = false;
+    float alignGain = 0.0f;
+    float effectGain = 0.0f;
+    int warmupRemaining = 0;
+    int fadeSamples = 1024;
+    std::atomic<int> reportedLatency { 0 };
+
     float thresholdDb = -24.0f;
     float ratio = 2.0f;
     float attackMs = 20.0f;
     float releaseMs = 200.0f;
     float mix = 1.0f;
+    // Bin level (FFT units) of a 0 dBFS sine, so the threshold is in dBFS.
+    float detectorOffsetDb = 0.0f;
+    LinkMode linkMode = LinkMode::independent;
+    BandGrouping bandGrouping = BandGrouping::bins;
+    SpectralKernels::GainParams gainParams;
+    SpectralKernels::BandLayout erbLayout;
+    SpectralKernels::BandLayout barkLayout;
 
-    std::vector<float> window;
+    // Shared by all channels: every channel advances in lock-step.
+    int ringPos = 0;
+    int hopFill = 0;
+
+    // Window shapes indexed by WindowType, with their sums for normalization.
+    std::array<std::vector<float>, 2> windowShapes;
+    std::array<double, 2> windowSums {};
+    std::array<double, 2> windowPowerSums {};
+    std::vector<float> analysisWindow;
+    // Synthesis window pre-scaled by the overlap-add normalization.
+    std::vector<float> synthesisWindow;
+    std::vector<float> chunkScratch;
+    // Per link group scratch (numBins each).
+    std::vector<float> detectPower;
+    std::vector<float> detectLevelDb;
+    std::vector<float> groupGainDb;
+    std::vector<float> groupGain;
     std::unique_ptr<juce::dsp::FFT> fft;
-    std::vector<ChannelState> states;
+
+    // Per channel: mirrored input ring (2 * fftSize) so every frame is contiguous.
+    juce::AudioBuffer<float> inputRing;
+    juce::AudioBuffer<float> olaRing;
+    // Per channel: FFT frame workspace (2 * fftSize).
+    juce::AudioBuffer<float> frames;
+    juce::AudioBuffer<float> binPower;
+    // Per link group: smoothed gain (dB) per bin or per band.
+    juce::AudioBuffer<float> gainState;
 };
 } // namespace eqdsp
@@ -1,12 +1,11 @@
 #include "AnalyzerComponent.h"
-#include <complex>
 #include <cmath>
 #include <algorithm>
 #include <functional>
 #include "../PluginProcessor.h"
 #include "../util/FFTUtils.h"
-#include "../util/Smoothing.h"
 #include "../util/ColorUtils.h"
+#include "CurveMath.h"
 
 // FFT display + EQ curve rendering + interactive band editing.
 
@@ -21,8 +20,6 @@ constexpr float kAnalyzerMinDb = -60.0f;
 constexpr float kAnalyzerMaxDb = 60.0f;
 constexpr float kPointRadius = 6.5f;
 constexpr float kHitRadius = 4.0f;
-// v4.4 beta: Faster smoothing for more reactive analyzer (was 0.2f, now 0.3f for quicker response)
-constexpr float kSmoothingCoeff = 0.3f;
 
 const juce::String kParamFreqSuffix = "freq";
 const juce::String kParamGainSuffix = "gain";
@@ -56,24 +53,37 @@ const juce::StringArray kFilterTypeLabels {
 AnalyzerComponent::AnalyzerComponent(EQProAudioProcessor& processor)
     : processorRef(processor),
       parameters(processor.getParameters()),
-      externalFifo(processor.getAnalyzerExternalFifo()),
-      harmonicFifo(processor.getAnalyzerHarmonicFifo()),  // v4.5 beta: FIFO for harmonic-only curve (red)
-      fft(fftOrder),
-      window(fftSize, juce::dsp::WindowingFunction<float>::hann)
+      worker(processor.getAnalyzerWorker())
 {
-    preMagnitudes.fill(kAnalyzerMinDb);
-    postMagnitudes.fill(kAnalyzerMinDb);
-    harmonicMagnitudes.fill(kAnalyzerMinDb);  // v4.5 beta: Magnitudes for harmonic-only curve (red)
-    externalMagnitudes.fill(kAnalyzerMinDb);
+    for (auto& curve : displayFrame.curves)
+        curve.fill(kAnalyzerMinDb);
     selectedBands.push_back(selectedBand);
+    for (int ch = 0; ch < ParamIDs::kMaxChannels; ++ch)
+    {
+        for (int band = 0; band < ParamIDs::kBandsPerChannel; ++band)
+        {
+            auto& pointers = harmonicParams[static_cast<size_t>(ch)][static_cast<size_t>(band)];
+            pointers.odd = parameters.getRawParameterValue(ParamIDs::bandParamId(ch, band, "odd"));
+            pointers.even = parameters.getRawParameterValue(ParamIDs::bandParamId(ch, band, "even"));
+            pointers.mixOdd = parameters.getRawParameterValue(ParamIDs::bandParamId(ch, band, "mixOdd"));
+            pointers.mixEven = parameters.getRawParameterValue(ParamIDs::bandParamId(ch, band, "mixEven"));
+            pointers.bypass = parameters.getRawParameterValue(ParamIDs::bandParamId(ch, band, "harmonicBypass"));
+        }
+    }
     lastTimerHz = 30;
-    // v4.4 beta: Defer timer start - will start after first resize
+    // v4.4 beta: Defer frame ticks - they start after first resize (see getFrameRateHz)
     // This prevents expensive FFT updates before component is properly laid out
     hasBeenResized = false;
-    perBandCurveHash.assign(ParamIDs::kBandsPerChannel, 0);
-    // v4.4 beta: Use buffered rendering for better performance on initial load
-    // Reduces repaint overhead and ensures controls appear immediately
-    setBufferedToImage(true);
+    // Static and EQ layers are cached explicitly (see paint); whole-component buffering would just
+    // re-render every frame because the spectrum repaints each tick.
+    setOpaque(false);
+}
+
+AnalyzerComponent::~AnalyzerComponent()
+{
+    endUndoGesture();
+    if (hasBeenResized)
+        worker.release();
 }
 
 void AnalyzerComponent::setSelectedBand(int bandIndex)
@@ -81,25 +91,27 @@ void AnalyzerComponent::setSelectedBand(int bandIndex)
     selectedBand = juce::jlimit(0, ParamIDs::kBandsPerChannel - 1, bandIndex);
     selectedBands.clear();
     selectedBands.push_back(selectedBand);
-    repaint();
+    repaintOverlay();
 }
 
 void AnalyzerComponent::setSelectedChannel(int channelIndex)
 {
     selectedChannel = juce::jlimit(0, ParamIDs::kMaxChannels - 1, channelIndex);
-    repaint();
+    repaintOverlay();
 }
 
 
 void AnalyzerComponent::setTheme(const ThemeColors& newTheme)
 {
     theme = newTheme;
+    invalidateLayers();
     repaint();
 }
 
 void AnalyzerComponent::setUiScale(float scale)
 {
     uiScale = juce::jlimit(0.75f, 2.5f, scale);
+    invalidateLayers();
     repaint();
 }
 
@@ -108,20 +120,82 @@ void AnalyzerComponent::setInteractive(bool shouldAllow)
     allowInteraction = shouldAllow;
 }
 
+void AnalyzerComponent::setBandEditingLocked(bool locked)
+{
+    bandEditingLocked = locked;
+}
+
 void AnalyzerComponent::invalidateCaches()
 {
     lastCurveWidth = 0;
-    lastCurveHash = 0;
     lastCurveBand = -1;
     lastCurveChannel = -1;
-    perBandCurveHash.assign(ParamIDs::kBandsPerChannel, 0);
-    eqCurveDb.clear();
-    selectedBandCurveDb.clear();
-    perBandCurveDb.clear();
-    perBandActive.clear();
+    bandCurveParamsChannel = -1;
+    for (auto& cache : bandCurves)
+        cache.valid = false;
+    invalidateLayers();
 }
 
 void AnalyzerComponent::paint(juce::Graphics& g)
+{
+    // Layers, bottom to top: background + grid (image), live spectrum, EQ curves + band points
+    // (image), hover HUD, amplitude labels (image). Only the spectrum and HUD are drawn every frame.
+    const float pixelScale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (pixelScale != layerPixelScale)
+    {
+        layerPixelScale = pixelScale;
+        invalidateLayers();
+    }
+
+    const auto renderLayer = [this, pixelScale](juce::Image& layer, const std::function<void(juce::Graphics&)>& draw)
+    {
+        const int w = juce::roundToInt(static_cast<float>(getWidth()) * pixelScale);
+        const int h = juce::roundToInt(static_cast<float>(getHeight()) * pixelScale);
+        if (! layer.isValid() || layer.getWidth() != w || layer.getHeight() != h)
+            layer = juce::Image(juce::Image::ARGB, juce::jmax(1, w), juce::jmax(1, h), true);
+        else
+            layer.clear(layer.getBounds());
+        juce::Graphics layerGraphics(layer);
+        layerGraphics.addTransform(juce::AffineTransform::scale(pixelScale));
+        draw(layerGraphics);
+    };
+    const auto drawLayer = [&g, pixelScale](const juce::Image& layer)
+    {
+        g.drawImageTransformed(layer, juce::AffineTransform::scale(1.0f / pixelScale));
+    };
+
+    if (! backgroundLayer.isValid())
+        renderLayer(backgroundLayer, [this](juce::Graphics& lg) { paintBackgroundLayer(lg); });
+    if (! labelLayer.isValid())
+        renderLayer(labelLayer, [this](juce::Graphics& lg) { drawAmplitudeLabels(lg, getMagnitudeArea()); });
+    if (overlayDirty || ! overlayLayer.isValid())
+    {
+        renderLayer(overlayLayer, [this](juce::Graphics& lg) { paintOverlayLayer(lg); });
+        overlayDirty = false;
+    }
+
+    drawLayer(backgroundLayer);
+    paintSpectrum(g);
+    drawLayer(overlayLayer);
+    paintHoverHud(g);
+    // Amplitude labels go on top so -60..+60 dB are never overlapped by graphical elements.
+    drawLayer(labelLayer);
+}
+
+void AnalyzerComponent::invalidateLayers()
+{
+    backgroundLayer = {};
+    labelLayer = {};
+    overlayDirty = true;
+}
+
+void AnalyzerComponent::repaintOverlay()
+{
+    overlayDirty = true;
+    repaint();
+}
+
+void AnalyzerComponent::paintBackgroundLayer(juce::Graphics& g)
 {
     auto plotArea = getPlotArea();
     auto magnitudeArea = getMagnitudeArea();
@@ -149,89 +223,51 @@ void AnalyzerComponent::paint(juce::Graphics& g)
 
     g.saveState();
     g.reduceClipRegion(plotArea);
-
-    // Draw grid lines early (background elements).
     drawGridLines(g, magnitudeArea);
+    g.restoreState();
+}
 
-    const float maxFreq = getMaxFreq();
+void AnalyzerComponent::paintSpectrum(juce::Graphics& g)
+{
+    auto plotArea = getPlotArea();
+    auto magnitudeArea = getMagnitudeArea();
+    const float scale = uiScale;
+
+    g.saveState();
+    g.reduceClipRegion(plotArea);
 
     // v4.4 beta: Smoother, more beautiful curves using quadratic interpolation
-    juce::Path prePath;
-    juce::Path postPath;
-    bool started = false;
-    int pointIndex = 0;
-    float prevPreX = 0.0f, prevPreY = 0.0f;
-    float prevPostX = 0.0f, prevPostY = 0.0f;
-
-    const int firstBin = juce::jlimit(1, fftBins - 1,
-                                      static_cast<int>(std::ceil((kMinFreq * fftSize) / lastSampleRate)));
-
-    const float seedX = plotArea.getX();
-    const float seedPreY = juce::jmap(preMagnitudes[firstBin], kAnalyzerMinDb, kAnalyzerMaxDb,
-                                      static_cast<float>(magnitudeArea.getBottom()),
-                                      static_cast<float>(magnitudeArea.getY()));
-    const float seedPostY = juce::jmap(postMagnitudes[firstBin], kAnalyzerMinDb, kAnalyzerMaxDb,
-                                       static_cast<float>(magnitudeArea.getBottom()),
-                                       static_cast<float>(magnitudeArea.getY()));
-    prePath.startNewSubPath(seedX, seedPreY);
-    postPath.startNewSubPath(seedX, seedPostY);
-    prevPreX = seedX;
-    prevPreY = seedPreY;
-    prevPostX = seedX;
-    prevPostY = seedPostY;
-    started = true;
-
-    for (int bin = firstBin; bin < fftBins; ++bin)
+    // The worker delivers one value per display column (its bin-to-column map is rebuilt only on
+    // resize or rate changes), so drawing is a straight walk.
+    const auto& frame = displayFrame;
+    const int columns = frame.validPoints;
+    const float columnWidth = frame.numPoints > 0
+        ? static_cast<float>(plotArea.getWidth()) / static_cast<float>(frame.numPoints)
+        : 0.0f;
+    const auto toAnalyzerY = [&magnitudeArea](float db)
     {
-        const float freq = (lastSampleRate * bin) / static_cast<float>(fftSize);
-        if (freq < kMinFreq || freq > maxFreq)
-            continue;
+        return juce::jmap(db, kAnalyzerMinDb, kAnalyzerMaxDb,
+                          static_cast<float>(magnitudeArea.getBottom()),
+                          static_cast<float>(magnitudeArea.getY()));
+    };
+    // Columns are already reduced to one envelope value per pixel, so straight segments are
+    // enough; quadratics would only add flattening work at 4K/HiDPI widths.
+    const auto buildSpectrumPath = [&](AnalyzerCurve curve)
+    {
+        juce::Path path;
+        if (columns <= 0)
+            return path;
+        const auto& values = frame.curve(curve);
+        path.preallocateSpace(columns * 3 + 8);
+        path.startNewSubPath(plotArea.getX(), toAnalyzerY(values[0]));
+        for (int i = 1; i < columns; ++i)
+            path.lineTo(plotArea.getX() + static_cast<float>(i) * columnWidth,
+                        toAnalyzerY(values[static_cast<size_t>(i)]));
+        return path;
+    };
 
-        const float xNorm = FFTUtils::freqToNorm(freq, kMinFreq, maxFreq);
-        const float x = plotArea.getX() + xNorm * plotArea.getWidth();
-        const float preDb = preMagnitudes[bin];
-        const float postDb = postMagnitudes[bin];
-        const float preY = juce::jmap(preDb, kAnalyzerMinDb, kAnalyzerMaxDb,
-                                      static_cast<float>(magnitudeArea.getBottom()),
-                                      static_cast<float>(magnitudeArea.getY()));
-        const float postY = juce::jmap(postDb, kAnalyzerMinDb, kAnalyzerMaxDb,
-                                       static_cast<float>(magnitudeArea.getBottom()),
-                                       static_cast<float>(magnitudeArea.getY()));
-
-        if (! started)
-        {
-            prePath.startNewSubPath(x, preY);
-            postPath.startNewSubPath(x, postY);
-            prevPreX = x;
-            prevPreY = preY;
-            prevPostX = x;
-            prevPostY = postY;
-            started = true;
-        }
-        else if (pointIndex < 3)
-        {
-            prePath.lineTo(x, preY);
-            postPath.lineTo(x, postY);
-            prevPreX = x;
-            prevPreY = preY;
-            prevPostX = x;
-            prevPostY = postY;
-        }
-        else
-        {
-            // v4.4 beta: Use quadratic curves for smoother, more beautiful lines
-            const float midX = (prevPreX + x) * 0.5f;
-            const float midPreY = (prevPreY + preY) * 0.5f;
-            const float midPostY = (prevPostY + postY) * 0.5f;
-            prePath.quadraticTo(midX, midPreY, x, preY);
-            postPath.quadraticTo(midX, midPostY, x, postY);
-            prevPreX = x;
-            prevPreY = preY;
-            prevPostX = x;
-            prevPostY = postY;
-        }
-        ++pointIndex;
-    }
+    const juce::Path prePath = buildSpectrumPath(AnalyzerCurve::pre);
+    const juce::Path postPath = buildSpectrumPath(AnalyzerCurve::post);
 
     const int viewIndex = parameters.getRawParameterValue(ParamIDs::analyzerView) != nullptr
         ? static_cast<int>(parameters.getRawParameterValue(ParamIDs::analyzerView)->load())
@@ -292,6 +328,26 @@ void AnalyzerComponent::paint(juce::Graphics& g)
         g.strokePath(postPath, juce::PathStrokeType(3.5f * scale));
     }
 
+    // Peak-hold traces: thin lines over the live curves.
+    if (frame.hasPeaks && columns > 1)
+    {
+        const auto drawPeaks = [&](AnalyzerCurve curve, juce::Colour colour)
+        {
+            const auto& peaks = frame.peak(curve);
+            juce::Path peakPath;
+            peakPath.startNewSubPath(plotArea.getX(), toAnalyzerY(peaks[0]));
+            for (int i = 1; i < columns; ++i)
+                peakPath.lineTo(plotArea.getX() + static_cast<float>(i) * columnWidth,
+                                toAnalyzerY(peaks[static_cast<size_t>(i)]));
+            g.setColour(colour.withAlpha(0.55f));
+            g.strokePath(peakPath, juce::PathStrokeType(1.0f * scale));
+        };
+        if (drawPre && frame.hasCurve[static_cast<size_t>(AnalyzerCurve::pre)])
+            drawPeaks(AnalyzerCurve::pre, preColour);
+        if (drawPost && frame.hasCurve[static_cast<size_t>(AnalyzerCurve::post)])
+            drawPeaks(AnalyzerCurve::post, postColour);
+    }
+
     // v4.5 beta: Draw harmonic curve (harmonic-only content) in RED
     // This third analyzer curve provides visual feedback for the harmonic processing layer.
     // It displays only the harmonic contribution (no dry/program signal), so changes are clearer.
@@ -303,81 +359,12 @@ void AnalyzerComponent::paint(juce::Graphics& g)
     // - Automatically appears when harmonics are active, disappears when all harmonics are bypassed
     //
     // Visibility Logic:
-    // - Checks all channels and bands to determine if any harmonic processing is active
-    // - Only draws the curve if at least one band has active harmonics (same logic as updateFft)
-    bool hasActiveHarmonics = false;
-    for (int ch = 0; ch < ParamIDs::kMaxChannels && !hasActiveHarmonics; ++ch)
-    {
-        for (int band = 0; band < ParamIDs::kBandsPerChannel; ++band)
-        {
-            const auto oddParam = parameters.getRawParameterValue(ParamIDs::bandParamId(ch, band, "odd"));
-            const auto evenParam = parameters.getRawParameterValue(ParamIDs::bandParamId(ch, band, "even"));
-            const auto mixOddParam = parameters.getRawParameterValue(ParamIDs::bandParamId(ch, band, "mixOdd"));
-            const auto mixEvenParam = parameters.getRawParameterValue(ParamIDs::bandParamId(ch, band, "mixEven"));
-            const auto bypassParam = parameters.getRawParameterValue(ParamIDs::bandParamId(ch, band, "harmonicBypass"));
-            
-            if (bypassParam != nullptr && bypassParam->load() > 0.5f)
-                continue;  // Bypassed - skip this band
-            
-            const float odd = oddParam != nullptr ? oddParam->load() : 0.0f;
-            const float even = evenParam != nullptr ? evenParam->load() : 0.0f;
-            const float mixOdd = mixOddParam != nullptr ? (mixOddParam->load() / 100.0f) : 0.0f;
-            const float mixEven = mixEvenParam != nullptr ? (mixEvenParam->load() / 100.0f) : 0.0f;
-            
-            // Check if this band has active harmonics (non-zero amount with mix > 0)
-            if ((std::abs(odd) > 0.001f && mixOdd > 0.001f) || (std::abs(even) > 0.001f && mixEven > 0.001f))
-            {
-                hasActiveHarmonics = true;
-                break;
-            }
-        }
-    }
-    
-    if (hasActiveHarmonics)
+    // - The timer scans the harmonic parameters and only asks the worker for this curve when at
+    //   least one band has active harmonics; the frame records whether it was produced.
+    if (frame.hasCurve[static_cast<size_t>(AnalyzerCurve::harmonic)])
     {
-        // Build harmonic path using same frequency mapping as pre/post curves
-        // This ensures the harmonic curve aligns perfectly with the frequency axis
-        juce::Path harmonicPath;
-        bool harmonicStarted = false;
-        float prevHarmonicX = 0.0f, prevHarmonicY = 0.0f;
-        
-        // Iterate through FFT bins and map to screen coordinates
-        for (int bin = 1; bin < fftBins; ++bin)
-        {
-            // Calculate frequency for this bin
-            const float freq = (lastSampleRate * bin) / static_cast<float>(fftSize);
-            if (freq < kMinFreq || freq > maxFreq)
-                continue;  // Skip frequencies outside display range
-
-            // Map frequency to normalized position (logarithmic scale)
-            const float xNorm = FFTUtils::freqToNorm(freq, kMinFreq, maxFreq);
-            const float x = plotArea.getX() + xNorm * plotArea.getWidth();
-            // Map magnitude (dB) to screen Y coordinate
-            const float harmonicDb = harmonicMagnitudes[bin];
-            const float harmonicY = juce::jmap(harmonicDb, kAnalyzerMinDb, kAnalyzerMaxDb,
-                                               static_cast<float>(magnitudeArea.getBottom()),
-                                               static_cast<float>(magnitudeArea.getY()));
-
-            if (!harmonicStarted)
-            {
-                // Start new path at first valid point
-                harmonicPath.startNewSubPath(x, harmonicY);
-                prevHarmonicX = x;
-                prevHarmonicY = harmonicY;
-                harmonicStarted = true;
-            }
-            else
-            {
-                // Use quadratic curves for smoother, more beautiful lines (same as pre/post curves)
-                // This creates smooth transitions between points instead of sharp linear segments
-                const float midX = (prevHarmonicX + x) * 0.5f;
-                const float midHarmonicY = (prevHarmonicY + harmonicY) * 0.5f;
-                harmonicPath.quadraticTo(midX, midHarmonicY, x, harmonicY);
-                prevHarmonicX = x;
-                prevHarmonicY = harmonicY;
-            }
-        }
-        
+        const juce::Path harmonicPath = buildSpectrumPath(AnalyzerCurve::harmonic);
+
         if (!harmonicPath.isEmpty())
         {
             // Red color for harmonic curve - distinct from grey pre/post curves
@@ -410,13 +397,14 @@ void AnalyzerComponent::paint(juce::Graphics& g)
 
     const bool showExternal = parameters.getRawParameterValue(ParamIDs::analyzerExternal) != nullptr
         && parameters.getRawParameterValue(ParamIDs::analyzerExternal)->load() > 0.5f;
-    if (showExternal)
+    if (showExternal && frame.hasCurve[static_cast<size_t>(AnalyzerCurve::external)] && columns > 0)
     {
+        const auto& externalValues = frame.curve(AnalyzerCurve::external);
         juce::Path extPath;
-        extPath.startNewSubPath(plotArea.getX(), gainToY(externalMagnitudes.front()));
-        for (int x = 1; x < static_cast<int>(externalMagnitudes.size()); ++x)
-            extPath.lineTo(plotArea.getX() + x,
-                           gainToY(externalMagnitudes[static_cast<size_t>(x)]));
+        extPath.startNewSubPath(plotArea.getX(), gainToY(externalValues.front()));
+        for (int i = 1; i < columns; ++i)
+            extPath.lineTo(plotArea.getX() + static_cast<float>(i) * columnWidth,
+                           gainToY(externalValues[static_cast<size_t>(i)]));
         g.setColour(theme.accentAlt.withAlpha(0.4f));
         g.strokePath(extPath, juce::PathStrokeType(1.0f * scale));
     }
@@ -462,9 +450,17 @@ void AnalyzerComponent::paint(juce::Graphics& g)
             g.drawFittedText(items[i], line.toNearestInt(),
                              juce::Justification::centredLeft, 1);
         }
+    }
+
 
     g.restoreState();
-    }
+}
+
+void AnalyzerComponent::paintOverlayLayer(juce::Graphics& g)
+{
+    auto plotArea = getPlotArea();
+    auto magnitudeArea = getMagnitudeArea();
+    const float scale = uiScale;
 
     auto sampleCurveDb = [&](const std::vector<float>& curve, int index, float floorDb)
     {
@@ -881,6 +877,10 @@ void AnalyzerComponent::paint(juce::Graphics& g)
     if (draggingBand >= 0)
         drawPointValue(draggingBand);
 
+}
+
+void AnalyzerComponent::paintHoverHud(juce::Graphics& g)
+{
     if (hoverBand >= 0 && hoverBand < ParamIDs::kBandsPerChannel)
     {
         const float hoverFreq = getBandParameter(hoverBand, kParamFreqSuffix);
@@ -915,26 +915,26 @@ void AnalyzerComponent::paint(juce::Graphics& g)
         g.drawFittedText(text, hudRect, juce::Justification::centredLeft, 1);
     }
     
-    // Draw amplitude labels LAST, after all band points and curves, so they're always visible on top.
-    // This ensures labels from -60 to +60 dB are never overlapped by graphical elements.
-    drawAmplitudeLabels(g, magnitudeArea);
 }
 
 void AnalyzerComponent::resized()
 {
-    // v4.4 beta: Start timer only after first resize to ensure proper initialization
+    // v4.4 beta: Start frame ticks only after first resize to ensure proper initialization
     // Prevents expensive FFT updates and repaints before component is properly laid out
     // This ensures all controls are visible immediately on plugin load
     if (!hasBeenResized)
     {
         hasBeenResized = true;
-        startTimerHz(30);
+        worker.retain();
     }
+    invalidateLayers();
     updateCurves();
 }
 
 void AnalyzerComponent::mouseDown(const juce::MouseEvent& event)
 {
+    if (bandEditingLocked)
+        return;
     if (! allowInteraction)
     {
         if (event.mods.isRightButtonDown())
@@ -973,6 +973,12 @@ void AnalyzerComponent::mouseDown(const juce::MouseEvent& event)
         }
         return;
     }
+    // Everything from press to release (band creation, drags, temporary solo) is one undo step.
+    if (! undoGestureOpen)
+    {
+        processorRef.beginUndoGesture("Edit Bands");
+        undoGestureOpen = true;
+    }
     draggingBand = -1;
     draggingQ = false;
     const auto plotArea = getMagnitudeArea().toFloat();
@@ -989,7 +995,7 @@ void AnalyzerComponent::mouseDown(const juce::MouseEvent& event)
             setSelectedBand(bandIndex);
             if (onBandSelected)
                 onBandSelected(bandIndex);
-            repaint();
+            repaintOverlay();
             return;
         }
     }
@@ -1015,7 +1021,7 @@ void AnalyzerComponent::mouseDown(const juce::MouseEvent& event)
             setSelectedBand(closestBand);
             if (onBandSelected)
                 onBandSelected(closestBand);
-            repaint();
+            repaintOverlay();
             return;
         }
         startAltSolo(event.position);
@@ -1106,7 +1112,7 @@ void AnalyzerComponent::mouseDown(const juce::MouseEvent& event)
 
 void AnalyzerComponent::mouseDrag(const juce::MouseEvent& event)
 {
-    if (! allowInteraction)
+    if (! allowInteraction || bandEditingLocked)
         return;
     if (isAltSoloing)
     {
@@ -1124,7 +1130,7 @@ void AnalyzerComponent::mouseDrag(const juce::MouseEvent& event)
         const float safeRatio = juce::jlimit(1.001f, 64.0f, ratio);
         const float qValue = 1.0f / (safeRatio - 1.0f / safeRatio);
         setBandParameter(selectedBand, kParamQSuffix, juce::jlimit(0.1f, 18.0f, qValue));
-        repaint();
+        repaintOverlay();
         return;
     }
 
@@ -1160,13 +1166,16 @@ void AnalyzerComponent::mouseDrag(const juce::MouseEvent& event)
         setBandParameter(state.band, kParamFreqSuffix, newFreq);
         setBandParameter(state.band, kParamGainSuffix, newGain);
     }
-    repaint();
+    repaintOverlay();
 }
 
 void AnalyzerComponent::mouseUp(const juce::MouseEvent& event)
 {
     if (! allowInteraction)
+    {
+        endUndoGesture();
         return;
+    }
     juce::ignoreUnused(event);
     if (isAltSoloing)
         stopAltSolo();
@@ -1181,11 +1190,20 @@ void AnalyzerComponent::mouseUp(const juce::MouseEvent& event)
     }
     draggingBand = -1;
     dragBands.clear();
+    endUndoGesture();
+}
+
+void AnalyzerComponent::endUndoGesture()
+{
+    if (! undoGestureOpen)
+        return;
+    undoGestureOpen = false;
+    processorRef.endUndoGesture();
 }
 
 void AnalyzerComponent::mouseDoubleClick(const juce::MouseEvent& event)
 {
-    if (! allowInteraction)
+    if (! allowInteraction || bandEditingLocked)
         return;
     const auto plotArea = getMagnitudeArea().toFloat();
     if (! plotArea.contains(event.position))
@@ -1196,11 +1214,13 @@ void AnalyzerComponent::mouseDoubleClick(const juce::MouseEvent& event)
 void AnalyzerComponent::mouseMove(const juce::MouseEvent& event)
 {
     hoverPos = event.position;
+    const int previousHover = hoverBand;
     const auto plotArea = getMagnitudeArea().toFloat();
     if (! plotArea.contains(event.position))
     {
         hoverBand = -1;
-        repaint();
+        if (hoverBand != previousHover)
+            repaintOverlay();
         return;
     }
 
@@ -1217,20 +1237,24 @@ void AnalyzerComponent::mouseMove(const juce::MouseEvent& event)
         }
     }
     hoverBand = (closestBand >= 0 && closest <= maxHit) ? closestBand : -1;
-    repaint();
+    // The hover curve lives in the overlay layer; the HUD is drawn live.
+    if (hoverBand != previousHover)
+        repaintOverlay();
+    else if (hoverBand >= 0)
+        repaint();
 }
 
 void AnalyzerComponent::mouseExit(const juce::MouseEvent& event)
 {
     juce::ignoreUnused(event);
     hoverBand = -1;
-    repaint();
+    repaintOverlay();
 }
 
 void AnalyzerComponent::mouseWheelMove(const juce::MouseEvent& event,
                                        const juce::MouseWheelDetails& wheel)
 {
-    if (! allowInteraction)
+    if (! allowInteraction || bandEditingLocked)
         return;
     juce::ignoreUnused(event);
     const float delta = wheel.deltaY != 0.0f ? wheel.deltaY : wheel.deltaX;
@@ -1373,10 +1397,16 @@ void AnalyzerComponent::stopAltSolo()
     altSoloBand = -1;
 }
 
-void AnalyzerComponent::timerCallback()
+int AnalyzerComponent::getFrameRateHz() const
+{
+    // Paused until the first layout; the rate itself is retuned in frameTick.
+    return hasBeenResized ? lastTimerHz : 0;
+}
+
+juce::Rectangle<int> AnalyzerComponent::frameTick()
 {
     if (! isShowing() || getWidth() <= 0 || getHeight() <= 0)
-        return;
+        return {};
 
     minDb = kMinDb;
     maxDb = kMaxDb;
@@ -1391,6 +1421,12 @@ void AnalyzerComponent::timerCallback()
 
     const float sr = static_cast<float>(processorRef.getSampleRate());
     const float effectiveSr = sr > 0.0f ? sr : lastSampleRate;
+    // The frequency axis follows the host rate; the worker marks columns above the analyzer band.
+    if (effectiveSr != lastSampleRate)
+    {
+        lastSampleRate = effectiveSr;
+        invalidateLayers();
+    }
     // v4.4 beta: Higher default update rates for more reactive analyzer
     int hz = (analyzerSpeedIndex == 0 ? 20 : (analyzerSpeedIndex == 1 ? 40 : 70));
     if (effectiveSr >= 192000.0f)
@@ -1402,439 +1438,218 @@ void AnalyzerComponent::timerCallback()
         : 0;
     if (viewIndex != 0)
         hz = juce::jmax(10, static_cast<int>(hz * 0.8f));
-    if (hz != lastTimerHz)
-    {
-        lastTimerHz = hz;
-        startTimerHz(hz);
-    }
+    lastTimerHz = hz;
 
     const bool freeze = parameters.getRawParameterValue(ParamIDs::analyzerFreeze) != nullptr
         && parameters.getRawParameterValue(ParamIDs::analyzerFreeze)->load() > 0.5f;
     if (freeze)
         hz = juce::jmax(8, hz / 2);
 
-    // v4.4 beta: More reactive - update FFT every frame for instant response
-    bool didUpdate = false;
+    // The worker does the FFT work; linear/natural modes halve its rate to protect audio CPU headroom.
     const int phaseMode = processorRef.getLastRmsPhaseMode();
-    // Throttle analyzer updates in linear/natural modes to protect audio CPU headroom.
     const int throttleDiv = phaseMode != 0 ? 2 : 1;
-    if (throttleDiv == 1)
-        throttleCounter = 0;
-    bool shouldUpdateFft = ! freeze;
-    if (shouldUpdateFft && throttleDiv > 1)
-        shouldUpdateFft = (++throttleCounter % throttleDiv) == 0;
-    if (shouldUpdateFft)
+
+    AnalyzerSettings settings;
+    settings.numPoints = juce::jmin(AnalyzerFrame::kMaxPoints, getPlotArea().getWidth());
+    settings.minFreq = kMinFreq;
+    settings.maxFreq = getMaxFreq();
+    settings.hostSampleRate = effectiveSr;
+    settings.analyzerSampleRate = processorRef.getAnalyzerSampleRate();
+    settings.updateHz = juce::jmax(1, hz / throttleDiv);
+    settings.frozen = freeze;
+    // Exponential time constants match the old per-frame smoothing at 20/40/70 Hz.
+    settings.averagingMs = analyzerSpeedIndex == 0 ? 140.0f : (analyzerSpeedIndex == 1 ? 70.0f : 40.0f);
+    const auto choiceIndex = [this](const juce::String& id, int fallback)
     {
-        updateFft();
-        didUpdate = true;
-    }
-    // v4.4 beta: Update curves every frame for smoother, more reactive display
-    updateCurves();
-    didUpdate = true;
-    
-    if (didUpdate)
-        repaint();
+        const auto* value = parameters.getRawParameterValue(id);
+        return value != nullptr ? static_cast<int>(value->load()) : fallback;
+    };
+    settings.hopDivisor = 2 << juce::jlimit(0, 2, choiceIndex(ParamIDs::analyzerOverlap, 1));
+    settings.averaging = choiceIndex(ParamIDs::analyzerAveraging, 0) == 1 ? AnalyzerAveraging::welch
+                                                                          : AnalyzerAveraging::exponential;
+    static constexpr std::array<float, 5> kSmoothingOctaves { 0.0f, 1.0f / 24.0f, 1.0f / 12.0f, 1.0f / 6.0f, 1.0f / 3.0f };
+    settings.smoothingOctaves = kSmoothingOctaves[static_cast<size_t>(juce::jlimit(0, 4, choiceIndex(ParamIDs::analyzerSmoothing, 0)))];
+    settings.peakHold = choiceIndex(ParamIDs::analyzerPeakHold, 0) != 0;
+    settings.multiResolution = choiceIndex(ParamIDs::analyzerResolution, 0) == 1;
+    settings.wantCurve[static_cast<size_t>(AnalyzerCurve::pre)] = viewIndex != 2;
+    settings.wantCurve[static_cast<size_t>(AnalyzerCurve::post)] = viewIndex != 1;
+    settings.wantCurve[static_cast<size_t>(AnalyzerCurve::harmonic)] = hasActiveHarmonics();
+    settings.wantCurve[static_cast<size_t>(AnalyzerCurve::external)] =
+        parameters.getRawParameterValue(ParamIDs::analyzerExternal) != nullptr
+        && parameters.getRawParameterValue(ParamIDs::analyzerExternal)->load() > 0.5f;
+    worker.setSettings(settings);
+    const bool newFrame = worker.fetchFrame(displayFrame, frameVersion);
+
+    // v4.4 beta: Update curves every frame for smoother, more reactive display.
+    // Only the plot repaints per tick; the EQ overlay re-renders when a curve actually changed.
+    if (updateCurves())
+        overlayDirty = true;
+    // Nothing new (including while frozen): skip the repaint.
+    if (! newFrame && ! overlayDirty && backgroundLayer.isValid())
+        return {};
+    return getPlotArea();
 }
 
-void AnalyzerComponent::updateFft()
+// v4.5 beta: The harmonic curve (red) is only shown when at least one band has active harmonics:
+// harmonic bypass is OFF and odd or even has a non-zero amount with mix > 0.
+bool AnalyzerComponent::hasActiveHarmonics() const
 {
-    auto& preFifo = processorRef.getAnalyzerPreFifo();
-    auto& postFifo = processorRef.getAnalyzerPostFifo();
-    auto& extFifo = externalFifo;
-
-    lastSampleRate = static_cast<float>(processorRef.getSampleRate());
-    if (lastSampleRate <= 0.0f)
-        lastSampleRate = 48000.0f;
-
-    // Use raw low-frequency bins so the curve reflects true sub-20 Hz content.
-    const int firstBin = juce::jlimit(1, fftBins - 1,
-                                      static_cast<int>(std::ceil((kMinFreq * fftSize) / lastSampleRate)));
-
-    const int viewIndex = parameters.getRawParameterValue(ParamIDs::analyzerView) != nullptr
-        ? static_cast<int>(parameters.getRawParameterValue(ParamIDs::analyzerView)->load())
-        : 0;
-    const bool wantPre = viewIndex != 2;
-    const bool wantPost = viewIndex != 1;
-
-    if (wantPre)
-    {
-        const int pulled = preFifo.pull(timeBuffer.data(), fftSize);
-        if (pulled > 0)
-        {
-            std::fill(fftDataPre.begin(), fftDataPre.end(), 0.0f);
-            juce::FloatVectorOperations::copy(fftDataPre.data(), timeBuffer.data(),
-                                              juce::jmin(pulled, fftSize));
-        window.multiplyWithWindowingTable(fftDataPre.data(), fftSize);
-        fft.performFrequencyOnlyForwardTransform(fftDataPre.data());
-
-        for (int i = 0; i < fftBins; ++i)
-        {
-            const float mag = juce::Decibels::gainToDecibels(fftDataPre[static_cast<size_t>(i)],
-                                                            minDb);
-            preMagnitudes[i] = Smoothing::smooth(preMagnitudes[i], mag, kSmoothingCoeff);
-        }
-        for (int i = 0; i < firstBin; ++i)
-            preMagnitudes[i] = preMagnitudes[static_cast<size_t>(firstBin)];
-    }
-    }
-
-    if (wantPost)
-    {
-        const int pulled = postFifo.pull(timeBuffer.data(), fftSize);
-        if (pulled > 0)
-        {
-            std::fill(fftDataPost.begin(), fftDataPost.end(), 0.0f);
-            juce::FloatVectorOperations::copy(fftDataPost.data(), timeBuffer.data(),
-                                              juce::jmin(pulled, fftSize));
-        window.multiplyWithWindowingTable(fftDataPost.data(), fftSize);
-        fft.performFrequencyOnlyForwardTransform(fftDataPost.data());
-
-        for (int i = 0; i < fftBins; ++i)
-        {
-            const float mag = juce::Decibels::gainToDecibels(fftDataPost[static_cast<size_t>(i)],
-                                                            minDb);
-            postMagnitudes[i] = Smoothing::smooth(postMagnitudes[i], mag, kSmoothingCoeff);
-        }
-        for (int i = 0; i < firstBin; ++i)
-            postMagnitudes[i] = postMagnitudes[static_cast<size_t>(firstBin)];
-    }
-    }
-
-    // v4.5 beta: Process harmonic curve (harmonic-only content) - red analyzer curve
-    // This third analyzer curve displays only harmonic content (no dry/program signal), providing clear feedback
-    // for the harmonic processing layer. The curve is only visible when harmonics are active on at least one band.
-    //
-    // Visibility Logic:
-    // - Scans all channels and bands to determine if any harmonic processing is active
-    // - A band is considered active if:
-    //   1. Harmonic bypass is OFF (harmonicBypass < 0.5)
-    //   2. At least one harmonic type (odd or even) has non-zero amount AND mix > 0
-    // - If no active harmonics are found, the curve is hidden and magnitudes are reset
-    //
-    // Processing:
-    // - Pulls audio data from the harmonic analyzer tap FIFO (tapped after harmonic processing in DSP)
-    // - Applies windowing function (Hann) for spectral leakage reduction
-    // - Performs FFT to convert time-domain to frequency-domain
-    // - Converts magnitude to decibels and applies smoothing for visual stability
-    // - Respects all analyzer settings: range, speed, freeze (via timerCallback and updateFft call)
-    bool hasActiveHarmonics = false;
-    for (int ch = 0; ch < ParamIDs::kMaxChannels && !hasActiveHarmonics; ++ch)
+    for (const auto& channel : harmonicParams)
     {
-        for (int band = 0; band < ParamIDs::kBandsPerChannel; ++band)
+        for (const auto& pointers : channel)
         {
-            const auto oddParam = parameters.getRawParameterValue(ParamIDs::bandParamId(ch, band, "odd"));
-            const auto evenParam = parameters.getRawParameterValue(ParamIDs::bandParamId(ch, band, "even"));
-            const auto mixOddParam = parameters.getRawParameterValue(ParamIDs::bandParamId(ch, band, "mixOdd"));
-            const auto mixEvenParam = parameters.getRawParameterValue(ParamIDs::bandParamId(ch, band, "mixEven"));
-            const auto bypassParam = parameters.getRawParameterValue(ParamIDs::bandParamId(ch, band, "harmonicBypass"));
-            
-            if (bypassParam != nullptr && bypassParam->load() > 0.5f)
+            if (pointers.bypass != nullptr && pointers.bypass->load() > 0.5f)
                 continue;  // Bypassed - skip this band
-            
-            const float odd = oddParam != nullptr ? oddParam->load() : 0.0f;
-            const float even = evenParam != nullptr ? evenParam->load() : 0.0f;
-            const float mixOdd = mixOddParam != nullptr ? (mixOddParam->load() / 100.0f) : 0.0f;
-            const float mixEven = mixEvenParam != nullptr ? (mixEvenParam->load() / 100.0f) : 0.0f;
-            
-            // Check if this band has active harmonics (non-zero amount with mix > 0)
-            if ((std::abs(odd) > 0.001f && mixOdd > 0.001f) || (std::abs(even) > 0.001f && mixEven > 0.001f))
-            {
-                hasActiveHarmonics = true;
-                break;
-            }
-        }
-    }
-    
-    if (hasActiveHarmonics)
-    {
-        // Pull audio samples from harmonic analyzer tap FIFO
-        // This FIFO is fed by the DSP engine after harmonic processing is applied
-        auto& harmonicFifoRef = harmonicFifo;
-        const int pulled = harmonicFifoRef.pull(timeBuffer.data(), fftSize);
-        if (pulled > 0)
-        {
-            // Clear FFT data buffer and copy time-domain samples
-            std::fill(fftDataHarmonic.begin(), fftDataHarmonic.end(), 0.0f);
-            juce::FloatVectorOperations::copy(fftDataHarmonic.data(), timeBuffer.data(),
-                                              juce::jmin(pulled, fftSize));
-            // Apply Hann windowing to reduce spectral leakage
-            window.multiplyWithWindowingTable(fftDataHarmonic.data(), fftSize);
-            // Perform FFT: convert time-domain to frequency-domain
-            fft.performFrequencyOnlyForwardTransform(fftDataHarmonic.data());
-
-            // Convert magnitude to decibels and apply exponential smoothing
-            // Smoothing coefficient (kSmoothingCoeff) provides visual stability while maintaining responsiveness
-            for (int i = 0; i < fftBins; ++i)
-            {
-                const float mag = juce::Decibels::gainToDecibels(fftDataHarmonic[static_cast<size_t>(i)],
-                                                                minDb);
-                harmonicMagnitudes[i] = Smoothing::smooth(harmonicMagnitudes[i], mag, kSmoothingCoeff);
-            }
-            for (int i = 0; i < firstBin; ++i)
-                harmonicMagnitudes[i] = harmonicMagnitudes[static_cast<size_t>(firstBin)];
-        }
-    }
-    else
-    {
-        // Reset harmonic magnitudes when no harmonics are active
-        // This ensures the curve disappears cleanly when all harmonics are bypassed or set to zero
-        harmonicMagnitudes.fill(kAnalyzerMinDb);
-    }
 
-    const bool showExternal = parameters.getRawParameterValue(ParamIDs::analyzerExternal) != nullptr
-        && parameters.getRawParameterValue(ParamIDs::analyzerExternal)->load() > 0.5f;
-    if (showExternal && extFifo.pull(timeBuffer.data(), fftSize) == fftSize)
-    {
-        std::fill(fftDataPost.begin(), fftDataPost.end(), 0.0f);
-        juce::FloatVectorOperations::copy(fftDataPost.data(), timeBuffer.data(), fftSize);
-        window.multiplyWithWindowingTable(fftDataPost.data(), fftSize);
-        fft.performFrequencyOnlyForwardTransform(fftDataPost.data());
+            const float odd = pointers.odd != nullptr ? pointers.odd->load() : 0.0f;
+            const float even = pointers.even != nullptr ? pointers.even->load() : 0.0f;
+            const float mixOdd = pointers.mixOdd != nullptr ? (pointers.mixOdd->load() / 100.0f) : 0.0f;
+            const float mixEven = pointers.mixEven != nullptr ? (pointers.mixEven->load() / 100.0f) : 0.0f;
 
-        for (int i = 0; i < fftBins; ++i)
-        {
-            const float mag = juce::Decibels::gainToDecibels(fftDataPost[static_cast<size_t>(i)],
-                                                            minDb);
-            externalMagnitudes[i] = Smoothing::smooth(externalMagnitudes[i], mag, kSmoothingCoeff);
+            if ((std::abs(odd) > 0.001f && mixOdd > 0.001f) || (std::abs(even) > 0.001f && mixEven > 0.001f))
+                return true;
         }
-        for (int i = 0; i < firstBin; ++i)
-            externalMagnitudes[i] = externalMagnitudes[static_cast<size_t>(firstBin)];
     }
+    return false;
 }
 
-void AnalyzerComponent::updateCurves()
+bool AnalyzerComponent::updateCurves()
 {
     const auto magnitudeArea = getMagnitudeArea();
-    if (magnitudeArea.getWidth() <= 0)
-        return;
-
-    if (lastCurveWidth != magnitudeArea.getWidth())
-    {
-        lastCurveWidth = magnitudeArea.getWidth();
-        perBandCurveDb.assign(ParamIDs::kBandsPerChannel,
-                              std::vector<float>(static_cast<size_t>(lastCurveWidth), 0.0f));
-        perBandCurveHash.assign(ParamIDs::kBandsPerChannel, 0);
-    }
-
     const int width = magnitudeArea.getWidth();
+    if (width <= 0)
+        return false;
 
-    uint64_t hash = 1469598103934665603ull;
-    auto hashValue = [&hash](float value)
-    {
-        const auto bits = static_cast<uint64_t>(std::hash<float>{}(value));
-        hash ^= bits + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
-    };
-    const float globalMixParam = parameters.getRawParameterValue(ParamIDs::globalMix) != nullptr
-        ? parameters.getRawParameterValue(ParamIDs::globalMix)->load()
-        : 100.0f;
-    hashValue(globalMixParam);
-    for (int band = 0; band < ParamIDs::kBandsPerChannel; ++band)
+    // Pixel grid: one frequency per column. Every cached response is keyed to it.
+    const float maxFreq = getMaxFreq();
+    const double sampleRate = std::max(1.0, processorRef.getSampleRate());
+    bool changed = false;
+    if (width != lastCurveWidth || maxFreq != curveGridMaxFreq || sampleRate != curveGridSampleRate)
     {
-        hashValue(getBandParameter(band, kParamFreqSuffix));
-        hashValue(getBandParameter(band, kParamGainSuffix));
-        hashValue(getBandParameter(band, kParamQSuffix));
-        hashValue(getBandParameter(band, kParamTypeSuffix));
-        hashValue(getBandParameter(band, kParamBypassSuffix));
-        hashValue(getBandParameter(band, kParamSlopeSuffix));
-        hashValue(getBandParameter(band, kParamMixSuffix));
-        hashValue(getBandDynamicGainDb(band));
+        lastCurveWidth = width;
+        curveGridMaxFreq = maxFreq;
+        curveGridSampleRate = sampleRate;
+        const auto size = static_cast<size_t>(width);
+        curveFrequencies.resize(size);
+        for (int x = 0; x < width; ++x)
+        {
+            const float norm = static_cast<float>(x) / static_cast<float>(width);
+            curveFrequencies[static_cast<size_t>(x)] = FFTUtils::normToFreq(norm, kMinFreq, maxFreq);
+        }
+        compositeRe.resize(size);
+        compositeIm.resize(size);
+        eqCurveDb.resize(size);
+        selectedBandCurveDb.resize(size);
+        for (int band = 0; band < ParamIDs::kBandsPerChannel; ++band)
+        {
+            bandCurves[static_cast<size_t>(band)].re.resize(size);
+            bandCurves[static_cast<size_t>(band)].im.resize(size);
+            bandCurves[static_cast<size_t>(band)].valid = false;
+            perBandCurveDb[static_cast<size_t>(band)].resize(size);
+        }
+        changed = true;
     }
 
-    const bool paramsUnchanged = (hash == lastCurveHash
-                                  && selectedChannel == lastCurveChannel
-                                  && lastCurveWidth == magnitudeArea.getWidth());
-
-    const bool selectedValid = selectedBand >= 0 && selectedBand < ParamIDs::kBandsPerChannel;
-    float selectedMix = 0.0f;
-    float selectedGainDb = 0.0f;
-    int selectedType = 0;
-    bool selectedDynEnabled = false;
-    if (selectedValid)
+    if (bandCurveParamsChannel != selectedChannel)
     {
-        selectedMix = getBandParameter(selectedBand, kParamMixSuffix) / 100.0f;
-        selectedGainDb = getBandParameter(selectedBand, kParamGainSuffix);
-        selectedType = getBandType(selectedBand);
-        selectedDynEnabled = getBandParameter(selectedBand, kParamDynEnableSuffix) > 0.5f;
+        resolveBandCurveParameters();
+        for (auto& cache : bandCurves)
+            cache.valid = false;
+        changed = true;
     }
-    lastSelectedMix = selectedMix;
 
-    const float maxFreq = getMaxFreq();
     const float globalMix = parameters.getRawParameterValue(ParamIDs::globalMix) != nullptr
         ? juce::jlimit(0.0f, 1.0f,
                        parameters.getRawParameterValue(ParamIDs::globalMix)->load() / 100.0f)
         : 1.0f;
+    const bool globalMixChanged = globalMix != lastGlobalMix;
     lastGlobalMix = globalMix;
 
-    auto updateSelectedBandCurve = [&](int curveWidth)
-    {
-        if (static_cast<int>(selectedBandCurveDb.size()) != curveWidth)
-            selectedBandCurveDb.assign(static_cast<size_t>(curveWidth), minDb);
-        else
-            std::fill(selectedBandCurveDb.begin(), selectedBandCurveDb.end(), minDb);
-
-        if (! selectedValid)
-            return;
-
-        for (int x = 0; x < curveWidth; ++x)
-        {
-            const float norm = static_cast<float>(x) / static_cast<float>(curveWidth);
-            const float freq = FFTUtils::normToFreq(norm, kMinFreq, maxFreq);
-            std::complex<double> selectedResponse = computeBandResponse(selectedBand, freq);
-            const float selectedDynamicDb = getBandDynamicGainDb(selectedBand);
-            if (std::abs(selectedDynamicDb) > 0.0001f)
-            {
-                const double deltaGain = juce::Decibels::decibelsToGain(selectedDynamicDb);
-                selectedResponse = std::complex<double>(1.0, 0.0)
-                    + (selectedResponse - std::complex<double>(1.0, 0.0)) * deltaGain;
-            }
-            const float mix = juce::jlimit(0.0f, 1.0f, selectedMix);
-            selectedResponse = std::complex<double>(1.0, 0.0)
-                + static_cast<double>(mix) * (selectedResponse - std::complex<double>(1.0, 0.0));
-            selectedResponse = std::complex<double>(1.0, 0.0)
-                + static_cast<double>(globalMix) * (selectedResponse - std::complex<double>(1.0, 0.0));
-            selectedBandCurveDb[static_cast<size_t>(x)] =
-                juce::Decibels::gainToDecibels(static_cast<float>(std::abs(selectedResponse)), minDb);
-        }
-    };
-
-    // v5.4 beta: Update the selected band preview on selection changes.
-    // v5.4 beta: Update the selected band preview on selection changes.
-    if (paramsUnchanged && selectedBand != lastCurveBand)
+    // Recompute only the bands whose parameter tuple changed; dragging one band touches one band.
+    for (int band = 0; band < ParamIDs::kBandsPerChannel; ++band)
     {
-        updateSelectedBandCurve(width);
-        lastCurveBand = selectedBand;
-        return;
-    }
+        auto& cache = bandCurves[static_cast<size_t>(band)];
+        const auto key = readBandCurveKey(band);
+        if (cache.valid && key == cache.key && ! globalMixChanged)
+            continue;
 
-    if (paramsUnchanged && selectedBand == lastCurveBand)
-        return;
+        const bool responseDirty = ! cache.valid || key != cache.key;
+        cache.key = key;
+        cache.valid = true;
+        changed = true;
 
-    lastCurveHash = hash;
-    lastCurveBand = selectedBand;
-    lastCurveChannel = selectedChannel;
-
-    eqCurveDb.assign(static_cast<size_t>(width), 0.0f);
-    selectedBandCurveDb.assign(static_cast<size_t>(width), 0.0f);
-    perBandActive.assign(ParamIDs::kBandsPerChannel, false);
-    // Phase view removed.
-    std::array<bool, ParamIDs::kBandsPerChannel> bandActive {};
-    for (int band = 0; band < ParamIDs::kBandsPerChannel; ++band)
-    {
-        const float mix = getBandParameter(band, kParamMixSuffix) / 100.0f;
-        const float gainDb = getBandParameter(band, kParamGainSuffix);
-        const int type = getBandType(band);
-        const bool dynEnabled = getBandParameter(band, kParamDynEnableSuffix) > 0.5f;
+        const int type = static_cast<int>(key.type);
         const bool isBell = type == static_cast<int>(eqdsp::FilterType::bell);
         const bool isShelf = type == static_cast<int>(eqdsp::FilterType::lowShelf)
             || type == static_cast<int>(eqdsp::FilterType::highShelf);
         const bool isTilt = type == static_cast<int>(eqdsp::FilterType::tilt)
             || type == static_cast<int>(eqdsp::FilterType::flatTilt);
-        const bool skipZeroGain = ! dynEnabled && (isBell || isShelf || isTilt)
-            && std::abs(gainDb) < 0.0001f;
-
-        bandActive[band] = ! getBandBypassed(band)
-            && ! skipZeroGain;
-        perBandActive[band] = bandActive[band];
-    }
-
-    std::vector<bool> bandDirty(ParamIDs::kBandsPerChannel, false);
-    for (int band = 0; band < ParamIDs::kBandsPerChannel; ++band)
-    {
-        uint64_t bandHash = 1469598103934665603ull;
-        auto hashBand = [&bandHash](float value)
-        {
-            const auto bits = static_cast<uint64_t>(std::hash<float>{}(value));
-            bandHash ^= bits + 0x9e3779b97f4a7c15ull + (bandHash << 6) + (bandHash >> 2);
-        };
-        hashBand(globalMixParam);
-        hashBand(getBandParameter(band, kParamFreqSuffix));
-        hashBand(getBandParameter(band, kParamGainSuffix));
-        hashBand(getBandParameter(band, kParamQSuffix));
-        hashBand(getBandParameter(band, kParamTypeSuffix));
-        hashBand(getBandParameter(band, kParamBypassSuffix));
-        hashBand(getBandParameter(band, kParamSlopeSuffix));
-        hashBand(getBandParameter(band, kParamMixSuffix));
-        hashBand(getBandParameter(band, kParamDynEnableSuffix));
-        hashBand(getBandDynamicGainDb(band));
-        bandDirty[static_cast<size_t>(band)] = bandHash != perBandCurveHash[static_cast<size_t>(band)];
-        perBandCurveHash[static_cast<size_t>(band)] = bandHash;
-    }
-
-    const bool selectedPreview = selectedValid;
-
-    for (int x = 0; x < width; ++x)
-    {
-        const float norm = static_cast<float>(x) / static_cast<float>(width);
-        const float freq = FFTUtils::normToFreq(norm, kMinFreq, maxFreq);
+        const bool skipZeroGain = key.dynEnable <= 0.5f && (isBell || isShelf || isTilt)
+            && std::abs(key.gain) < 0.0001f;
+        const bool active = key.bypass <= 0.5f && ! skipZeroGain;
+        perBandActive[static_cast<size_t>(band)] = active;
 
-        std::complex<double> total = { 1.0, 0.0 };
-        for (int band = 0; band < ParamIDs::kBandsPerChannel; ++band)
+        if (responseDirty)
         {
-            std::complex<double> response { 1.0, 0.0 };
-            if (bandActive[band])
-            {
-                const float dynamicDeltaDb = getBandDynamicGainDb(band);
-                const float mix = juce::jlimit(0.0f, 1.0f,
-                                               getBandParameter(band, kParamMixSuffix) / 100.0f);
-                if (bandDirty[static_cast<size_t>(band)])
-                {
-                    response = computeBandResponse(band, freq);
-                    if (std::abs(dynamicDeltaDb) > 0.0001f)
-                    {
-                        const double deltaGain = juce::Decibels::decibelsToGain(dynamicDeltaDb);
-                        response = std::complex<double>(1.0, 0.0)
-                            + (response - std::complex<double>(1.0, 0.0)) * deltaGain;
-                    }
-                    auto mixed = std::complex<double>(1.0, 0.0)
-                        + static_cast<double>(mix) * (response - std::complex<double>(1.0, 0.0));
-                    mixed = std::complex<double>(1.0, 0.0)
-                        + static_cast<double>(globalMix) * (mixed - std::complex<double>(1.0, 0.0));
-                    const float magnitude = static_cast<float>(std::abs(mixed));
-                    perBandCurveDb[static_cast<size_t>(band)][static_cast<size_t>(x)] =
-                        juce::Decibels::gainToDecibels(magnitude, minDb);
-                    response = mixed;
-                }
-                else
-                {
-                    const float db = perBandCurveDb[static_cast<size_t>(band)][static_cast<size_t>(x)];
-                    response = std::complex<double>(juce::Decibels::decibelsToGain(db), 0.0);
-                }
-            }
-            else
-            {
-                perBandCurveDb[static_cast<size_t>(band)][static_cast<size_t>(x)] = minDb;
-            }
-
-            total *= response;
+            const CurveMath::BandShape shape { key.freq, key.gain, key.q, static_cast<int>(key.type),
+                                               key.slope, key.bypass > 0.5f };
+            CurveMath::computeBandResponse(shape, sampleRate, curveFrequencies.data(), width,
+                                           cache.re.data(), cache.im.data());
+            // H' = 1 + mix * dynamicGain * (H - 1): dynamic delta first, then the band's wet/dry.
+            double wet = static_cast<double>(juce::jlimit(0.0f, 1.0f, key.mix / 100.0f));
+            if (std::abs(key.dynamicDb) > 0.0001f)
+                wet *= juce::Decibels::decibelsToGain(static_cast<double>(key.dynamicDb));
+            CurveMath::applyCurveMix(cache.re.data(), cache.im.data(), cache.re.data(), cache.im.data(),
+                          static_cast<float>(wet), width);
         }
 
-        total = std::complex<double>(1.0, 0.0)
-            + static_cast<double>(globalMix) * (total - std::complex<double>(1.0, 0.0));
-        const double mag = std::abs(total);
-        eqCurveDb[static_cast<size_t>(x)] =
-            juce::Decibels::gainToDecibels(static_cast<float>(mag), minDb);
-        if (selectedPreview)
+        // Per-band overlay curve (global mix applied for display).
+        auto& bandDb = perBandCurveDb[static_cast<size_t>(band)];
+        if (active)
         {
-            std::complex<double> selectedResponse = computeBandResponse(selectedBand, freq);
-            const float selectedDynamicDb = getBandDynamicGainDb(selectedBand);
-            if (std::abs(selectedDynamicDb) > 0.0001f)
-            {
-                const double deltaGain = juce::Decibels::decibelsToGain(selectedDynamicDb);
-                selectedResponse = std::complex<double>(1.0, 0.0)
-                    + (selectedResponse - std::complex<double>(1.0, 0.0)) * deltaGain;
-            }
-            const float mix = juce::jlimit(0.0f, 1.0f, selectedMix);
-            selectedResponse = std::complex<double>(1.0, 0.0)
-                + static_cast<double>(mix) * (selectedResponse - std::complex<double>(1.0, 0.0));
-            selectedResponse = std::complex<double>(1.0, 0.0)
-                + static_cast<double>(globalMix) * (selectedResponse - std::complex<double>(1.0, 0.0));
-            selectedBandCurveDb[static_cast<size_t>(x)] =
-                juce::Decibels::gainToDecibels(static_cast<float>(std::abs(selectedResponse)), minDb);
+            CurveMath::applyCurveMix(cache.re.data(), cache.im.data(), compositeRe.data(), compositeIm.data(),
+                          globalMix, width);
+            CurveMath::responseToDecibels(compositeRe.data(), compositeIm.data(), bandDb.data(), width, minDb);
         }
         else
         {
-            selectedBandCurveDb[static_cast<size_t>(x)] = minDb;
+            std::fill(bandDb.begin(), bandDb.end(), minDb);
         }
     }
+
+    const bool selectedValid = selectedBand >= 0 && selectedBand < ParamIDs::kBandsPerChannel;
+    lastSelectedMix = selectedValid ? bandCurves[static_cast<size_t>(selectedBand)].key.mix / 100.0f : 0.0f;
+
+    if (! changed && selectedBand == lastCurveBand && selectedChannel == lastCurveChannel)
+        return false;
+
+    lastCurveBand = selectedBand;
+    lastCurveChannel = selectedChannel;
+
+    // Composite: complex product of the active bands, then the global wet/dry, then one dB pass.
+    std::fill(compositeRe.begin(), compositeRe.end(), 1.0f);
+    std::fill(compositeIm.begin(), compositeIm.end(), 0.0f);
+    for (int band = 0; band < ParamIDs::kBandsPerChannel; ++band)
+    {
+        if (! perBandActive[static_cast<size_t>(band)])
+            continue;
+        const auto& cache = bandCurves[static_cast<size_t>(band)];
+        CurveMath::multiplyCurves(compositeRe.data(), compositeIm.data(), cache.re.data(), cache.im.data(), width);
+    }
+    CurveMath::applyCurveMix(compositeRe.data(), compositeIm.data(), compositeRe.data(), compositeIm.data(),
+                  globalMix, width);
+    CurveMath::responseToDecibels(compositeRe.data(), compositeIm.data(), eqCurveDb.data(), width, minDb);
+
+    // Selected-band preview: the band's own curve, or the unity line when it has no effect.
+    if (! selectedValid)
+        std::fill(selectedBandCurveDb.begin(), selectedBandCurveDb.end(), minDb);
+    else if (perBandActive[static_cast<size_t>(selectedBand)])
+        std::copy(perBandCurveDb[static_cast<size_t>(selectedBand)].begin(),
+                  perBandCurveDb[static_cast<size_t>(selectedBand)].end(),
+                  selectedBandCurveDb.begin());
+    else
+        std::fill(selectedBandCurveDb.begin(), selectedBandCurveDb.end(), 0.0f);
+    return true;
 }
 
 void AnalyzerComponent::drawGridLines(juce::Graphics& g, const juce::Rectangle<int>& area)
@@ -2082,26 +1897,32 @@ float AnalyzerComponent::snapFrequencyToPeak(float x) const
 
     const float normalized = juce::jlimit(0.0f, 1.0f,
                                           (x - plotArea.getX()) / plotArea.getWidth());
-    const int centerBin = juce::jlimit(0, fftBins - 1,
-                                       static_cast<int>(std::round(normalized * (fftBins - 1))));
+    const auto& values = displayFrame.curve(AnalyzerCurve::pre);
+    const int columns = displayFrame.validPoints;
+    if (columns <= 0 || displayFrame.numPoints <= 0)
+        return xToFrequency(x);
+
+    const int centerColumn = juce::jlimit(0, columns - 1,
+                                          static_cast<int>(std::round(normalized * displayFrame.numPoints)));
     const int search = 6;
-    int bestBin = centerBin;
-    float bestMag = preMagnitudes[static_cast<size_t>(centerBin)];
-    for (int i = centerBin - search; i <= centerBin + search; ++i)
+    int bestColumn = centerColumn;
+    float bestMag = values[static_cast<size_t>(centerColumn)];
+    for (int i = centerColumn - search; i <= centerColumn + search; ++i)
     {
-        const int idx = juce::jlimit(0, fftBins - 1, i);
-        const float mag = preMagnitudes[static_cast<size_t>(idx)];
+        const int idx = juce::jlimit(0, columns - 1, i);
+        const float mag = values[static_cast<size_t>(idx)];
         if (mag > bestMag)
         {
             bestMag = mag;
-            bestBin = idx;
+            bestColumn = idx;
         }
     }
 
-    const double freq = (static_cast<double>(bestBin) * lastSampleRate) / fftSize;
+    const float freq = FFTUtils::normToFreq(static_cast<float>(bestColumn) / static_cast<float>(displayFrame.numPoints),
+                                            displayFrame.minFreq, displayFrame.maxFreq);
     return juce::jlimit<float>(kMinFreq,
                                static_cast<float>(lastSampleRate * 0.49),
-                               static_cast<float>(freq));
+                               freq);
 }
 
 void AnalyzerComponent::setBandParameter(int bandIndex, const juce::String& suffix, float value)
@@ -2146,187 +1967,36 @@ int AnalyzerComponent::getBandType(int bandIndex) const
     return static_cast<int>(getBandParameter(bandIndex, kParamTypeSuffix));
 }
 
-std::complex<double> AnalyzerComponent::computeBandResponse(int bandIndex, float frequency) const
+void AnalyzerComponent::resolveBandCurveParameters()
 {
-    if (getBandBypassed(bandIndex))
-        return { 1.0, 0.0 };
-
-    const float gainDb = getBandParameter(bandIndex, kParamGainSuffix);
-    const float q = std::max(0.1f, getBandParameter(bandIndex, kParamQSuffix));
-    const float freq = getBandParameter(bandIndex, kParamFreqSuffix);
-    const int type = getBandType(bandIndex);
-    const float slopeDb = getBandParameter(bandIndex, kParamSlopeSuffix);
-    const double sampleRate = std::max(1.0, processorRef.getSampleRate());
-
-    const double nyquist = sampleRate * 0.5;
-    const double clampedFreq = juce::jlimit(10.0, nyquist * 0.99, static_cast<double>(freq));
-    const double omega = 2.0 * juce::MathConstants<double>::pi * clampedFreq / sampleRate;
-    const double sinW = std::sin(omega);
-    const double cosW = std::cos(omega);
-    const double alpha = sinW / (2.0 * q);
-    const double a = std::pow(10.0, gainDb / 40.0);
-
-    auto computeResponseForType = [&](eqdsp::FilterType filterType,
-                                      double gainDbForType,
-                                      double qOverride)
-    {
-        const double qLocal = (qOverride > 0.0) ? qOverride : q;
-        const double alphaLocal = sinW / (2.0 * qLocal);
-        const double aLocal = std::pow(10.0, gainDbForType / 40.0);
-        double b0 = 1.0;
-        double b1 = 0.0;
-        double b2 = 0.0;
-        double a0 = 1.0;
-        double a1 = 0.0;
-        double a2 = 0.0;
-
-        switch (filterType)
-        {
-            case eqdsp::FilterType::bell:
-                b0 = 1.0 + alphaLocal * aLocal;
-                b1 = -2.0 * cosW;
-                b2 = 1.0 - alphaLocal * aLocal;
-                a0 = 1.0 + alphaLocal / aLocal;
-                a1 = -2.0 * cosW;
-                a2 = 1.0 - alphaLocal / aLocal;
-                break;
-            case eqdsp::FilterType::lowShelf:
-            {
-                const double beta = std::sqrt(aLocal) / qLocal;
-                b0 = aLocal * ((aLocal + 1.0) - (aLocal - 1.0) * cosW + beta * sinW);
-                b1 = 2.0 * aLocal * ((aLocal - 1.0) - (aLocal + 1.0) * cosW);
-                b2 = aLocal * ((aLocal + 1.0) - (aLocal - 1.0) * cosW - beta * sinW);
-                a0 = (aLocal + 1.0) + (aLocal - 1.0) * cosW + beta * sinW;
-                a1 = -2.0 * ((aLocal - 1.0) + (aLocal + 1.0) * cosW);
-                a2 = (aLocal + 1.0) + (aLocal - 1.0) * cosW - beta * sinW;
-                break;
-            }
-            case eqdsp::FilterType::highShelf:
-            {
-                const double beta = std::sqrt(aLocal) / qLocal;
-                b0 = aLocal * ((aLocal + 1.0) + (aLocal - 1.0) * cosW + beta * sinW);
-                b1 = -2.0 * aLocal * ((aLocal - 1.0) + (aLocal + 1.0) * cosW);
-                b2 = aLocal * ((aLocal + 1.0) + (aLocal - 1.0) * cosW - beta * sinW);
-                a0 = (aLocal + 1.0) - (aLocal - 1.0) * cosW + beta * sinW;
-                a1 = 2.0 * ((aLocal - 1.0) - (aLocal + 1.0) * cosW);
-                a2 = (aLocal + 1.0) - (aLocal - 1.0) * cosW - beta * sinW;
-                break;
-            }
-            case eqdsp::FilterType::lowPass:
-                b0 = (1.0 - cosW) * 0.5;
-                b1 = 1.0 - cosW;
-                b2 = (1.0 - cosW) * 0.5;
-                a0 = 1.0 + alphaLocal;
-                a1 = -2.0 * cosW;
-                a2 = 1.0 - alphaLocal;
-                break;
-            case eqdsp::FilterType::highPass:
-                b0 = (1.0 + cosW) * 0.5;
-                b1 = -(1.0 + cosW);
-                b2 = (1.0 + cosW) * 0.5;
-                a0 = 1.0 + alphaLocal;
-                a1 = -2.0 * cosW;
-                a2 = 1.0 - alphaLocal;
-                break;
-            case eqdsp::FilterType::notch:
-                b0 = 1.0;
-                b1 = -2.0 * cosW;
-                b2 = 1.0;
-                a0 = 1.0 + alphaLocal;
-                a1 = -2.0 * cosW;
-                a2 = 1.0 - alphaLocal;
-                break;
-            case eqdsp::FilterType::bandPass:
-                b0 = alphaLocal;
-                b1 = 0.0;
-                b2 = -alphaLocal;
-                a0 = 1.0 + alphaLocal;
-                a1 = -2.0 * cosW;
-                a2 = 1.0 - alphaLocal;
-                break;
-            case eqdsp::FilterType::allPass:
-                b0 = 1.0 - alphaLocal;
-                b1 = -2.0 * cosW;
-                b2 = 1.0 + alphaLocal;
-                a0 = 1.0 + alphaLocal;
-                a1 = -2.0 * cosW;
-                a2 = 1.0 - alphaLocal;
-                break;
-            case eqdsp::FilterType::tilt:
-            case eqdsp::FilterType::flatTilt:
-                break;
-        }
-
-        const double invA0 = 1.0 / a0;
-        b0 *= invA0;
-        b1 *= invA0;
-        b2 *= invA0;
-        a1 *= invA0;
-        a2 *= invA0;
-
-        const double w = 2.0 * juce::MathConstants<double>::pi
-            * juce::jlimit(10.0, nyquist * 0.99, static_cast<double>(frequency)) / sampleRate;
-        const std::complex<double> z = std::exp(std::complex<double>(0.0, -w));
-        const std::complex<double> z2 = z * z;
-        const std::complex<double> numerator = b0 + b1 * z + b2 * z2;
-        const std::complex<double> denominator = 1.0 + a1 * z + a2 * z2;
-        return numerator / denominator;
+    static const juce::String* const suffixes[numCurveParams] {
+        &kParamFreqSuffix, &kParamGainSuffix, &kParamQSuffix, &kParamTypeSuffix,
+        &kParamBypassSuffix, &kParamSlopeSuffix, &kParamMixSuffix, &kParamDynEnableSuffix
     };
+    for (int band = 0; band < ParamIDs::kBandsPerChannel; ++band)
+        for (int param = 0; param < numCurveParams; ++param)
+            bandCurveParams[static_cast<size_t>(band)][static_cast<size_t>(param)] =
+                parameters.getRawParameterValue(ParamIDs::bandParamId(selectedChannel, band, *suffixes[param]));
+    bandCurveParamsChannel = selectedChannel;
+}
 
-    std::complex<double> response;
-    const auto filterType = static_cast<eqdsp::FilterType>(type);
-    if (filterType == eqdsp::FilterType::tilt || filterType == eqdsp::FilterType::flatTilt)
-    {
-        const double qOverride = (filterType == eqdsp::FilterType::flatTilt) ? 0.5 : -1.0;
-        const auto low = computeResponseForType(eqdsp::FilterType::lowShelf, gainDb * 0.5, qOverride);
-        const auto high = computeResponseForType(eqdsp::FilterType::highShelf, -gainDb * 0.5, qOverride);
-        response = low * high;
-    }
-    else
-    {
-        response = computeResponseForType(filterType, gainDb, -1.0);
-    }
-
-    if (filterType == eqdsp::FilterType::lowPass || filterType == eqdsp::FilterType::highPass)
+AnalyzerComponent::BandCurveKey AnalyzerComponent::readBandCurveKey(int bandIndex) const
+{
+    const auto& values = bandCurveParams[static_cast<size_t>(bandIndex)];
+    auto read = [&values](BandCurveParam param)
     {
-        auto onePoleResponse = [sampleRate, filterType](double cutoff, double freqHz)
-        {
-            const double clamped = juce::jlimit(10.0, sampleRate * 0.5 * 0.99, cutoff);
-            const double a = std::exp(-2.0 * juce::MathConstants<double>::pi * clamped / sampleRate);
-            const std::complex<double> z1 = std::exp(std::complex<double>(0.0,
-                                                                          -2.0 * juce::MathConstants<double>::pi
-                                                                              * freqHz / sampleRate));
-            if (filterType == eqdsp::FilterType::lowPass)
-                return (1.0 - a) / (1.0 - a * z1);
-
-            return ((1.0 + a) * 0.5) * (1.0 - z1) / (1.0 - a * z1);
-        };
-
-        const float clamped = juce::jlimit(6.0f, 96.0f, slopeDb);
-        const int stages = static_cast<int>(std::floor(clamped / 12.0f));
-        const float remainder = clamped - static_cast<float>(stages) * 12.0f;
-        const bool useOnePole = (remainder >= 6.0f) || stages == 0;
-        if (stages > 0)
-        {
-            response = std::pow(response, stages);
-        }
-        else
-        {
-            // 6 dB/oct uses only the one-pole stage (no biquad contribution).
-            response = { 1.0, 0.0 };
-        }
-        if (useOnePole)
-            response *= onePoleResponse(freq, frequency);
-        if (stages == 0 && useOnePole)
-        {
-            const float resonanceMix = juce::jlimit(0.0f, 0.8f, (q - 0.707f) / 6.0f);
-            if (resonanceMix > 0.0f)
-            {
-                const auto bandPass = computeResponseForType(eqdsp::FilterType::bandPass, 0.0, -1.0);
-                response += bandPass * static_cast<double>(resonanceMix);
-            }
-        }
-    }
-
-    return response;
+        const auto* value = values[static_cast<size_t>(param)];
+        return value != nullptr ? value->load() : 0.0f;
+    };
+    BandCurveKey key;
+    key.freq = read(curveParamFreq);
+    key.gain = read(curveParamGain);
+    key.q = read(curveParamQ);
+    key.type = read(curveParamType);
+    key.bypass = read(curveParamBypass);
+    key.slope = read(curveParamSlope);
+    key.mix = read(curveParamMix);
+    key.dynEnable = read(curveParamDynEnable);
+    key.dynamicDb = getBandDynamicGainDb(bandIndex);
+    return key;
 }
@@ -1,18 +1,20 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include "../util/RingBuffer.h"
 #include "../util/ParamIDs.h"
+#include "AnalyzerWorker.h"
+#include "FrameScheduler.h"
 #include "Theme.h"
 
 class EQProAudioProcessor;
 
 // FFT analyzer + EQ curve editor with interactive band points.
 class AnalyzerComponent final : public juce::Component,
-                                private juce::Timer
+                                public FrameScheduler::Client
 {
 public:
     explicit AnalyzerComponent(EQProAudioProcessor& processor);
+    ~AnalyzerComponent() override;
 
     // UI selection hooks from parent editor.
     void setSelectedBand(int bandIndex);
@@ -22,6 +24,8 @@ public:
     void setUiScale(float scale);
     // Enable/disable interactive editing on the graph.
     void setInteractive(bool shouldAllow);
+    // Blocks band edits (drag, create, wheel Q, context menu) while the snapshot morph plays.
+    void setBandEditingLocked(bool locked);
     // Clears cached paths to force re-render.
     void invalidateCaches();
     int getTimerHz() const noexcept { return lastTimerHz; }
@@ -42,10 +46,20 @@ public:
     void mouseExit(const juce::MouseEvent& event) override;
 
 private:
-    // Timer refresh (FFT + curves).
-    void timerCallback() override;
-    void updateFft();
-    void updateCurves();
+    // Scheduler frame: hand settings to the worker, take its latest frame, update curves.
+    int getFrameRateHz() const override;
+    juce::Rectangle<int> frameTick() override;
+    bool hasActiveHarmonics() const;
+    // Recompute EQ curves if band parameters changed; true when anything was recomputed.
+    bool updateCurves();
+    // Layer rendering (see paint): cached background/overlay/labels, live spectrum and HUD.
+    void paintBackgroundLayer(juce::Graphics& g);
+    void paintSpectrum(juce::Graphics& g);
+    void paintOverlayLayer(juce::Graphics& g);
+    void paintHoverHud(juce::Graphics& g);
+    void invalidateLayers();
+    // Mark the EQ/band-point layer stale and repaint.
+    void repaintOverlay();
     // Layout helpers for plot and label regions.
     juce::Rectangle<int> getPlotArea() const;
     juce::Rectangle<int> getMagnitudeArea() const;
@@ -70,12 +84,36 @@ private:
     bool getBandBypassed(int bandIndex) const;
     int getBandType(int bandIndex) const;
 
-    std::complex<double> computeBandResponse(int bandIndex, float frequency) const;
+    // Parameter tuple a band's cached response was computed from (compared exactly, not hashed).
+    struct BandCurveKey
+    {
+        float freq = 0.0f;
+        float gain = 0.0f;
+        float q = 0.0f;
+        float type = 0.0f;
+        float bypass = 0.0f;
+        float slope = 0.0f;
+        float mix = 0.0f;
+        float dynEnable = 0.0f;
+        float dynamicDb = 0.0f;
+
+        bool operator==(const BandCurveKey& other) const noexcept
+        {
+            return freq == other.freq && gain == other.gain && q == other.q && type == other.type
+                && bypass == other.bypass && slope == other.slope && mix == other.mix
+                && dynEnable == other.dynEnable && dynamicDb == other.dynamicDb;
+        }
+        bool operator!=(const BandCurveKey& other) const noexcept { return ! (*this == other); }
+    };
+
+    // Resolve the selected channel's band parameter pointers once (no string lookups per update).
+    void resolveBandCurveParameters();
+    BandCurveKey readBandCurveKey(int bandIndex) const;
+    // Closes the processor undo gesture opened on mouseDown.
+    void endUndoGesture();
 
     EQProAudioProcessor& processorRef;
     juce::AudioProcessorValueTreeState& parameters;
-    AudioFifo& externalFifo;
-    AudioFifo& harmonicFifo;  // v4.5 beta: FIFO for program + harmonics (red curve)
 
     int selectedBand = 0;
     int selectedChannel = 0;
@@ -97,6 +135,7 @@ private:
     };
     AltSoloState altSoloState {};
     bool draggingQ = false;
+    bool undoGestureOpen = false;
     int qDragSide = 0;
     float qDragStart = 1.0f;
     juce::Point<float> dragStartPos;
@@ -109,28 +148,61 @@ private:
     std::vector<int> selectedBands;
     std::vector<DragBandState> dragBands;
     bool allowInteraction = false;
-
-    static constexpr int fftOrder = 12;
-    static constexpr int fftSize = 1 << fftOrder;
-    static constexpr int fftBins = fftSize / 2;
-
-    juce::dsp::FFT fft;
-    juce::dsp::WindowingFunction<float> window;
-
-    std::array<float, fftSize> timeBuffer {};
-    std::array<float, fftSize * 2> fftDataPre {};
-    std::array<float, fftSize * 2> fftDataPost {};
-    std::array<float, fftSize * 2> fftDataHarmonic {};  // v4.5 beta: FFT data for program + harmonics (red curve)
-
-    std::array<float, fftBins> preMagnitudes {};
-    std::array<float, fftBins> postMagnitudes {};
-    std::array<float, fftBins> harmonicMagnitudes {};  // v4.5 beta: Magnitudes for program + harmonics (red curve)
-    std::array<float, fftBins> externalMagnitudes {};
-
+    bool bandEditingLocked = false;
+
+    // Spectrum analysis runs on the processor's worker; displayFrame is the UI's copy of its latest frame.
+    AnalyzerWorker& worker;
+    AnalyzerFrame displayFrame;
+    uint32_t frameVersion = 0;
+
+    // Cached layers at physical pixel resolution.
+    juce::Image backgroundLayer;
+    juce::Image overlayLayer;
+    juce::Image labelLayer;
+    float layerPixelScale = 0.0f;
+    bool overlayDirty = true;
+
+    // EQ curves over the pixel grid. Buffers are sized when the grid changes, never per update.
+    struct BandCurveCache
+    {
+        BandCurveKey key;
+        bool valid = false;
+        // Band response with its dynamic gain and band mix applied (global mix is not).
+        std::vector<float> re;
+        std::vector<float> im;
+    };
+    enum BandCurveParam
+    {
+        curveParamFreq,
+        curveParamGain,
+        curveParamQ,
+        curveParamType,
+        curveParamBypass,
+        curveParamSlope,
+        curveParamMix,
+        curveParamDynEnable,
+        numCurveParams
+    };
+    std::array<BandCurveCache, ParamIDs::kBandsPerChannel> bandCurves;
+    std::array<std::array<std::atomic<float>*, numCurveParams>, ParamIDs::kBandsPerChannel> bandCurveParams {};
+    int bandCurveParamsChannel = -1;
+    // Harmonic parameters of every band, resolved once for hasActiveHarmonics().
+    struct HarmonicParamPointers
+    {
+        const std::atomic<float>* odd = nullptr;
+        const std::atomic<float>* even = nullptr;
+        const std::atomic<float>* mixOdd = nullptr;
+        const std::atomic<float>* mixEven = nullptr;
+        const std::atomic<float>* bypass = nullptr;
+    };
+    std::array<std::array<HarmonicParamPointers, ParamIDs::kBandsPerChannel>, ParamIDs::kMaxChannels> harmonicParams {};
+    std::vector<float> curveFrequencies;
+    std::vector<float> compositeRe;
+    std::vector<float> compositeIm;
     std::vector<float> eqCurveDb;
     std::vector<float> selectedBandCurveDb;
-    std::vector<std::vector<float>> perBandCurveDb;
-    std::vector<bool> perBandActive;
+    std::array<std::vector<float>, ParamIDs::kBandsPerChannel> perBandCurveDb;
+    std::array<bool, ParamIDs::kBandsPerChannel> perBandActive {};
     struct BandPoint
     {
         int band = 0;
@@ -148,14 +220,13 @@ private:
 
     float lastSampleRate = 48000.0f;
     int frameCounter = 0;
-    int throttleCounter = 0;
     float minDb = -60.0f;
     float maxDb = 60.0f;
     int analyzerSpeedIndex = -1;
     int lastTimerHz = 0;
     int lastCurveWidth = 0;
-    std::vector<uint64_t> perBandCurveHash;
-    uint64_t lastCurveHash = 0;
+    float curveGridMaxFreq = 0.0f;
+    double curveGridSampleRate = 0.0;
     int lastCurveBand = -1;
     int lastCurveChannel = -1;
     float lastSelectedMix = 1.0f;
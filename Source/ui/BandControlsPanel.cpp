@@ -1156,7 +1156,7 @@ void BandControlsPanel::paint(juce::Graphics& g)
     }
 }
 
-void BandControlsPanel::timerCallback()
+juce::Rectangle<int> BandControlsPanel::frameTick()
 {
     detectorDb = processor.getBandDetectorDb(selectedChannel, selectedBand);
     cacheBandFromParams(selectedChannel, selectedBand);
@@ -1263,7 +1263,7 @@ void BandControlsPanel::timerCallback()
     }
     if (selectedBand >= 0 && selectedBand < ParamIDs::kBandsPerChannel)
         selectedBandGlow = bandSelectFade[static_cast<size_t>(selectedBand)].getCurrentValue();
-    repaint(detectorMeterBounds.getSmallestIntegerContainer());
+    return detectorMeterBounds.getSmallestIntegerContainer();
 }
 
 void BandControlsPanel::cacheBandFromUi(int channelIndex, int bandIndex)
@@ -1480,8 +1480,7 @@ void BandControlsPanel::resized()
         hasBeenResized = true;
         // Force initial repaint to ensure all components render properly
         repaint();
-        // Start timer at normal rate after components are laid out
-        startTimerHz(30);
+        // Frame ticks start now (getFrameRateHz) that components are laid out
     }
     
     auto bounds = getLocalBounds().reduced(kPanelPadding);
@@ -2,13 +2,16 @@
 
 #include <JuceHeader.h>
 #include <array>
+#include <vector>
+#include "FrameScheduler.h"
 #include "Theme.h"
 
 class EQProAudioProcessor;
 
-// Goniometer/phase scope with correlation readout.
+// Goniometer/phase scope with correlation readout. Points are rasterized into a decaying
+// phosphor buffer, so paint cost is one image draw regardless of the point count.
 class CorrelationComponent final : public juce::Component,
-                                   private juce::Timer
+                                   public FrameScheduler::Client
 {
 public:
     explicit CorrelationComponent(EQProAudioProcessor& processor);
@@ -20,13 +23,27 @@ public:
     void setTheme(const ThemeColors& newTheme);
 
 private:
-    void timerCallback() override;
+    // Scheduler frame: drain the point FIFO, fade and splat into the phosphor buffer.
+    int getFrameRateHz() const override { return 30; }
+    juce::Rectangle<int> frameTick() override;
+
+    // Square scope area inside the panel (shared by paint and the phosphor buffer).
+    juce::Rectangle<float> getScopeArea() const;
+    // Decay the accumulation buffer, then add this frame's points (bilinear splats).
+    void accumulatePoints(int numPoints, float decay, float gain);
+    // Tone-map the accumulation buffer into phosphorImage.
+    void renderPhosphor();
 
     EQProAudioProcessor& processorRef;
-    // Ring of pre-decimated scope points.
-    static constexpr int kScopePoints = 512;
-    std::array<juce::Point<float>, kScopePoints> scopePoints {};
-    int scopePointCount = 0;
+    // Largest number of points taken per frame (the processor FIFO's capacity).
+    static constexpr int kMaxFramePoints = 8192;
+    std::array<float, kMaxFramePoints> pointMid {};
+    std::array<float, kMaxFramePoints> pointSide {};
+    // Phosphor intensity per scope pixel (phosphorSize^2, resized with the component).
+    std::vector<float> intensity;
+    int phosphorSize = 0;
+    juce::Image phosphorImage;
+    double lastTickMs = 0.0;
     // Smoothed auto-gain for consistent scope size.
     juce::SmoothedValue<float> scopeGainSmoothed { 1.0f };
     ThemeColors theme = makeDarkTheme();
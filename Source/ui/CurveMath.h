@@ -0,0 +1,34 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// EQ curve math for the analyzer display: per-band complex responses over a frequency grid (the
+// same RBJ sections and slope cascade the IIR engine runs) and the SIMD curve operations that
+// combine them. No component state, so the benchmark can time curve evaluation on its own.
+namespace CurveMath
+{
+// Band parameters the response depends on (type is an eqdsp::FilterType index).
+struct BandShape
+{
+    float frequencyHz = 1000.0f;
+    float gainDb = 0.0f;
+    float q = 0.707f;
+    int type = 0;
+    float slopeDb = 12.0f;
+    bool bypassed = false;
+};
+
+// Complex response of one band at each frequency; coefficients are computed once per call.
+void computeBandResponse(const BandShape& band, double sampleRate, const float* frequencies, int count,
+                         float* re, float* im);
+
+// dest = 1 + wet * (src - 1) on complex curves; may run in place.
+void applyCurveMix(const float* srcRe, const float* srcIm, float* destRe, float* destIm,
+                   float wet, int count) noexcept;
+
+// accum *= other, element-wise complex product.
+void multiplyCurves(float* accRe, float* accIm, const float* re, const float* im, int count) noexcept;
+
+// db = max(floorDb, 10 * log10(|H|^2)) via the spectral kernels' fast log.
+void responseToDecibels(const float* re, const float* im, float* db, int count, float floorDb) noexcept;
+} // namespace CurveMath
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "FrameScheduler.h"
+#include "Theme.h"
+#include "../util/StageProfiler.h"
+
+class EQProAudioProcessor;
+
+// Profiler overlay for the debug panel: one row per processing stage with mean/p50/p99/max time,
+// share of the block budget, deadline-overrun blame and a sparkline of its histogram, plus the CPU
+// governor's predicted load and shed features. Reads the processor's StageProfiler a few times per
+// second; Reset clears it, JSON dumps it to the log folder.
+class DiagnosticsPanel final : public juce::Component,
+                               public FrameScheduler::Client
+{
+public:
+    explicit DiagnosticsPanel(EQProAudioProcessor& processor);
+
+    void paint(juce::Graphics&) override;
+    void resized() override;
+    void setTheme(const ThemeColors& newTheme);
+
+private:
+    int getFrameRateHz() const override { return isShowing() ? 4 : 0; }
+    juce::Rectangle<int> frameTick() override;
+
+    EQProAudioProcessor& processorRef;
+    StageProfiler::Report report;
+    uint32_t governorSteps = 0;
+    float governorLoad = 0.0f;
+    juce::TextButton resetButton;
+    juce::TextButton jsonButton;
+    juce::String statusText;
+    ThemeColors theme = makeDarkTheme();
+};
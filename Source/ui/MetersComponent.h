@@ -1,13 +1,14 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "FrameScheduler.h"
 #include "Theme.h"
 
 class EQProAudioProcessor;
 
-// Output meter panel with RMS/peak display and peak hold.
+// Output meter panel with RMS/true-peak display, peak hold and a LUFS readout.
 class MetersComponent final : public juce::Component,
-                              private juce::Timer
+                              public FrameScheduler::Client
 {
 public:
     explicit MetersComponent(EQProAudioProcessor& processor);
@@ -23,9 +24,13 @@ public:
 
     void paint(juce::Graphics&) override;
     void resized() override;
+    // Clicking the loudness readout restarts integrated loudness.
+    void mouseDown(const juce::MouseEvent& event) override;
 
 private:
-    void timerCallback() override;
+    // Scheduler frame: pull the latest meter snapshot.
+    int getFrameRateHz() const override { return 30; }
+    juce::Rectangle<int> frameTick() override;
     // Utility for mapping dB to meter Y space.
     float dbToY(float db) const;
 
@@ -37,5 +42,9 @@ private:
     std::vector<float> rmsDb;
     std::vector<float> peakDb;
     std::vector<float> peakHoldDb;
+    float momentaryLufs = -120.0f;
+    float shortTermLufs = -120.0f;
+    float integratedLufs = -120.0f;
+    juce::Rectangle<int> loudnessArea;
     ThemeColors theme = makeDarkTheme();
 };
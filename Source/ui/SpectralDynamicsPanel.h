@@ -27,9 +27,12 @@ private:
     juce::Slider attackSlider;
     juce::Slider releaseSlider;
     juce::Slider mixSlider;
+    juce::ComboBox linkBox;
+    juce::ComboBox bandsBox;
 
     using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     using ButtonAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
+    using ComboBoxAttachment = juce::AudioProcessorValueTreeState::ComboBoxAttachment;
 
     std::unique_ptr<ButtonAttachment> enableAttachment;
     std::unique_ptr<SliderAttachment> thresholdAttachment;
@@ -37,6 +40,8 @@ private:
     std::unique_ptr<SliderAttachment> attackAttachment;
     std::unique_ptr<SliderAttachment> releaseAttachment;
     std::unique_ptr<SliderAttachment> mixAttachment;
+    std::unique_ptr<ComboBoxAttachment> linkAttachment;
+    std::unique_ptr<ComboBoxAttachment> bandsAttachment;
 
     ThemeColors theme = makeDarkTheme();
 };
@@ -22,12 +22,20 @@ extern const juce::String spectralRatio;
 extern const juce::String spectralAttack;
 extern const juce::String spectralRelease;
 extern const juce::String spectralMix;
+extern const juce::String spectralLink;
+extern const juce::String spectralBands;
 extern const juce::String characterMode;
 extern const juce::String qMode;
 extern const juce::String qModeAmount;
 extern const juce::String analyzerRange;
 extern const juce::String analyzerSpeed;
 extern const juce::String analyzerView;
+extern const juce::String analyzerSource;
+extern const juce::String analyzerOverlap;
+extern const juce::String analyzerAveraging;
+extern const juce::String analyzerSmoothing;
+extern const juce::String analyzerPeakHold;
+extern const juce::String analyzerResolution;
 extern const juce::String analyzerFreeze;
 extern const juce::String analyzerExternal;
 extern const juce::String autoGainEnable;
@@ -36,6 +44,9 @@ extern const juce::String phaseInvert;
 extern const juce::String midiLearn;
 extern const juce::String midiTarget;
 extern const juce::String smartSolo;
+extern const juce::String snapshotMorph;
+extern const juce::String snapshotMorphPair;
+extern const juce::String snapshotMorphOn;
 
 // Helper to create a full band parameter ID.
 juce::String bandParamId(int channelIndex, int bandIndex, juce::StringRef suffix);
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+// Undo history of parameter vectors (denormalised values in host parameter order). Each transaction
+// stores only the parameters it changed, as before/after pairs against a baseline that tracks the
+// last committed state, so a drag or a preset load is one entry however many values moved.
+// Oldest transactions are dropped once the history exceeds its memory limit. Message thread only.
+class ParameterHistory
+{
+public:
+    static constexpr size_t kDefaultMemoryLimit = 4u * 1024u * 1024u;
+
+    // Clears all transactions and sets the baseline (session load, construction).
+    void reset(const std::vector<float>& values);
+    // Records values - baseline as one transaction (nothing if identical) and moves the baseline.
+    // Drops any redo entries. Returns true if a transaction was recorded.
+    bool commit(const std::vector<float>& values, const juce::String& name);
+    // True if values differ from the baseline (uncommitted changes).
+    bool hasChanges(const std::vector<float>& values) const;
+
+    // Fill values (resized, NaN = unchanged) with the entries to apply and move the cursor and
+    // baseline accordingly. Return false if there is nothing to undo/redo.
+    bool undo(std::vector<float>& values);
+    bool redo(std::vector<float>& values);
+    bool canUndo() const { return cursor > 0; }
+    bool canRedo() const { return cursor < transactions.size(); }
+    juce::String getUndoName() const;
+    juce::String getRedoName() const;
+
+    void setMemoryLimit(size_t bytes);
+    size_t getMemoryLimit() const { return memoryLimit; }
+    size_t getMemoryUsage() const { return memoryUsed; }
+    int getNumTransactions() const { return static_cast<int>(transactions.size()); }
+
+private:
+    struct Change
+    {
+        uint32_t index;
+        float before;
+        float after;
+    };
+
+    struct Transaction
+    {
+        juce::String name;
+        std::vector<Change> changes;
+        size_t bytes = 0;
+    };
+
+    void trimToLimit();
+
+    std::deque<Transaction> transactions;
+    // Transactions [0, cursor) are applied; [cursor, size) can be redone.
+    size_t cursor = 0;
+    std::vector<float> baseline;
+    size_t memoryLimit = kDefaultMemoryLimit;
+    size_t memoryUsed = 0;
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Preset library: indexes the preset folder (recursively) on a background thread and keeps every
+// preset in a compact binary form, so the editor never touches the file system or parses XML.
+// One instance is shared by all plugin instances in the process (juce::SharedResourcePointer).
+//
+// The folder is rescanned every few seconds and on request; only files whose size or modification
+// time changed are parsed again. The index is persisted next to the user settings so a large folder
+// lists immediately on the next launch while the first rescan validates it.
+class PresetLibrary final : public juce::ChangeBroadcaster,
+                            private juce::Thread
+{
+public:
+    static constexpr int kThumbnailPoints = 48;
+    static constexpr float kThumbnailMinFreq = 20.0f;
+    static constexpr float kThumbnailMaxFreq = 20000.0f;
+    // Thumbnail values are int8 half-dB steps.
+    static constexpr float kThumbnailDbScale = 2.0f;
+
+    struct Preset
+    {
+        juce::File file;
+        // File name without extension.
+        juce::String name;
+        // Sub-folder names below the library root plus the preset's own "tags" attribute.
+        juce::StringArray tags;
+        juce::int64 modified = 0;
+        juce::int64 size = 0;
+        // Composite curve of channel 1 at log-spaced points between kThumbnailMinFreq and kThumbnailMaxFreq.
+        std::array<int8_t, kThumbnailPoints> thumbnail {};
+        // Parameters differing from default, in the StateCodec::encodeParameterValues() block format.
+        juce::MemoryBlock parameters;
+    };
+    // Sorted by name; immutable once published.
+    using Index = std::vector<Preset>;
+
+    PresetLibrary();
+    ~PresetLibrary() override;
+
+    // Default location: <Documents>/EQPro/Presets.
+    static juce::File getDefaultDirectory();
+
+    // Starts indexing (first call only). Parameter defaults come from the caller's layout; presets
+    // are stored as a delta from them.
+    void start(const juce::AudioProcessorValueTreeState& parameters);
+    // Wakes the indexer for an immediate rescan (after saving a preset, refresh button).
+    void requestRescan();
+
+    // Latest published index (any thread). A change message follows every new index.
+    std::shared_ptr<const Index> getIndex() const;
+    bool isIndexing() const { return indexing.load(); }
+
+    // Thumbnail as a drawable path scaled into bounds (message thread).
+    static juce::Path makeThumbnailPath(const Preset& preset, juce::Rectangle<float> bounds, float rangeDb);
+
+private:
+    void run() override;
+    // One pass over the folder; returns true if the index changed.
+    bool rescan();
+    bool parsePreset(const juce::File& file, Preset& preset) const;
+    void computeThumbnail(Preset& preset) const;
+    void publish(Index&& index);
+    void loadCache();
+    void saveCache(const Index& index) const;
+    juce::File getCacheFile() const;
+
+    // Stamp of a file that failed to parse, so it is not retried (or republished) until it changes.
+    struct FailedStamp
+    {
+        juce::int64 modified = 0;
+        juce::int64 size = 0;
+    };
+
+    juce::File root;
+    // Indexer thread only; keyed by full path.
+    juce::HashMap<juce::String, FailedStamp> failedStamps;
+    juce::HashMap<juce::String, float> defaults;
+    juce::StringArray defaultIds;
+    juce::int64 defaultsHash = 0;
+
+    mutable juce::SpinLock indexLock;
+    std::shared_ptr<const Index> current;
+    std::atomic<bool> indexing { false };
+    std::atomic<bool> started { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetLibrary)
+};
@@ -6,14 +6,32 @@
 class AudioFifo
 {
 public:
-    // Preallocate buffer for expected size.
-    void prepare(int bufferSize);
+    // Preallocate buffer for expected size; numChannels planes share one read/write index.
+    void prepare(int bufferSize, int numChannels = 1);
     // Push samples into the FIFO (audio thread).
     void push(const float* data, int numSamples);
+    // Push multichannel frames (audio thread); planes beyond numChannels are left untouched.
+    // A channel-count change drops frames until the reader has called acknowledgeLayout(), so
+    // frames queued under the old layout are never read as the new one.
+    void pushFrames(const float* const* data, int numChannels, int numSamples);
     // Pull samples out of the FIFO (UI thread).
     int pull(float* dest, int numSamples);
+    // Pull multichannel frames (UI thread).
+    int pullFrames(float* const* dest, int numChannels, int numSamples);
+    // Reader: applies a pending layout change (discarding the frames queued before it) and
+    // returns the channels carried by the frames now ready to pull.
+    int acknowledgeLayout();
+    int getNumChannels() const;
+    // Samples (frames) ready to pull.
+    int getNumReady() const;
 
 private:
     juce::AbstractFifo fifo { 1 };
     juce::AudioBuffer<float> buffer;
+    // Layout the reader has acknowledged.
+    std::atomic<int> frameChannels { 1 };
+    // Layout the writer switched to, awaiting acknowledgement (0 = none).
+    std::atomic<int> pendingChannels { 0 };
+    // Writer only.
+    int pushedChannels = 1;
 };
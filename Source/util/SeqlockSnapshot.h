@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+// Single-writer seqlock for publishing a trivially copyable snapshot (audio -> UI).
+// The writer never blocks; readers retry while a write is in flight.
+template <typename T>
+class SeqlockSnapshot
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SeqlockSnapshot needs a trivially copyable type");
+
+public:
+    // Writer side (one thread only).
+    void write(const T& value) noexcept
+    {
+        const auto start = sequence.load(std::memory_order_relaxed);
+        sequence.store(start + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        data = value;
+        sequence.store(start + 2, std::memory_order_release);
+    }
+
+    // Reader side; returns false if no consistent copy was obtained within maxAttempts.
+    bool read(T& dest, int maxAttempts = 8) const noexcept
+    {
+        for (int attempt = 0; attempt < maxAttempts; ++attempt)
+        {
+            const auto before = sequence.load(std::memory_order_acquire);
+            if ((before & 1u) != 0)
+                continue;
+            dest = data;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == before)
+                return true;
+        }
+        return false;
+    }
+
+    // Bumped on every completed write; lets readers skip unchanged frames.
+    uint32_t getVersion() const noexcept { return sequence.load(std::memory_order_acquire) >> 1; }
+
+private:
+    std::atomic<uint32_t> sequence { 0 };
+    T data {};
+};
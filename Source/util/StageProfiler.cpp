@@ -0,0 +1,237 @@
+#include "StageProfiler.h"
+#include <cmath>
+
+namespace
+{
+// Nominal tick rate until calibrate() has measured one. The invariant TSC runs at about the rated
+// CPU clock, so the OS-reported speed is close enough for the first second; read once per process.
+double initialTicksPerSecond()
+{
+#if EQPRO_HAS_TSC
+    static const double nominal = []
+    {
+        const int mhz = juce::SystemStats::getCpuSpeedInMegahertz();
+        return mhz > 0 ? mhz * 1.0e6 : 3.0e9;
+    }();
+    return nominal;
+#else
+    return static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+#endif
+}
+
+int floorLog2(uint64_t value) noexcept
+{
+    int log = 0;
+    while (value >>= 1)
+        ++log;
+    return log;
+}
+
+void relaxedIncrement(std::atomic<uint32_t>& counter) noexcept
+{
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void relaxedAdd(std::atomic<uint64_t>& counter, uint64_t amount) noexcept
+{
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+} // namespace
+
+StageProfiler::StageProfiler()
+{
+    ticksPerSecond.store(initialTicksPerSecond());
+    anchorTicks = now();
+    anchorHighRes = juce::Time::getHighResolutionTicks();
+}
+
+const char* StageProfiler::getStageName(int stage)
+{
+    static constexpr const char* names[numStages] {
+        "snapshot", "iir", "fir", "calibration", "oversampleUp", "oversampleDown",
+        "character", "spectral", "mix", "meters", "taps", "total"
+    };
+    return stage >= 0 && stage < numStages ? names[stage] : "unknown";
+}
+
+int StageProfiler::binFor(uint64_t ticks) noexcept
+{
+    if (ticks < 2)
+        return 0;
+    // Octave from the top bit, sub-bin from the next two bits below it.
+    const int octave = floorLog2(ticks);
+    const int fraction = octave >= 2 ? static_cast<int>((ticks >> (octave - 2)) & 3u)
+                                     : static_cast<int>((ticks << (2 - octave)) & 3u);
+    return juce::jmin(kNumBins - 1, octave * kBinsPerOctave + fraction);
+}
+
+double StageProfiler::binLowerUs(int bin, double rate)
+{
+    const int octave = bin / kBinsPerOctave;
+    const int fraction = bin % kBinsPerOctave;
+    const double ticks = std::ldexp(1.0 + fraction / static_cast<double>(kBinsPerOctave), octave);
+    return rate > 0.0 ? ticks * 1.0e6 / rate : 0.0;
+}
+
+void StageProfiler::beginBlock(int numSamples, double sampleRate) noexcept
+{
+    if (resetRequested.exchange(false))
+        clear();
+    blockTicks.fill(0);
+    const double budgetSeconds = sampleRate > 0.0 ? numSamples / sampleRate : 0.0;
+    blockBudget = static_cast<uint64_t>(budgetSeconds * ticksPerSecond.load(std::memory_order_relaxed));
+    budgetUs.store(budgetSeconds * 1.0e6, std::memory_order_relaxed);
+    blockStart = now();
+}
+
+void StageProfiler::endBlock() noexcept
+{
+    blockTicks[total] = now() - blockStart;
+
+    int worst = -1;
+    uint64_t worstTicks = 0;
+    for (size_t s = 0; s < blockTicks.size(); ++s)
+    {
+        const auto ticks = blockTicks[s];
+        if (ticks == 0)
+            continue;
+        auto& histogram = histograms[s];
+        relaxedIncrement(histogram.bins[static_cast<size_t>(binFor(ticks))]);
+        relaxedAdd(histogram.count, 1);
+        relaxedAdd(histogram.sum, ticks);
+        histogram.last.store(ticks, std::memory_order_relaxed);
+        if (ticks > histogram.max.load(std::memory_order_relaxed))
+            histogram.max.store(ticks, std::memory_order_relaxed);
+        if (s != total && ticks > worstTicks)
+        {
+            worst = static_cast<int>(s);
+            worstTicks = ticks;
+        }
+    }
+
+    relaxedAdd(blocks, 1);
+    if (blockBudget > 0 && blockTicks[total] > blockBudget)
+    {
+        relaxedAdd(overruns, 1);
+        if (worst >= 0)
+            relaxedAdd(histograms[static_cast<size_t>(worst)].overrunBlame, 1);
+    }
+}
+
+void StageProfiler::clear() noexcept
+{
+    for (auto& histogram : histograms)
+    {
+        for (auto& bin : histogram.bins)
+            bin.store(0, std::memory_order_relaxed);
+        histogram.count.store(0, std::memory_order_relaxed);
+        histogram.sum.store(0, std::memory_order_relaxed);
+        histogram.max.store(0, std::memory_order_relaxed);
+        histogram.last.store(0, std::memory_order_relaxed);
+        histogram.overrunBlame.store(0, std::memory_order_relaxed);
+    }
+    blocks.store(0, std::memory_order_relaxed);
+    overruns.store(0, std::memory_order_relaxed);
+}
+
+void StageProfiler::calibrate()
+{
+#if EQPRO_HAS_TSC
+    const auto ticks = now();
+    const auto highRes = juce::Time::getHighResolutionTicks();
+    const double seconds = juce::Time::highResolutionTicksToSeconds(highRes - anchorHighRes);
+    // Wait for a long enough baseline; the rate is then accurate to well under 0.1 %.
+    if (seconds > 1.0 && ticks > anchorTicks)
+        ticksPerSecond.store(static_cast<double>(ticks - anchorTicks) / seconds);
+#endif
+}
+
+StageProfiler::Report StageProfiler::getReport() const
+{
+    Report report;
+    report.blocks = blocks.load(std::memory_order_relaxed);
+    report.overruns = overruns.load(std::memory_order_relaxed);
+    report.budgetUs = budgetUs.load(std::memory_order_relaxed);
+    report.ticksPerSecond = ticksPerSecond.load(std::memory_order_relaxed);
+    const double usPerTick = report.ticksPerSecond > 0.0 ? 1.0e6 / report.ticksPerSecond : 0.0;
+
+    for (size_t s = 0; s < histograms.size(); ++s)
+    {
+        const auto& histogram = histograms[s];
+        auto& stats = report.stages[s];
+        uint64_t binTotal = 0;
+        for (size_t b = 0; b < stats.bins.size(); ++b)
+        {
+            stats.bins[b] = histogram.bins[b].load(std::memory_order_relaxed);
+            binTotal += stats.bins[b];
+        }
+        stats.count = histogram.count.load(std::memory_order_relaxed);
+        stats.meanUs = stats.count > 0
+            ? static_cast<double>(histogram.sum.load(std::memory_order_relaxed)) * usPerTick / stats.count
+            : 0.0;
+        stats.maxUs = static_cast<double>(histogram.max.load(std::memory_order_relaxed)) * usPerTick;
+        stats.lastUs = static_cast<double>(histogram.last.load(std::memory_order_relaxed)) * usPerTick;
+        stats.overrunBlame = histogram.overrunBlame.load(std::memory_order_relaxed);
+
+        // Percentiles at the upper edge of the bin that crosses the rank.
+        auto percentile = [&stats, binTotal, rate = report.ticksPerSecond](double fraction)
+        {
+            if (binTotal == 0)
+                return 0.0;
+            const auto rank = static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(binTotal)));
+            uint64_t seen = 0;
+            for (int b = 0; b < kNumBins; ++b)
+            {
+                seen += stats.bins[static_cast<size_t>(b)];
+                if (seen >= rank)
+                    return binLowerUs(b + 1, rate);
+            }
+            return binLowerUs(kNumBins, rate);
+        };
+        stats.p50Us = juce::jmin(percentile(0.5), stats.maxUs);
+        stats.p99Us = juce::jmin(percentile(0.99), stats.maxUs);
+    }
+    return report;
+}
+
+juce::String StageProfiler::toJson(const Report& report)
+{
+    auto root = std::make_unique<juce::DynamicObject>();
+    root->setProperty("blocks", static_cast<juce::int64>(report.blocks));
+    root->setProperty("overruns", static_cast<juce::int64>(report.overruns));
+    root->setProperty("budgetUs", report.budgetUs);
+    root->setProperty("ticksPerSecond", report.ticksPerSecond);
+    root->setProperty("binsPerOctave", kBinsPerOctave);
+
+    juce::Array<juce::var> stages;
+    for (int s = 0; s < numStages; ++s)
+    {
+        const auto& stats = report.stages[static_cast<size_t>(s)];
+        auto stage = std::make_unique<juce::DynamicObject>();
+        stage->setProperty("name", getStageName(s));
+        stage->setProperty("count", static_cast<juce::int64>(stats.count));
+        stage->setProperty("meanUs", stats.meanUs);
+        stage->setProperty("p50Us", stats.p50Us);
+        stage->setProperty("p99Us", stats.p99Us);
+        stage->setProperty("maxUs", stats.maxUs);
+        stage->setProperty("overrunBlame", static_cast<juce::int64>(stats.overrunBlame));
+        // Sparse histogram: [lower edge in us, count] for non-empty bins.
+        juce::Array<juce::var> bins;
+        for (int b = 0; b < kNumBins; ++b)
+        {
+            const auto count = stats.bins[static_cast<size_t>(b)];
+            if (count == 0)
+                continue;
+            bins.add(juce::Array<juce::var> { binLowerUs(b, report.ticksPerSecond), static_cast<int>(count) });
+        }
+        stage->setProperty("histogram", bins);
+        stages.add(juce::var(stage.release()));
+    }
+    root->setProperty("stages", stages);
+    return juce::JSON::toString(juce::var(root.release()));
+}
+
+bool StageProfiler::writeJson(const juce::File& file) const
+{
+    return file.replaceWithText(toJson(getReport()));
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+ #include <intrin.h>
+ #define EQPRO_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+ #include <x86intrin.h>
+ #define EQPRO_HAS_TSC 1
+#else
+ #define EQPRO_HAS_TSC 0
+#endif
+
+// Per-stage realtime profiler. The audio thread stamps each processing stage with the time-stamp
+// counter (high-resolution ticks where there is none) and, at the end of the block, adds every
+// stage's duration to a log-scale histogram. Histograms are relaxed atomics with a single writer,
+// so readers (diagnostics panel, JSON dump) never block the audio thread.
+//
+// Blocks that take longer than their real-time budget count as overruns, and the stage that took the
+// longest in that block is blamed, which shows which stage blows the deadline rather than only that
+// one did.
+class StageProfiler
+{
+public:
+    enum Stage
+    {
+        snapshot = 0,   // snapshot build / morph on the audio thread
+        iir,            // realtime EQDSP pass (includes per-band dynamics and harmonics)
+        fir,            // linear-phase convolution, M/S, min-phase blend, swap crossfade
+        calibration,    // realtime reference pass and RMS match in linear modes
+        oversampleUp,
+        oversampleDown,
+        character,      // character saturation
+        spectral,
+        mix,            // dry/wet, auto-gain, trims, fades
+        meters,
+        taps,           // analyzer pre/post/harmonic taps
+        total,          // whole processBlock
+        numStages
+    };
+
+    // Bins cover ticks logarithmically: kBinsPerOctave per doubling, starting at 1 tick.
+    static constexpr int kBinsPerOctave = 4;
+    static constexpr int kNumBins = 40 * kBinsPerOctave;
+
+    StageProfiler();
+
+    static const char* getStageName(int stage);
+
+    static inline uint64_t now() noexcept
+    {
+#if EQPRO_HAS_TSC
+        return static_cast<uint64_t>(__rdtsc());
+#else
+        return static_cast<uint64_t>(juce::Time::getHighResolutionTicks());
+#endif
+    }
+
+    // Audio thread.
+    void beginBlock(int numSamples, double sampleRate) noexcept;
+    void add(Stage stage, uint64_t ticks) noexcept
+    {
+        blockTicks[static_cast<size_t>(stage)] += ticks;
+    }
+    void endBlock() noexcept;
+    // Stage durations of the last block, valid after endBlock() until the next beginBlock().
+    const std::array<uint64_t, numStages>& getBlockTicks() const noexcept { return blockTicks; }
+    double getTicksPerSecond() const noexcept { return ticksPerSecond.load(std::memory_order_relaxed); }
+
+    // Times one stage of the current block; a null profiler records nothing.
+    class Scope
+    {
+    public:
+        Scope(StageProfiler* profilerIn, Stage stageIn) noexcept
+            : profiler(profilerIn), stage(stageIn), start(profilerIn != nullptr ? now() : 0) {}
+        ~Scope()
+        {
+            if (profiler != nullptr)
+                profiler->add(stage, now() - start);
+        }
+
+    private:
+        StageProfiler* profiler;
+        Stage stage;
+        uint64_t start;
+        JUCE_DECLARE_NON_COPYABLE(Scope)
+    };
+
+    // Any thread. Times are microseconds.
+    struct StageStats
+    {
+        uint64_t count = 0;
+        double meanUs = 0.0;
+        double p50Us = 0.0;
+        double p99Us = 0.0;
+        double maxUs = 0.0;
+        double lastUs = 0.0;
+        // Overrun blocks in which this stage took the longest.
+        uint64_t overrunBlame = 0;
+        std::array<uint32_t, kNumBins> bins {};
+    };
+
+    struct Report
+    {
+        uint64_t blocks = 0;
+        uint64_t overruns = 0;
+        double budgetUs = 0.0;
+        double ticksPerSecond = 0.0;
+        std::array<StageStats, numStages> stages {};
+    };
+
+    Report getReport() const;
+    // Clears the histograms at the start of the next block (keeps a single writer).
+    void requestReset() noexcept { resetRequested.store(true); }
+
+    // Message thread: refines the tick rate against the high-resolution clock.
+    void calibrate();
+
+    static juce::String toJson(const Report& report);
+    bool writeJson(const juce::File& file) const;
+    // Lower edge of bin in microseconds for the given tick rate.
+    static double binLowerUs(int bin, double ticksPerSecond);
+
+private:
+    static int binFor(uint64_t ticks) noexcept;
+    void clear() noexcept;
+
+    struct Histogram
+    {
+        std::array<std::atomic<uint32_t>, kNumBins> bins {};
+        std::atomic<uint64_t> count { 0 };
+        std::atomic<uint64_t> sum { 0 };
+        std::atomic<uint64_t> max { 0 };
+        std::atomic<uint64_t> last { 0 };
+        std::atomic<uint64_t> overrunBlame { 0 };
+    };
+
+    // Audio thread only.
+    std::array<uint64_t, numStages> blockTicks {};
+    uint64_t blockStart = 0;
+    uint64_t blockBudget = 0;
+
+    std::array<Histogram, numStages> histograms;
+    std::atomic<uint64_t> blocks { 0 };
+    std::atomic<uint64_t> overruns { 0 };
+    std::atomic<double> budgetUs { 0.0 };
+    std::atomic<double> ticksPerSecond { 0.0 };
+    std::atomic<bool> resetRequested { false };
+
+    // Calibration anchor (message thread).
+    uint64_t anchorTicks = 0;
+    juce::int64 anchorHighRes = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StageProfiler)
+};
@@ -0,0 +1,263 @@
+#include "StateCodec.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+const juce::Identifier kParamType { "PARAM" };
+const juce::Identifier kIdProperty { "id" };
+const juce::Identifier kValueProperty { "value" };
+const std::array<juce::Identifier, 4> kSnapshotProperties { "snapshotA", "snapshotB", "snapshotC", "snapshotD" };
+
+bool isSnapshotProperty(const juce::Identifier& name)
+{
+    return std::find(kSnapshotProperties.begin(), kSnapshotProperties.end(), name) != kSnapshotProperties.end();
+}
+
+float getDefaultValue(const juce::RangedAudioParameter& parameter)
+{
+    return parameter.convertFrom0to1(parameter.getDefaultValue());
+}
+
+void writeBlock(const juce::AudioProcessorValueTreeState& parameters, const juce::ValueTree& state,
+                juce::OutputStream& out, bool nested)
+{
+    // Parameters away from their default.
+    juce::MemoryOutputStream params;
+    int numParams = 0;
+    for (const auto& child : state)
+    {
+        if (! child.hasType(kParamType))
+            continue;
+        const auto id = child.getProperty(kIdProperty).toString();
+        const auto* parameter = parameters.getParameter(id);
+        if (parameter == nullptr || ! child.hasProperty(kValueProperty))
+            continue;
+        const auto value = static_cast<float>(child.getProperty(kValueProperty));
+        if (juce::approximatelyEqual(value, getDefaultValue(*parameter)))
+            continue;
+        params.writeString(id);
+        params.writeFloat(value);
+        ++numParams;
+    }
+    out.writeCompressedInt(numParams);
+    out << params.getMemoryBlock();
+
+    // Plain properties, and XML snapshot slots as nested blocks (a snapshot's own slots are dropped:
+    // they are never recalled and used to nest whole states inside each other).
+    juce::MemoryOutputStream plain;
+    juce::MemoryOutputStream snapshots;
+    int numPlain = 0;
+    int numSnapshots = 0;
+    for (int i = 0; i < state.getNumProperties(); ++i)
+    {
+        const auto name = state.getPropertyName(i);
+        const auto& value = state.getProperty(name);
+        // Snapshot slots stored as binary parameter vectors are plain properties; only the XML
+        // strings of older versions are re-encoded.
+        if (isSnapshotProperty(name) && value.isString())
+        {
+            if (nested)
+                continue;
+            const auto xml = juce::parseXML(value.toString());
+            if (xml == nullptr || ! xml->hasTagName(state.getType().toString()))
+                continue;
+            snapshots.writeString(name.toString());
+            writeBlock(parameters, juce::ValueTree::fromXml(*xml), snapshots, true);
+            ++numSnapshots;
+            continue;
+        }
+        plain.writeString(name.toString());
+        value.writeToStream(plain);
+        ++numPlain;
+    }
+    out.writeCompressedInt(numPlain);
+    out << plain.getMemoryBlock();
+    out.writeCompressedInt(numSnapshots);
+    out << snapshots.getMemoryBlock();
+}
+
+// Counts are bounded by the bytes left so a corrupt chunk cannot spin or over-allocate.
+bool readCount(juce::InputStream& in, int& count)
+{
+    count = in.readCompressedInt();
+    return count >= 0 && count <= in.getNumBytesRemaining();
+}
+
+// Skips the chunk header; false if the version is not one this build reads.
+bool readHeader(juce::InputStream& in)
+{
+    in.readInt();
+    const int version = in.readShort();
+    in.readShort();
+    return version >= 1 && version <= StateCodec::kVersion;
+}
+
+juce::ValueTree makeDefaultState(const juce::AudioProcessorValueTreeState& parameters,
+                                 juce::HashMap<juce::String, int>& childIndex)
+{
+    juce::ValueTree state(parameters.state.getType());
+    for (auto* parameter : parameters.processor.getParameters())
+    {
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+        {
+            juce::ValueTree child(kParamType);
+            child.setProperty(kIdProperty, ranged->getParameterID(), nullptr);
+            child.setProperty(kValueProperty, getDefaultValue(*ranged), nullptr);
+            childIndex.set(ranged->getParameterID(), state.getNumChildren());
+            state.appendChild(child, nullptr);
+        }
+    }
+    return state;
+}
+
+bool readBlock(const juce::AudioProcessorValueTreeState& parameters, juce::InputStream& in,
+               juce::ValueTree& state, bool nested)
+{
+    juce::HashMap<juce::String, int> childIndex;
+    state = makeDefaultState(parameters, childIndex);
+
+    int count = 0;
+    if (! readCount(in, count))
+        return false;
+    for (int i = 0; i < count; ++i)
+    {
+        const auto id = in.readString();
+        const auto value = in.readFloat();
+        // Parameters removed since the chunk was written are skipped.
+        if (childIndex.contains(id))
+            state.getChild(childIndex[id]).setProperty(kValueProperty, value, nullptr);
+    }
+
+    if (! readCount(in, count))
+        return false;
+    for (int i = 0; i < count; ++i)
+    {
+        const auto name = in.readString();
+        const auto value = juce::var::readFromStream(in);
+        if (name.isNotEmpty())
+            state.setProperty(name, value, nullptr);
+    }
+
+    if (! readCount(in, count) || (nested && count != 0))
+        return false;
+    for (int i = 0; i < count; ++i)
+    {
+        const auto name = in.readString();
+        juce::ValueTree snapshot;
+        if (! readBlock(parameters, in, snapshot, true))
+            return false;
+        if (name.isNotEmpty())
+            if (auto xml = snapshot.createXml())
+                state.setProperty(name, xml->toString(), nullptr);
+    }
+    return true;
+}
+} // namespace
+
+namespace StateCodec
+{
+void write(const juce::AudioProcessorValueTreeState& parameters, const juce::ValueTree& state,
+           juce::MemoryBlock& dest)
+{
+    juce::MemoryOutputStream out(dest, false);
+    out.writeInt(kMagic);
+    out.writeShort(static_cast<short>(kVersion));
+    out.writeShort(0);
+    writeBlock(parameters, state, out, false);
+}
+
+bool isBinary(const void* data, int sizeInBytes)
+{
+    return data != nullptr && sizeInBytes >= 8
+        && static_cast<int>(juce::ByteOrder::littleEndianInt(data)) == kMagic;
+}
+
+juce::ValueTree read(const juce::AudioProcessorValueTreeState& parameters, const void* data, int sizeInBytes)
+{
+    if (! isBinary(data, sizeInBytes))
+        return {};
+
+    juce::MemoryInputStream in(data, static_cast<size_t>(sizeInBytes), false);
+    if (! readHeader(in))
+        return {};
+
+    juce::ValueTree state;
+    if (! readBlock(parameters, in, state, false))
+        return {};
+    return state;
+}
+
+bool readParameterDeltas(const void* data, int sizeInBytes, std::vector<std::pair<juce::String, float>>& dest)
+{
+    dest.clear();
+    if (! isBinary(data, sizeInBytes))
+        return false;
+
+    juce::MemoryInputStream in(data, static_cast<size_t>(sizeInBytes), false);
+    int count = 0;
+    if (! readHeader(in) || ! readCount(in, count))
+        return false;
+    dest.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i)
+    {
+        auto id = in.readString();
+        const auto value = in.readFloat();
+        dest.emplace_back(std::move(id), value);
+    }
+    return true;
+}
+
+void encodeParameterValues(const juce::AudioProcessorValueTreeState& parameters, const std::vector<float>& values,
+                           juce::MemoryBlock& dest)
+{
+    juce::MemoryOutputStream body;
+    int count = 0;
+    const auto& all = parameters.processor.getParameters();
+    for (int i = 0; i < juce::jmin(all.size(), static_cast<int>(values.size())); ++i)
+    {
+        auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(all[i]);
+        const auto value = values[static_cast<size_t>(i)];
+        if (ranged == nullptr || std::isnan(value) || juce::approximatelyEqual(value, getDefaultValue(*ranged)))
+            continue;
+        body.writeString(ranged->getParameterID());
+        body.writeFloat(value);
+        ++count;
+    }
+
+    juce::MemoryOutputStream out(dest, false);
+    out.writeCompressedInt(count);
+    out << body.getMemoryBlock();
+}
+
+std::vector<float> decodeParameterValues(const juce::AudioProcessorValueTreeState& parameters, const void* data,
+                                         size_t sizeInBytes)
+{
+    std::vector<float> values;
+    juce::HashMap<juce::String, int> index;
+    const auto& all = parameters.processor.getParameters();
+    values.reserve(static_cast<size_t>(all.size()));
+    for (auto* parameter : all)
+    {
+        auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter);
+        if (ranged != nullptr)
+            index.set(ranged->getParameterID(), static_cast<int>(values.size()));
+        values.push_back(ranged != nullptr ? getDefaultValue(*ranged) : std::numeric_limits<float>::quiet_NaN());
+    }
+
+    juce::MemoryInputStream in(data, sizeInBytes, false);
+    int count = 0;
+    if (! readCount(in, count))
+        return {};
+    for (int i = 0; i < count; ++i)
+    {
+        const auto id = in.readString();
+        const auto value = in.readFloat();
+        if (index.contains(id))
+            values[static_cast<size_t>(index[id])] = value;
+    }
+    return values;
+}
+} // namespace StateCodec
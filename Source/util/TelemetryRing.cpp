@@ -0,0 +1,144 @@
+#include "TelemetryRing.h"
+#include <cmath>
+#include <new>
+
+namespace
+{
+constexpr size_t kAlignment = 64;
+
+constexpr size_t alignUp(size_t size)
+{
+    return (size + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+constexpr size_t kHeaderSize = alignUp(sizeof(Telemetry::Header));
+constexpr size_t kSlotSize = alignUp(sizeof(Telemetry::Slot));
+constexpr size_t kFileSize = kHeaderSize + kSlotSize * Telemetry::kSlotCount;
+} // namespace
+
+namespace Telemetry
+{
+void binSpectrum(const float* columnsDb, int numColumns, int validColumns, float columnMinFreq,
+                 float columnMaxFreq, float binMinFreq, float binMaxFreq, int16_t* destBins)
+{
+    const int valid = juce::jlimit(0, numColumns, validColumns);
+    if (valid <= 0 || columnMinFreq <= 0.0f || columnMaxFreq <= columnMinFreq || binMinFreq <= 0.0f
+        || binMaxFreq <= binMinFreq)
+    {
+        std::fill(destBins, destBins + kSpectrumBins, kNoData);
+        return;
+    }
+
+    // Column c spans [c, c + 1) in units of columnsPerLog * log(f / columnMinFreq).
+    const double columnsPerLog = numColumns / std::log(static_cast<double>(columnMaxFreq) / columnMinFreq);
+    const double binLogStep = std::log(static_cast<double>(binMaxFreq) / binMinFreq) / kSpectrumBins;
+    const double binOrigin = columnsPerLog * std::log(static_cast<double>(binMinFreq) / columnMinFreq);
+    const double columnsPerBin = columnsPerLog * binLogStep;
+
+    for (int b = 0; b < kSpectrumBins; ++b)
+    {
+        const double lo = binOrigin + b * columnsPerBin;
+        const double hi = lo + columnsPerBin;
+        if (hi <= 0.0 || lo >= valid)
+        {
+            destBins[b] = kNoData;
+            continue;
+        }
+
+        int first = static_cast<int>(std::floor(lo));
+        int last = static_cast<int>(std::ceil(hi)) - 1;
+        if (last <= first)
+            first = last = static_cast<int>(std::floor(0.5 * (lo + hi)));
+        first = juce::jmax(0, first);
+        last = juce::jmin(valid - 1, last);
+
+        float peak = columnsDb[first];
+        for (int c = first + 1; c <= last; ++c)
+            peak = juce::jmax(peak, columnsDb[c]);
+        destBins[b] = static_cast<int16_t>(juce::jlimit(-32767.0f, 32767.0f, std::round(peak * kCentiDbScale)));
+    }
+}
+} // namespace Telemetry
+
+TelemetryRing::~TelemetryRing()
+{
+    close();
+}
+
+juce::File TelemetryRing::getDefaultDirectory()
+{
+    return juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("EQPro").getChildFile("Telemetry");
+}
+
+bool TelemetryRing::open(const juce::File& target, const juce::String& label)
+{
+    close();
+    if (! target.getParentDirectory().createDirectory())
+        return false;
+
+    // Size the file up front; the mapping cannot grow it.
+    {
+        juce::FileOutputStream out(target);
+        if (! out.openedOk())
+            return false;
+        out.setPosition(0);
+        out.truncate();
+        juce::HeapBlock<char> zeros(kSlotSize, true);
+        out.write(zeros.getData(), kHeaderSize);
+        for (int i = 0; i < Telemetry::kSlotCount; ++i)
+            out.write(zeros.getData(), kSlotSize);
+        out.flush();
+        if (out.getStatus().failed())
+            return false;
+    }
+
+    auto map = std::make_unique<juce::MemoryMappedFile>(target, juce::MemoryMappedFile::readWrite, false);
+    if (map->getData() == nullptr || map->getSize() < kFileSize)
+        return false;
+
+    auto* base = static_cast<char*>(map->getData());
+    auto* newHeader = new (base) Telemetry::Header {};
+    newHeader->magic = Telemetry::kMagic;
+    newHeader->version = Telemetry::kVersion;
+    newHeader->headerSize = static_cast<uint32_t>(kHeaderSize);
+    newHeader->slotSize = static_cast<uint32_t>(kSlotSize);
+    newHeader->slotCount = static_cast<uint32_t>(Telemetry::kSlotCount);
+    newHeader->spectrumBins = static_cast<uint32_t>(Telemetry::kSpectrumBins);
+    label.copyToUTF8(newHeader->label, sizeof(newHeader->label));
+    for (int i = 0; i < Telemetry::kSlotCount; ++i)
+        new (base + kHeaderSize + kSlotSize * static_cast<size_t>(i)) Telemetry::Slot {};
+    newHeader->writeCount.store(0, std::memory_order_release);
+
+    file = target;
+    mapping = std::move(map);
+    header = newHeader;
+    slots = reinterpret_cast<Telemetry::Slot*>(base + kHeaderSize);
+    written = 0;
+    return true;
+}
+
+void TelemetryRing::close()
+{
+    if (mapping == nullptr)
+        return;
+    header = nullptr;
+    slots = nullptr;
+    mapping.reset();
+    file.deleteFile();
+    file = juce::File();
+}
+
+void TelemetryRing::publish(const Telemetry::Record& record) noexcept
+{
+    if (slots == nullptr)
+        return;
+
+    auto* slotBytes = reinterpret_cast<char*>(slots) + kSlotSize * static_cast<size_t>(written % Telemetry::kSlotCount);
+    auto& slot = *reinterpret_cast<Telemetry::Slot*>(slotBytes);
+    const auto start = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(start + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.record = record;
+    slot.sequence.store(start + 2, std::memory_order_release);
+    header->writeCount.store(++written, std::memory_order_release);
+}
@@ -0,0 +1,584 @@
+// EQ engine benchmark suite: EqEngine::process and EQDSP::process throughput over a channel / band /
+// band kind / phase mode / block size / sample rate matrix, linear-phase FIR design time and analyzer
+// curve evaluation. Writes one JSON document (stdout or --out) for comparing builds.
+//
+//   eqpro_bench [--out=<file.json>] [--seconds=<audio seconds per case>] [--full] [--filter=<text>]
+//
+// Default matrix: every phase mode over channels x active bands x band kind at 512 samples / 48 kHz
+// and the default quality (Medium), plus a quality sweep (realtime: oversampling Low=1x..Intensive=16x;
+// linear: FIR length) and a block size x sample rate sweep at 2 channels / 12 static bands. --full
+// runs the whole cartesian product instead (slow). --filter keeps the cases whose name contains the text.
+//
+// Every case uses a fixed-seed noise input and a freshly prepared engine, pre-rolled until the FIRs
+// are installed; only the process() calls are timed. ns_per_sample is per channel sample;
+// realtime_factor is audio time over processing time for the whole block (all channels).
+
+#include <JuceHeader.h>
+#include "../src/dsp/EQDSP.h"
+#include "../src/dsp/EqEngine.h"
+#include "../src/dsp/SnapshotBuilder.h"
+#include "../src/ui/CurveMath.h"
+#include "../src/util/ChannelLayoutUtils.h"
+#include "../src/util/SimdSupport.h"
+#include "../src/util/Version.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr int kChannelCounts[] { 1, 2, 6, 12, 16 };
+constexpr int kActiveBandCounts[] { 0, 4, 12 };
+constexpr int kPhaseModes[] { 0, 1, 2 };
+// linearQuality: Low, Medium, High, Very High, Intensive.
+constexpr int kQualities[] { 0, 1, 2, 3, 4 };
+constexpr int kBlockSizes[] { 32, 64, 128, 256, 512, 1024, 2048 };
+constexpr double kSampleRates[] { 44100.0, 48000.0, 96000.0, 192000.0 };
+constexpr int kCurveWidths[] { 256, 1024, 2048 };
+constexpr int kDefaultBlockSize = 512;
+constexpr double kDefaultSampleRate = 48000.0;
+constexpr int kDefaultQuality = static_cast<int>(eqdsp::kDefaultLinearQuality);
+constexpr double kWarmupSeconds = 0.1;
+constexpr double kFirReadyTimeoutSeconds = 30.0;
+constexpr int kFirRebuilds = 5;
+constexpr int kCurveFrames = 200;
+
+enum class BandKind
+{
+    staticEq,
+    dynamic,
+    harmonic
+};
+
+const char* kindName(BandKind kind)
+{
+    switch (kind)
+    {
+        case BandKind::dynamic: return "dynamic";
+        case BandKind::harmonic: return "harmonic";
+        case BandKind::staticEq: break;
+    }
+    return "static";
+}
+
+struct Case
+{
+    int channels = 2;
+    int activeBands = 12;
+    BandKind kind = BandKind::staticEq;
+    int phaseMode = 0;
+    int quality = kDefaultQuality;
+    int blockSize = kDefaultBlockSize;
+    double sampleRate = kDefaultSampleRate;
+
+    juce::String getName(const char* suite) const
+    {
+        return juce::String(suite) + "/pm" + juce::String(phaseMode) + "/q" + juce::String(quality) + "/ch" + juce::String(channels) + "/b"
+            + juce::String(activeBands) + "/" + kindName(kind) + "/n" + juce::String(blockSize) + "/"
+            + juce::String(juce::roundToInt(sampleRate));
+    }
+
+    // EqEngine oversamples the realtime path by 2^quality; linear modes never oversample.
+    int getOversamplingFactor() const { return phaseMode == 0 ? 1 << quality : 1; }
+};
+
+struct Timing
+{
+    double nsPerSample = 0.0;
+    double realtimeFactor = 0.0;
+    double meanBlockUs = 0.0;
+    double p99BlockUs = 0.0;
+};
+
+// Band k of n: log-spaced 60 Hz..14 kHz, alternating +/-4 dB, shelves at the ends.
+eqdsp::BandSnapshot makeBand(int band, int activeBands, BandKind kind)
+{
+    eqdsp::BandSnapshot b;
+    b.frequencyHz = eqdsp::kDefaultBandFreqs[static_cast<size_t>(band)];
+    b.bypassed = band >= activeBands;
+    b.harmonicBypassed = true;
+    if (b.bypassed)
+        return b;
+    const float position = activeBands > 1 ? static_cast<float>(band) / static_cast<float>(activeBands - 1) : 0.5f;
+    b.frequencyHz = 60.0f * std::pow(2.0f, 7.9f * position);
+    b.gainDb = (band % 2 == 0) ? 4.0f : -4.0f;
+    b.q = 1.0f;
+    b.type = static_cast<int>(band == 0 && activeBands > 2 ? eqdsp::FilterType::lowShelf
+                              : (band == activeBands - 1 && activeBands > 2 ? eqdsp::FilterType::highShelf
+                                                                            : eqdsp::FilterType::bell));
+    if (kind == BandKind::dynamic)
+    {
+        b.dynEnabled = true;
+        b.dynMode = 1;
+        b.dynThresholdDb = -30.0f;
+    }
+    else if (kind == BandKind::harmonic)
+    {
+        b.harmonicBypassed = false;
+        b.oddHarmonicDb = 6.0f;
+        b.evenHarmonicDb = 3.0f;
+    }
+    return b;
+}
+
+eqdsp::ParamSnapshot makeSnapshot(const Case& c)
+{
+    eqdsp::ParamSnapshot snapshot {};
+    snapshot.numChannels = c.channels;
+    snapshot.phaseMode = c.phaseMode;
+    snapshot.linearQuality = c.quality;
+    snapshot.oversampling = c.quality;
+    for (int ch = 0; ch < c.channels; ++ch)
+        for (int band = 0; band < ParamIDs::kBandsPerChannel; ++band)
+            snapshot.bands[ch][band] = makeBand(band, c.activeBands, c.kind);
+    eqdsp::routeBands(snapshot,
+                      ChannelLayoutUtils::getChannelNames(juce::AudioChannelSet::canonicalChannelSet(c.channels)), 0);
+    return snapshot;
+}
+
+// Fixed-seed noise at about -12 dBFS, long enough that blocks do not repeat within a case.
+juce::AudioBuffer<float> makeInput(int channels, int numSamples)
+{
+    juce::AudioBuffer<float> input(channels, numSamples);
+    juce::Random random(0x45515072);
+    for (int ch = 0; ch < channels; ++ch)
+        for (int i = 0; i < numSamples; ++i)
+            input.setSample(ch, i, 0.25f * (2.0f * random.nextFloat() - 1.0f));
+    return input;
+}
+
+// Feeds consecutive input blocks to process(buffer); only process() is timed.
+template <typename Process>
+Timing timeBlocks(const Case& c, double seconds, Process&& process)
+{
+    const int numBlocks = juce::jmax(16, static_cast<int>(seconds * c.sampleRate / c.blockSize));
+    const int warmupBlocks = juce::jmax(4, static_cast<int>(kWarmupSeconds * c.sampleRate / c.blockSize));
+    const auto input = makeInput(c.channels, c.blockSize * juce::jmin(numBlocks, 64));
+    const int inputBlocks = input.getNumSamples() / c.blockSize;
+    juce::AudioBuffer<float> buffer(c.channels, c.blockSize);
+    std::vector<double> blockNs;
+    blockNs.reserve(static_cast<size_t>(numBlocks));
+
+    for (int block = 0; block < warmupBlocks + numBlocks; ++block)
+    {
+        const int offset = (block % inputBlocks) * c.blockSize;
+        for (int ch = 0; ch < c.channels; ++ch)
+            buffer.copyFrom(ch, 0, input, ch, offset, c.blockSize);
+        const auto start = Clock::now();
+        process(buffer);
+        const auto end = Clock::now();
+        if (block >= warmupBlocks)
+            blockNs.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+
+    double total = 0.0;
+    for (const auto ns : blockNs)
+        total += ns;
+    std::sort(blockNs.begin(), blockNs.end());
+    Timing timing;
+    const double samples = static_cast<double>(numBlocks) * c.blockSize;
+    timing.nsPerSample = total / (samples * c.channels);
+    timing.realtimeFactor = (samples / c.sampleRate) / juce::jmax(1.0e-12, total * 1.0e-9);
+    timing.meanBlockUs = total / numBlocks / 1000.0;
+    timing.p99BlockUs = blockNs[static_cast<size_t>(0.99 * (blockNs.size() - 1))] / 1000.0;
+    return timing;
+}
+
+juce::var makeResult(const Case& c, const char* suite, const Timing& timing, int latency)
+{
+    auto* obj = new juce::DynamicObject();
+    obj->setProperty("name", c.getName(suite));
+    obj->setProperty("channels", c.channels);
+    obj->setProperty("active_bands", c.activeBands);
+    obj->setProperty("band_kind", kindName(c.kind));
+    obj->setProperty("phase_mode", c.phaseMode);
+    obj->setProperty("quality", c.quality);
+    obj->setProperty("oversampling", c.getOversamplingFactor());
+    obj->setProperty("block_size", c.blockSize);
+    obj->setProperty("sample_rate", c.sampleRate);
+    obj->setProperty("latency_samples", latency);
+    obj->setProperty("ns_per_sample", timing.nsPerSample);
+    obj->setProperty("realtime_factor", timing.realtimeFactor);
+    obj->setProperty("mean_block_us", timing.meanBlockUs);
+    obj->setProperty("p99_block_us", timing.p99BlockUs);
+    obj->setProperty("block_budget_us", 1.0e6 * c.blockSize / c.sampleRate);
+    return juce::var(obj);
+}
+
+class EngineRunner
+{
+public:
+    explicit EngineRunner(const Case& c)
+        : engine(std::make_unique<eqdsp::EqEngine>()),
+          snapshot(makeSnapshot(c))
+    {
+        engine->prepare(c.sampleRate, c.blockSize, c.channels);
+        for (auto* tap : { &preTap, &postTap, &harmonicTap })
+            tap->prepare(4096, c.sampleRate, 1);
+        meterTap.prepare(c.sampleRate);
+        engine->updateLinearPhase(snapshot, c.sampleRate);
+    }
+
+    // Runs silence until the convolvers use the new FIRs (they install them on their own threads).
+    bool waitForFir(int channels, int blockSize)
+    {
+        juce::AudioBuffer<float> silence(channels, blockSize);
+        const auto deadline = juce::Time::getMillisecondCounterHiRes() + kFirReadyTimeoutSeconds * 1000.0;
+        while (juce::Time::getMillisecondCounterHiRes() < deadline)
+        {
+            silence.clear();
+            process(silence);
+            if (engine->isLinearPhaseReady(channels))
+                return true;
+            juce::Thread::sleep(1);
+        }
+        return false;
+    }
+
+    void process(juce::AudioBuffer<float>& buffer)
+    {
+        engine->process(buffer, snapshot, nullptr, preTap, postTap, harmonicTap, meterTap);
+    }
+
+    int getLatencySamples() const { return engine->getLatencySamples(); }
+
+private:
+    std::unique_ptr<eqdsp::EqEngine> engine;
+    eqdsp::ParamSnapshot snapshot;
+    // The engine always feeds taps; these are never read.
+    eqdsp::AnalyzerTap preTap;
+    eqdsp::AnalyzerTap postTap;
+    eqdsp::AnalyzerTap harmonicTap;
+    eqdsp::MeterTap meterTap;
+};
+
+juce::var runEngineCase(const Case& c, double seconds)
+{
+    EngineRunner runner(c);
+    if (! runner.waitForFir(c.channels, c.blockSize))
+    {
+        std::cerr << c.getName("engine") << ": timed out waiting for the FIR" << std::endl;
+        return {};
+    }
+    const auto timing = timeBlocks(c, seconds, [&runner](juce::AudioBuffer<float>& buffer) { runner.process(buffer); });
+    return makeResult(c, "engine", timing, runner.getLatencySamples());
+}
+
+juce::var runEqDspCase(const Case& c, double seconds)
+{
+    // EQDSP only runs the minimum-phase path; it is set up the way EqEngine feeds it.
+    const auto snapshot = makeSnapshot(c);
+    auto dsp = std::make_unique<eqdsp::EQDSP>();
+    dsp->prepare(c.sampleRate, c.blockSize, c.channels);
+    for (int ch = 0; ch < c.channels; ++ch)
+    {
+        for (int band = 0; band < ParamIDs::kBandsPerChannel; ++band)
+        {
+            const auto& src = snapshot.bands[ch][band];
+            eqdsp::BandParams params;
+            params.frequencyHz = src.frequencyHz;
+            params.gainDb = src.gainDb;
+            params.q = src.q;
+            params.type = static_cast<eqdsp::FilterType>(src.type);
+            params.slopeDb = src.slopeDb;
+            params.bypassed = src.bypassed;
+            params.solo = src.solo;
+            params.mix = src.mix;
+            params.dynamicEnabled = src.dynEnabled;
+            params.dynamicMode = src.dynMode;
+            params.thresholdDb = src.dynThresholdDb;
+            params.attackMs = src.dynAttackMs;
+            params.releaseMs = src.dynReleaseMs;
+            params.autoScale = src.dynAuto;
+            params.useExternalDetector = src.dynExternal;
+            params.oddHarmonicDb = src.oddHarmonicDb;
+            params.mixOdd = src.mixOdd;
+            params.evenHarmonicDb = src.evenHarmonicDb;
+            params.mixEven = src.mixEven;
+            params.harmonicBypassed = src.harmonicBypassed;
+            dsp->updateBandParams(ch, band, params);
+            if (ch == 0)
+                dsp->updateMsBandParams(band, params);
+        }
+    }
+    dsp->setMsTargets(snapshot.msTargets);
+    dsp->setBandChannelMasks(snapshot.bandChannelMasks);
+    juce::AudioBuffer<float> harmonicBuffer(c.channels, c.blockSize);
+    const auto timing = timeBlocks(c, seconds, [&](juce::AudioBuffer<float>& buffer)
+    {
+        dsp->process(buffer, nullptr, &harmonicBuffer);
+    });
+    return makeResult(c, "eqdsp", timing, 0);
+}
+
+// Full FIR rebuilds (updateLinearPhase with a changed band) per phase mode / quality / channel count.
+juce::Array<juce::var> runFirDesign(const juce::String& filter)
+{
+    juce::Array<juce::var> results;
+    for (const int phaseMode : { 1, 2 })
+    {
+        for (int quality = 0; quality <= 4; ++quality)
+        {
+            for (const int channels : { 2, 16 })
+            {
+                Case c;
+                c.channels = channels;
+                c.phaseMode = phaseMode;
+                const auto name = "fir/pm" + juce::String(phaseMode) + "/q" + juce::String(quality) + "/ch"
+                    + juce::String(channels);
+                if (filter.isNotEmpty() && ! name.contains(filter))
+                    continue;
+                auto snapshot = makeSnapshot(c);
+                snapshot.linearQuality = quality;
+                auto engine = std::make_unique<eqdsp::EqEngine>();
+                engine->prepare(c.sampleRate, c.blockSize, channels);
+                double totalMs = 0.0;
+                double worstMs = 0.0;
+                for (int i = 0; i <= kFirRebuilds; ++i)
+                {
+                    // A changed gain forces a full redesign; the first rebuild is warm-up.
+                    snapshot.bands[0][1].gainDb = (i % 2 == 0) ? -4.0f : -3.5f;
+                    const auto start = Clock::now();
+                    engine->updateLinearPhase(snapshot, c.sampleRate);
+                    const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+                    if (i == 0)
+                        continue;
+                    totalMs += ms;
+                    worstMs = juce::jmax(worstMs, ms);
+                }
+                auto* obj = new juce::DynamicObject();
+                obj->setProperty("name", name);
+                obj->setProperty("phase_mode", phaseMode);
+                obj->setProperty("quality", quality);
+                obj->setProperty("channels", channels);
+                obj->setProperty("sample_rate", c.sampleRate);
+                obj->setProperty("latency_samples", engine->getLatencySamples());
+                obj->setProperty("mean_ms", totalMs / kFirRebuilds);
+                obj->setProperty("max_ms", worstMs);
+                results.add(juce::var(obj));
+                std::cerr << name << ": " << juce::String(totalMs / kFirRebuilds, 2) << " ms" << std::endl;
+            }
+        }
+    }
+    return results;
+}
+
+// Analyzer EQ curve: every band's response, band mix, composite product and dB conversion per frame
+// (the editor's worst case, e.g. after a channel switch).
+juce::Array<juce::var> runCurve(const juce::String& filter)
+{
+    juce::Array<juce::var> results;
+    const double sampleRate = kDefaultSampleRate;
+    std::array<CurveMath::BandShape, ParamIDs::kBandsPerChannel> shapes {};
+    for (int band = 0; band < ParamIDs::kBandsPerChannel; ++band)
+    {
+        const auto b = makeBand(band, ParamIDs::kBandsPerChannel, BandKind::staticEq);
+        shapes[static_cast<size_t>(band)] = { b.frequencyHz, b.gainDb, b.q, b.type, b.slopeDb, false };
+    }
+    // Include the slope cascade: a 48 dB/oct high-pass and a 30 dB/oct low-pass.
+    shapes[1] = { 30.0f, 0.0f, 0.707f, static_cast<int>(eqdsp::FilterType::highPass), 48.0f, false };
+    shapes[10] = { 18000.0f, 0.0f, 0.707f, static_cast<int>(eqdsp::FilterType::lowPass), 30.0f, false };
+
+    for (const int width : kCurveWidths)
+    {
+        const auto name = "curve/w" + juce::String(width);
+        if (filter.isNotEmpty() && ! name.contains(filter))
+            continue;
+        std::vector<float> frequencies(static_cast<size_t>(width));
+        for (int i = 0; i < width; ++i)
+            frequencies[static_cast<size_t>(i)] =
+                10.0f * std::pow(2000.0f, static_cast<float>(i) / static_cast<float>(width - 1));
+        std::vector<float> re(static_cast<size_t>(width));
+        std::vector<float> im(static_cast<size_t>(width));
+        std::vector<float> compRe(static_cast<size_t>(width));
+        std::vector<float> compIm(static_cast<size_t>(width));
+        std::vector<float> db(static_cast<size_t>(width));
+        const auto frame = [&]
+        {
+            std::fill(compRe.begin(), compRe.end(), 1.0f);
+            std::fill(compIm.begin(), compIm.end(), 0.0f);
+            for (const auto& shape : shapes)
+            {
+                CurveMath::computeBandResponse(shape, sampleRate, frequencies.data(), width, re.data(), im.data());
+                CurveMath::applyCurveMix(re.data(), im.data(), re.data(), im.data(), 1.0f, width);
+                CurveMath::multiplyCurves(compRe.data(), compIm.data(), re.data(), im.data(), width);
+            }
+            CurveMath::responseToDecibels(compRe.data(), compIm.data(), db.data(), width, -60.0f);
+        };
+        for (int i = 0; i < kCurveFrames / 10; ++i)
+            frame();
+        const auto start = Clock::now();
+        for (int i = 0; i < kCurveFrames; ++i)
+            frame();
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        auto* obj = new juce::DynamicObject();
+        obj->setProperty("name", name);
+        obj->setProperty("width", width);
+        obj->setProperty("bands", ParamIDs::kBandsPerChannel);
+        obj->setProperty("us_per_frame", ns / kCurveFrames / 1000.0);
+        obj->setProperty("ns_per_point", ns / (static_cast<double>(kCurveFrames) * width * ParamIDs::kBandsPerChannel));
+        results.add(juce::var(obj));
+        std::cerr << name << ": " << juce::String(ns / kCurveFrames / 1000.0, 1) << " us/frame" << std::endl;
+    }
+    return results;
+}
+
+std::vector<Case> buildMatrix(bool full)
+{
+    std::vector<Case> cases;
+    const auto addKinds = [&cases](Case c)
+    {
+        // Band kind has no effect without active bands.
+        for (const auto kind : { BandKind::staticEq, BandKind::dynamic, BandKind::harmonic })
+        {
+            if (c.activeBands == 0 && kind != BandKind::staticEq)
+                continue;
+            c.kind = kind;
+            cases.push_back(c);
+        }
+    };
+    for (const int phaseMode : kPhaseModes)
+    {
+        Case c;
+        c.phaseMode = phaseMode;
+        if (full)
+        {
+            for (const int quality : kQualities)
+                for (const double rate : kSampleRates)
+                    for (const int block : kBlockSizes)
+                        for (const int channels : kChannelCounts)
+                            for (const int bands : kActiveBandCounts)
+                            {
+                                c.quality = quality;
+                                c.sampleRate = rate;
+                                c.blockSize = block;
+                                c.channels = channels;
+                                c.activeBands = bands;
+                                addKinds(c);
+                            }
+            continue;
+        }
+        for (const int channels : kChannelCounts)
+            for (const int bands : kActiveBandCounts)
+            {
+                c.channels = channels;
+                c.activeBands = bands;
+                addKinds(c);
+            }
+        c.channels = 2;
+        c.activeBands = ParamIDs::kBandsPerChannel;
+        c.kind = BandKind::staticEq;
+        for (const int quality : kQualities)
+        {
+            // Already covered by the channel / band grid.
+            if (quality == kDefaultQuality)
+                continue;
+            c.quality = quality;
+            cases.push_back(c);
+        }
+        c.quality = kDefaultQuality;
+        for (const double rate : kSampleRates)
+            for (const int block : kBlockSizes)
+            {
+                // Already covered by the channel / band grid.
+                if (rate == kDefaultSampleRate && block == kDefaultBlockSize)
+                    continue;
+                c.sampleRate = rate;
+                c.blockSize = block;
+                cases.push_back(c);
+            }
+    }
+    return cases;
+}
+
+juce::var makeHostInfo(double seconds, bool full)
+{
+    auto* obj = new juce::DynamicObject();
+    obj->setProperty("eqpro_version", Version::versionString());
+    obj->setProperty("juce_version", juce::SystemStats::getJUCEVersion());
+    obj->setProperty("cpu", juce::SystemStats::getCpuModel());
+    obj->setProperty("cpu_mhz", juce::SystemStats::getCpuSpeedInMegahertz());
+    obj->setProperty("cores", juce::SystemStats::getNumPhysicalCpus());
+    obj->setProperty("os", juce::SystemStats::getOperatingSystemName());
+    obj->setProperty("sse2", EQPRO_HAS_SSE2 != 0);
+#if JUCE_DEBUG
+    obj->setProperty("debug_build", true);
+#else
+    obj->setProperty("debug_build", false);
+#endif
+    obj->setProperty("seconds_per_case", seconds);
+    obj->setProperty("full_matrix", full);
+    obj->setProperty("time", juce::Time::getCurrentTime().toISO8601(true));
+    return juce::var(obj);
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    return juce::ConsoleApplication::invokeCatchingFailures([argc, argv]
+    {
+        const juce::ArgumentList args(argc, argv);
+        if (args.containsOption("--help|-h"))
+        {
+            std::cout << "usage: eqpro_bench [--out=<file.json>] [--seconds=<audio seconds per case>] [--full]"
+                         " [--filter=<text>]\n";
+            return 0;
+        }
+        const double seconds = args.containsOption("--seconds")
+            ? juce::jmax(0.01, args.getValueForOption("--seconds").getDoubleValue())
+            : 1.0;
+        const bool full = args.containsOption("--full");
+        const auto filter = args.getValueForOption("--filter");
+
+        juce::Array<juce::var> engineResults;
+        juce::Array<juce::var> eqDspResults;
+        for (const auto& c : buildMatrix(full))
+        {
+            const bool runEngine = filter.isEmpty() || c.getName("engine").contains(filter);
+            // EQDSP is phase-mode and quality independent; it is measured once, alongside the realtime cases.
+            const bool runEqDsp = c.phaseMode == 0 && c.quality == kDefaultQuality && (filter.isEmpty() || c.getName("eqdsp").contains(filter));
+            if (runEngine)
+            {
+                const auto result = runEngineCase(c, seconds);
+                if (! result.isVoid())
+                {
+                    engineResults.add(result);
+                    std::cerr << c.getName("engine") << ": " << juce::String(static_cast<double>(result["ns_per_sample"]), 2)
+                              << " ns/sample, " << juce::String(static_cast<double>(result["realtime_factor"]), 1)
+                              << "x realtime" << std::endl;
+                }
+            }
+            if (runEqDsp)
+            {
+                const auto result = runEqDspCase(c, seconds);
+                eqDspResults.add(result);
+                std::cerr << c.getName("eqdsp") << ": " << juce::String(static_cast<double>(result["ns_per_sample"]), 2)
+                          << " ns/sample" << std::endl;
+            }
+        }
+
+        auto* root = new juce::DynamicObject();
+        root->setProperty("schema", 1);
+        root->setProperty("host", makeHostInfo(seconds, full));
+        root->setProperty("engine", engineResults);
+        root->setProperty("eqdsp", eqDspResults);
+        root->setProperty("fir_design", runFirDesign(filter));
+        root->setProperty("curve", runCurve(filter));
+        const auto json = juce::JSON::toString(juce::var(root));
+
+        if (args.containsOption("--out"))
+        {
+            const auto file = args.getFileForOption("--out");
+            if (! file.replaceWithText(json))
+                juce::ConsoleApplication::fail("cannot write " + file.getFullPathName());
+            std::cerr << "wrote " << file.getFullPathName() << std::endl;
+        }
+        else
+        {
+            std::cout << json << std::endl;
+        }
+        return 0;
+    });
+}
@@ -51,7 +51,8 @@ EQProAudioProcessorEditor::EQProAudioProcessorEditor(EQProAudioProcessor& p)
       analyzer(p),
       bandControls(p),
       spectralPanel(p.getParameters()),
-      correlation(p)
+      correlation(p),
+      diagnostics(p)
 {
     processorRef.logStartup("Editor ctor begin");
     setLookAndFeel(&lookAndFeel);
@@ -71,7 +72,14 @@ EQProAudioProcessorEditor::EQProAudioProcessorEditor(EQProAudioProcessor& p)
     }
     analyzer.setInteractive(true);
     backgroundNoise = makeNoiseImage(128);
-    startTimerHz(2);
+    // One clock for the whole editor, ticked in a fixed order: housekeeping, analyzer, band panel, meters.
+    frameScheduler.addClient(*this, nullptr);
+    frameScheduler.addClient(analyzer, &analyzer);
+    frameScheduler.addClient(bandControls, &bandControls);
+    frameScheduler.addClient(meters, &meters);
+    frameScheduler.addClient(correlation, &correlation);
+    frameScheduler.addClient(diagnostics, &diagnostics);
+    frameScheduler.start();
 
     // v4.4 beta: Uppercase for consistency
     headerLabel.setText("EQ PRO", juce::dontSendNotification);
@@ -92,6 +100,7 @@ EQProAudioProcessorEditor::EQProAudioProcessorEditor(EQProAudioProcessor& p)
     debugButton.onClick = [this]()
     {
         debugVisible = debugButton.getToggleState();
+        resized();
         repaint();
     };
     addAndMakeVisible(debugButton);
@@ -335,6 +344,82 @@ EQProAudioProcessorEditor::EQProAudioProcessorEditor(EQProAudioProcessor& p)
     analyzerViewAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
         processorRef.getParameters(), ParamIDs::analyzerView, analyzerViewBox);
 
+    analyzerSourceLabel.setText("SOURCE", juce::dontSendNotification);
+    analyzerSourceLabel.setJustificationType(juce::Justification::centredLeft);
+    analyzerSourceLabel.setFont(kLabelFontSize);
+    analyzerSourceLabel.setColour(juce::Label::textColourId, juce::Colour(0xffcbd5e1));
+    addAndMakeVisible(analyzerSourceLabel);
+
+    analyzerSourceBox.addItemList(juce::StringArray("SELECTED", "L+R", "MID", "SIDE", "ALL"), 1);
+    analyzerSourceBox.setColour(juce::ComboBox::backgroundColourId, theme.panel);
+    analyzerSourceBox.setColour(juce::ComboBox::textColourId, juce::Colour(0xffe2e8f0));
+    analyzerSourceBox.setColour(juce::ComboBox::outlineColourId, juce::Colour(0xff1f2937));
+    addAndMakeVisible(analyzerSourceBox);
+    analyzerSourceAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        processorRef.getParameters(), ParamIDs::analyzerSource, analyzerSourceBox);
+
+    analyzerOverlapLabel.setText("OVERLAP", juce::dontSendNotification);
+    analyzerOverlapLabel.setJustificationType(juce::Justification::centredLeft);
+    analyzerOverlapLabel.setFont(kLabelFontSize);
+    analyzerOverlapLabel.setColour(juce::Label::textColourId, juce::Colour(0xffcbd5e1));
+    addAndMakeVisible(analyzerOverlapLabel);
+
+    analyzerOverlapBox.addItemList(juce::StringArray("50%", "75%", "87.5%"), 1);
+    analyzerOverlapBox.setColour(juce::ComboBox::backgroundColourId, theme.panel);
+    analyzerOverlapBox.setColour(juce::ComboBox::textColourId, juce::Colour(0xffe2e8f0));
+    analyzerOverlapBox.setColour(juce::ComboBox::outlineColourId, juce::Colour(0xff1f2937));
+    addAndMakeVisible(analyzerOverlapBox);
+    analyzerOverlapAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        processorRef.getParameters(), ParamIDs::analyzerOverlap, analyzerOverlapBox);
+
+    analyzerAveragingLabel.setText("AVERAGE", juce::dontSendNotification);
+    analyzerAveragingLabel.setJustificationType(juce::Justification::centredLeft);
+    analyzerAveragingLabel.setFont(kLabelFontSize);
+    analyzerAveragingLabel.setColour(juce::Label::textColourId, juce::Colour(0xffcbd5e1));
+    addAndMakeVisible(analyzerAveragingLabel);
+
+    analyzerAveragingBox.addItemList(juce::StringArray("EXP", "WELCH"), 1);
+    analyzerAveragingBox.setColour(juce::ComboBox::backgroundColourId, theme.panel);
+    analyzerAveragingBox.setColour(juce::ComboBox::textColourId, juce::Colour(0xffe2e8f0));
+    analyzerAveragingBox.setColour(juce::ComboBox::outlineColourId, juce::Colour(0xff1f2937));
+    addAndMakeVisible(analyzerAveragingBox);
+    analyzerAveragingAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        processorRef.getParameters(), ParamIDs::analyzerAveraging, analyzerAveragingBox);
+
+    analyzerSmoothingLabel.setText("SMOOTH", juce::dontSendNotification);
+    analyzerSmoothingLabel.setJustificationType(juce::Justification::centredLeft);
+    analyzerSmoothingLabel.setFont(kLabelFontSize);
+    analyzerSmoothingLabel.setColour(juce::Label::textColourId, juce::Colour(0xffcbd5e1));
+    addAndMakeVisible(analyzerSmoothingLabel);
+
+    analyzerSmoothingBox.addItemList(juce::StringArray("OFF", "1/24", "1/12", "1/6", "1/3"), 1);
+    analyzerSmoothingBox.setColour(juce::ComboBox::backgroundColourId, theme.panel);
+    analyzerSmoothingBox.setColour(juce::ComboBox::textColourId, juce::Colour(0xffe2e8f0));
+    analyzerSmoothingBox.setColour(juce::ComboBox::outlineColourId, juce::Colour(0xff1f2937));
+    addAndMakeVisible(analyzerSmoothingBox);
+    analyzerSmoothingAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        processorRef.getParameters(), ParamIDs::analyzerSmoothing, analyzerSmoothingBox);
+
+    analyzerResolutionLabel.setText("RESOLUTION", juce::dontSendNotification);
+    analyzerResolutionLabel.setJustificationType(juce::Justification::centredLeft);
+    analyzerResolutionLabel.setFont(kLabelFontSize);
+    analyzerResolutionLabel.setColour(juce::Label::textColourId, juce::Colour(0xffcbd5e1));
+    addAndMakeVisible(analyzerResolutionLabel);
+
+    analyzerResolutionBox.addItemList(juce::StringArray("STANDARD", "MULTI-RES"), 1);
+    analyzerResolutionBox.setColour(juce::ComboBox::backgroundColourId, theme.panel);
+    analyzerResolutionBox.setColour(juce::ComboBox::textColourId, juce::Colour(0xffe2e8f0));
+    analyzerResolutionBox.setColour(juce::ComboBox::outlineColourId, juce::Colour(0xff1f2937));
+    addAndMakeVisible(analyzerResolutionBox);
+    analyzerResolutionAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        processorRef.getParameters(), ParamIDs::analyzerResolution, analyzerResolutionBox);
+
+    analyzerPeakHoldToggle.setButtonText("PEAK HOLD");
+    analyzerPeakHoldToggle.setColour(juce::ToggleButton::textColourId, juce::Colour(0xffcbd5e1));
+    addAndMakeVisible(analyzerPeakHoldToggle);
+    analyzerPeakHoldAttachment = std::make_unique<ButtonAttachment>(
+        processorRef.getParameters(), ParamIDs::analyzerPeakHold, analyzerPeakHoldToggle);
+
     analyzerFreezeToggle.setButtonText("FREEZE");
     analyzerFreezeToggle.setColour(juce::ToggleButton::textColourId, juce::Colour(0xffcbd5e1));
     addAndMakeVisible(analyzerFreezeToggle);
@@ -451,6 +536,7 @@ EQProAudioProcessorEditor::EQProAudioProcessorEditor(EQProAudioProcessor& p)
         spectralPanel.setTheme(newTheme);
         meters.setTheme(newTheme);
         correlation.setTheme(newTheme);
+        diagnostics.setTheme(newTheme);
 
         headerLabel.setColour(juce::Label::textColourId, newTheme.text);
         versionLabel.setColour(juce::Label::textColourId, newTheme.textMuted);
@@ -498,8 +584,10 @@ EQProAudioProcessorEditor::EQProAudioProcessorEditor(EQProAudioProcessor& p)
         snapshotRecallButton.setColour(juce::TextButton::textColourOffId, newTheme.textMuted);
         snapshotStoreButton.setColour(juce::TextButton::textColourOffId, newTheme.textMuted);
         analyzerFreezeToggle.setColour(juce::ToggleButton::textColourId, newTheme.textMuted);
+        analyzerPeakHoldToggle.setColour(juce::ToggleButton::textColourId, newTheme.textMuted);
         analyzerExternalToggle.setColour(juce::ToggleButton::textColourId, newTheme.textMuted);
         smartSoloToggle.setColour(juce::ToggleButton::textColourId, newTheme.textMuted);
+        snapshotMorphToggle.setColour(juce::ToggleButton::textColourId, newTheme.textMuted);
         autoGainToggle.setColour(juce::ToggleButton::textColourId, newTheme.textMuted);
         midiLearnToggle.setColour(juce::ToggleButton::textColourId, newTheme.textMuted);
         phaseInvertToggle.setColour(juce::ToggleButton::textColourId, newTheme.textMuted);
@@ -509,6 +597,7 @@ EQProAudioProcessorEditor::EQProAudioProcessorEditor(EQProAudioProcessor& p)
         globalMixSlider.setColour(juce::Slider::trackColourId, newTheme.accent);
         globalMixSlider.setColour(juce::Slider::textBoxTextColourId, newTheme.text);
         globalMixSlider.setColour(juce::Slider::textBoxOutlineColourId, newTheme.panelOutline);
+        snapshotMorphSlider.setColour(juce::Slider::trackColourId, newTheme.accent);
         // Style toggles to match copy/paste buttons with text inside.
         // Colors are handled by custom LookAndFeel::drawToggleButton method.
         rmsToggle.setColour(juce::ToggleButton::textColourId, newTheme.textMuted);
@@ -551,6 +640,7 @@ EQProAudioProcessorEditor::EQProAudioProcessorEditor(EQProAudioProcessor& p)
         setComboTheme(correlationBox);
         setComboTheme(themeBox);
         setComboTheme(snapshotMenu);
+        setComboTheme(snapshotMorphPairBox);
 
         repaint();
     };
@@ -614,8 +704,7 @@ EQProAudioProcessorEditor::EQProAudioProcessorEditor(EQProAudioProcessor& p)
                 param->setValueNotifyingHost(param->convertTo0to1(value));
         };
 
-        if (auto* undo = processorRef.getUndoManager())
-            undo->beginNewTransaction("Apply Preset");
+        processorRef.beginUndoGesture("Apply Preset");
 
         auto applyPresetToChannel = [&](int ch)
         {
@@ -688,6 +777,7 @@ EQProAudioProcessorEditor::EQProAudioProcessorEditor(EQProAudioProcessor& p)
         {
             applyPresetToChannel(selectedChannel);
         }
+        processorRef.endUndoGesture();
     };
 
     savePresetButton.setButtonText("SAVE");
@@ -696,7 +786,7 @@ EQProAudioProcessorEditor::EQProAudioProcessorEditor(EQProAudioProcessor& p)
     {
         saveChooser = std::make_unique<juce::FileChooser>(
             "Save Preset",
-            juce::File::getSpecialLocation(juce::File::userDocumentsDirectory),
+            PresetLibrary::getDefaultDirectory(),
             "*.xml");
         saveChooser->launchAsync(juce::FileBrowserComponent::saveMode
                                      | juce::FileBrowserComponent::canSelectFiles,
@@ -707,6 +797,7 @@ EQProAudioProcessorEditor::EQProAudioProcessorEditor(EQProAudioProcessor& p)
                                      {
                                          if (auto xml = processorRef.getParameters().copyState().createXml())
                                              xml->writeTo(file, {});
+                                         processorRef.getPresetLibrary().requestRescan();
                                      }
                                      saveChooser.reset();
                                  });
@@ -794,59 +885,25 @@ EQProAudioProcessorEditor::EQProAudioProcessorEditor(EQProAudioProcessor& p)
     refreshPresetsButton.setButtonText("REFRESH");
     addAndMakeVisible(refreshPresetsButton);
 
-    auto refreshPresetBrowser = [this](bool keepSelection)
-    {
-        const auto presetDir = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
-                                   .getChildFile("EQPro")
-                                   .getChildFile("Presets");
-        presetDir.createDirectory();
-
-        const auto files = presetDir.findChildFiles(juce::File::findFiles, false, "*.xml");
-        juce::StringArray favorites;
-        favorites.addTokens(processorRef.getFavoritePresets(), ";", "");
-        favorites.removeEmptyStrings();
-
-        const auto previous = presetBrowserBox.getText();
-        presetBrowserBox.clear();
-        for (const auto& file : files)
-        {
-            const auto name = file.getFileNameWithoutExtension();
-            const bool isFav = favorites.contains(name);
-            presetBrowserBox.addItem((isFav ? "★ " : "") + name, presetBrowserBox.getNumItems() + 1);
-        }
-
-        if (keepSelection && previous.isNotEmpty())
-            presetBrowserBox.setText(previous, juce::dontSendNotification);
-        else if (presetBrowserBox.getNumItems() > 0)
-            presetBrowserBox.setSelectedItemIndex(0, juce::dontSendNotification);
-
-        const auto currentName = presetBrowserBox.getText().trimStart();
-        favoriteToggle.setToggleState(favorites.contains(currentName), juce::dontSendNotification);
-    };
-
-    refreshPresetsButton.onClick = [refreshPresetBrowser]
+    refreshPresetsButton.onClick = [this]
     {
-        refreshPresetBrowser(true);
+        processorRef.getPresetLibrary().requestRescan();
     };
 
-    presetBrowserBox.onChange = [this, refreshPresetBrowser]
+    presetBrowserBox.onChange = [this]
     {
-        const auto presetDir = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
-                                   .getChildFile("EQPro")
-                                   .getChildFile("Presets");
-        const auto name = presetBrowserBox.getText().trimStart();
-        const auto file = presetDir.getChildFile(name + ".xml");
-        if (file.existsAsFile())
-        {
-            if (auto xml = juce::XmlDocument::parse(file))
-                processorRef.getParameters().replaceState(juce::ValueTree::fromXml(*xml));
-        }
-        refreshPresetBrowser(true);
+        const int index = presetBrowserBox.getSelectedId() - 1;
+        if (presetIndex == nullptr || index < 0 || index >= static_cast<int>(presetIndex->size()))
+            return;
+        const auto& preset = (*presetIndex)[static_cast<size_t>(index)];
+        selectedPresetFile = preset.file;
+        processorRef.applyPreset(preset);
+        updateFavoriteToggle();
     };
 
-    favoriteToggle.onClick = [this, refreshPresetBrowser]
+    favoriteToggle.onClick = [this]
     {
-        const auto name = presetBrowserBox.getText().trimStart();
+        const auto name = selectedPresetFile.getFileNameWithoutExtension();
         if (name.isEmpty())
             return;
 
@@ -864,17 +921,20 @@ EQProAudioProcessorEditor::EQProAudioProcessorEditor(EQProAudioProcessor& p)
         }
 
         processorRef.setFavoritePresets(favorites.joinIntoString(";"));
-        refreshPresetBrowser(true);
+        refreshPresetBrowser();
     };
 
-    refreshPresetBrowser(false);
+    // The library indexes on its own thread; the list fills in when the first index is published.
+    auto& presetLibrary = processorRef.getPresetLibrary();
+    presetLibrary.addChangeListener(this);
+    presetLibrary.start(processorRef.getParameters());
+    refreshPresetBrowser();
 
     undoButton.setButtonText("UNDO");
     undoButton.setTooltip("Undo last change");
     undoButton.onClick = [this]
     {
-        if (auto* undo = processorRef.getUndoManager())
-            undo->undo();
+        processorRef.undo();
     };
     addAndMakeVisible(undoButton);
 
@@ -882,8 +942,7 @@ EQProAudioProcessorEditor::EQProAudioProcessorEditor(EQProAudioProcessor& p)
     redoButton.setTooltip("Redo last change");
     redoButton.onClick = [this]
     {
-        if (auto* undo = processorRef.getUndoManager())
-            undo->redo();
+        processorRef.redo();
     };
     addAndMakeVisible(redoButton);
 
@@ -950,31 +1009,38 @@ EQProAudioProcessorEditor::EQProAudioProcessorEditor(EQProAudioProcessor& p)
     snapshotRecallButton.setButtonText("RECALL");
     snapshotRecallButton.onClick = [this]
     {
-        switch (snapshotMenu.getSelectedItemIndex())
-        {
-            case 0: processorRef.recallSnapshotA(); break;
-            case 1: processorRef.recallSnapshotB(); break;
-            case 2: processorRef.recallSnapshotC(); break;
-            case 3: processorRef.recallSnapshotD(); break;
-            default: break;
-        }
+        processorRef.recallSnapshot(snapshotMenu.getSelectedItemIndex());
     };
     addAndMakeVisible(snapshotRecallButton);
 
     snapshotStoreButton.setButtonText("Store");
     snapshotStoreButton.onClick = [this]
     {
-        switch (snapshotMenu.getSelectedItemIndex())
-        {
-            case 0: processorRef.storeSnapshotA(); break;
-            case 1: processorRef.storeSnapshotB(); break;
-            case 2: processorRef.storeSnapshotC(); break;
-            case 3: processorRef.storeSnapshotD(); break;
-            default: break;
-        }
+        processorRef.storeSnapshot(snapshotMenu.getSelectedItemIndex());
     };
     addAndMakeVisible(snapshotStoreButton);
 
+    snapshotMorphPairBox.addItemList(juce::StringArray("A-B", "A-C", "A-D", "B-C", "B-D", "C-D"), 1);
+    snapshotMorphPairBox.setTooltip("Snapshot pair to morph between");
+    addAndMakeVisible(snapshotMorphPairBox);
+    snapshotMorphPairAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        processorRef.getParameters(), ParamIDs::snapshotMorphPair, snapshotMorphPairBox);
+
+    snapshotMorphSlider.setSliderStyle(juce::Slider::LinearHorizontal);
+    snapshotMorphSlider.setTextBoxStyle(juce::Slider::NoTextBox, false, 0, 0);
+    snapshotMorphSlider.setTextValueSuffix(" %");
+    snapshotMorphSlider.setTooltip("Morph band settings from the pair's first snapshot (0 %) to its second (100 %)");
+    addAndMakeVisible(snapshotMorphSlider);
+    snapshotMorphAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
+        processorRef.getParameters(), ParamIDs::snapshotMorph, snapshotMorphSlider);
+
+    snapshotMorphToggle.setButtonText("MORPH");
+    snapshotMorphToggle.setTooltip("Play the snapshot morph instead of the live bands (band editing is locked meanwhile)");
+    snapshotMorphToggle.setColour(juce::ToggleButton::textColourId, juce::Colour(0xffcbd5e1));
+    addAndMakeVisible(snapshotMorphToggle);
+    snapshotMorphOnAttachment = std::make_unique<ButtonAttachment>(
+        processorRef.getParameters(), ParamIDs::snapshotMorphOn, snapshotMorphToggle);
+
     correlationLabel.setText("GONIO", juce::dontSendNotification);
     correlationLabel.setJustificationType(juce::Justification::centredLeft);
     correlationLabel.setFont(kLabelFontSize);
@@ -1057,6 +1123,7 @@ EQProAudioProcessorEditor::EQProAudioProcessorEditor(EQProAudioProcessor& p)
     addAndMakeVisible(bandControls);
     addAndMakeVisible(spectralPanel);
     addAndMakeVisible(correlation);
+    addChildComponent(diagnostics);
 
     // Hide advanced panels until collapsible UI is added.
     presetSectionLabel.setVisible(false);
@@ -1138,17 +1205,71 @@ EQProAudioProcessorEditor::EQProAudioProcessorEditor(EQProAudioProcessor& p)
 EQProAudioProcessorEditor::~EQProAudioProcessorEditor()
 {
     processorRef.logStartup("Editor dtor begin");
+    processorRef.getPresetLibrary().removeChangeListener(this);
+    frameScheduler.stop();
     openGLContext.detach();
     setLookAndFeel(nullptr);
     processorRef.logStartup("Editor dtor end");
 }
 
+void EQProAudioProcessorEditor::changeListenerCallback(juce::ChangeBroadcaster*)
+{
+    refreshPresetBrowser();
+}
+
+void EQProAudioProcessorEditor::refreshPresetBrowser()
+{
+    // Built from the library's cached index only: no file system access or parsing here.
+    presetIndex = processorRef.getPresetLibrary().getIndex();
+    juce::StringArray favorites;
+    favorites.addTokens(processorRef.getFavoritePresets(), ";", "");
+    favorites.removeEmptyStrings();
+
+    presetBrowserBox.clear(juce::dontSendNotification);
+    auto* menu = presetBrowserBox.getRootMenu();
+    int selectedId = 0;
+    const auto thumbnailColour = findColour(juce::ComboBox::textColourId);
+    for (size_t i = 0; i < presetIndex->size(); ++i)
+    {
+        const auto& preset = (*presetIndex)[i];
+        const int itemId = static_cast<int>(i) + 1;
+        juce::PopupMenu::Item item((favorites.contains(preset.name) ? "★ " : "") + preset.name);
+        item.itemID = itemId;
+        item.shortcutKeyDescription = preset.tags.joinIntoString(", ");
+        auto thumbnail = std::make_unique<juce::DrawablePath>();
+        thumbnail->setPath(PresetLibrary::makeThumbnailPath(preset, { 0.0f, 0.0f, 48.0f, 16.0f }, 18.0f));
+        thumbnail->setFill(juce::Colours::transparentBlack);
+        thumbnail->setStrokeFill(thumbnailColour);
+        thumbnail->setStrokeThickness(1.2f);
+        item.image = std::move(thumbnail);
+        menu->addItem(std::move(item));
+        if (preset.file == selectedPresetFile)
+            selectedId = itemId;
+    }
+
+    if (selectedId != 0)
+        presetBrowserBox.setSelectedId(selectedId, juce::dontSendNotification);
+    else if (! presetIndex->empty() && selectedPresetFile == juce::File())
+        presetBrowserBox.setSelectedId(1, juce::dontSendNotification);
+    if (const int index = presetBrowserBox.getSelectedId() - 1; index >= 0)
+        selectedPresetFile = (*presetIndex)[static_cast<size_t>(index)].file;
+    updateFavoriteToggle();
+}
+
+void EQProAudioProcessorEditor::updateFavoriteToggle()
+{
+    juce::StringArray favorites;
+    favorites.addTokens(processorRef.getFavoritePresets(), ";", "");
+    const auto name = selectedPresetFile.getFileNameWithoutExtension();
+    favoriteToggle.setToggleState(name.isNotEmpty() && favorites.contains(name), juce::dontSendNotification);
+}
+
 bool EQProAudioProcessorEditor::syncToHostBounds()
 {
     return false;
 }
 
-void EQProAudioProcessorEditor::timerCallback()
+juce::Rectangle<int> EQProAudioProcessorEditor::frameTick()
 {
     if (pendingWindowRescue)
     {
@@ -1182,6 +1303,15 @@ void EQProAudioProcessorEditor::timerCallback()
     }
     
     refreshChannelLayout();
+
+    const bool morphActive = processorRef.isSnapshotMorphActive();
+    if (morphActive != bandEditingLocked)
+    {
+        bandEditingLocked = morphActive;
+        bandControls.setEnabled(! morphActive);
+        analyzer.setBandEditingLocked(morphActive);
+    }
+    return {};
 }
 
 void EQProAudioProcessorEditor::refreshChannelLayout()
@@ -1332,7 +1462,7 @@ void EQProAudioProcessorEditor::paint(juce::Graphics& g)
         g.setColour(theme.panelOutline);
         g.drawRoundedRectangle(debugPanelBounds.toFloat(), 6.0f, 1.0f);
 
-        auto textArea = debugPanelBounds.reduced(8).withTrimmedTop(26);
+        auto textArea = debugPanelBounds.reduced(8).withTrimmedTop(26).withRight(diagnostics.getX() - 8);
         g.setColour(theme.text);
         g.setFont(13.0f);
         g.drawFittedText(getDebugText(), textArea, juce::Justification::topLeft, 10);
@@ -1347,6 +1477,7 @@ bool EQProAudioProcessorEditor::keyPressed(const juce::KeyPress& key)
     {
         debugVisible = ! debugVisible;
         debugButton.setToggleState(debugVisible, juce::dontSendNotification);
+        resized();
         repaint();
         return true;
     }
@@ -1375,7 +1506,9 @@ juce::String EQProAudioProcessorEditor::getDebugText() const
             + juce::String(processorRef.getLastProcessBand0GainDb(), 2) + " dB "
             + (processorRef.getLastProcessBand0Bypassed() ? "BYP" : "ON") + "\n"
         "Analyzer: " + juce::String(analyzer.getTimerHz()) + " Hz\n"
-        "OpenGL: " + juce::String(openGLContext.isAttached() ? "On" : "Off");
+        "OpenGL: " + juce::String(openGLContext.isAttached() ? "On" : "Off") + "\n"
+        "Telemetry: " + (processorRef.getTelemetryFile() == juce::File() ? juce::String("Off")
+                                                                          : processorRef.getTelemetryFile().getFullPathName());
 }
 
 void EQProAudioProcessorEditor::resized()
@@ -1387,12 +1520,15 @@ void EQProAudioProcessorEditor::resized()
 
     debugPanelBounds = {};
     debugCopyButton.setVisible(debugVisible);
-    debugCopyButton.setVisible(debugVisible);
+    diagnostics.setVisible(debugVisible);
     if (debugVisible)
     {
-        const int debugHeight = static_cast<int>(130 * uiScale);
+        const int debugHeight = static_cast<int>(200 * uiScale);
         auto debugArea = bounds.removeFromBottom(debugHeight);
         debugPanelBounds = debugArea.reduced(static_cast<int>(10 * uiScale));
+        // Stage profiler on the right, debug text on the left.
+        diagnostics.setBounds(debugPanelBounds.reduced(8).withTrimmedTop(26).withTrimmedLeft(
+            juce::jmin(static_cast<int>(300 * uiScale), debugPanelBounds.getWidth() / 3)));
         auto debugRow = debugPanelBounds.reduced(8).removeFromTop(static_cast<int>(22 * uiScale));
         const int copyW = static_cast<int>(58 * uiScale);
         debugCopyButton.setBounds(debugRow.removeFromRight(copyW)
@@ -1510,6 +1646,22 @@ void EQProAudioProcessorEditor::resized()
         qualityLabel.getFont().getStringWidthFloat(qualityLabel.getText()) + 10 * uiScale);
     qualityLabel.setBounds(processingRow.removeFromLeft(qualityLabelWidth));
     linearQualityBox.setBounds(processingRow.removeFromLeft(static_cast<int>(120 * uiScale)));
+    processingRow.removeFromLeft(static_cast<int>(12 * uiScale));
+    const int snapshotLabelWidth = static_cast<int>(
+        snapshotSectionLabel.getFont().getStringWidthFloat(snapshotSectionLabel.getText()) + 8 * uiScale);
+    snapshotSectionLabel.setBounds(processingRow.removeFromLeft(snapshotLabelWidth));
+    snapshotMenu.setBounds(processingRow.removeFromLeft(static_cast<int>(96 * uiScale)));
+    processingRow.removeFromLeft(navGap);
+    snapshotRecallButton.setBounds(processingRow.removeFromLeft(navW).withSizeKeepingCentre(navW, navH));
+    processingRow.removeFromLeft(navGap);
+    snapshotStoreButton.setBounds(processingRow.removeFromLeft(navW).withSizeKeepingCentre(navW, navH));
+    processingRow.removeFromLeft(static_cast<int>(10 * uiScale));
+    snapshotMorphPairBox.setBounds(processingRow.removeFromLeft(static_cast<int>(64 * uiScale)));
+    processingRow.removeFromLeft(navGap);
+    snapshotMorphToggle.setBounds(processingRow.removeFromLeft(static_cast<int>(72 * uiScale)));
+    processingRow.removeFromLeft(navGap);
+    snapshotMorphSlider.setBounds(processingRow.removeFromLeft(
+        juce::jmin(processingRow.getWidth(), static_cast<int>(140 * uiScale))));
     const auto bandArea = controlsArea.reduced(static_cast<int>(6 * uiScale), 0);
     bandBounds = bandArea;
     bandControls.setBounds(bandArea);
@@ -1547,6 +1699,17 @@ void EQProAudioProcessorEditor::resized()
     analyzerSpeedBox.setBounds({0, 0, 0, 0});
     analyzerViewLabel.setBounds({0, 0, 0, 0});
     analyzerViewBox.setBounds({0, 0, 0, 0});
+    analyzerSourceLabel.setBounds({0, 0, 0, 0});
+    analyzerSourceBox.setBounds({0, 0, 0, 0});
+    analyzerOverlapLabel.setBounds({0, 0, 0, 0});
+    analyzerOverlapBox.setBounds({0, 0, 0, 0});
+    analyzerAveragingLabel.setBounds({0, 0, 0, 0});
+    analyzerAveragingBox.setBounds({0, 0, 0, 0});
+    analyzerSmoothingLabel.setBounds({0, 0, 0, 0});
+    analyzerSmoothingBox.setBounds({0, 0, 0, 0});
+    analyzerResolutionLabel.setBounds({0, 0, 0, 0});
+    analyzerResolutionBox.setBounds({0, 0, 0, 0});
+    analyzerPeakHoldToggle.setBounds({0, 0, 0, 0});
     analyzerFreezeToggle.setBounds({0, 0, 0, 0});
     analyzerExternalToggle.setBounds({0, 0, 0, 0});
     smartSoloToggle.setBounds({0, 0, 0, 0});
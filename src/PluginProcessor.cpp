@@ -1,12 +1,16 @@
 #include "PluginProcessor.h"
+#include "dsp/SnapshotBuilder.h"
 #include "util/ParamIDs.h"
 #include "util/ChannelLayoutUtils.h"
 #include "util/Version.h"
+#include "util/StateCodec.h"
+#include "util/AsyncLog.h"
 
 // Audio processor implementation: parameters, DSP orchestration, and state I/O.
 #include <cmath>
 #include <complex>
 #include <cstring>
+#include <limits>
 
 namespace
 {
@@ -88,53 +92,41 @@ const juce::StringArray kMsChoices {
     "Side Top Middle"
 };
 
-constexpr std::array<float, ParamIDs::kBandsPerChannel> kDefaultBandFreqs {
-    20.0f, 40.0f, 80.0f, 160.0f, 320.0f, 640.0f,
-    1250.0f, 2500.0f, 5000.0f, 10000.0f, 16000.0f, 24000.0f
-};
+const std::array<juce::Identifier, 4> kSnapshotSlotProperties { "snapshotA", "snapshotB", "snapshotC", "snapshotD" };
+// Slot pairs of the snapshotMorphPair choices.
+constexpr std::array<std::pair<int, int>, 6> kMorphPairs { { { 0, 1 }, { 0, 2 }, { 0, 3 }, { 1, 2 }, { 1, 3 }, { 2, 3 } } };
 
-enum MsChoiceIndex
-{
-    kMsAll = 0,
-    kMsStereoFront,
-    kMsLeft,
-    kMsRight,
-    kMsMidFront,
-    kMsSideFront,
-    kMsCentre,
-    kMsLfe,
-    kMsStereoRear,
-    kMsLs,
-    kMsRs,
-    kMsMidRear,
-    kMsSideRear,
-    kMsStereoLateral,
-    kMsLrs,
-    kMsRrs,
-    kMsMidLateral,
-    kMsSideLateral,
-    kMsCs,
-    kMsStereoFrontWide,
-    kMsLw,
-    kMsRw,
-    kMsMidFrontWide,
-    kMsSideFrontWide,
-    kMsStereoTopFront,
-    kMsTfl,
-    kMsTfr,
-    kMsMidTopFront,
-    kMsSideTopFront,
-    kMsStereoTopRear,
-    kMsTrl,
-    kMsTrr,
-    kMsMidTopRear,
-    kMsSideTopRear,
-    kMsStereoTopMiddle,
-    kMsTml,
-    kMsTmr,
-    kMsMidTopMiddle,
-    kMsSideTopMiddle
-};
+// Blends two bands at position t (0 = a, 1 = b): frequency and Q geometrically, gains in dB and the
+// other continuous values linearly; switches (type, slope, routing, enables) flip at the midpoint.
+// A band active on one side only keeps that side's shape and fades in through its band mix.
+eqdsp::BandSnapshot morphBand(const eqdsp::BandSnapshot& a, const eqdsp::BandSnapshot& b, float t)
+{
+    if (a.bypassed != b.bypassed)
+    {
+        auto out = a.bypassed ? b : a;
+        out.mix *= a.bypassed ? t : 1.0f - t;
+        return out;
+    }
+
+    const auto lerp = [t](float from, float to) { return from + (to - from) * t; };
+    const auto logLerp = [t](float from, float to)
+    {
+        return (from > 0.0f && to > 0.0f) ? from * std::pow(to / from, t) : (t < 0.5f ? from : to);
+    };
+    auto out = t < 0.5f ? a : b;
+    out.frequencyHz = logLerp(a.frequencyHz, b.frequencyHz);
+    out.q = logLerp(a.q, b.q);
+    out.gainDb = lerp(a.gainDb, b.gainDb);
+    out.mix = lerp(a.mix, b.mix);
+    out.dynThresholdDb = lerp(a.dynThresholdDb, b.dynThresholdDb);
+    out.dynAttackMs = lerp(a.dynAttackMs, b.dynAttackMs);
+    out.dynReleaseMs = lerp(a.dynReleaseMs, b.dynReleaseMs);
+    out.oddHarmonicDb = lerp(a.oddHarmonicDb, b.oddHarmonicDb);
+    out.mixOdd = lerp(a.mixOdd, b.mixOdd);
+    out.evenHarmonicDb = lerp(a.evenHarmonicDb, b.evenHarmonicDb);
+    out.mixEven = lerp(a.mixEven, b.mixEven);
+    return out;
+}
 
 
 const juce::StringArray kPhaseModeChoices {
@@ -181,46 +173,34 @@ juce::File makeLogFile()
     return getLogDirectory().getChildFile(name);
 }
 
-std::atomic<int> gLoggerUsers { 0 };
-std::unique_ptr<juce::FileLogger> gSharedLogger;
-juce::File gSharedLogFile;
-juce::CriticalSection gLoggerLock;
 std::atomic<bool> gCrashHandlerInstalled { false };
 
 void crashHandler(void*)
 {
-    if (auto* logger = juce::Logger::getCurrentLogger())
-    {
-        logger->writeToLog("CRASH: " + juce::SystemStats::getStackBacktrace());
-    }
+    if (AsyncLog::isRunning())
+        AsyncLog::writeNow("CRASH: " + juce::SystemStats::getStackBacktrace());
 }
 
+// Log lines are queued and written by the AsyncLog writer thread; nothing here touches the disk on
+// the calling thread.
 void startSharedLogger()
 {
-    const juce::ScopedLock lock(gLoggerLock);
-    if (gLoggerUsers.fetch_add(1) == 0)
-    {
-        gSharedLogFile = makeLogFile();
-        gSharedLogger = std::make_unique<juce::FileLogger>(gSharedLogFile, "EQ Pro log", 0);
-        juce::Logger::setCurrentLogger(gSharedLogger.get());
-        juce::Logger::writeToLog("Log file: " + gSharedLogFile.getFullPathName());
-        juce::Logger::writeToLog("Version: " + Version::displayString());
-        juce::Logger::writeToLog("Logger bootstrap: module load.");
-        if (! gCrashHandlerInstalled.exchange(true))
-            juce::SystemStats::setApplicationCrashHandler(crashHandler);
-    }
+    const bool first = ! AsyncLog::isRunning();
+    const auto file = first ? makeLogFile() : AsyncLog::getFile();
+    AsyncLog::start(file);
+    if (! first)
+        return;
+    AsyncLog::post(AsyncLog::Event::text, "Log file: " + file.getFullPathName());
+    AsyncLog::post(AsyncLog::Event::text, "Version: " + Version::displayString());
+    AsyncLog::post(AsyncLog::Event::text, "Logger bootstrap: module load.");
+    if (! gCrashHandlerInstalled.exchange(true))
+        juce::SystemStats::setApplicationCrashHandler(crashHandler);
 }
 
 void stopSharedLogger()
 {
-    const juce::ScopedLock lock(gLoggerLock);
-    if (gLoggerUsers.fetch_sub(1) == 1)
-    {
-        juce::Logger::writeToLog("Log closed.");
-        juce::Logger::setCurrentLogger(nullptr);
-        gSharedLogger.reset();
-        gSharedLogFile = juce::File();
-    }
+    AsyncLog::post(AsyncLog::Event::text, "Log closed.");
+    AsyncLog::stop();
 }
 
 struct LoggerBootstrap
@@ -270,7 +250,7 @@ EQProAudioProcessor::EQProAudioProcessor()
                          .withInput("Input", juce::AudioChannelSet::stereo(), true)
                          .withInput("Sidechain", juce::AudioChannelSet::stereo(), false)
                          .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
-      parameters(*this, &undoManager, "PARAMETERS", createParameterLayout())
+      parameters(*this, nullptr, "PARAMETERS", createParameterLayout())
 {
     initLogging();
     logStartup("EQProAudioProcessor ctor");
@@ -284,9 +264,40 @@ EQProAudioProcessor::EQProAudioProcessor()
     bandVerifyLogFile = juce::File::getSpecialLocation(juce::File::tempDirectory)
                             .getChildFile("EQPro_band_verify.log");
     if (verifyBands)
+    {
         bandVerifyLogFile.deleteFile();
+        AsyncLog::setMirrorFile(AsyncLog::Event::bandVerify, bandVerifyLogFile);
+    }
 
     initializeParamPointers();
+    eqEngine.setProfiler(&profiler);
+    history.reset(captureParameterValues());
+    const int undoLimitKb =
+        juce::SystemStats::getEnvironmentVariable("EQPRO_UNDO_MEMORY_KB", "0").getIntValue();
+    if (undoLimitKb > 0)
+        history.setMemoryLimit(static_cast<size_t>(undoLimitKb) * 1024u);
+    addListener(this);
+
+    analyzerWorker = std::make_unique<AnalyzerWorker>(analyzerPreTap.getFifo(), analyzerPostTap.getFifo(),
+                                                      analyzerHarmonicTap.getFifo(), analyzerExternalTap.getFifo());
+    if (juce::SystemStats::getEnvironmentVariable("EQPRO_TELEMETRY", "0").getIntValue() != 0)
+    {
+        const auto dirOverride = juce::SystemStats::getEnvironmentVariable("EQPRO_TELEMETRY_DIR", {});
+        const auto dir = dirOverride.isNotEmpty() ? juce::File(dirOverride) : TelemetryRing::getDefaultDirectory();
+        const auto label = "EQ Pro " + Version::versionString() + " @ "
+            + juce::PluginHostType().getHostDescription();
+        if (telemetryRing.open(dir.getChildFile(juce::Uuid().toString() + ".eqtm"), label))
+        {
+            analyzerWorker->setFrameSink(this);
+            analyzerWorker->retain();
+            logStartup("Telemetry: " + telemetryRing.getFile().getFullPathName());
+        }
+        else
+        {
+            logStartup("Telemetry: failed to open ring in " + dir.getFullPathName());
+        }
+    }
+
     logStartup("Processor init done");
     startTimerHz(10);
 }
@@ -294,7 +305,15 @@ EQProAudioProcessor::EQProAudioProcessor()
 EQProAudioProcessor::~EQProAudioProcessor()
 {
     stopTimer();
+    removeListener(this);
+    // Stop the worker before the ring it publishes into goes away.
+    analyzerWorker->setFrameSink(nullptr);
+    analyzerWorker.reset();
+    telemetryRing.close();
     linearPhasePool.removeAllJobs(true, 2000);
+    // Keep the evidence when a session missed deadlines.
+    if (profiler.getReport().overruns > 0)
+        logStartup("Profile: " + dumpProfile().getFullPathName());
     logStartup("Processor dtor");
     shutdownLogging();
 }
@@ -314,15 +333,17 @@ void EQProAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
     const int channelCount = juce::jmax(getTotalNumInputChannels(), getTotalNumOutputChannels());
     eqEngine.prepare(sampleRate, samplesPerBlock, channelCount);
     meterTap.prepare(sampleRate);
+    governor.prepare(sampleRate, samplesPerBlock);
     lastSampleRate = sampleRate;
+    telemetrySampleRate.store(sampleRate, std::memory_order_relaxed);
     lastMaxBlockSize = samplesPerBlock;
     constexpr int analyzerBufferSize = 16384;
-    analyzerPreTap.prepare(analyzerBufferSize);
-    analyzerPostTap.prepare(analyzerBufferSize);
-    analyzerHarmonicTap.prepare(analyzerBufferSize);  // v4.5 beta: Tap for program + harmonics (red curve)
-    analyzerExternalTap.prepare(analyzerBufferSize);
+    analyzerPreTap.prepare(analyzerBufferSize, sampleRate, channelCount);
+    analyzerPostTap.prepare(analyzerBufferSize, sampleRate, channelCount);
+    analyzerHarmonicTap.prepare(analyzerBufferSize, sampleRate, channelCount);  // v4.5 beta: Tap for program + harmonics (red curve)
+    analyzerExternalTap.prepare(analyzerBufferSize, sampleRate, 1);
 
-    cachedChannelNames = getCurrentChannelNames();
+    refreshChannelNames();
     lastSnapshotHash = buildSnapshot(snapshots[0]);
     activeSnapshot.store(0);
 }
@@ -362,7 +383,7 @@ void EQProAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
 {
     // Critical path: process audio on the realtime thread.
     juce::ScopedNoDenormals noDenormals;
-    const auto startTicks = juce::Time::getHighResolutionTicks();
+    profiler.beginBlock(buffer.getNumSamples(), lastSampleRate);
 
     const auto numChannels = juce::jmin(buffer.getNumChannels(), ParamIDs::kMaxChannels);
 
@@ -413,6 +434,16 @@ void EQProAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
         meterTap.setCorrelationPair(pair.first, pair.second);
     }
 
+    // Analyzer source follows the parameter; "Selected" tracks the editor's channel.
+    {
+        const int sourceIndex = analyzerSourceParam != nullptr ? static_cast<int>(analyzerSourceParam->load()) : 0;
+        const auto source = static_cast<eqdsp::AnalyzerTap::Source>(juce::jlimit(0, 4, sourceIndex));
+        const int channel = selectedChannelIndex.load();
+        analyzerPreTap.setSource(source, channel);
+        analyzerPostTap.setSource(source, channel);
+        analyzerHarmonicTap.setSource(source, channel);
+    }
+
     auto updateProcessDebug = [this](const eqdsp::ParamSnapshot& snapshot)
     {
         lastProcessPhaseMode.store(snapshot.phaseMode, std::memory_order_relaxed);
@@ -433,7 +464,10 @@ void EQProAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     {
         // Realtime mode: build a fresh snapshot so DSP always responds to UI edits.
         eqdsp::ParamSnapshot realtimeSnapshot {};
-        buildSnapshot(realtimeSnapshot);
+        {
+            const StageProfiler::Scope scope(&profiler, StageProfiler::snapshot);
+            buildSnapshot(realtimeSnapshot);
+        }
         updateProcessDebug(realtimeSnapshot);
         eqEngine.process(buffer, realtimeSnapshot, detectorBuffer, analyzerPreTap, analyzerPostTap,
                          analyzerHarmonicTap, meterTap);
@@ -447,59 +481,34 @@ void EQProAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                          analyzerHarmonicTap, meterTap);
     }
 
-    if (livePhaseMode != 0 && lastSampleRate > 0.0)
+    if (analyzerExternalParam != nullptr && analyzerExternalParam->load() > 0.5f && detectorBuffer != nullptr
+        && detectorBuffer->getNumChannels() > 0)
     {
-        // Adaptive quality: reduce linear FIR load during CPU pressure, recover when stable.
-        const auto endTicks = juce::Time::getHighResolutionTicks();
-        const double elapsedSeconds = juce::Time::highResolutionTicksToSeconds(endTicks - startTicks);
-        const double blockSeconds = static_cast<double>(buffer.getNumSamples()) / lastSampleRate;
-        if (blockSeconds > 0.0)
-        {
-            const double ratio = elapsedSeconds / blockSeconds;
-            if (ratio > 0.90)
-            {
-                ++cpuOverloadCounter;
-                cpuRecoverCounter = 0;
-            }
-            else if (ratio < 0.60)
-            {
-                ++cpuRecoverCounter;
-                cpuOverloadCounter = 0;
-            }
+        const StageProfiler::Scope scope(&profiler, StageProfiler::taps);
+        analyzerExternalTap.push(detectorBuffer->getReadPointer(0), detectorBuffer->getNumSamples());
+    }
+    profiler.endBlock();
 
-            int currentOffset = adaptiveQualityOffset.load();
-            if (cpuOverloadCounter >= 3 && currentOffset > -2)
-            {
-                currentOffset -= 1;
-                adaptiveQualityOffset.store(currentOffset);
-                pendingAdaptiveQualityLog.store(currentOffset);
-                cpuOverloadCounter = 0;
-            }
-            else if (cpuRecoverCounter >= 8 && currentOffset < 0)
-            {
-                currentOffset += 1;
-                adaptiveQualityOffset.store(currentOffset);
-                pendingAdaptiveQualityLog.store(currentOffset);
-                cpuRecoverCounter = 0;
-            }
-            eqEngine.setAdaptiveQualityOffset(currentOffset);
-        }
+    // CPU governor: predict the next block's load from the stage costs, shed or restore features.
+    eqdsp::CpuGovernor::Context governorContext;
+    governorContext.phaseMode = livePhaseMode;
+    governorContext.oversamplingIndex = eqEngine.getOversamplingIndex();
+    if (governor.update(profiler, buffer.getNumSamples(), governorContext))
+    {
+        const auto& output = governor.getOutput();
+        for (auto* tap : { &analyzerPreTap, &analyzerPostTap, &analyzerHarmonicTap, &analyzerExternalTap })
+            tap->setBlockStride(output.analyzerStride);
+        meterTap.setTruePeakAllowed(output.truePeak);
+        eqEngine.setOversamplingCap(output.oversamplingCap);
     }
-    else
+    // The FIR length steps only apply in the linear modes; the timer schedules the rebuild.
+    const int qualityOffset = livePhaseMode != 0 ? governor.getOutput().firOffset : 0;
+    if (adaptiveQualityOffset.load() != qualityOffset)
     {
-        if (adaptiveQualityOffset.load() != 0)
-        {
-            adaptiveQualityOffset.store(0);
-            pendingAdaptiveQualityLog.store(0);
-            eqEngine.setAdaptiveQualityOffset(0);
-        }
-        cpuOverloadCounter = 0;
-        cpuRecoverCounter = 0;
+        adaptiveQualityOffset.store(qualityOffset);
+        pendingAdaptiveQualityLog.store(qualityOffset);
+        eqEngine.setAdaptiveQualityOffset(qualityOffset);
     }
-
-    if (analyzerExternalParam != nullptr && analyzerExternalParam->load() > 0.5f && detectorBuffer != nullptr
-        && detectorBuffer->getNumChannels() > 0)
-        analyzerExternalTap.push(detectorBuffer->getReadPointer(0), detectorBuffer->getNumSamples());
 }
 
 bool EQProAudioProcessor::hasEditor() const
@@ -563,17 +572,21 @@ void EQProAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
     parameters.state.setProperty("showPhase", showPhasePreference, nullptr);
     parameters.state.setProperty("presetSelection", presetSelection, nullptr);
     parameters.state.setProperty("presetApplyTarget", presetApplyTarget, nullptr);
-    parameters.state.setProperty("snapshotA", snapshotA, nullptr);
-    parameters.state.setProperty("snapshotB", snapshotB, nullptr);
-    parameters.state.setProperty("snapshotC", snapshotC, nullptr);
-    parameters.state.setProperty("snapshotD", snapshotD, nullptr);
+    for (int slot = 0; slot < kNumSnapshotSlots; ++slot)
+        writeSnapshotProperty(slot);
     parameters.state.setProperty("darkTheme", darkTheme, nullptr);
     parameters.state.setProperty("themeMode", themeMode, nullptr);
     parameters.state.setProperty("correlationPairIndex", correlationPairIndex, nullptr);
     parameters.state.setProperty("favoritePresets", favoritePresets, nullptr);
     auto state = parameters.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    // Binary delta-from-defaults chunk; EQPRO_XML_STATE=1 keeps writing XML for older builds.
+    if (juce::SystemStats::getEnvironmentVariable("EQPRO_XML_STATE", "0").getIntValue() != 0)
+    {
+        std::unique_ptr<juce::XmlElement> xml(state.createXml());
+        copyXmlToBinary(*xml, destData);
+        return;
+    }
+    StateCodec::write(parameters, state, destData);
 }
 
 void EQProAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
@@ -583,17 +596,36 @@ void EQProAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
     if (juce::JUCEApplicationBase::isStandaloneApp() && ! loadStateInStandalone)
         return;
 
-    std::unique_ptr<juce::XmlElement> xml(getXmlFromBinary(data, sizeInBytes));
-    if (xml != nullptr && xml->hasTagName(parameters.state.getType()))
-        replaceStateSafely(juce::ValueTree::fromXml(*xml));
+    if (StateCodec::isBinary(data, sizeInBytes))
+    {
+        replaceStateSafely(StateCodec::read(parameters, data, sizeInBytes));
+    }
+    else
+    {
+        std::unique_ptr<juce::XmlElement> xml(getXmlFromBinary(data, sizeInBytes));
+        if (xml != nullptr && xml->hasTagName(parameters.state.getType()))
+            replaceStateSafely(juce::ValueTree::fromXml(*xml));
+    }
 
     showPhasePreference = parameters.state.getProperty("showPhase", true);
     presetSelection = static_cast<int>(parameters.state.getProperty("presetSelection", 0));
     presetApplyTarget = static_cast<int>(parameters.state.getProperty("presetApplyTarget", 0));
-    snapshotA = parameters.state.getProperty("snapshotA", "");
-    snapshotB = parameters.state.getProperty("snapshotB", "");
-    snapshotC = parameters.state.getProperty("snapshotC", "");
-    snapshotD = parameters.state.getProperty("snapshotD", "");
+    for (int slot = 0; slot < kNumSnapshotSlots; ++slot)
+        readSnapshotProperty(slot);
+    if (juce::MessageManager::existsAndIsCurrentThread())
+        updateMorphEndpoints();
+    else
+        morphRefreshPending.store(true);
+    // A loaded session starts a fresh undo history.
+    if (juce::MessageManager::existsAndIsCurrentThread())
+    {
+        history.reset(captureParameterValues());
+        undoPollValues.clear();
+    }
+    else
+    {
+        historyResetPending.store(true);
+    }
     darkTheme = parameters.state.getProperty("darkTheme", true);
     themeMode = static_cast<int>(parameters.state.getProperty("themeMode", darkTheme ? 0 : 1));
     darkTheme = (themeMode == 0);
@@ -626,6 +658,103 @@ AudioFifo& EQProAudioProcessor::getAnalyzerExternalFifo()
     return analyzerExternalTap.getFifo();
 }
 
+double EQProAudioProcessor::getAnalyzerSampleRate() const
+{
+    return analyzerPreTap.getOutputSampleRate();
+}
+
+AnalyzerWorker& EQProAudioProcessor::getAnalyzerWorker()
+{
+    return *analyzerWorker;
+}
+
+juce::File EQProAudioProcessor::getTelemetryFile() const
+{
+    return telemetryRing.getFile();
+}
+
+const StageProfiler& EQProAudioProcessor::getProfiler() const
+{
+    return profiler;
+}
+
+const eqdsp::CpuGovernor& EQProAudioProcessor::getGovernor() const
+{
+    return governor;
+}
+
+void EQProAudioProcessor::resetProfiler()
+{
+    profiler.requestReset();
+}
+
+juce::File EQProAudioProcessor::dumpProfile() const
+{
+    const auto file = getLogDirectory().getChildFile(
+        "EQPro_profile_" + juce::Time::getCurrentTime().formatted("%Y-%m-%d_%H-%M-%S") + ".json");
+    return profiler.writeJson(file) ? file : juce::File();
+}
+
+AnalyzerSettings EQProAudioProcessor::makeTelemetrySettings() const
+{
+    // Fixed headless view: enough columns for the export bins, normal speed, pre and post only.
+    const double rate = telemetrySampleRate.load(std::memory_order_relaxed);
+    const double hostRate = rate > 0.0 ? rate : 48000.0;
+    AnalyzerSettings settings;
+    settings.numPoints = 2 * Telemetry::kSpectrumBins;
+    settings.minFreq = 20.0f;
+    settings.maxFreq = static_cast<float>(juce::jmin(20000.0, hostRate * 0.5));
+    settings.hostSampleRate = hostRate;
+    settings.analyzerSampleRate = getAnalyzerSampleRate() > 0.0 ? getAnalyzerSampleRate() : hostRate;
+    settings.updateHz = 20;
+    settings.wantCurve[static_cast<size_t>(AnalyzerCurve::pre)] = true;
+    settings.wantCurve[static_cast<size_t>(AnalyzerCurve::post)] = true;
+    return settings;
+}
+
+void EQProAudioProcessor::analyzerFrameReady(const AnalyzerFrame& frame)
+{
+    // Worker thread. Bins span the frame's own range so an open editor's view exports unchanged.
+    auto& record = telemetryRecord;
+    record.frameIndex++;
+    record.timestampMs = juce::Time::getMillisecondCounterHiRes();
+    record.sampleRate = static_cast<float>(telemetrySampleRate.load(std::memory_order_relaxed));
+    record.minFreq = frame.minFreq;
+    record.maxFreq = frame.maxFreq;
+    record.flags = 0;
+    const std::array<std::pair<AnalyzerCurve, Telemetry::SpectrumIndex>, 2> spectra {
+        { { AnalyzerCurve::pre, Telemetry::pre }, { AnalyzerCurve::post, Telemetry::post } }
+    };
+    for (const auto& [curve, index] : spectra)
+    {
+        auto* dest = record.spectrum[index];
+        if (! frame.hasCurve[static_cast<size_t>(curve)])
+        {
+            std::fill(dest, dest + Telemetry::kSpectrumBins, Telemetry::kNoData);
+            continue;
+        }
+        record.flags |= index == Telemetry::pre ? Telemetry::hasPre : Telemetry::hasPost;
+        Telemetry::binSpectrum(frame.curve(curve).data(), frame.numPoints, frame.validPoints, frame.minFreq,
+                               frame.maxFreq, frame.minFreq, frame.maxFreq, dest);
+    }
+
+    if (meterTap.getSnapshot(telemetryMeters))
+    {
+        record.numChannels = juce::jmin(telemetryMeters.numChannels, Telemetry::kMaxChannels);
+        for (int ch = 0; ch < Telemetry::kMaxChannels; ++ch)
+        {
+            const auto& state = telemetryMeters.channels[static_cast<size_t>(ch)];
+            record.channels[ch] = { state.rmsDb, state.peakDb, state.truePeakDb };
+        }
+        record.momentaryLufs = telemetryMeters.momentaryLufs;
+        record.shortTermLufs = telemetryMeters.shortTermLufs;
+        record.integratedLufs = telemetryMeters.integratedLufs;
+        record.truePeakMaxDb = telemetryMeters.truePeakMaxDb;
+        record.correlation = telemetryMeters.correlation;
+    }
+    telemetryRing.publish(record);
+}
+
 std::vector<juce::String> EQProAudioProcessor::getCurrentChannelNames() const
 {
     const auto* bus = getBus(true, 0);
@@ -655,14 +784,36 @@ eqdsp::ChannelMeterState EQProAudioProcessor::getMeterState(int channelIndex) co
     return meterTap.getState(channelIndex);
 }
 
+bool EQProAudioProcessor::getMeterSnapshot(eqdsp::MeterSnapshot& dest) const
+{
+    return meterTap.getSnapshot(dest);
+}
+
+void EQProAudioProcessor::resetLoudness()
+{
+    meterTap.requestLoudnessReset();
+}
+
+void EQProAudioProcessor::refreshChannelNames()
+{
+    cachedChannelNames = getCurrentChannelNames();
+    for (int ch = 0; ch < ParamIDs::kMaxChannels; ++ch)
+    {
+        const float weight = ch < static_cast<int>(cachedChannelNames.size())
+            ? eqdsp::MeteringDSP::loudnessWeightForLabel(cachedChannelNames[static_cast<size_t>(ch)])
+            : 1.0f;
+        meterTap.setLoudnessWeight(ch, weight);
+    }
+}
+
 float EQProAudioProcessor::getCorrelation() const
 {
     return meterTap.getCorrelation();
 }
 
-int EQProAudioProcessor::getGoniometerPoints(juce::Point<float>* dest, int maxPoints, int& writePos) const
+int EQProAudioProcessor::popGoniometerPoints(float* destMid, float* destSide, int maxPoints)
 {
-    return meterTap.copyScopePoints(dest, maxPoints, writePos);
+    return meterTap.popScopePoints(destMid, destSide, maxPoints);
 }
 
 juce::StringArray EQProAudioProcessor::getCorrelationPairNames()
@@ -771,9 +922,109 @@ bool EQProAudioProcessor::getLastProcessBand0Bypassed() const
     return lastProcessBand0Bypassed.load(std::memory_order_relaxed) != 0;
 }
 
-juce::UndoManager* EQProAudioProcessor::getUndoManager()
+bool EQProAudioProcessor::undo()
+{
+    commitPendingEdits();
+    std::vector<float> values;
+    if (! history.undo(values))
+        return false;
+    applyParameterValues(values);
+    undoPollValues.clear();
+    finishBulkApply({});
+    return true;
+}
+
+bool EQProAudioProcessor::redo()
+{
+    commitPendingEdits();
+    std::vector<float> values;
+    if (! history.redo(values))
+        return false;
+    applyParameterValues(values);
+    undoPollValues.clear();
+    finishBulkApply({});
+    return true;
+}
+
+bool EQProAudioProcessor::canUndo() const
 {
-    return &undoManager;
+    return history.canUndo();
+}
+
+bool EQProAudioProcessor::canRedo() const
+{
+    return history.canRedo();
+}
+
+void EQProAudioProcessor::beginUndoGesture(const juce::String& name)
+{
+    if (openUndoGestures++ > 0)
+        return;
+    commitPendingEdits();
+    undoGestureName = name;
+}
+
+void EQProAudioProcessor::endUndoGesture()
+{
+    if (openUndoGestures == 0 || --openUndoGestures > 0)
+        return;
+    history.commit(captureParameterValues(), undoGestureName);
+    undoPollValues.clear();
+}
+
+void EQProAudioProcessor::updateUndoHistory()
+{
+    if (historyResetPending.exchange(false))
+    {
+        history.reset(captureParameterValues());
+        undoPollValues.clear();
+        return;
+    }
+    if (openUndoGestures > 0)
+        return;
+
+    // Edits without a gesture (host automation, MIDI learn, keyboard) become one transaction once
+    // they have been still for kUndoIdleTicks timer ticks.
+    auto values = captureParameterValues();
+    const bool still = values.size() == undoPollValues.size()
+        && std::memcmp(values.data(), undoPollValues.data(), values.size() * sizeof(float)) == 0;
+    if (! still)
+    {
+        undoPollValues = std::move(values);
+        undoIdleTicks = 0;
+        return;
+    }
+    if (++undoIdleTicks == kUndoIdleTicks)
+        history.commit(undoPollValues, "Edit");
+}
+
+void EQProAudioProcessor::setUndoMemoryLimit(size_t bytes)
+{
+    history.setMemoryLimit(bytes);
+}
+
+void EQProAudioProcessor::commitPendingEdits()
+{
+    if (! juce::MessageManager::existsAndIsCurrentThread() || openUndoGestures > 0)
+        return;
+    history.commit(captureParameterValues(), "Edit");
+    undoPollValues.clear();
+}
+
+void EQProAudioProcessor::audioProcessorParameterChangeGestureBegin(juce::AudioProcessor*, int parameterIndex)
+{
+    // Gestures from the audio thread (host automation) are left to the idle grouping.
+    if (! juce::MessageManager::existsAndIsCurrentThread())
+        return;
+    const auto* parameter = AudioProcessor::getParameters()[parameterIndex];
+    beginUndoGesture(parameter != nullptr ? parameter->getName(64) : juce::String("Edit"));
+}
+
+void EQProAudioProcessor::audioProcessorParameterChangeGestureEnd(juce::AudioProcessor*, int parameterIndex)
+{
+    juce::ignoreUnused(parameterIndex);
+    if (juce::MessageManager::existsAndIsCurrentThread())
+        endUndoGesture();
 }
 
 void EQProAudioProcessor::setPresetSelection(int index)
@@ -798,56 +1049,279 @@ int EQProAudioProcessor::getPresetApplyTarget() const
     return presetApplyTarget;
 }
 
+void EQProAudioProcessor::storeSnapshot(int slot)
+{
+    if (slot < 0 || slot >= kNumSnapshotSlots)
+        return;
+    auto values = captureParameterValues();
+    excludeMorphParameters(values);
+    snapshotSlots[static_cast<size_t>(slot)] = std::move(values);
+    writeSnapshotProperty(slot);
+    updateMorphEndpoints();
+}
+
+void EQProAudioProcessor::excludeMorphParameters(std::vector<float>& values) const
+{
+    // Recalling a slot must not move the morph that blends between slots; applyParameterValues()
+    // skips NaN entries.
+    for (auto* morphValue : { snapshotMorphParam, snapshotMorphPairParam, snapshotMorphOnParam })
+    {
+        const auto it = paramIndexByValue.find(morphValue);
+        if (it != paramIndexByValue.end() && it->second < values.size())
+            values[it->second] = std::numeric_limits<float>::quiet_NaN();
+    }
+}
+
+void EQProAudioProcessor::recallSnapshot(int slot)
+{
+    if (! hasSnapshot(slot))
+        return;
+    commitPendingEdits();
+    applyParameterValues(snapshotSlots[static_cast<size_t>(slot)]);
+    finishBulkApply("Recall Snapshot " + juce::String::charToString(static_cast<juce::juce_wchar>('A' + slot)));
+}
+
+bool EQProAudioProcessor::hasSnapshot(int slot) const
+{
+    return slot >= 0 && slot < kNumSnapshotSlots && ! snapshotSlots[static_cast<size_t>(slot)].empty();
+}
+
+bool EQProAudioProcessor::isSnapshotMorphActive() const
+{
+    return snapshotMorphOnParam != nullptr && snapshotMorphOnParam->load() > 0.5f
+        && morphEndpoints[morphPublishedSlot].valid;
+}
+
 void EQProAudioProcessor::storeSnapshotA()
 {
-    if (auto xml = parameters.copyState().createXml())
-        snapshotA = xml->toString();
-    parameters.state.setProperty("snapshotA", snapshotA, nullptr);
+    storeSnapshot(0);
 }
 
 void EQProAudioProcessor::storeSnapshotB()
 {
-    if (auto xml = parameters.copyState().createXml())
-        snapshotB = xml->toString();
-    parameters.state.setProperty("snapshotB", snapshotB, nullptr);
+    storeSnapshot(1);
 }
 
 void EQProAudioProcessor::recallSnapshotA()
 {
-    if (snapshotA.isNotEmpty())
-        parameters.replaceState(juce::ValueTree::fromXml(snapshotA));
+    recallSnapshot(0);
 }
 
 void EQProAudioProcessor::recallSnapshotB()
 {
-    if (snapshotB.isNotEmpty())
-        parameters.replaceState(juce::ValueTree::fromXml(snapshotB));
+    recallSnapshot(1);
 }
 
 void EQProAudioProcessor::storeSnapshotC()
 {
-    if (auto xml = parameters.copyState().createXml())
-        snapshotC = xml->toString();
-    parameters.state.setProperty("snapshotC", snapshotC, nullptr);
+    storeSnapshot(2);
 }
 
 void EQProAudioProcessor::storeSnapshotD()
 {
-    if (auto xml = parameters.copyState().createXml())
-        snapshotD = xml->toString();
-    parameters.state.setProperty("snapshotD", snapshotD, nullptr);
+    storeSnapshot(3);
 }
 
 void EQProAudioProcessor::recallSnapshotC()
 {
-    if (snapshotC.isNotEmpty())
-        parameters.replaceState(juce::ValueTree::fromXml(snapshotC));
+    recallSnapshot(2);
 }
 
 void EQProAudioProcessor::recallSnapshotD()
 {
-    if (snapshotD.isNotEmpty())
-        parameters.replaceState(juce::ValueTree::fromXml(snapshotD));
+    recallSnapshot(3);
+}
+
+std::vector<float> EQProAudioProcessor::captureParameterValues() const
+{
+    std::vector<float> values(orderedParamValues.size(), std::numeric_limits<float>::quiet_NaN());
+    for (size_t i = 0; i < values.size(); ++i)
+        if (orderedParamValues[i] != nullptr)
+            values[i] = orderedParamValues[i]->load();
+    return values;
+}
+
+std::vector<float> EQProAudioProcessor::parameterValuesFromState(const juce::ValueTree& state) const
+{
+    static const juce::Identifier paramType { "PARAM" };
+    static const juce::Identifier idProperty { "id" };
+    static const juce::Identifier valueProperty { "value" };
+    std::vector<float> values(orderedParamValues.size(), std::numeric_limits<float>::quiet_NaN());
+    for (const auto& child : state)
+    {
+        if (! child.hasType(paramType) || ! child.hasProperty(valueProperty))
+            continue;
+        const auto id = child.getProperty(idProperty).toString();
+        if (paramIndexById.contains(id))
+            values[static_cast<size_t>(paramIndexById[id])] = static_cast<float>(child.getProperty(valueProperty));
+    }
+    return values;
+}
+
+void EQProAudioProcessor::applyParameterValues(const std::vector<float>& values)
+{
+    // Write only the values that differ into the live tree. Each write drives its parameter once
+    // through APVTS, and the tree already holds the value, so the next flush records nothing. The
+    // tree is never redirected, so adapters and attachments keep their connections; a full
+    // replaceState re-pointed every parameter and re-evaluated all of them.
+    static const juce::Identifier paramType { "PARAM" };
+    static const juce::Identifier idProperty { "id" };
+    static const juce::Identifier valueProperty { "value" };
+    juce::HashMap<juce::String, juce::ValueTree> liveParams;
+    for (auto child : parameters.state)
+        if (child.hasType(paramType))
+            liveParams.set(child.getProperty(idProperty).toString(), child);
+
+    const auto& all = AudioProcessor::getParameters();
+    const auto count = juce::jmin(values.size(), orderedParamValues.size());
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto* current = orderedParamValues[i];
+        const auto value = values[i];
+        if (current == nullptr || std::isnan(value) || juce::approximatelyEqual(current->load(), value))
+            continue;
+        auto* parameter = dynamic_cast<juce::RangedAudioParameter*>(all[static_cast<int>(i)]);
+        if (parameter == nullptr)
+            continue;
+        const auto id = parameter->getParameterID();
+        if (liveParams.contains(id))
+            liveParams.getReference(id).setProperty(valueProperty, value, nullptr);
+        else
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+}
+
+void EQProAudioProcessor::finishBulkApply(const juce::String& undoName)
+{
+    // The whole apply is one undo step; undo/redo pass no name since they already moved the history.
+    // Restores off the message thread (host session load) start a fresh history on the next tick.
+    if (! juce::MessageManager::existsAndIsCurrentThread())
+        historyResetPending.store(true);
+    else if (undoName.isNotEmpty())
+        history.commit(captureParameterValues(), undoName);
+
+    selectedBandIndex.store(juce::jlimit(0, ParamIDs::kBandsPerChannel - 1, selectedBandIndex.load()));
+    selectedChannelIndex.store(juce::jlimit(0, ParamIDs::kMaxChannels - 1, selectedChannelIndex.load()));
+
+    // One snapshot and one FIR rebuild for the whole restore; hosts may restore off the message
+    // thread, where the timer picks it up on its next tick.
+    if (juce::MessageManager::existsAndIsCurrentThread())
+        publishSnapshot(true);
+    else
+        bulkRestorePending.store(true);
+}
+
+void EQProAudioProcessor::writeSnapshotProperty(int slot)
+{
+    const auto& name = kSnapshotSlotProperties[static_cast<size_t>(slot)];
+    const auto& values = snapshotSlots[static_cast<size_t>(slot)];
+    if (values.empty())
+    {
+        parameters.state.removeProperty(name, nullptr);
+        return;
+    }
+    juce::MemoryBlock block;
+    StateCodec::encodeParameterValues(parameters, values, block);
+    parameters.state.setProperty(name, block, nullptr);
+}
+
+void EQProAudioProcessor::readSnapshotProperty(int slot)
+{
+    auto& values = snapshotSlots[static_cast<size_t>(slot)];
+    values.clear();
+    const auto& property = parameters.state.getProperty(kSnapshotSlotProperties[static_cast<size_t>(slot)]);
+    juce::MemoryBlock block;
+    if (const auto* binary = property.getBinaryData())
+    {
+        block = *binary;
+    }
+    else if (property.isString())
+    {
+        // Older versions stored the whole state as XML; XML chunks carry binary slots as base64.
+        const auto text = property.toString();
+        if (auto xml = juce::parseXML(text))
+        {
+            if (xml->hasTagName(parameters.state.getType().toString()))
+                values = parameterValuesFromState(juce::ValueTree::fromXml(*xml));
+        }
+        else
+        {
+            block.fromBase64Encoding(text);
+        }
+    }
+    if (block.getSize() > 0)
+        values = StateCodec::decodeParameterValues(parameters, block.getData(), block.getSize());
+    // Stored slots drop the NaN morph entries and decode them as defaults; restore the exclusion.
+    if (! values.empty())
+        excludeMorphParameters(values);
+}
+
+void EQProAudioProcessor::updateMorphEndpoints()
+{
+    const int pair = snapshotMorphPairParam != nullptr
+        ? juce::jlimit(0, static_cast<int>(kMorphPairs.size()) - 1, static_cast<int>(snapshotMorphPairParam->load()))
+        : 0;
+    morphEndpointsPair = pair;
+
+    auto& next = morphEndpoints[morphWriteSlot];
+    const auto& from = snapshotSlots[static_cast<size_t>(kMorphPairs[static_cast<size_t>(pair)].first)];
+    const auto& to = snapshotSlots[static_cast<size_t>(kMorphPairs[static_cast<size_t>(pair)].second)];
+    next.valid = ! from.empty() && ! to.empty();
+    if (next.valid)
+    {
+        const auto fillBands = [this](const std::vector<float>& values, BandTable& table)
+        {
+            const auto loadSlot = [this, &values](const std::atomic<float>* value, float fallback)
+            {
+                const auto it = paramIndexByValue.find(value);
+                if (it == paramIndexByValue.end() || it->second >= values.size() || std::isnan(values[it->second]))
+                    return fallback;
+                return values[it->second];
+            };
+            for (int ch = 0; ch < ParamIDs::kMaxChannels; ++ch)
+            {
+                for (int band = 0; band < ParamIDs::kBandsPerChannel; ++band)
+                {
+                    auto& dst = table[static_cast<size_t>(ch)][static_cast<size_t>(band)];
+                    dst = {};
+                    eqdsp::loadBandParams(bandParamPointers[ch][band], band, loadSlot, dst);
+                }
+            }
+        };
+        fillBands(from, next.from);
+        fillBands(to, next.to);
+    }
+    morphPublishedSlot = morphWriteSlot;
+    morphWriteSlot = morphLatest.exchange(morphWriteSlot | kMorphFresh, std::memory_order_acq_rel) & ~kMorphFresh;
+}
+
+void EQProAudioProcessor::applySnapshotMorph(eqdsp::ParamSnapshot& snapshot, int numChannels) const
+{
+    // The blend runs continuously from the pair's first slot (0 %) to its second (100 %); the live
+    // bands only play while the morph is switched off, so moving the amount never jumps.
+    if (snapshotMorphOnParam == nullptr || snapshotMorphOnParam->load() <= 0.5f)
+        return;
+    const float amount = snapshotMorphParam != nullptr ? snapshotMorphParam->load() / 100.0f : 0.0f;
+    // Snapshots built by the timer read what it published; the audio thread takes the latest slot.
+    int slot = morphPublishedSlot;
+    if (! juce::MessageManager::existsAndIsCurrentThread())
+    {
+        if ((morphLatest.load(std::memory_order_acquire) & kMorphFresh) != 0)
+            morphReadSlot = morphLatest.exchange(morphReadSlot, std::memory_order_acq_rel) & ~kMorphFresh;
+        slot = morphReadSlot;
+    }
+    const auto& endpoints = morphEndpoints[slot];
+    if (! endpoints.valid)
+        return;
+
+    const float t = juce::jlimit(0.0f, 1.0f, amount);
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const auto& from = endpoints.from[static_cast<size_t>(ch)];
+        const auto& to = endpoints.to[static_cast<size_t>(ch)];
+        for (int band = 0; band < ParamIDs::kBandsPerChannel; ++band)
+            snapshot.bands[ch][band] = morphBand(from[static_cast<size_t>(band)], to[static_cast<size_t>(band)], t);
+    }
 }
 
 void EQProAudioProcessor::setDarkTheme(bool enabled)
@@ -899,6 +1373,23 @@ void EQProAudioProcessor::pasteStateFromClipboard()
         replaceStateSafely(juce::ValueTree::fromXml(sharedStateClipboard));
 }
 
+PresetLibrary& EQProAudioProcessor::getPresetLibrary()
+{
+    return *presetLibrary;
+}
+
+bool EQProAudioProcessor::applyPreset(const PresetLibrary::Preset& preset)
+{
+    const auto values = StateCodec::decodeParameterValues(parameters, preset.parameters.getData(),
+                                                          preset.parameters.getSize());
+    if (values.empty())
+        return false;
+    commitPendingEdits();
+    applyParameterValues(values);
+    finishBulkApply("Load Preset " + preset.name);
+    return true;
+}
+
 bool EQProAudioProcessor::replaceStateSafely(const juce::ValueTree& newState)
 {
     if (! newState.isValid())
@@ -908,9 +1399,10 @@ bool EQProAudioProcessor::replaceStateSafely(const juce::ValueTree& newState)
     if (newState.getNumChildren() == 0)
         return false;
 
-    parameters.replaceState(newState);
-    selectedBandIndex.store(juce::jlimit(0, ParamIDs::kBandsPerChannel - 1, selectedBandIndex.load()));
-    selectedChannelIndex.store(juce::jlimit(0, ParamIDs::kMaxChannels - 1, selectedChannelIndex.load()));
+    commitPendingEdits();
+    applyParameterValues(parameterValuesFromState(newState));
+    parameters.state.copyPropertiesFrom(newState, nullptr);
+    finishBulkApply("Restore State");
     return true;
 }
 
@@ -954,17 +1446,13 @@ float EQProAudioProcessor::getBandDynamicGainDb(int channelIndex, int bandIndex)
 
 void EQProAudioProcessor::logStartup(const juce::String& message)
 {
-    if (auto* logger = juce::Logger::getCurrentLogger())
-        logger->writeToLog(message);
+    AsyncLog::post(AsyncLog::Event::text, message);
 }
 
 void EQProAudioProcessor::logBandVerify(const juce::String& message)
 {
-    if (! verifyBands)
-        return;
-    bandVerifyLogFile.appendText(message + "\n");
-    if (auto* logger = juce::Logger::getCurrentLogger())
-        logger->writeToLog(message);
+    if (verifyBands)
+        AsyncLog::post(AsyncLog::Event::bandVerify, message);
 }
 
 void EQProAudioProcessor::verifyBandIndependence()
@@ -1036,16 +1524,26 @@ void EQProAudioProcessor::initializeParamPointers()
     spectralAttackParam = parameters.getRawParameterValue(ParamIDs::spectralAttack);
     spectralReleaseParam = parameters.getRawParameterValue(ParamIDs::spectralRelease);
     spectralMixParam = parameters.getRawParameterValue(ParamIDs::spectralMix);
+    spectralLinkParam = parameters.getRawParameterValue(ParamIDs::spectralLink);
+    spectralBandsParam = parameters.getRawParameterValue(ParamIDs::spectralBands);
     characterModeParam = parameters.getRawParameterValue(ParamIDs::characterMode);
     qModeParam = parameters.getRawParameterValue(ParamIDs::qMode);
     qModeAmountParam = parameters.getRawParameterValue(ParamIDs::qModeAmount);
     analyzerExternalParam = parameters.getRawParameterValue(ParamIDs::analyzerExternal);
+    analyzerSourceParam = parameters.getRawParameterValue(ParamIDs::analyzerSource);
     autoGainEnableParam = parameters.getRawParameterValue(ParamIDs::autoGainEnable);
     gainScaleParam = parameters.getRawParameterValue(ParamIDs::gainScale);
     phaseInvertParam = parameters.getRawParameterValue(ParamIDs::phaseInvert);
     midiLearnParam = parameters.getRawParameterValue(ParamIDs::midiLearn);
     midiTargetParam = parameters.getRawParameterValue(ParamIDs::midiTarget);
     smartSoloParam = parameters.getRawParameterValue(ParamIDs::smartSolo);
+    snapshotMorphParam = parameters.getRawParameterValue(ParamIDs::snapshotMorph);
+    snapshotMorphPairParam = parameters.getRawParameterValue(ParamIDs::snapshotMorphPair);
+    snapshotMorphOnParam = parameters.getRawParameterValue(ParamIDs::snapshotMorphOn);
+    globalParamPointers = eqdsp::findGlobalParams([this](const juce::String& id) -> const std::atomic<float>*
+    {
+        return parameters.getRawParameterValue(id);
+    });
 
     for (int ch = 0; ch < ParamIDs::kMaxChannels; ++ch)
     {
@@ -1097,6 +1595,22 @@ void EQProAudioProcessor::initializeParamPointers()
                 parameters.getRawParameterValue(ParamIDs::bandParamId(ch, band, kParamDynExternalSuffix));
         }
     }
+
+    // Snapshot slots store values in host parameter order.
+    orderedParamValues.clear();
+    paramIndexByValue.clear();
+    paramIndexById.clear();
+    for (auto* parameter : AudioProcessor::getParameters())
+    {
+        auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter);
+        auto* value = ranged != nullptr ? parameters.getRawParameterValue(ranged->getParameterID()) : nullptr;
+        if (value != nullptr)
+        {
+            paramIndexByValue[value] = orderedParamValues.size();
+            paramIndexById.set(ranged->getParameterID(), static_cast<int>(orderedParamValues.size()));
+        }
+        orderedParamValues.push_back(value);
+    }
 }
 
 // Defines every APVTS parameter (global + per-band).
@@ -1110,13 +1624,13 @@ juce::AudioProcessorValueTreeState::ParameterLayout EQProAudioProcessor::createP
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         ParamIDs::globalMix, "Global Mix",
         juce::NormalisableRange<float>(0.0f, 100.0f, 0.01f),
-        100.0f));
+        eqdsp::kDefaultGlobalMix));
     params.push_back(std::make_unique<juce::AudioParameterChoice>(
         ParamIDs::phaseMode, "Phase Mode",
         kPhaseModeChoices, 0));
     params.push_back(std::make_unique<juce::AudioParameterChoice>(
         ParamIDs::linearQuality, "Linear Quality",
-        kLinearQualityChoices, 1));
+        kLinearQualityChoices, static_cast<int>(eqdsp::kDefaultLinearQuality)));
     params.push_back(std::make_unique<juce::AudioParameterChoice>(
         ParamIDs::linearWindow, "Linear Window",
         kLinearWindowChoices, 0));
@@ -1134,23 +1648,31 @@ juce::AudioProcessorValueTreeState::ParameterLayout EQProAudioProcessor::createP
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         ParamIDs::spectralThreshold, "Spectral Threshold",
         juce::NormalisableRange<float>(-60.0f, 0.0f, 0.1f),
-        -24.0f));
+        eqdsp::kDefaultSpectralThresholdDb));
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         ParamIDs::spectralRatio, "Spectral Ratio",
         juce::NormalisableRange<float>(1.0f, 20.0f, 0.01f),
-        2.0f));
+        eqdsp::kDefaultSpectralRatio));
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         ParamIDs::spectralAttack, "Spectral Attack",
         juce::NormalisableRange<float>(1.0f, 200.0f, 0.1f),
-        20.0f));
+        eqdsp::kDefaultSpectralAttackMs));
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         ParamIDs::spectralRelease, "Spectral Release",
         juce::NormalisableRange<float>(5.0f, 1000.0f, 0.1f),
-        200.0f));
+        eqdsp::kDefaultSpectralReleaseMs));
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         ParamIDs::spectralMix, "Spectral Mix",
         juce::NormalisableRange<float>(0.0f, 100.0f, 0.01f),
-        100.0f));
+        eqdsp::kDefaultSpectralMix));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        ParamIDs::spectralLink, "Spectral Link",
+        juce::StringArray("Off", "Sum", "Max"),
+        0));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        ParamIDs::spectralBands, "Spectral Bands",
+        juce::StringArray("Bins", "ERB", "Bark"),
+        0));
     params.push_back(std::make_unique<juce::AudioParameterChoice>(
         ParamIDs::characterMode, "Character Mode",
         juce::StringArray("Off", "Gentle", "Warm"),
@@ -1162,7 +1684,7 @@ juce::AudioProcessorValueTreeState::ParameterLayout EQProAudioProcessor::createP
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         ParamIDs::qModeAmount, "Q Amount",
         juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f),
-        50.0f));
+        eqdsp::kDefaultQModeAmount));
     params.push_back(std::make_unique<juce::AudioParameterChoice>(
         ParamIDs::analyzerRange, "Analyzer Range",
         juce::StringArray("3 dB", "6 dB", "12 dB", "30 dB"),
@@ -1175,6 +1697,29 @@ juce::AudioProcessorValueTreeState::ParameterLayout EQProAudioProcessor::createP
         ParamIDs::analyzerView, "Analyzer View",
         juce::StringArray("Both", "Pre", "Post"),
         0));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        ParamIDs::analyzerSource, "Analyzer Source",
+        juce::StringArray("Selected", "L+R", "Mid", "Side", "All"),
+        0));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        ParamIDs::analyzerOverlap, "Analyzer Overlap",
+        juce::StringArray("50%", "75%", "87.5%"),
+        1));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        ParamIDs::analyzerAveraging, "Analyzer Averaging",
+        juce::StringArray("Exponential", "Welch"),
+        0));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        ParamIDs::analyzerSmoothing, "Analyzer Smoothing",
+        juce::StringArray("Off", "1/24 Oct", "1/12 Oct", "1/6 Oct", "1/3 Oct"),
+        0));
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        ParamIDs::analyzerPeakHold, "Analyzer Peak Hold",
+        false));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        ParamIDs::analyzerResolution, "Analyzer Resolution",
+        juce::StringArray("Standard", "Multi-Res"),
+        0));
     params.push_back(std::make_unique<juce::AudioParameterBool>(
         ParamIDs::analyzerFreeze, "Analyzer Freeze",
         false));
@@ -1187,7 +1732,7 @@ juce::AudioProcessorValueTreeState::ParameterLayout EQProAudioProcessor::createP
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         ParamIDs::gainScale, "Gain Scale",
         juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f),
-        100.0f));
+        eqdsp::kDefaultGainScale));
     params.push_back(std::make_unique<juce::AudioParameterBool>(
         ParamIDs::phaseInvert, "Phase Invert",
         false));
@@ -1201,6 +1746,17 @@ juce::AudioProcessorValueTreeState::ParameterLayout EQProAudioProcessor::createP
     params.push_back(std::make_unique<juce::AudioParameterBool>(
         ParamIDs::smartSolo, "Smart Solo",
         false));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        ParamIDs::snapshotMorph, "Snapshot Morph",
+        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f),
+        0.0f));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        ParamIDs::snapshotMorphPair, "Snapshot Morph Pair",
+        juce::StringArray("A-B", "A-C", "A-D", "B-C", "B-D", "C-D"),
+        0));
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        ParamIDs::snapshotMorphOn, "Snapshot Morph On",
+        false));
 
     const juce::NormalisableRange<float> freqRange(10.0f, 30000.0f, 0.01f, 0.5f);
     const juce::NormalisableRange<float> gainRange(-30.0f, 30.0f, 0.01f);
@@ -1214,7 +1770,7 @@ juce::AudioProcessorValueTreeState::ParameterLayout EQProAudioProcessor::createP
                 ParamIDs::bandParamId(ch, band, kParamFreqSuffix),
                 ParamIDs::bandParamName(ch, band, "Freq"),
                 freqRange,
-                kDefaultBandFreqs[static_cast<size_t>(band)]));
+                eqdsp::kDefaultBandFreqs[static_cast<size_t>(band)]));
 
             params.push_back(std::make_unique<juce::AudioParameterFloat>(
                 ParamIDs::bandParamId(ch, band, kParamGainSuffix),
@@ -1226,7 +1782,7 @@ juce::AudioProcessorValueTreeState::ParameterLayout EQProAudioProcessor::createP
                 ParamIDs::bandParamId(ch, band, kParamQSuffix),
                 ParamIDs::bandParamName(ch, band, "Q"),
                 qRange,
-                0.707f));
+                eqdsp::kDefaultBandQ));
 
             params.push_back(std::make_unique<juce::AudioParameterChoice>(
                 ParamIDs::bandParamId(ch, band, kParamTypeSuffix),
@@ -1237,7 +1793,7 @@ juce::AudioProcessorValueTreeState::ParameterLayout EQProAudioProcessor::createP
             params.push_back(std::make_unique<juce::AudioParameterBool>(
                 ParamIDs::bandParamId(ch, band, kParamBypassSuffix),
                 ParamIDs::bandParamName(ch, band, "Bypass"),
-                true));
+                eqdsp::kDefaultBandBypass > 0.5f));
 
             params.push_back(std::make_unique<juce::AudioParameterChoice>(
                 ParamIDs::bandParamId(ch, band, kParamMsSuffix),
@@ -1249,7 +1805,7 @@ juce::AudioProcessorValueTreeState::ParameterLayout EQProAudioProcessor::createP
                 ParamIDs::bandParamId(ch, band, kParamSlopeSuffix),
                 ParamIDs::bandParamName(ch, band, "Slope"),
                 juce::NormalisableRange<float>(6.0f, 96.0f, 6.0f),
-                12.0f));
+                eqdsp::kDefaultBandSlope));
 
             params.push_back(std::make_unique<juce::AudioParameterBool>(
                 ParamIDs::bandParamId(ch, band, kParamSoloSuffix),
@@ -1260,7 +1816,7 @@ juce::AudioProcessorValueTreeState::ParameterLayout EQProAudioProcessor::createP
                 ParamIDs::bandParamId(ch, band, kParamMixSuffix),
                 ParamIDs::bandParamName(ch, band, "Mix"),
                 juce::NormalisableRange<float>(0.0f, 100.0f, 0.01f),
-                100.0f));
+                eqdsp::kDefaultBandMix));
             
             // v4.4 beta: Harmonic layer parameters
             params.push_back(std::make_unique<juce::AudioParameterFloat>(
@@ -1273,7 +1829,7 @@ juce::AudioProcessorValueTreeState::ParameterLayout EQProAudioProcessor::createP
                 ParamIDs::bandParamId(ch, band, kParamMixOddSuffix),
                 ParamIDs::bandParamName(ch, band, "Mix Odd"),
                 juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f),
-                100.0f));
+                eqdsp::kDefaultHarmonicMix));
             
             params.push_back(std::make_unique<juce::AudioParameterFloat>(
                 ParamIDs::bandParamId(ch, band, kParamEvenSuffix),
@@ -1285,14 +1841,14 @@ juce::AudioProcessorValueTreeState::ParameterLayout EQProAudioProcessor::createP
                 ParamIDs::bandParamId(ch, band, kParamMixEvenSuffix),
                 ParamIDs::bandParamName(ch, band, "Mix Even"),
                 juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f),
-                100.0f));
+                eqdsp::kDefaultHarmonicMix));
             
             // v4.5 beta: Harmonic bypass parameter (per-band, independent for each of 12 bands)
             // Default to bypassed so harmonic layer is opt-in per band.
             params.push_back(std::make_unique<juce::AudioParameterBool>(
                 ParamIDs::bandParamId(ch, band, kParamHarmonicBypassSuffix),
                 ParamIDs::bandParamName(ch, band, "Harmonic Bypass"),
-                true));
+                eqdsp::kDefaultHarmonicBypass > 0.5f));
 
             params.push_back(std::make_unique<juce::AudioParameterBool>(
                 ParamIDs::bandParamId(ch, band, kParamDynEnableSuffix),
@@ -1309,24 +1865,24 @@ juce::AudioProcessorValueTreeState::ParameterLayout EQProAudioProcessor::createP
                 ParamIDs::bandParamId(ch, band, kParamDynThreshSuffix),
                 ParamIDs::bandParamName(ch, band, "Dyn Threshold"),
                 juce::NormalisableRange<float>(-60.0f, 0.0f, 0.1f),
-                -24.0f));
+                eqdsp::kDefaultDynThresholdDb));
 
             params.push_back(std::make_unique<juce::AudioParameterFloat>(
                 ParamIDs::bandParamId(ch, band, kParamDynAttackSuffix),
                 ParamIDs::bandParamName(ch, band, "Dyn Attack"),
                 juce::NormalisableRange<float>(1.0f, 200.0f, 0.1f),
-                20.0f));
+                eqdsp::kDefaultDynAttackMs));
 
             params.push_back(std::make_unique<juce::AudioParameterFloat>(
                 ParamIDs::bandParamId(ch, band, kParamDynReleaseSuffix),
                 ParamIDs::bandParamName(ch, band, "Dyn Release"),
                 juce::NormalisableRange<float>(5.0f, 1000.0f, 0.1f),
-                200.0f));
+                eqdsp::kDefaultDynReleaseMs));
 
             params.push_back(std::make_unique<juce::AudioParameterBool>(
                 ParamIDs::bandParamId(ch, band, kParamDynAutoSuffix),
                 ParamIDs::bandParamName(ch, band, "Dyn Auto Scale"),
-                true));
+                eqdsp::kDefaultDynAuto > 0.5f));
 
             params.push_back(std::make_unique<juce::AudioParameterBool>(
                 ParamIDs::bandParamId(ch, band, kParamDynExternalSuffix),
@@ -1353,7 +1909,50 @@ void EQProAudioProcessor::timerCallback()
         verifyBandIndependence();
     }
 
-    cachedChannelNames = getCurrentChannelNames();
+    refreshChannelNames();
+    // Headless export: an open editor's analyzer drives the worker settings instead (the worker adds
+    // the export's curves and keeps exporting while the view is frozen).
+    if (telemetryRing.isOpen() && getActiveEditor() == nullptr)
+        analyzerWorker->setSettings(makeTelemetrySettings());
+    if (morphRefreshPending.exchange(false)
+        || (snapshotMorphPairParam != nullptr && static_cast<int>(snapshotMorphPairParam->load()) != morphEndpointsPair))
+        updateMorphEndpoints();
+    publishSnapshot(bulkRestorePending.exchange(false));
+    updateUndoHistory();
+    profiler.calibrate();
+
+    static int rmsLogTick = 0;
+    static int lastLogMode = -1;
+    static int lastLogQuality = -1;
+    if (++rmsLogTick >= 30)
+    {
+        rmsLogTick = 0;
+        const int mode = eqEngine.getLastRmsPhaseMode();
+        const int quality = eqEngine.getLastRmsQuality();
+        const float preDb = eqEngine.getLastPreRmsDb();
+        const float postDb = eqEngine.getLastPostRmsDb();
+        if (mode != lastLogMode || quality != lastLogQuality
+            || std::abs(postDb - preDb) > 0.5f)
+        {
+            lastLogMode = mode;
+            lastLogQuality = quality;
+            AsyncLog::post(AsyncLog::Event::rmsDelta, { static_cast<float>(mode), static_cast<float>(quality),
+                                                        preDb, postDb });
+        }
+    }
+
+    const int pendingQualityLog = pendingAdaptiveQualityLog.exchange(999);
+    if (pendingQualityLog != 999)
+    {
+        AsyncLog::post(AsyncLog::Event::adaptiveQuality, { static_cast<float>(pendingQualityLog) });
+        pendingLinearRebuild = true;
+        lastParamChangeTick = snapshotTick - 6;
+    }
+}
+
+
+void EQProAudioProcessor::publishSnapshot(bool immediateRebuild)
+{
     const int nextIndex = 1 - activeSnapshot.load();
     const uint64_t hash = buildSnapshot(snapshots[nextIndex]);
     ++snapshotTick;
@@ -1364,11 +1963,19 @@ void EQProAudioProcessor::timerCallback()
         setLatencySamples(pendingLatencySamples.load());
         pendingLatencySamples.store(-1);
     }
+    // Spectral enable/disable changes latency without a FIR rebuild, so follow the engine here.
+    else if (! linearJobRunning.load())
+    {
+        const int engineLatency = eqEngine.getLatencySamples();
+        if (engineLatency != getLatencySamples())
+            setLatencySamples(engineLatency);
+    }
 
     const bool paramChanged = hash != lastSnapshotHash;
     if (paramChanged)
     {
-        lastParamChangeTick = snapshotTick;
+        // A restore is not a drag: skip the debounce, also if a running job defers the rebuild.
+        lastParamChangeTick = immediateRebuild ? snapshotTick - 6 : snapshotTick;
         pendingLinearRebuild = true;
     }
 
@@ -1385,10 +1992,9 @@ void EQProAudioProcessor::timerCallback()
         if (allowRebuild && ! linearJobRunning.load())
         {
             linearJobRunning.store(true);
-            juce::Logger::writeToLog("LinearPhase: scheduling FIR rebuild (mode="
-                                     + juce::String(snapshot.phaseMode)
-                                     + ", quality=" + juce::String(snapshot.linearQuality)
-                                     + ", window=" + juce::String(snapshot.linearWindow) + ")");
+            AsyncLog::post(AsyncLog::Event::firSchedule,
+                           { static_cast<float>(snapshot.phaseMode), static_cast<float>(snapshot.linearQuality),
+                             static_cast<float>(snapshot.linearWindow) });
             linearPhasePool.addJob(new LinearPhaseJob(eqEngine, snapshot, sampleRate,
                                                       pendingLatencySamples, linearJobRunning),
                                    true);
@@ -1405,40 +2011,8 @@ void EQProAudioProcessor::timerCallback()
         lastSnapshotHash = hash;
         activeSnapshot.store(nextIndex);
     }
-
-    static int rmsLogTick = 0;
-    static int lastLogMode = -1;
-    static int lastLogQuality = -1;
-    if (++rmsLogTick >= 30)
-    {
-        rmsLogTick = 0;
-        const int mode = eqEngine.getLastRmsPhaseMode();
-        const int quality = eqEngine.getLastRmsQuality();
-        const float preDb = eqEngine.getLastPreRmsDb();
-        const float postDb = eqEngine.getLastPostRmsDb();
-        if (mode != lastLogMode || quality != lastLogQuality
-            || std::abs(postDb - preDb) > 0.5f)
-        {
-            lastLogMode = mode;
-            lastLogQuality = quality;
-            logStartup("RMS delta: mode=" + juce::String(mode)
-                       + " quality=" + juce::String(quality)
-                       + " pre=" + juce::String(preDb, 2) + " dB"
-                       + " post=" + juce::String(postDb, 2) + " dB"
-                       + " delta=" + juce::String(postDb - preDb, 2) + " dB");
-        }
-    }
-
-    const int pendingQualityLog = pendingAdaptiveQualityLog.exchange(999);
-    if (pendingQualityLog != 999)
-    {
-        logStartup("Adaptive quality offset: " + juce::String(pendingQualityLog));
-        pendingLinearRebuild = true;
-        lastParamChangeTick = snapshotTick - 6;
-    }
 }
 
-
 #if 0
 void EQProAudioProcessor::rebuildLinearPhase(int taps, double sampleRate, int channels)
 {
@@ -1496,45 +2070,45 @@ void EQProAudioProcessor::rebuildLinearPhase(int taps, double sampleRate, int ch
         uint32_t mask = maskAll;
         switch (target)
         {
-            case kMsAll: mask = maskAll; break;
-            case kMsStereoFront: mask = maskForPair("L", "R"); break;
-            case kMsLeft: mask = maskFor("L"); break;
-            case kMsRight: mask = maskFor("R"); break;
-            case kMsMidFront: mask = maskForPair("L", "R"); break;
-            case kMsSideFront: mask = maskForPair("L", "R"); break;
-            case kMsCentre: mask = maskFor("C"); break;
-            case kMsLfe: mask = maskFor("LFE"); break;
-            case kMsStereoRear: mask = maskForPair("Ls", "Rs"); break;
-            case kMsLs: mask = maskFor("Ls"); break;
-            case kMsRs: mask = maskFor("Rs"); break;
-            case kMsMidRear: mask = maskForPair("Ls", "Rs"); break;
-            case kMsSideRear: mask = maskForPair("Ls", "Rs"); break;
-            case kMsStereoLateral: mask = maskForPair("Lrs", "Rrs"); break;
-            case kMsLrs: mask = maskFor("Lrs"); break;
-            case kMsRrs: mask = maskFor("Rrs"); break;
-            case kMsMidLateral: mask = maskForPair("Lrs", "Rrs"); break;
-            case kMsSideLateral: mask = maskForPair("Lrs", "Rrs"); break;
-            case kMsCs: mask = maskFor("Cs"); break;
-            case kMsStereoFrontWide: mask = maskForPair("Lw", "Rw"); break;
-            case kMsLw: mask = maskFor("Lw"); break;
-            case kMsRw: mask = maskFor("Rw"); break;
-            case kMsMidFrontWide: mask = maskForPair("Lw", "Rw"); break;
-            case kMsSideFrontWide: mask = maskForPair("Lw", "Rw"); break;
-            case kMsStereoTopFront: mask = maskForPair("TFL", "TFR"); break;
-            case kMsTfl: mask = maskFor("TFL"); break;
-            case kMsTfr: mask = maskFor("TFR"); break;
-            case kMsMidTopFront: mask = maskForPair("TFL", "TFR"); break;
-            case kMsSideTopFront: mask = maskForPair("TFL", "TFR"); break;
-            case kMsStereoTopRear: mask = maskForPair("TRL", "TRR"); break;
-            case kMsTrl: mask = maskFor("TRL"); break;
-            case kMsTrr: mask = maskFor("TRR"); break;
-            case kMsMidTopRear: mask = maskForPair("TRL", "TRR"); break;
-            case kMsSideTopRear: mask = maskForPair("TRL", "TRR"); break;
-            case kMsStereoTopMiddle: mask = maskForPair("TML", "TMR"); break;
-            case kMsTml: mask = maskFor("TML"); break;
-            case kMsTmr: mask = maskFor("TMR"); break;
-            case kMsMidTopMiddle: mask = maskForPair("TML", "TMR"); break;
-            case kMsSideTopMiddle: mask = maskForPair("TML", "TMR"); break;
+            case eqdsp::kMsAll: mask = maskAll; break;
+            case eqdsp::kMsStereoFront: mask = maskForPair("L", "R"); break;
+            case eqdsp::kMsLeft: mask = maskFor("L"); break;
+            case eqdsp::kMsRight: mask = maskFor("R"); break;
+            case eqdsp::kMsMidFront: mask = maskForPair("L", "R"); break;
+            case eqdsp::kMsSideFront: mask = maskForPair("L", "R"); break;
+            case eqdsp::kMsCentre: mask = maskFor("C"); break;
+            case eqdsp::kMsLfe: mask = maskFor("LFE"); break;
+            case eqdsp::kMsStereoRear: mask = maskForPair("Ls", "Rs"); break;
+            case eqdsp::kMsLs: mask = maskFor("Ls"); break;
+            case eqdsp::kMsRs: mask = maskFor("Rs"); break;
+            case eqdsp::kMsMidRear: mask = maskForPair("Ls", "Rs"); break;
+            case eqdsp::kMsSideRear: mask = maskForPair("Ls", "Rs"); break;
+            case eqdsp::kMsStereoLateral: mask = maskForPair("Lrs", "Rrs"); break;
+            case eqdsp::kMsLrs: mask = maskFor("Lrs"); break;
+            case eqdsp::kMsRrs: mask = maskFor("Rrs"); break;
+            case eqdsp::kMsMidLateral: mask = maskForPair("Lrs", "Rrs"); break;
+            case eqdsp::kMsSideLateral: mask = maskForPair("Lrs", "Rrs"); break;
+            case eqdsp::kMsCs: mask = maskFor("Cs"); break;
+            case eqdsp::kMsStereoFrontWide: mask = maskForPair("Lw", "Rw"); break;
+            case eqdsp::kMsLw: mask = maskFor("Lw"); break;
+            case eqdsp::kMsRw: mask = maskFor("Rw"); break;
+            case eqdsp::kMsMidFrontWide: mask = maskForPair("Lw", "Rw"); break;
+            case eqdsp::kMsSideFrontWide: mask = maskForPair("Lw", "Rw"); break;
+            case eqdsp::kMsStereoTopFront: mask = maskForPair("TFL", "TFR"); break;
+            case eqdsp::kMsTfl: mask = maskFor("TFL"); break;
+            case eqdsp::kMsTfr: mask = maskFor("TFR"); break;
+            case eqdsp::kMsMidTopFront: mask = maskForPair("TFL", "TFR"); break;
+            case eqdsp::kMsSideTopFront: mask = maskForPair("TFL", "TFR"); break;
+            case eqdsp::kMsStereoTopRear: mask = maskForPair("TRL", "TRR"); break;
+            case eqdsp::kMsTrl: mask = maskFor("TRL"); break;
+            case eqdsp::kMsTrr: mask = maskFor("TRR"); break;
+            case eqdsp::kMsMidTopRear: mask = maskForPair("TRL", "TRR"); break;
+            case eqdsp::kMsSideTopRear: mask = maskForPair("TRL", "TRR"); break;
+            case eqdsp::kMsStereoTopMiddle: mask = maskForPair("TML", "TMR"); break;
+            case eqdsp::kMsTml: mask = maskFor("TML"); break;
+            case eqdsp::kMsTmr: mask = maskFor("TMR"); break;
+            case eqdsp::kMsMidTopMiddle: mask = maskForPair("TML", "TMR"); break;
+            case eqdsp::kMsSideTopMiddle: mask = maskForPair("TML", "TMR"); break;
             default: mask = maskAll; break;
         }
         bandChannelMasks[band] = mask;
@@ -1825,202 +2399,19 @@ uint64_t EQProAudioProcessor::buildSnapshot(eqdsp::ParamSnapshot& snapshot)
     const int ioChannels = juce::jmax(getTotalNumInputChannels(), getTotalNumOutputChannels());
     const int numChannels = juce::jmin(ioChannels, ParamIDs::kMaxChannels);
     snapshot.numChannels = numChannels;
-    snapshot.globalBypass = globalBypassParam != nullptr && globalBypassParam->load() > 0.5f;
-    snapshot.globalMix = globalMixParam != nullptr ? (globalMixParam->load() / 100.0f) : 1.0f;
-    snapshot.phaseMode = phaseModeParam != nullptr ? static_cast<int>(phaseModeParam->load()) : 0;
-    const int rawQuality =
-        linearQualityParam != nullptr ? static_cast<int>(linearQualityParam->load()) : 1;
-    // v4.6 beta: Quality is selectable in linear mode.
-    snapshot.linearQuality = rawQuality;
-    snapshot.linearWindow = linearWindowParam != nullptr ? static_cast<int>(linearWindowParam->load()) : 0;
-    // v4.6 beta: Oversampling follows quality, but only in linear mode.
-    snapshot.oversampling = rawQuality;
-    snapshot.outputTrimDb = outputTrimParam != nullptr ? outputTrimParam->load() : 0.0f;
-    snapshot.characterMode = characterModeParam != nullptr ? static_cast<int>(characterModeParam->load()) : 0;
-    snapshot.smartSolo = smartSoloParam != nullptr && smartSoloParam->load() > 0.5f;
-    snapshot.qMode = qModeParam != nullptr ? static_cast<int>(qModeParam->load()) : 0;
-    snapshot.qModeAmount = qModeAmountParam != nullptr ? qModeAmountParam->load() : 50.0f;
-    snapshot.spectralEnabled = spectralEnableParam != nullptr && spectralEnableParam->load() > 0.5f;
-    snapshot.spectralThresholdDb = spectralThresholdParam != nullptr ? spectralThresholdParam->load() : -24.0f;
-    snapshot.spectralRatio = spectralRatioParam != nullptr ? spectralRatioParam->load() : 2.0f;
-    snapshot.spectralAttackMs = spectralAttackParam != nullptr ? spectralAttackParam->load() : 20.0f;
-    snapshot.spectralReleaseMs = spectralReleaseParam != nullptr ? spectralReleaseParam->load() : 200.0f;
-    snapshot.spectralMix = spectralMixParam != nullptr ? (spectralMixParam->load() / 100.0f) : 1.0f;
-    snapshot.autoGainEnabled = autoGainEnableParam != nullptr && autoGainEnableParam->load() > 0.5f;
-    snapshot.gainScale = gainScaleParam != nullptr ? (gainScaleParam->load() / 100.0f) : 1.0f;
-    snapshot.phaseInvert = phaseInvertParam != nullptr && phaseInvertParam->load() > 0.5f;
 
-    for (int ch = 0; ch < numChannels; ++ch)
+    const auto loadLive = [](const std::atomic<float>* value, float fallback)
     {
+        return value != nullptr ? value->load() : fallback;
+    };
+    eqdsp::loadGlobalParams(globalParamPointers, loadLive, snapshot);
+    for (int ch = 0; ch < numChannels; ++ch)
         for (int band = 0; band < ParamIDs::kBandsPerChannel; ++band)
-        {
-            const auto& ptrs = bandParamPointers[ch][band];
-            auto& dst = snapshot.bands[ch][band];
-            if (ptrs.frequency != nullptr)
-                dst.frequencyHz = ptrs.frequency->load();
-            if (ptrs.gain != nullptr)
-                dst.gainDb = ptrs.gain->load();
-            if (ptrs.q != nullptr)
-                dst.q = ptrs.q->load();
-            if (ptrs.type != nullptr)
-                dst.type = static_cast<int>(ptrs.type->load());
-            dst.bypassed = ptrs.bypass != nullptr && ptrs.bypass->load() > 0.5f;
-            dst.msTarget = ptrs.msTarget != nullptr ? static_cast<int>(ptrs.msTarget->load()) : 0;
-            dst.slopeDb = ptrs.slope != nullptr ? ptrs.slope->load() : 12.0f;
-            dst.solo = ptrs.solo != nullptr && ptrs.solo->load() > 0.5f;
-            dst.mix = ptrs.mix != nullptr ? (ptrs.mix->load() / 100.0f) : 1.0f;
-            dst.dynEnabled = ptrs.dynEnable != nullptr && ptrs.dynEnable->load() > 0.5f;
-            dst.dynMode = ptrs.dynMode != nullptr ? static_cast<int>(ptrs.dynMode->load()) : 0;
-            dst.dynThresholdDb = ptrs.dynThreshold != nullptr ? ptrs.dynThreshold->load() : -24.0f;
-            dst.dynAttackMs = ptrs.dynAttack != nullptr ? ptrs.dynAttack->load() : 20.0f;
-            dst.dynReleaseMs = ptrs.dynRelease != nullptr ? ptrs.dynRelease->load() : 200.0f;
-            dst.dynAuto = ptrs.dynAuto != nullptr && ptrs.dynAuto->load() > 0.5f;
-            dst.dynExternal = ptrs.dynExternal != nullptr && ptrs.dynExternal->load() > 0.5f;
-            // v4.4 beta: Harmonic parameters (per-band, independent for each of 12 bands)
-            dst.oddHarmonicDb = ptrs.odd != nullptr ? ptrs.odd->load() : 0.0f;
-            dst.mixOdd = ptrs.mixOdd != nullptr ? (ptrs.mixOdd->load() / 100.0f) : 1.0f;
-            dst.evenHarmonicDb = ptrs.even != nullptr ? ptrs.even->load() : 0.0f;
-            dst.mixEven = ptrs.mixEven != nullptr ? (ptrs.mixEven->load() / 100.0f) : 1.0f;
-            dst.harmonicBypassed = ptrs.harmonicBypass != nullptr && ptrs.harmonicBypass->load() > 0.5f;
-
-            // Auto-activate a band if parameters deviate from defaults.
-            if (dst.bypassed)
-            {
-                constexpr float kEps = 1.0e-3f;
-                const float defaultFreq = kDefaultBandFreqs[static_cast<size_t>(band)];
-                const bool isDefault =
-                    std::abs(dst.frequencyHz - defaultFreq) < 0.01f
-                    && std::abs(dst.gainDb) < kEps
-                    && std::abs(dst.q - 0.707f) < kEps
-                    && dst.type == 0
-                    && std::abs(dst.slopeDb - 12.0f) < kEps
-                    && std::abs(dst.mix - 1.0f) < kEps
-                    && dst.msTarget == 0
-                    && !dst.solo;
-                if (! isDefault)
-                    dst.bypassed = false;
-            }
-        }
-    }
-
-    snapshot.msTargets.fill(0);
-    snapshot.bandChannelMasks.fill(0);
-    const uint32_t maskAll = (numChannels >= 32)
-        ? 0xFFFFFFFFu
-        : (numChannels > 0 ? ((1u << static_cast<uint32_t>(numChannels)) - 1u) : 0u);
+            eqdsp::loadBandParams(bandParamPointers[ch][band], band, loadLive, snapshot.bands[ch][band]);
+    applySnapshotMorph(snapshot, numChannels);
 
     const auto& channelNames = cachedChannelNames.empty() ? getCurrentChannelNames() : cachedChannelNames;
-    auto findIndex = [&channelNames](const juce::String& name) -> int
-    {
-        for (int i = 0; i < static_cast<int>(channelNames.size()); ++i)
-            if (channelNames[static_cast<size_t>(i)] == name)
-                return i;
-        return -1;
-    };
-    auto maskForIndex = [&](int index) -> uint32_t
-    {
-        return (index >= 0 && index < numChannels) ? (1u << static_cast<uint32_t>(index)) : 0u;
-    };
-    auto maskFor = [&](const juce::String& name) -> uint32_t
-    {
-        const int idx = findIndex(name);
-        return maskForIndex(idx);
-    };
-    auto maskForPair = [&](const juce::String& left, const juce::String& right) -> uint32_t
-    {
-        return maskFor(left) | maskFor(right);
-    };
-    const int sourceChannel = juce::jlimit(0, numChannels - 1, selectedChannelIndex.load());
-    const int lIndex = findIndex("L");
-    const int rIndex = findIndex("R");
-    const uint32_t maskL = maskForIndex(lIndex >= 0 ? lIndex : 0);
-    const uint32_t maskR = maskForIndex(rIndex >= 0 ? rIndex : (numChannels > 1 ? 1 : 0));
-    const uint32_t maskStereo = maskL | maskR;
-
-    for (int band = 0; band < ParamIDs::kBandsPerChannel; ++band)
-    {
-        const int target = snapshot.bands[sourceChannel][band].msTarget;
-        int msTarget = 0;
-        uint32_t mask = maskAll;
-
-        // Map UI selection to a channel mask and optional M/S target.
-        switch (target)
-        {
-            case kMsAll: mask = maskAll; break;
-            case kMsStereoFront: mask = maskStereo; break;
-            case kMsLeft: mask = maskL; break;
-            case kMsRight: mask = maskR; break;
-            case kMsMidFront: msTarget = 1; mask = maskStereo; break;
-            case kMsSideFront: msTarget = 2; mask = maskStereo; break;
-            case kMsCentre: mask = maskFor("C"); break;
-            case kMsLfe: mask = maskFor("LFE"); break;
-            case kMsStereoRear: mask = maskForPair("Ls", "Rs"); break;
-            case kMsLs: mask = maskFor("Ls"); break;
-            case kMsRs: mask = maskFor("Rs"); break;
-            case kMsMidRear: msTarget = 1; mask = maskForPair("Ls", "Rs"); break;
-            case kMsSideRear: msTarget = 2; mask = maskForPair("Ls", "Rs"); break;
-            case kMsStereoLateral: mask = maskForPair("Lrs", "Rrs"); break;
-            case kMsLrs: mask = maskFor("Lrs"); break;
-            case kMsRrs: mask = maskFor("Rrs"); break;
-            case kMsMidLateral: msTarget = 1; mask = maskForPair("Lrs", "Rrs"); break;
-            case kMsSideLateral: msTarget = 2; mask = maskForPair("Lrs", "Rrs"); break;
-            case kMsCs: mask = maskFor("Cs"); break;
-            case kMsStereoFrontWide: mask = maskForPair("Lw", "Rw"); break;
-            case kMsLw: mask = maskFor("Lw"); break;
-            case kMsRw: mask = maskFor("Rw"); break;
-            case kMsMidFrontWide: msTarget = 1; mask = maskForPair("Lw", "Rw"); break;
-            case kMsSideFrontWide: msTarget = 2; mask = maskForPair("Lw", "Rw"); break;
-            case kMsStereoTopFront: mask = maskForPair("TFL", "TFR"); break;
-            case kMsTfl: mask = maskFor("TFL"); break;
-            case kMsTfr: mask = maskFor("TFR"); break;
-            case kMsMidTopFront: msTarget = 1; mask = maskForPair("TFL", "TFR"); break;
-            case kMsSideTopFront: msTarget = 2; mask = maskForPair("TFL", "TFR"); break;
-            case kMsStereoTopRear: mask = maskForPair("TRL", "TRR"); break;
-            case kMsTrl: mask = maskFor("TRL"); break;
-            case kMsTrr: mask = maskFor("TRR"); break;
-            case kMsMidTopRear: msTarget = 1; mask = maskForPair("TRL", "TRR"); break;
-            case kMsSideTopRear: msTarget = 2; mask = maskForPair("TRL", "TRR"); break;
-            case kMsStereoTopMiddle: mask = maskForPair("TML", "TMR"); break;
-            case kMsTml: mask = maskFor("TML"); break;
-            case kMsTmr: mask = maskFor("TMR"); break;
-            case kMsMidTopMiddle: msTarget = 1; mask = maskForPair("TML", "TMR"); break;
-            case kMsSideTopMiddle: msTarget = 2; mask = maskForPair("TML", "TMR"); break;
-            default: mask = maskAll; break;
-        }
-
-        // Guard against missing channel labels: fall back to full mask.
-        if (mask == 0u)
-        {
-            mask = maskAll;
-            msTarget = 0;
-        }
-        const auto maskBitCount = [](uint32_t value)
-        {
-            int count = 0;
-            while (value != 0)
-            {
-                value &= (value - 1u);
-                ++count;
-            }
-            return count;
-        };
-        // Only allow MS targets when a stereo pair is present.
-        if (msTarget != 0 && maskBitCount(mask) < 2)
-            msTarget = 0;
-
-        snapshot.msTargets[band] = msTarget;
-        snapshot.bandChannelMasks[band] = mask;
-
-        // For multi-channel selections, mirror the band parameters to the covered channels.
-        if (maskBitCount(mask) > 1)
-        {
-            for (int ch = 0; ch < numChannels; ++ch)
-            {
-                if ((mask & (1u << static_cast<uint32_t>(ch))) != 0)
-                    snapshot.bands[ch][band] = snapshot.bands[sourceChannel][band];
-            }
-        }
-    }
+    eqdsp::routeBands(snapshot, channelNames, selectedChannelIndex.load());
 
     auto hash = uint64_t { 1469598103934665603ull };
     const auto hashFloat = [&hash](float value)
@@ -2052,6 +2443,8 @@ uint64_t EQProAudioProcessor::buildSnapshot(eqdsp::ParamSnapshot& snapshot)
     hashFloat(snapshot.spectralAttackMs);
     hashFloat(snapshot.spectralReleaseMs);
     hashFloat(snapshot.spectralMix);
+    hashFloat(static_cast<float>(snapshot.spectralLink));
+    hashFloat(static_cast<float>(snapshot.spectralBands));
     hashBool(snapshot.autoGainEnabled);
     hashFloat(snapshot.gainScale);
     hashBool(snapshot.phaseInvert);
@@ -1,21 +1,72 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include "HalfBandDecimator.h"
+#include "../util/ParamIDs.h"
 #include "../util/RingBuffer.h"
 
 namespace eqdsp
 {
 // Analyzer tap to capture audio into a FIFO for UI FFT.
+// Input is reduced to the analyzer rate (<= ~50 kHz) by a chain of half-band decimators.
 class AnalyzerTap
 {
 public:
-    // Prepare FIFO size.
-    void prepare(int fifoSize);
-    // Push audio samples (audio thread).
-    void push(const float* data, int numSamples);
+    // What the tap feeds the analyzer; powerSum pushes every channel as one frame.
+    enum class Source
+    {
+        channel = 0,
+        sum,
+        mid,
+        side,
+        powerSum
+    };
+
+    static constexpr int kMaxStages = 6;
+
+    // Prepare FIFO size (in analyzer-rate samples), decimation for sampleRate, and frame channels.
+    void prepare(int fifoSize, double sampleRate, int numChannels);
+    // Select the source; safe from any thread, applied on the next push.
+    void setSource(Source source, int channel);
+    // Feed only every strideth block to the FIFO (audio thread); the analyzer rate is unchanged, it
+    // just sees fewer frames. 1 = every block.
+    void setBlockStride(int stride);
+    // Push a block (audio thread); extraStages removes additional 2x oversampling.
+    void pushBlock(const juce::AudioBuffer<float>& buffer, int numChannels, int extraStages = 0);
+    // Push mono audio samples (audio thread).
+    void push(const float* data, int numSamples, int extraStages = 0);
+    // Keep the FIFO moving with silence for numSamples input samples (audio thread).
+    void pushSilence(int numSamples, int extraStages = 0);
+    // Sample rate of the samples in the FIFO.
+    double getOutputSampleRate() const;
     // Get FIFO for UI reads.
     AudioFifo& getFifo();
 
 private:
+    static constexpr int kChunk = 512;
+
+    // Advance the block stride counter; false when this block is skipped.
+    bool takeBlock();
+    // Pick up a pending source change; resets decimator state when it changes.
+    void applyPendingSource(int numChannels);
+    // Decimate the first frames scratch channels and push them.
+    void decimateAndPush(int frames, int numSamples, int extraStages);
+
     AudioFifo fifo;
+    int baseStages = 0;
+    std::atomic<double> outputSampleRate { 48000.0 };
+    int fifoChannels = 1;
+
+    std::atomic<int> requestedSource { static_cast<int>(Source::channel) };
+    std::atomic<int> requestedChannel { 0 };
+    Source activeSource = Source::channel;
+    int activeChannel = 0;
+    int activeFrames = 1;
+    int blockStride = 1;
+    int strideCounter = 0;
+
+    std::array<std::array<float, kChunk>, ParamIDs::kMaxChannels> scratch {};
+    std::array<std::array<HalfBandDecimator, kMaxStages>, ParamIDs::kMaxChannels> decimators {};
 };
 } // namespace eqdsp
@@ -0,0 +1,173 @@
+#include "CpuGovernor.h"
+#include "../util/AsyncLog.h"
+#include <cmath>
+
+namespace eqdsp
+{
+const char* CpuGovernor::getStepName(int step)
+{
+    static constexpr const char* names[numSteps] {
+        "analyzer thinning", "meter true peak", "oversampling", "FIR length -1", "FIR length -2"
+    };
+    return step >= 0 && step < numSteps ? names[step] : "unknown";
+}
+
+void CpuGovernor::prepare(double sampleRate, int maxBlockSize)
+{
+    juce::ignoreUnused(maxBlockSize);
+    sampleRateHz = sampleRate > 0.0 ? sampleRate : 48000.0;
+    // Costs per sample change with the rate; start learning afresh but keep the shed steps.
+    for (auto& model : models)
+        model = {};
+    measuredSaving.fill(-1.0);
+    recoverHold.fill(kRecoverHoldSeconds);
+    restoredAt.fill(-1.0e9);
+    pendingMeasurement = -1;
+    pressureSeconds = 0.0;
+    quietSeconds = 0.0;
+}
+
+bool CpuGovernor::isApplicable(int step, const Context& context) const noexcept
+{
+    switch (step)
+    {
+        case analyzerThinning: return models[StageProfiler::taps].mean > 0.0;
+        case meterTruePeak: return models[StageProfiler::meters].mean > 0.0;
+        case oversampling: return context.phaseMode == 0 && context.oversamplingIndex > 0;
+        case firLength1:
+        case firLength2: return context.phaseMode != 0;
+        default: break;
+    }
+    return false;
+}
+
+double CpuGovernor::estimatedSaving(int step) const noexcept
+{
+    if (measuredSaving[static_cast<size_t>(step)] >= 0.0)
+        return measuredSaving[static_cast<size_t>(step)];
+    // Priors until the step has been measured.
+    const auto cost = [this](StageProfiler::Stage stage) { return models[static_cast<size_t>(stage)].mean; };
+    switch (step)
+    {
+        case analyzerThinning: return 0.5 * cost(StageProfiler::taps);
+        case meterTruePeak: return 0.6 * cost(StageProfiler::meters);
+        case oversampling:
+            return 0.5 * (cost(StageProfiler::iir) + cost(StageProfiler::oversampleUp)
+                          + cost(StageProfiler::oversampleDown));
+        case firLength1:
+        case firLength2: return 0.5 * cost(StageProfiler::fir);
+        default: break;
+    }
+    return 0.0;
+}
+
+void CpuGovernor::applyStep(int step, bool shed) noexcept
+{
+    if (shed)
+        mask |= 1u << step;
+    else
+        mask &= ~(1u << step);
+    appliedMask.store(mask, std::memory_order_relaxed);
+    lastChangeSeconds = clockSeconds;
+    pressureSeconds = 0.0;
+    quietSeconds = 0.0;
+    rebuildOutput();
+}
+
+void CpuGovernor::rebuildOutput() noexcept
+{
+    const auto has = [this](int step) { return (mask & (1u << step)) != 0; };
+    output.analyzerStride = has(analyzerThinning) ? 2 : 1;
+    output.truePeak = ! has(meterTruePeak);
+    if (! has(oversampling))
+        output.oversamplingCap = 4;
+    output.firOffset = has(firLength2) ? -2 : (has(firLength1) ? -1 : 0);
+}
+
+bool CpuGovernor::update(const StageProfiler& profiler, int numSamples, const Context& context) noexcept
+{
+    if (numSamples <= 0)
+        return false;
+    const double blockSeconds = numSamples / sampleRateHz;
+    clockSeconds += blockSeconds;
+
+    // Per-sample cost model per stage: exponential mean and mean absolute deviation.
+    const auto& ticks = profiler.getBlockTicks();
+    const double alpha = juce::jmin(1.0, blockSeconds / kModelSeconds);
+    for (size_t s = 0; s < models.size(); ++s)
+    {
+        auto& model = models[s];
+        const double perSample = static_cast<double>(ticks[s]) / numSamples;
+        if (! model.primed)
+        {
+            model.mean = perSample;
+            model.primed = true;
+            continue;
+        }
+        const double error = perSample - model.mean;
+        model.mean += alpha * error;
+        model.deviation += alpha * (std::abs(error) - model.deviation);
+    }
+
+    const double budgetPerSample = profiler.getTicksPerSecond() / sampleRateHz;
+    if (budgetPerSample <= 0.0)
+        return false;
+    const auto& total = models[StageProfiler::total];
+    const double predicted = total.mean + 2.0 * total.deviation;
+    const double load = predicted / budgetPerSample;
+    predictedLoad.store(static_cast<float>(load), std::memory_order_relaxed);
+
+    const double sinceChange = clockSeconds - lastChangeSeconds;
+    // Once the model has settled on the shed configuration, record what the step actually saved.
+    if (pendingMeasurement >= 0 && sinceChange >= kDwellSeconds)
+    {
+        const auto step = static_cast<size_t>(pendingMeasurement);
+        measuredSaving[step] = juce::jmax(0.0, costBeforeShed[step] - total.mean);
+        pendingMeasurement = -1;
+    }
+
+    pressureSeconds = load > kDegradeLoad ? pressureSeconds + blockSeconds : 0.0;
+    if (pressureSeconds >= kDegradeHoldSeconds && sinceChange >= kDwellSeconds)
+    {
+        for (int step = 0; step < numSteps; ++step)
+        {
+            if ((mask & (1u << step)) != 0 || ! isApplicable(step, context))
+                continue;
+            const auto index = static_cast<size_t>(step);
+            if (clockSeconds - restoredAt[index] < kFlapWindowSeconds)
+                recoverHold[index] = juce::jmin(kMaxRecoverHoldSeconds, recoverHold[index] * 2.0);
+            costBeforeShed[index] = total.mean;
+            pendingMeasurement = step;
+            if (step == oversampling)
+                output.oversamplingCap = juce::jmax(0, context.oversamplingIndex - 1);
+            applyStep(step, true);
+            AsyncLog::post(AsyncLog::Event::governor, getStepName(step),
+                           { 1.0f, static_cast<float>(load), static_cast<float>(mask) });
+            return true;
+        }
+        // Nothing left to shed.
+        pressureSeconds = 0.0;
+        return false;
+    }
+
+    if (mask == 0)
+        return false;
+
+    // Restore the most recently shed step (highest priority index) when the load with it is low.
+    int last = numSteps - 1;
+    while ((mask & (1u << last)) == 0)
+        --last;
+    const double restoredLoad = (predicted + estimatedSaving(last)) / budgetPerSample;
+    quietSeconds = restoredLoad < kRecoverLoad ? quietSeconds + blockSeconds : 0.0;
+    if (quietSeconds < recoverHold[static_cast<size_t>(last)] || sinceChange < kDwellSeconds)
+        return false;
+
+    restoredAt[static_cast<size_t>(last)] = clockSeconds;
+    if (pendingMeasurement == last)
+        pendingMeasurement = -1;
+    applyStep(last, false);
+    AsyncLog::post(AsyncLog::Event::governor, getStepName(last),
+                   { 0.0f, static_cast<float>(restoredLoad), static_cast<float>(mask) });
+    return true;
+}
+} // namespace eqdsp
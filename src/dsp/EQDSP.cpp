@@ -186,6 +186,34 @@ void EQDSP::reset()
         }
 }
 
+void EQDSP::copyParameterState(const EQDSP& other)
+{
+    const int channels = juce::jmin(numChannels, other.numChannels);
+    for (int ch = 0; ch < channels; ++ch)
+        for (int band = 0; band < ParamIDs::kBandsPerChannel; ++band)
+        {
+            cachedParams[ch][band] = other.cachedParams[ch][band];
+            auto copySmoother = [](juce::SmoothedValue<float>& dest, const juce::SmoothedValue<float>& src)
+            {
+                dest.setCurrentAndTargetValue(src.getCurrentValue());
+                dest.setTargetValue(src.getTargetValue());
+            };
+            copySmoother(smoothFreq[ch][band], other.smoothFreq[ch][band]);
+            copySmoother(smoothGain[ch][band], other.smoothGain[ch][band]);
+            copySmoother(smoothQ[ch][band], other.smoothQ[ch][band]);
+            copySmoother(smoothMix[ch][band], other.smoothMix[ch][band]);
+            copySmoother(smoothDynThresh[ch][band], other.smoothDynThresh[ch][band]);
+            detectorEnv[ch][band] = other.detectorEnv[ch][band];
+            detectorEnvRms[ch][band] = other.detectorEnvRms[ch][band];
+        }
+    msTargets = other.msTargets;
+    bandChannelMasks = other.bandChannelMasks;
+    globalBypass = other.globalBypass;
+    smartSoloEnabled = other.smartSoloEnabled;
+    qMode = other.qMode;
+    qModeAmount = other.qModeAmount;
+}
+
 void EQDSP::setGlobalBypass(bool shouldBypass)
 {
     globalBypass = shouldBypass;
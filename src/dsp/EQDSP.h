@@ -17,6 +17,9 @@ public:
     void prepare(double sampleRate, int maxBlockSize, int numChannels);
     // Reset filter state.
     void reset();
+    // Takes over band parameters, smoother positions and detector envelopes from another
+    // instance (call after prepare(): a rate switch continues instead of gliding from defaults).
+    void copyParameterState(const EQDSP& other);
     // Global bypass toggle for IIR path.
     void setGlobalBypass(bool shouldBypass);
     // Smart solo logic.
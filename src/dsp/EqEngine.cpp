@@ -1,4 +1,6 @@
 #include "EqEngine.h"
+#include "../util/AsyncLog.h"
+#include "../util/StageProfiler.h"
 #include <algorithm>
 #include <cmath>
 #include <cstring>
@@ -19,6 +21,11 @@ void EqEngine::prepare(double sampleRate, int maxBlockSize, int numChannels)
     linearPhaseEq.reset();
     linearPhaseMsEq.prepare(sampleRate, maxBlockSize, 2);
     linearPhaseMsEq.reset();
+    // Spectral frames keep their duration (and bin width) across rates: 2048 at 44.1/48 kHz,
+    // 4096 at 88.2/96 kHz, 8192 at 176.4/192 kHz.
+    // Overlap and window follow the quality setting per block (see process()).
+    spectralFftOrder = 11 + juce::jlimit(-1, 2, juce::roundToInt(std::log2(sampleRate / 48000.0)));
+    spectralDsp.setFrameConfig(spectralFftOrder, 2, SpectralDynamicsDSP::WindowType::sqrtHann);
     spectralDsp.prepare(sampleRate, maxBlockSize, numChannels);
     spectralDsp.reset();
 
@@ -28,15 +35,44 @@ void EqEngine::prepare(double sampleRate, int maxBlockSize, int numChannels)
     dryDelayBuffer.clear();
     dryDelayWritePos = 0;
     mixDelaySamples = 0;
-    minPhaseBuffer.setSize(numChannels, maxBlockSize);
-    minPhaseBuffer.clear();
     minPhaseDelayBuffer.setSize(numChannels, maxPreparedBlockSize + maxDelaySamples + 1);
     minPhaseDelayBuffer.clear();
     minPhaseDelayWritePos = 0;
     minPhaseDelaySamples = 0;
-    constexpr int kMaxEqOversampleFactor = 16;
-    oversampledBuffer.setSize(numChannels, maxBlockSize * kMaxEqOversampleFactor);
-    oversampledBuffer.clear();
+    // Every realtime oversampling factor is built here so quality or governor changes only switch.
+    preparedChannels = numChannels;
+    oversamplerLatencies.fill(0);
+    for (int index = 1; index <= kMaxOversamplingIndex; ++index)
+    {
+        auto& stage = oversamplers[static_cast<size_t>(index)];
+        stage = std::make_unique<juce::dsp::Oversampling<float>>(
+            static_cast<size_t>(juce::jmax(1, numChannels)),
+            static_cast<size_t>(index),
+            juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR,
+            true);
+        stage->initProcessing(static_cast<size_t>(maxBlockSize));
+        oversamplerLatencies[static_cast<size_t>(index)] = static_cast<int>(stage->getLatencyInSamples());
+    }
+    oversamplingIndex = 0;
+    oversamplingLatencySamples = 0;
+    // Both realtime paths get buffers for the largest factor, so a switch only changes the rate.
+    oversampledBlockSize = maxBlockSize * (1 << kMaxOversamplingIndex);
+    for (auto& path : realtimePaths)
+    {
+        path.eq.prepare(sampleRate, oversampledBlockSize, numChannels);
+        path.eq.reset();
+        path.padBuffer.setSize(numChannels, oversamplerLatencies[kMaxOversamplingIndex] + 1);
+        path.padBuffer.clear();
+        path.padWritePos = 0;
+        path.padSamples = 0;
+        path.index = -1;
+    }
+    activeRealtimePath = 0;
+    realtimeFadeBuffer.setSize(numChannels, maxBlockSize);
+    realtimeFadeBuffer.clear();
+    realtimeFadePosition = 0;
+    realtimeFadeHoldSamples = 0;
+    realtimeFadeTotalSamples = 0;
     harmonicTapBuffer.setSize(numChannels, maxBlockSize);
     harmonicTapBuffer.clear();
     harmonicTapOversampledBuffer.setSize(numChannels, maxBlockSize * 16);
@@ -52,12 +88,6 @@ void EqEngine::prepare(double sampleRate, int maxBlockSize, int numChannels)
     forceTestGainSmoothed.reset(sampleRate, 0.02);
     forceTestGainSmoothed.setCurrentAndTargetValue(1.0f);
 
-    meterSkipFactor = 1;
-    if (sampleRateHz >= 256000.0)
-        meterSkipFactor = 3;
-    else if (sampleRateHz >= 192000.0)
-        meterSkipFactor = 2;
-    meterSkipCounter = 0;
     linearSwapSamplesRemaining = 0;
     linearSwapTotalSamples = 0;
     linearPrevBuffer.setSize(0, 0);
@@ -70,6 +100,16 @@ void EqEngine::prepare(double sampleRate, int maxBlockSize, int numChannels)
 void EqEngine::reset()
 {
     eqDsp.reset();
+    for (auto& path : realtimePaths)
+    {
+        path.eq.reset();
+        path.padBuffer.clear();
+        path.padWritePos = 0;
+    }
+    for (auto& stage : oversamplers)
+        if (stage != nullptr)
+            stage->reset();
+    realtimeFadeTotalSamples = 0;
     linearPhaseEq.reset();
     linearPhaseMsEq.reset();
     spectralDsp.reset();
@@ -102,7 +142,7 @@ void EqEngine::process(juce::AudioBuffer<float>& buffer,
     const int bufferChannels = buffer.getNumChannels();
     const int numChannels = juce::jmin(bufferChannels,
                                        snapshotChannels > 0 ? snapshotChannels : bufferChannels);
-    updateOversampling(snapshot, sampleRateHz, maxPreparedBlockSize, numChannels);
+    updateOversampling(snapshot);
     const int previousPhaseMode = lastPhaseMode;
     lastPhaseMode = snapshot.phaseMode;
     if (previousPhaseMode != snapshot.phaseMode)
@@ -139,10 +179,13 @@ void EqEngine::process(juce::AudioBuffer<float>& buffer,
     eqDsp.setSmartSoloEnabled(snapshot.smartSolo);
     eqDsp.setQMode(snapshot.qMode);
     eqDsp.setQModeAmount(snapshot.qModeAmount);
-    eqDspOversampled.setGlobalBypass(snapshot.globalBypass);
-    eqDspOversampled.setSmartSoloEnabled(snapshot.smartSolo);
-    eqDspOversampled.setQMode(snapshot.qMode);
-    eqDspOversampled.setQModeAmount(snapshot.qModeAmount);
+    for (auto& path : realtimePaths)
+    {
+        path.eq.setGlobalBypass(snapshot.globalBypass);
+        path.eq.setSmartSoloEnabled(snapshot.smartSolo);
+        path.eq.setQMode(snapshot.qMode);
+        path.eq.setQModeAmount(snapshot.qModeAmount);
+    }
 
     const int preChannels = juce::jmax(1, buffer.getNumChannels());
     const double preRms = computeRms(buffer, preChannels);
@@ -151,39 +194,9 @@ void EqEngine::process(juce::AudioBuffer<float>& buffer,
     lastRmsPhaseMode.store(snapshot.phaseMode, std::memory_order_relaxed);
     lastRmsQuality.store(snapshot.linearQuality, std::memory_order_relaxed);
 
-    if (buffer.getNumChannels() > 0)
     {
-        const float* data = buffer.getReadPointer(0);
-        const int samples = buffer.getNumSamples();
-        int stride = 1;
-        if (sampleRateHz >= 192000.0)
-            stride = 4;
-        else if (sampleRateHz >= 96000.0)
-            stride = 2;
-        if (samples > 4096)
-            stride = juce::jmax(stride, samples / 2048);
-
-        if (stride == 1)
-        {
-            preTap.push(data, samples);
-        }
-        else
-        {
-            constexpr int kChunk = 512;
-            float temp[kChunk];
-            int idx = 0;
-            for (int i = 0; i < samples; i += stride)
-            {
-                temp[idx++] = data[i];
-                if (idx == kChunk)
-                {
-                    preTap.push(temp, idx);
-                    idx = 0;
-                }
-            }
-            if (idx > 0)
-                preTap.push(temp, idx);
-        }
+        const StageProfiler::Scope scope(profiler, StageProfiler::taps);
+        preTap.pushBlock(buffer, numChannels);
     }
 
     const bool bypassed = snapshot.globalBypass;
@@ -197,6 +210,7 @@ void EqEngine::process(juce::AudioBuffer<float>& buffer,
         || std::abs(snapshot.globalMix - 1.0f) > 0.0001f;
     if (applyGlobalMix)
     {
+        const StageProfiler::Scope scope(profiler, StageProfiler::mix);
         const int latencySamples = getLatencySamples();
         // v4.6 beta: Minimum-phase compensation for realtime oversampling.
         // Keep dry/wet perfectly aligned when oversampling introduces latency.
@@ -241,118 +255,71 @@ void EqEngine::process(juce::AudioBuffer<float>& buffer,
             params.useExternalDetector = src.dynExternal;
 
             eqDsp.updateBandParams(ch, band, params);
+            for (auto& path : realtimePaths)
+                path.eq.updateBandParams(ch, band, params);
             if (ch == 0)
+            {
                 eqDsp.updateMsBandParams(band, params);
+                for (auto& path : realtimePaths)
+                    path.eq.updateMsBandParams(band, params);
+            }
         }
     }
 
     eqDsp.setMsTargets(snapshot.msTargets);
     eqDsp.setBandChannelMasks(snapshot.bandChannelMasks);
-    eqDspOversampled.setMsTargets(snapshot.msTargets);
-    eqDspOversampled.setBandChannelMasks(snapshot.bandChannelMasks);
+    for (auto& path : realtimePaths)
+    {
+        path.eq.setMsTargets(snapshot.msTargets);
+        path.eq.setBandChannelMasks(snapshot.bandChannelMasks);
+    }
 
     const int phaseMode = snapshot.phaseMode;
-    const bool useOversampling = (phaseMode == 0 && oversamplingIndex > 0 && oversampler != nullptr);
     bool characterApplied = false;
-    if (useOversampling)
+    if (phaseMode == 0)
     {
-        auto block = juce::dsp::AudioBlock<float>(buffer);
-        auto upBlock = oversampler->processSamplesUp(block);
-        const int upSamples = static_cast<int>(upBlock.getNumSamples());
-        const int channels = juce::jmin(numChannels, static_cast<int>(upBlock.getNumChannels()));
-
-        std::vector<float*> upPtrs;
-        upPtrs.resize(static_cast<size_t>(channels));
-        for (int ch = 0; ch < channels; ++ch)
-            upPtrs[static_cast<size_t>(ch)] = upBlock.getChannelPointer(ch);
-        juce::AudioBuffer<float> upBuffer;
-        upBuffer.setDataToReferTo(upPtrs.data(), channels, upSamples);
-
-        harmonicTapOversampledBuffer.setSize(channels, upSamples, false, false, true);
-        harmonicTapOversampledBuffer.clear();
-        eqDspOversampled.process(upBuffer, detectorBuffer, &harmonicTapOversampledBuffer);
-
-        if (snapshot.characterMode > 0)
+        // Character runs inside the realtime path at every factor, so a crossfade between factors
+        // blends two equally coloured signals.
+        characterApplied = true;
+        auto& incoming = realtimePaths[static_cast<size_t>(activeRealtimePath)];
+        const int samples = buffer.getNumSamples();
+        const bool fading = realtimeFadePosition < realtimeFadeTotalSamples
+            && samples <= realtimeFadeBuffer.getNumSamples();
+        juce::AudioBuffer<float> outgoingBuffer;
+        if (fading)
         {
-            characterApplied = true;
-            const float drive = (snapshot.characterMode == 1) ? 1.5f : 2.5f;
-            const float norm = std::tanh(drive);
-            for (int ch = 0; ch < channels; ++ch)
-            {
-                auto* data = upBuffer.getWritePointer(ch);
-                for (int i = 0; i < upSamples; ++i)
-                {
-                    const float x = data[i] * drive;
-                    data[i] = std::tanh(x) / norm;
-                }
-            }
+            // The outgoing factor keeps running on a copy of the input until the ramp completes.
+            outgoingBuffer.setDataToReferTo(realtimeFadeBuffer.getArrayOfWritePointers(),
+                                            juce::jmin(numChannels, realtimeFadeBuffer.getNumChannels()),
+                                            samples);
+            for (int ch = 0; ch < outgoingBuffer.getNumChannels(); ++ch)
+                juce::FloatVectorOperations::copy(outgoingBuffer.getWritePointer(ch),
+                                                  buffer.getReadPointer(ch), samples);
+            processRealtimePath(realtimePaths[static_cast<size_t>(1 - activeRealtimePath)], outgoingBuffer,
+                                numChannels, snapshot.characterMode, detectorBuffer, false);
         }
+        processRealtimePath(incoming, buffer, numChannels, snapshot.characterMode, detectorBuffer, true);
 
-        oversampler->processSamplesDown(block);
-        
-        // v4.5 beta: Tap signal after harmonic processing for oversampled path
-        // Harmonics are processed inside eqDspOversampled, so tap after downsample
-        bool hasActiveHarmonics = false;
-        for (int ch = 0; ch < numChannels && !hasActiveHarmonics; ++ch)
+        if (fading)
         {
-            for (int band = 0; band < ParamIDs::kBandsPerChannel; ++band)
+            const StageProfiler::Scope scope(profiler, StageProfiler::mix);
+            const int ramp = juce::jmax(1, realtimeFadeTotalSamples - realtimeFadeHoldSamples);
+            const int channels = outgoingBuffer.getNumChannels();
+            for (int i = 0; i < samples; ++i)
             {
-                const auto& b = snapshot.bands[ch][band];
-                if (!b.harmonicBypassed && 
-                    ((b.oddHarmonicDb != 0.0f && b.mixOdd > 0.0f) || 
-                     (b.evenHarmonicDb != 0.0f && b.mixEven > 0.0f)))
+                const int elapsed = realtimeFadePosition + i - realtimeFadeHoldSamples;
+                const float t = juce::jlimit(0.0f, 1.0f, static_cast<float>(elapsed) / static_cast<float>(ramp));
+                for (int ch = 0; ch < channels; ++ch)
                 {
-                    hasActiveHarmonics = true;
-                    break;
+                    auto* wet = buffer.getWritePointer(ch);
+                    wet[i] = wet[i] * t + outgoingBuffer.getReadPointer(ch)[i] * (1.0f - t);
                 }
             }
+            realtimeFadePosition = juce::jmin(realtimeFadeTotalSamples, realtimeFadePosition + samples);
         }
-        
-        const int samples = harmonicTapOversampledBuffer.getNumSamples();
-        int stride = (oversamplingIndex > 0) ? (1 << oversamplingIndex) : 1;
-        const int perfStride = (sampleRateHz >= 192000.0 ? 4 : (sampleRateHz >= 96000.0 ? 2 : 1));
-        stride = juce::jmax(stride, stride * perfStride);
 
-        if (hasActiveHarmonics && harmonicTapOversampledBuffer.getNumChannels() > 0)
-        {
-            const float* data = harmonicTapOversampledBuffer.getReadPointer(0);
-            constexpr int kChunk = 512;
-            float temp[kChunk];
-            int idx = 0;
-            for (int i = 0; i < samples; i += stride)
-            {
-                temp[idx++] = data[i];
-                if (idx == kChunk)
-                {
-                    harmonicTap.push(temp, idx);
-                    idx = 0;
-                }
-            }
-            if (idx > 0)
-                harmonicTap.push(temp, idx);
-        }
-        else
-        {
-            // Keep the harmonic analyzer responsive even when harmonics are bypassed.
-            constexpr int kChunk = 512;
-            float temp[kChunk] = {};
-            int remaining = (samples + stride - 1) / stride;
-            while (remaining > 0)
-            {
-                const int block = juce::jmin(remaining, kChunk);
-                harmonicTap.push(temp, block);
-                remaining -= block;
-            }
-        }
-    }
-    else if (phaseMode == 0)
-    {
-        harmonicTapBuffer.setSize(numChannels, buffer.getNumSamples(), false, false, true);
-        harmonicTapBuffer.clear();
-        eqDsp.process(buffer, detectorBuffer, &harmonicTapBuffer);
-        
         // v4.5 beta: Tap signal after harmonic processing for realtime path
-        // Harmonics are processed inside eqDsp, so tap right after
+        // Harmonics are processed inside the path's EQ, so tap right after
         bool hasActiveHarmonics = false;
         for (int ch = 0; ch < numChannels && !hasActiveHarmonics; ++ch)
         {
@@ -369,58 +336,21 @@ void EqEngine::process(juce::AudioBuffer<float>& buffer,
             }
         }
         
-        const int samples = harmonicTapBuffer.getNumSamples();
-        int stride = 1;
-        if (sampleRateHz >= 192000.0)
-            stride = 4;
-        else if (sampleRateHz >= 96000.0)
-            stride = 2;
-        if (samples > 4096)
-            stride = juce::jmax(stride, samples / 2048);
-
-        if (hasActiveHarmonics && harmonicTapBuffer.getNumChannels() > 0)
-        {
-            const float* data = harmonicTapBuffer.getReadPointer(0);
-            if (stride == 1)
-            {
-                harmonicTap.push(data, samples);
-            }
-            else
-            {
-                constexpr int kChunk = 512;
-                float temp[kChunk];
-                int idx = 0;
-                for (int i = 0; i < samples; i += stride)
-                {
-                    temp[idx++] = data[i];
-                    if (idx == kChunk)
-                    {
-                        harmonicTap.push(temp, idx);
-                        idx = 0;
-                    }
-                }
-                if (idx > 0)
-                    harmonicTap.push(temp, idx);
-            }
-        }
+        // The tap removes the oversampling factor with extra half-band stages; silence keeps the
+        // harmonic analyzer responsive even when harmonics are bypassed.
+        const StageProfiler::Scope scope(profiler, StageProfiler::taps);
+        auto& harmonicSource = incoming.index > 0 ? harmonicTapOversampledBuffer : harmonicTapBuffer;
+        const int harmonicFactor = juce::jmax(0, incoming.index);
+        if (hasActiveHarmonics && harmonicSource.getNumChannels() > 0)
+            harmonicTap.pushBlock(harmonicSource, numChannels, harmonicFactor);
         else
-        {
-            // Keep the harmonic analyzer responsive even when harmonics are bypassed.
-            constexpr int kChunk = 512;
-            float temp[kChunk] = {};
-            int remaining = (samples + stride - 1) / stride;
-            while (remaining > 0)
-            {
-                const int block = juce::jmin(remaining, kChunk);
-                harmonicTap.push(temp, block);
-                remaining -= block;
-            }
-        }
+            harmonicTap.pushSilence(harmonicSource.getNumSamples(), harmonicFactor);
     }
     else
     {
         const int samples = buffer.getNumSamples();
-        const int latencySamples = getLatencySamples();
+        // The min-phase blend aligns to the FIR only; the spectral stage runs after the blend.
+        const int latencySamples = getEqLatencySamples();
         if (calibBuffer.getNumChannels() != numChannels
             || calibBuffer.getNumSamples() < samples)
         {
@@ -429,6 +359,21 @@ void EqEngine::process(juce::AudioBuffer<float>& buffer,
         for (int ch = 0; ch < numChannels; ++ch)
             juce::FloatVectorOperations::copy(calibBuffer.getWritePointer(ch),
                                               buffer.getReadPointer(ch), samples);
+
+        // Realtime reference pass (level calibration, mixed-phase blend, fallback). It is delayed by
+        // the FIR latency so it lines up with the centred linear-phase output.
+        harmonicTapBuffer.setSize(numChannels, calibBuffer.getNumSamples(), false, false, true);
+        harmonicTapBuffer.clear();
+        {
+            const StageProfiler::Scope scope(profiler, StageProfiler::calibration);
+            eqDsp.process(calibBuffer, detectorBuffer, &harmonicTapBuffer);
+            if (latencySamples > 0)
+            {
+                updateMinPhaseDelay(latencySamples, samples, numChannels);
+                applyMinPhaseDelay(calibBuffer, samples, latencySamples);
+            }
+        }
+
         float mixedPhaseAmount = 0.0f;
             bool hasSubtractive = false;
             for (int ch = 0; ch < numChannels && ! hasSubtractive; ++ch)
@@ -453,25 +398,6 @@ void EqEngine::process(juce::AudioBuffer<float>& buffer,
             if (hasSubtractive)
                 mixedPhaseAmount = 0.0f;
 
-            if (mixedPhaseAmount > 0.0f)
-            {
-                if (minPhaseBuffer.getNumChannels() != numChannels
-                    || minPhaseBuffer.getNumSamples() < samples)
-                {
-                    minPhaseBuffer.setSize(numChannels, samples);
-                }
-                for (int ch = 0; ch < numChannels; ++ch)
-                    juce::FloatVectorOperations::copy(minPhaseBuffer.getWritePointer(ch),
-                                                      buffer.getReadPointer(ch), samples);
-                // Minimum-phase pass for transient preservation in linear modes.
-                eqDsp.process(minPhaseBuffer, detectorBuffer, nullptr);
-                if (latencySamples > 0)
-                {
-                    updateMinPhaseDelay(latencySamples, samples, numChannels);
-                    applyMinPhaseDelay(minPhaseBuffer, samples, latencySamples);
-                }
-            }
-
             // Crossfade after FIR swaps to prevent zipper artifacts.
             const int pendingFade = pendingLinearFadeSamples.exchange(0);
             if (pendingFade > 0)
@@ -486,10 +412,13 @@ void EqEngine::process(juce::AudioBuffer<float>& buffer,
             if (! linearSafe)
             {
                 linearPhaseDropoutCounter.fetch_add(1);
-                eqDsp.process(buffer, detectorBuffer, nullptr);
+                for (int ch = 0; ch < numChannels; ++ch)
+                    juce::FloatVectorOperations::copy(buffer.getWritePointer(ch),
+                                                      calibBuffer.getReadPointer(ch), samples);
             }
             else
             {
+            const StageProfiler::Scope scope(profiler, StageProfiler::fir);
             // Linear-phase M/S is only applied to the front L/R pair.
             bool useMs = false;
             if (numChannels >= 2)
@@ -545,7 +474,7 @@ void EqEngine::process(juce::AudioBuffer<float>& buffer,
                 for (int ch = 0; ch < numChannels; ++ch)
                 {
                     auto* wet = buffer.getWritePointer(ch);
-                    const auto* minPhase = minPhaseBuffer.getReadPointer(ch);
+                    const auto* minPhase = calibBuffer.getReadPointer(ch);
                     for (int i = 0; i < samples; ++i)
                         wet[i] = wet[i] * dryMix + minPhase[i] * mixedPhaseAmount;
                 }
@@ -581,11 +510,6 @@ void EqEngine::process(juce::AudioBuffer<float>& buffer,
             // For now, tap after linear phase processing - harmonics will be in the final mix
             // TODO: This might need adjustment if harmonics are only in the reference path
             
-            // Realtime reference pass for post-mode RMS calibration.
-            harmonicTapBuffer.setSize(numChannels, calibBuffer.getNumSamples(), false, false, true);
-            harmonicTapBuffer.clear();
-            eqDsp.process(calibBuffer, detectorBuffer, &harmonicTapBuffer);
-            
             // v4.5 beta: For linear phase mode, tap from calibBuffer which has harmonics from eqDsp
             // The calibBuffer contains the realtime reference with harmonics, which is what we want to show
             bool hasActiveHarmonics = false;
@@ -604,55 +528,17 @@ void EqEngine::process(juce::AudioBuffer<float>& buffer,
                 }
             }
             
-            const int tapSamples = harmonicTapBuffer.getNumSamples();
-            int stride = 1;
-            if (sampleRateHz >= 192000.0)
-                stride = 4;
-            else if (sampleRateHz >= 96000.0)
-                stride = 2;
-            if (tapSamples > 4096)
-                stride = juce::jmax(stride, tapSamples / 2048);
-
-            if (hasActiveHarmonics && harmonicTapBuffer.getNumChannels() > 0)
+            // Silence keeps the harmonic analyzer responsive even when harmonics are bypassed.
             {
-                const float* data = harmonicTapBuffer.getReadPointer(0);
-                if (stride == 1)
-                {
-                    harmonicTap.push(data, tapSamples);
-                }
+                const StageProfiler::Scope scope(profiler, StageProfiler::taps);
+                if (hasActiveHarmonics && harmonicTapBuffer.getNumChannels() > 0)
+                    harmonicTap.pushBlock(harmonicTapBuffer, numChannels);
                 else
-                {
-                    constexpr int kChunk = 512;
-                    float temp[kChunk];
-                    int idx = 0;
-                    for (int i = 0; i < tapSamples; i += stride)
-                    {
-                        temp[idx++] = data[i];
-                        if (idx == kChunk)
-                        {
-                            harmonicTap.push(temp, idx);
-                            idx = 0;
-                        }
-                    }
-                    if (idx > 0)
-                        harmonicTap.push(temp, idx);
-                }
-            }
-            else
-            {
-                // Keep the harmonic analyzer responsive even when harmonics are bypassed.
-                constexpr int kChunk = 512;
-                float temp[kChunk] = {};
-                int remaining = (tapSamples + stride - 1) / stride;
-                while (remaining > 0)
-                {
-                    const int block = juce::jmin(remaining, kChunk);
-                    harmonicTap.push(temp, block);
-                    remaining -= block;
-                }
+                    harmonicTap.pushSilence(harmonicTapBuffer.getNumSamples());
             }
 
             // Fallback: if the linear output collapses, keep realtime EQ so audio never drops.
+            const StageProfiler::Scope scope(profiler, StageProfiler::calibration);
             const double linRms = computeRms(buffer, numChannels);
             const double refRms = computeRms(calibBuffer, numChannels);
             if (linRms < 1.0e-9 && refRms > 1.0e-6)
@@ -663,34 +549,35 @@ void EqEngine::process(juce::AudioBuffer<float>& buffer,
             }
     }
 
+    // Always run the spectral stage: it crossfades its own enable/disable and idles once faded out.
     spectralDsp.setEnabled(snapshot.spectralEnabled);
-    if (snapshot.spectralEnabled)
+    // High quality and above: 75% overlap with the lower-sidelobe Hann window (twice the frames).
+    const bool spectralHann = snapshot.linearQuality >= kSpectralHannQuality;
+    spectralDsp.setFrameConfig(spectralFftOrder,
+                               spectralHann ? 4 : 2,
+                               spectralHann ? SpectralDynamicsDSP::WindowType::hann
+                                            : SpectralDynamicsDSP::WindowType::sqrtHann);
+    spectralDsp.setParams(snapshot.spectralThresholdDb,
+                          snapshot.spectralRatio,
+                          snapshot.spectralAttackMs,
+                          snapshot.spectralReleaseMs,
+                          snapshot.spectralMix);
+    spectralDsp.setDetection(static_cast<SpectralDynamicsDSP::LinkMode>(juce::jlimit(0, 2, snapshot.spectralLink)),
+                             static_cast<SpectralDynamicsDSP::BandGrouping>(juce::jlimit(0, 2, snapshot.spectralBands)));
     {
-        spectralDsp.setParams(snapshot.spectralThresholdDb,
-                              snapshot.spectralRatio,
-                              snapshot.spectralAttackMs,
-                              snapshot.spectralReleaseMs,
-                              snapshot.spectralMix);
+        const StageProfiler::Scope scope(profiler, StageProfiler::spectral);
         spectralDsp.process(buffer);
     }
 
     if (snapshot.characterMode > 0 && ! characterApplied)
     {
-        const float drive = (snapshot.characterMode == 1) ? 1.5f : 2.5f;
-        const float norm = std::tanh(drive);
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-        {
-            auto* data = buffer.getWritePointer(ch);
-            for (int i = 0; i < buffer.getNumSamples(); ++i)
-            {
-                const float x = data[i] * drive;
-                data[i] = std::tanh(x) / norm;
-            }
-        }
+        const StageProfiler::Scope scope(profiler, StageProfiler::character);
+        applyCharacter(buffer, buffer.getNumChannels(), buffer.getNumSamples(), snapshot.characterMode);
     }
 
     if (applyGlobalMix)
     {
+        const StageProfiler::Scope scope(profiler, StageProfiler::mix);
         const int mixChannels = juce::jmin(numChannels, dryBuffer.getNumChannels());
         const int numSamples = buffer.getNumSamples();
         const float wetStart = globalMixSmoothed.getCurrentValue();
@@ -728,6 +615,7 @@ void EqEngine::process(juce::AudioBuffer<float>& buffer,
     if (snapshot.phaseMode != 0)
     {
         // Match linear/natural output level to realtime RMS before auto-gain.
+        const StageProfiler::Scope scope(profiler, StageProfiler::calibration);
         const int numSamples = buffer.getNumSamples();
         const int refChannels = juce::jmin(numChannels, calibBuffer.getNumChannels());
         auto mixSmoothed = globalMixSmoothed;
@@ -770,6 +658,7 @@ void EqEngine::process(juce::AudioBuffer<float>& buffer,
     }
 
     // Auto-gain matches the processed RMS to the input RMS.
+    const StageProfiler::Scope gainScope(profiler, StageProfiler::mix);
     float autoGainDb = 0.0f;
     if (snapshot.autoGainEnabled)
     {
@@ -814,20 +703,6 @@ void EqEngine::process(juce::AudioBuffer<float>& buffer,
             buffer.applyGainRamp(ch, 0, numSamples, startGain, endGain);
     }
 
-    const float forceDb = (forceTestEnabled.load() && snapshot.phaseMode == 0) ? 6.0f : 0.0f;
-    const float forceGain = juce::Decibels::decibelsToGain(forceDb);
-    forceTestGainSmoothed.setTargetValue(forceGain);
-    if (forceTestGainSmoothed.isSmoothing()
-        || std::abs(forceGain - 1.0f) > 0.0001f)
-    {
-        const int numSamples = buffer.getNumSamples();
-        const float startGain = forceTestGainSmoothed.getCurrentValue();
-        forceTestGainSmoothed.skip(numSamples);
-        const float endGain = forceTestGainSmoothed.getCurrentValue();
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-            buffer.applyGainRamp(ch, 0, numSamples, startGain, endGain);
-    }
-
     if (modeFadeSamplesRemaining > 0
         && modeFadeBuffer.getNumChannels() == buffer.getNumChannels()
         && modeFadeBuffer.getNumSamples() >= buffer.getNumSamples())
@@ -850,10 +725,10 @@ void EqEngine::process(juce::AudioBuffer<float>& buffer,
         }
     }
 
-    if (++meterSkipCounter >= meterSkipFactor)
+    // Every block is metered: loudness gating needs contiguous audio.
     {
+        const StageProfiler::Scope scope(profiler, StageProfiler::meters);
         meterTap.process(buffer, numChannels);
-        meterSkipCounter = 0;
     }
 
     if (modeFadeSamplesRemaining <= 0)
@@ -895,40 +770,8 @@ void EqEngine::process(juce::AudioBuffer<float>& buffer,
     lastPostRmsDb.store(juce::Decibels::gainToDecibels(static_cast<float>(postRms), -120.0f),
                         std::memory_order_relaxed);
 
-    if (buffer.getNumChannels() > 0)
-    {
-        const float* data = buffer.getReadPointer(0);
-        const int samples = buffer.getNumSamples();
-        int stride = 1;
-        if (sampleRateHz >= 192000.0)
-            stride = 4;
-        else if (sampleRateHz >= 96000.0)
-            stride = 2;
-        if (samples > 4096)
-            stride = juce::jmax(stride, samples / 2048);
-
-        if (stride == 1)
-        {
-            postTap.push(data, samples);
-        }
-        else
-        {
-            constexpr int kChunk = 512;
-            float temp[kChunk];
-            int idx = 0;
-            for (int i = 0; i < samples; i += stride)
-            {
-                temp[idx++] = data[i];
-                if (idx == kChunk)
-                {
-                    postTap.push(temp, idx);
-                    idx = 0;
-                }
-            }
-            if (idx > 0)
-                postTap.push(temp, idx);
-        }
-    }
+    const StageProfiler::Scope scope(profiler, StageProfiler::taps);
+    postTap.pushBlock(buffer, numChannels);
 }
 
 float EqEngine::getLastPreRmsDb() const
@@ -977,12 +820,39 @@ void EqEngine::setForceTestEnabled(bool enabled)
     forceTestEnabled.store(enabled);
 }
 
-void EqEngine::setForceTestEnabled(bool enabled)
+void EqEngine::setProfiler(StageProfiler* profilerIn)
 {
-    forceTestEnabled.store(enabled);
+    profiler = profilerIn;
+}
+
+void EqEngine::setOversamplingCap(int maxIndex)
+{
+    oversamplingCap = juce::jlimit(0, 4, maxIndex);
+}
+
+int EqEngine::getOversamplingIndex() const
+{
+    return oversamplingIndex;
+}
+
+void EqEngine::applyCharacter(juce::AudioBuffer<float>& target, int channels, int numSamples,
+                              int characterMode)
+{
+    const float drive = Saturation::characterDrive(characterMode);
+    const float outputGain = 1.0f / std::tanh(drive);
+    const int count = juce::jmin(channels, target.getNumChannels());
+    for (int ch = 0; ch < count; ++ch)
+    {
+        Saturation::processTanh(target.getWritePointer(ch), numSamples, drive, outputGain);
+    }
 }
 
 int EqEngine::getLatencySamples() const
+{
+    return getEqLatencySamples() + spectralDsp.getLatencySamples();
+}
+
+int EqEngine::getEqLatencySamples() const
 {
     if (lastPhaseMode == 0)
         return oversamplingLatencySamples;
@@ -1068,11 +938,10 @@ void EqEngine::updateLinearPhase(const ParamSnapshot& snapshot, double sampleRat
 
     rebuildLinearPhase(snapshot, taps, headSize, sampleRate, quality);
     pendingLinearFadeSamples.store(juce::jmin(2048, maxPreparedBlockSize));
-    juce::Logger::writeToLog("LinearPhase rebuild: mode=" + juce::String(snapshot.phaseMode)
-                             + " quality=" + juce::String(quality)
-                             + " offset=" + juce::String(adaptiveQualityOffset.load())
-                             + " taps=" + juce::String(taps)
-                             + " window=" + juce::String(snapshot.linearWindow));
+    AsyncLog::post(AsyncLog::Event::firRebuild,
+                   { static_cast<float>(snapshot.phaseMode), static_cast<float>(quality),
+                     static_cast<float>(adaptiveQualityOffset.load()), static_cast<float>(taps),
+                     static_cast<float>(snapshot.linearWindow) });
     lastParamHash = hash;
     lastTaps = taps;
     lastPhaseMode = snapshot.phaseMode;
@@ -1080,6 +949,18 @@ void EqEngine::updateLinearPhase(const ParamSnapshot& snapshot, double sampleRat
     lastWindowIndex = snapshot.linearWindow;
 }
 
+bool EqEngine::isLinearPhaseReady(int numChannels) const
+{
+    if (lastPhaseMode == 0)
+        return true;
+    for (int ch = 0; ch < numChannels; ++ch)
+        if (linearPhaseEq.getActiveImpulseSize(ch) != lastTaps)
+            return false;
+    return numChannels < 2
+        || (linearPhaseMsEq.getActiveImpulseSize(0) == lastTaps
+            && linearPhaseMsEq.getActiveImpulseSize(1) == lastTaps);
+}
+
 uint64_t EqEngine::computeParamsHash(const ParamSnapshot& snapshot) const
 {
     auto hash = uint64_t { 1469598103934665603ull };
@@ -1141,11 +1022,11 @@ void EqEngine::rebuildLinearPhase(const ParamSnapshot& snapshot, int taps, int h
         : (windowIndex == 2 ? juce::dsp::WindowingFunction<float>::kaiser
                                        : juce::dsp::WindowingFunction<float>::hann);
 
-    if (firWindow == nullptr || static_cast<int>(firImpulse.size()) != taps
-        || firWindowMethod != static_cast<int>(method))
+    if (firWindow == nullptr || firWindowTaps != taps || firWindowMethod != static_cast<int>(method))
     {
         firWindow = std::make_unique<juce::dsp::WindowingFunction<float>>(taps, method);
         firWindowMethod = static_cast<int>(method);
+        firWindowTaps = taps;
     }
 
     auto buildImpulse = [&](int channel, std::function<bool(int)> includeBand) -> juce::AudioBuffer<float>
@@ -1343,8 +1224,12 @@ void EqEngine::rebuildLinearPhase(const ParamSnapshot& snapshot, int taps, int h
         }
 
         firFft->performRealOnlyInverseTransform(firData.data());
+        // The zero-phase response wraps around index 0; rotate it onto the centre tap so the FIR is
+        // symmetric and its delay is the reported latency.
+        const int centre = (taps - 1) / 2;
         for (int i = 0; i < taps; ++i)
-            firImpulse[static_cast<size_t>(i)] = firData[static_cast<size_t>(i)] / static_cast<float>(fftSize);
+            firImpulse[static_cast<size_t>(i)] =
+                firData[static_cast<size_t>((i - centre + fftSize) % fftSize)] / static_cast<float>(fftSize);
 
         firWindow->multiplyWithWindowingTable(firImpulse.data(), taps);
 
@@ -1406,7 +1291,7 @@ void EqEngine::rebuildLinearPhase(const ParamSnapshot& snapshot, int taps, int h
         {
             impulse.clear();
             impulse.setSample(0, 0, 1.0f);
-            juce::Logger::writeToLog("LinearPhase: impulse fallback -> delta (" + tag + ")");
+            AsyncLog::post(AsyncLog::Event::impulseFallback, tag);
         }
     };
 
@@ -1467,45 +1352,150 @@ void EqEngine::rebuildLinearPhase(const ParamSnapshot& snapshot, int taps, int h
     }
 }
 
-void EqEngine::updateOversampling(const ParamSnapshot& snapshot, double sampleRate, int maxBlockSize, int channels)
+void EqEngine::updateOversampling(const ParamSnapshot& snapshot)
 {
     // Quality ladder drives oversampling depth for realtime EQ:
     // Low=none, Medium=2x, High=4x, Very High=8x, Intensive=16x.
-    const int quality = juce::jlimit(0, 4, snapshot.linearQuality);
-    const int desiredIndex = (snapshot.phaseMode == 0) ? quality : 0;
-    const bool needsRebuild = desiredIndex != lastOversamplingIndex
-        || sampleRate != lastOversamplingSampleRate
-        || maxBlockSize != lastOversamplingBlockSize
-        || channels != lastOversamplingChannels;
-
-    if (! needsRebuild)
+    const int quality = juce::jlimit(0, kMaxOversamplingIndex, snapshot.linearQuality);
+    const int requestedIndex = snapshot.phaseMode == 0 ? quality : 0;
+    const int desiredIndex = juce::jmin(requestedIndex, oversamplingCap);
+    // The reported latency follows the quality setting only; a governor cap is padded up to it.
+    oversamplingLatencySamples = oversamplerLatencies[static_cast<size_t>(requestedIndex)];
+    const int padSamples = oversamplingLatencySamples - oversamplerLatencies[static_cast<size_t>(desiredIndex)];
+    const bool realtimeRunning = snapshot.phaseMode == 0 && lastPhaseMode == 0;
+
+    // A running crossfade finishes first; the next block picks up any newer request.
+    if (realtimeFadePosition < realtimeFadeTotalSamples)
+    {
+        if (realtimeRunning)
+            return;
+        realtimeFadeTotalSamples = 0;
+    }
+
+    auto& active = realtimePaths[static_cast<size_t>(activeRealtimePath)];
+    if (desiredIndex == active.index)
+    {
+        active.padSamples = padSamples;
         return;
+    }
 
+    // The idle path takes over the active path's smoothed band state at the new rate, so the
+    // switch neither glides from defaults nor starts from stale filter memory.
+    auto& incoming = realtimePaths[static_cast<size_t>(1 - activeRealtimePath)];
+    incoming.eq.prepare(sampleRateHz * (1 << desiredIndex), oversampledBlockSize, preparedChannels);
+    if (active.index >= 0)
+        incoming.eq.copyParameterState(active.eq);
+    incoming.padBuffer.clear();
+    incoming.padWritePos = 0;
+    incoming.padSamples = padSamples;
+    incoming.index = desiredIndex;
+    if (auto* stage = oversamplers[static_cast<size_t>(desiredIndex)].get())
+        stage->reset();
+
+    const bool crossfade = realtimeRunning && active.index >= 0;
+    activeRealtimePath = 1 - activeRealtimePath;
     oversamplingIndex = desiredIndex;
-    lastOversamplingIndex = desiredIndex;
-    lastOversamplingSampleRate = sampleRate;
-    lastOversamplingBlockSize = maxBlockSize;
-    lastOversamplingChannels = channels;
-    oversamplingLatencySamples = 0;
-    oversampler.reset();
-    oversampledBuffer.setSize(0, 0);
+    realtimeFadePosition = 0;
+    // Hold the incoming path until its oversampler and pad have filled, then ramp over ~10 ms.
+    realtimeFadeHoldSamples = oversamplingLatencySamples;
+    realtimeFadeTotalSamples = crossfade
+        ? realtimeFadeHoldSamples + juce::jmax(64, juce::roundToInt(sampleRateHz * 0.01))
+        : 0;
+}
 
-    if (oversamplingIndex <= 0 || channels <= 0 || maxBlockSize <= 0)
+void EqEngine::processRealtimePath(RealtimePath& path, juce::AudioBuffer<float>& target, int numChannels,
+                                   int characterMode, const juce::AudioBuffer<float>* detectorBuffer,
+                                   bool tapHarmonics)
+{
+    auto* stage = path.index > 0 ? oversamplers[static_cast<size_t>(path.index)].get() : nullptr;
+    if (stage == nullptr)
+    {
+        juce::AudioBuffer<float>* harmonicOut = nullptr;
+        if (tapHarmonics)
+        {
+            harmonicTapBuffer.setSize(numChannels, target.getNumSamples(), false, false, true);
+            harmonicTapBuffer.clear();
+            harmonicOut = &harmonicTapBuffer;
+        }
+        {
+            const StageProfiler::Scope scope(profiler, StageProfiler::iir);
+            path.eq.process(target, detectorBuffer, harmonicOut);
+        }
+        if (characterMode > 0)
+        {
+            const StageProfiler::Scope scope(profiler, StageProfiler::character);
+            applyCharacter(target, numChannels, target.getNumSamples(), characterMode);
+        }
+        applyRealtimePad(path, target, numChannels);
         return;
+    }
+
+    auto block = juce::dsp::AudioBlock<float>(target);
+    auto upBlock = [this, stage, &block]
+    {
+        const StageProfiler::Scope scope(profiler, StageProfiler::oversampleUp);
+        return stage->processSamplesUp(block);
+    }();
+    const int upSamples = static_cast<int>(upBlock.getNumSamples());
+    const int channels = juce::jmin(numChannels, static_cast<int>(upBlock.getNumChannels()));
+
+    std::array<float*, ParamIDs::kMaxChannels> upPtrs {};
+    for (int ch = 0; ch < channels; ++ch)
+        upPtrs[static_cast<size_t>(ch)] = upBlock.getChannelPointer(ch);
+    juce::AudioBuffer<float> upBuffer;
+    upBuffer.setDataToReferTo(upPtrs.data(), channels, upSamples);
+
+    juce::AudioBuffer<float>* harmonicOut = nullptr;
+    if (tapHarmonics)
+    {
+        harmonicTapOversampledBuffer.setSize(channels, upSamples, false, false, true);
+        harmonicTapOversampledBuffer.clear();
+        harmonicOut = &harmonicTapOversampledBuffer;
+    }
+    {
+        const StageProfiler::Scope scope(profiler, StageProfiler::iir);
+        path.eq.process(upBuffer, detectorBuffer, harmonicOut);
+    }
+
+    if (characterMode > 0)
+    {
+        const StageProfiler::Scope scope(profiler, StageProfiler::character);
+        applyCharacter(upBuffer, channels, upSamples, characterMode);
+    }
 
-    oversampler = std::make_unique<juce::dsp::Oversampling<float>>(
-        channels,
-        oversamplingIndex,
-        juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR,
-        true);
-    oversampler->initProcessing(static_cast<size_t>(maxBlockSize));
-    oversamplingLatencySamples = static_cast<int>(oversampler->getLatencyInSamples());
-
-    const int upFactor = 1 << oversamplingIndex;
-    oversampledBuffer.setSize(channels, maxBlockSize * upFactor);
-    oversampledBuffer.clear();
-    eqDspOversampled.prepare(sampleRate * upFactor, maxBlockSize * upFactor, channels);
-    eqDspOversampled.reset();
+    {
+        const StageProfiler::Scope scope(profiler, StageProfiler::oversampleDown);
+        stage->processSamplesDown(block);
+    }
+    applyRealtimePad(path, target, numChannels);
+}
+
+void EqEngine::applyRealtimePad(RealtimePath& path, juce::AudioBuffer<float>& target, int numChannels)
+{
+    // Runs even at a zero pad so the line holds recent output if the pad grows again.
+    const int bufferSize = path.padBuffer.getNumSamples();
+    if (bufferSize <= 1)
+        return;
+    const int delaySamples = juce::jlimit(0, bufferSize - 1, path.padSamples);
+    const int numSamples = target.getNumSamples();
+    const int channels = juce::jmin(numChannels, target.getNumChannels(), path.padBuffer.getNumChannels());
+    for (int ch = 0; ch < channels; ++ch)
+    {
+        auto* delayData = path.padBuffer.getWritePointer(ch);
+        auto* data = target.getWritePointer(ch);
+        int localWrite = path.padWritePos;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            delayData[localWrite] = data[i];
+            int readPos = localWrite - delaySamples;
+            if (readPos < 0)
+                readPos += bufferSize;
+            data[i] = delayData[readPos];
+            if (++localWrite >= bufferSize)
+                localWrite = 0;
+        }
+    }
+    path.padWritePos = (path.padWritePos + numSamples) % bufferSize;
 }
 
 void EqEngine::updateDryDelay(int latencySamples, int maxBlockSize, int numChannels)
@@ -1528,9 +1518,9 @@ void EqEngine::updateDryDelay(int latencySamples, int maxBlockSize, int numChann
         dryDelayWritePos = 0;
         // Crossfade dry delay to avoid clicks when latency changes.
         mixDelayFadeSamplesRemaining = juce::jmin(maxBlockSize, 2048);
-        juce::Logger::writeToLog("GlobalMix dry-delay: latency=" + juce::String(mixDelaySamples)
-                                 + " samples, maxBlock=" + juce::String(maxBlockSize)
-                                 + ", channels=" + juce::String(numChannels));
+        AsyncLog::post(AsyncLog::Event::dryDelay, { static_cast<float>(mixDelaySamples),
+                                                    static_cast<float>(maxBlockSize),
+                                                    static_cast<float>(numChannels) });
     }
 }
 
@@ -1570,7 +1560,7 @@ void EqEngine::updateMinPhaseDelay(int latencySamples, int maxBlockSize, int num
     const int targetDelay = juce::jmax(0, latencySamples);
     maxPreparedBlockSize = juce::jmax(maxPreparedBlockSize, maxBlockSize);
     const int neededSize = maxPreparedBlockSize + maxDelaySamples + 1;
-    if (minPhaseDelayBuffer.getNumChannels() != numChannels
+    if (minPhaseDelayBuffer.getNumChannels() < numChannels
         || minPhaseDelayBuffer.getNumSamples() != neededSize)
     {
         minPhaseDelayBuffer.setSize(numChannels, neededSize);
@@ -0,0 +1,84 @@
+#include "HalfBandDecimator.h"
+
+#include <cmath>
+
+namespace
+{
+constexpr double kPi = 3.14159265358979323846;
+// Kaiser beta for roughly 80 dB of stopband rejection at this length.
+constexpr double kKaiserBeta = 7.8;
+
+double besselI0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 32; ++k)
+    {
+        term *= (x * 0.5 / k) * (x * 0.5 / k);
+        sum += term;
+    }
+    return sum;
+}
+
+template <int SideTaps, int Centre>
+std::array<float, SideTaps> designSideTaps()
+{
+    // Windowed sinc at a quarter of the input rate; even offsets are exactly zero.
+    std::array<double, SideTaps> taps {};
+    double sum = 0.0;
+    const double i0Beta = besselI0(kKaiserBeta);
+    for (int i = 0; i < SideTaps; ++i)
+    {
+        const int offset = 2 * i + 1;
+        const double sinc = std::sin(kPi * offset * 0.5) / (kPi * offset);
+        const double r = static_cast<double>(offset) / Centre;
+        const double window = besselI0(kKaiserBeta * std::sqrt(1.0 - r * r)) / i0Beta;
+        taps[static_cast<size_t>(i)] = sinc * window;
+        sum += taps[static_cast<size_t>(i)];
+    }
+
+    // Unity DC gain: 0.5 (centre) + 2 * sum(side taps) = 1.
+    std::array<float, SideTaps> result {};
+    for (int i = 0; i < SideTaps; ++i)
+        result[static_cast<size_t>(i)] = static_cast<float>(taps[static_cast<size_t>(i)] * 0.25 / sum);
+    return result;
+}
+}
+
+namespace eqdsp
+{
+void HalfBandDecimator::reset()
+{
+    history.fill(0.0f);
+    writePos = 0;
+    outputPhase = false;
+}
+
+int HalfBandDecimator::process(float* data, int numSamples)
+{
+    static const auto sideTaps = designSideTaps<kSideTaps, kCentre>();
+
+    int outCount = 0;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        history[static_cast<size_t>(writePos)] = data[i];
+        history[static_cast<size_t>(writePos + kTaps)] = data[i];
+        if (++writePos == kTaps)
+            writePos = 0;
+
+        outputPhase = ! outputPhase;
+        if (! outputPhase)
+            continue;
+
+        const float* window = history.data() + writePos;
+        float acc = 0.5f * window[kCentre];
+        for (int t = 0; t < kSideTaps; ++t)
+        {
+            const int offset = 2 * t + 1;
+            acc += sideTaps[static_cast<size_t>(t)] * (window[kCentre - offset] + window[kCentre + offset]);
+        }
+        data[outCount++] = acc;
+    }
+    return outCount;
+}
+} // namespace eqdsp
@@ -28,6 +28,9 @@ public:
 
     int getLatencySamples() const;
     void setLatencySamples(int samples);
+    // Impulse length the channel's convolver is running (the convolver installs loaded impulses
+    // on its own thread and swaps them in during process()).
+    int getActiveImpulseSize(int channelIndex) const;
 
 private:
     // DSP format + state tracking.
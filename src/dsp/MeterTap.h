@@ -16,9 +16,16 @@ public:
     void process(const juce::AudioBuffer<float>& buffer, int numChannels);
     // Retrieve per-channel meter state.
     ChannelMeterState getState(int channel) const;
+    // Consistent copy of all meter values (levels, loudness, correlation).
+    bool getSnapshot(MeterSnapshot& dest) const;
+    // Loudness channel weight and integrated/true-peak-max reset.
+    void setLoudnessWeight(int channel, float weight);
+    void requestLoudnessReset();
+    // Sample-peak fallback for true peak under CPU pressure (audio thread).
+    void setTruePeakAllowed(bool allowed);
     // Correlation and scope points.
     float getCorrelation() const;
-    int copyScopePoints(juce::Point<float>* dest, int maxPoints, int& writePos) const;
+    int popScopePoints(float* destMid, float* destSide, int maxPoints);
     // Choose correlation channel pair.
     void setCorrelationPair(int channelA, int channelB);
 
@@ -4,14 +4,125 @@ namespace
 {
 constexpr float kMinDb = -120.0f;
 constexpr float kEpsilon = 1.0e-12f;
-constexpr int kScopeDecim = 4;
+// BS.1770 loudness offset and gates.
+constexpr double kLoudnessOffset = -0.691;
+constexpr double kAbsoluteGateLufs = -70.0;
+constexpr double kRelativeGateLu = -10.0;
+constexpr double kHistogramStepLu = 0.1;
+constexpr int kMomentaryBlocks = 4;
+// Kaiser beta for the true-peak interpolator prototype.
+constexpr double kTruePeakKaiserBeta = 6.0;
+// Inter-sample overshoot allowed over a local sample maximum when picking chunks to interpolate
+// (+6 dB; a full-scale fs/4 tone at 45 degrees overshoots by +3 dB).
+constexpr float kTruePeakCandidateMargin = 2.0f;
+
+double besselI0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 32; ++k)
+    {
+        term *= (x * 0.5 / k) * (x * 0.5 / k);
+        sum += term;
+    }
+    return sum;
+}
+
+float energyToLufs(double energy)
+{
+    if (energy <= 1.0e-12)
+        return kMinDb;
+    return static_cast<float>(juce::jmax(static_cast<double>(kMinDb), kLoudnessOffset + 10.0 * std::log10(energy)));
+}
 }
 
 namespace eqdsp
 {
+MeteringDSP::MeteringDSP()
+{
+    for (auto& weight : loudnessWeights)
+        weight.store(1.0f, std::memory_order_relaxed);
+    // Sized once: the UI may be reading while the host re-prepares.
+    scopeFifo.prepare(kScopeFifoPoints, 2);
+}
+
 void MeteringDSP::prepare(double sampleRate)
 {
     sampleRateHz = sampleRate;
+    // BS.1770 asks for the peak at >= 192 kHz equivalent: 4x up to 48 kHz, 2x at 96 kHz, and the
+    // samples themselves from 176.4 kHz. There the K-weighted energy is measured at half the rate on
+    // pair averages (-0.5 dB at 20 kHz), which halves the filter work like the old meter's skip did.
+    truePeakFactor = sampleRate < 80000.0 ? 4 : (sampleRate < 160000.0 ? 2 : 1);
+    loudnessPairs = sampleRate >= 160000.0;
+    const double filterRate = loudnessPairs ? 0.5 * sampleRate : sampleRate;
+
+    // BS.1770 K-weighting (pre-filter shelf + RLB high-pass), re-derived for this rate.
+    const double pi = juce::MathConstants<double>::pi;
+    {
+        const double f0 = 1681.974450955533;
+        const double gainDb = 3.999843853973347;
+        const double q = 0.7071752369554196;
+        const double k = std::tan(pi * f0 / filterRate);
+        const double vh = std::pow(10.0, gainDb / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+        shelf.b0 = static_cast<float>((vh + vb * k / q + k * k) / a0);
+        shelf.b1 = static_cast<float>(2.0 * (k * k - vh) / a0);
+        shelf.b2 = static_cast<float>((vh - vb * k / q + k * k) / a0);
+        shelf.a1 = static_cast<float>(2.0 * (k * k - 1.0) / a0);
+        shelf.a2 = static_cast<float>((1.0 - k / q + k * k) / a0);
+    }
+    {
+        const double f0 = 38.13547087602444;
+        const double q = 0.5003270373238773;
+        const double k = std::tan(pi * f0 / filterRate);
+        const double a0 = 1.0 + k / q + k * k;
+        highPass.b0 = 1.0f;
+        highPass.b1 = -2.0f;
+        highPass.b2 = 1.0f;
+        highPass.a1 = static_cast<float>(2.0 * (k * k - 1.0) / a0);
+        highPass.a2 = static_cast<float>((1.0 - k / q + k * k) / a0);
+    }
+
+    // 4x true-peak interpolator: 49-tap Kaiser-windowed sinc whose phase 0 is the input itself.
+    // Its phase 2 (the half-sample point) alone is the 2x interpolator.
+    constexpr int prototypeTaps = kTruePeakTaps * 4 + 1;
+    constexpr double centre = 0.5 * (prototypeTaps - 1);
+    const double i0Beta = besselI0(kTruePeakKaiserBeta);
+    std::array<std::array<double, kTruePeakTaps>, 2> phases {};
+    for (int phase = 1; phase <= 2; ++phase)
+    {
+        auto& coeffs = phases[static_cast<size_t>(phase - 1)];
+        double sum = 0.0;
+        for (int j = 0; j < kTruePeakTaps; ++j)
+        {
+            const int n = phase + 4 * j;
+            const double t = (n - centre) / 4.0;
+            const double sinc = std::sin(pi * t) / (pi * t);
+            const double r = (n - centre) / centre;
+            const double window = besselI0(kTruePeakKaiserBeta * std::sqrt(juce::jmax(0.0, 1.0 - r * r))) / i0Beta;
+            // The history window runs oldest -> newest, so tap j (delay j) sits at the far end.
+            coeffs[static_cast<size_t>(kTruePeakTaps - 1 - j)] = sinc * window;
+            sum += sinc * window;
+        }
+        for (auto& c : coeffs)
+            c /= sum;
+    }
+    for (int i = 0; i < kTruePeakHalf; ++i)
+    {
+        const auto a = static_cast<size_t>(i);
+        const auto b = static_cast<size_t>(kTruePeakTaps - 1 - i);
+        truePeakEven[a] = static_cast<float>(0.5 * (phases[0][a] + phases[0][b]));
+        truePeakOdd[a] = static_cast<float>(0.5 * (phases[0][a] - phases[0][b]));
+        truePeakMid[a] = static_cast<float>(0.5 * (phases[1][a] + phases[1][b]));
+    }
+
+    loudnessBlockSamples = juce::jmax(1, juce::roundToInt(0.1 * sampleRate));
+    for (int bin = 0; bin < kHistogramBins; ++bin)
+    {
+        const double lufs = kAbsoluteGateLufs + (bin + 0.5) * kHistogramStepLu;
+        histogramEnergy[static_cast<size_t>(bin)] = std::pow(10.0, (lufs - kLoudnessOffset) / 10.0);
+    }
     reset();
 }
 
@@ -21,27 +132,80 @@ void MeteringDSP::reset()
     {
         state.rmsDb = kMinDb;
         state.peakDb = kMinDb;
+        state.truePeakDb = kMinDb;
     }
+    for (auto& group : laneGroups)
+        group = LaneGroup {};
+
+    loudnessBlockFill = 0;
+    loudnessBlockEnergy.fill(0.0);
+    loudnessHistory.fill(0.0);
+    loudnessHistoryPos = 0;
+    loudnessHistoryCount = 0;
+    loudnessHistogram.fill(0);
+    momentaryLufs = kMinDb;
+    shortTermLufs = kMinDb;
+    integratedLufs = kMinDb;
+    truePeakMaxDb = kMinDb;
+    loudnessResetPending.store(false, std::memory_order_relaxed);
 
     correlation = 0.0f;
-    scopeWritePos.store(0, std::memory_order_release);
+    // The scope FIFO is left to drain; resetting it here would race the UI reader.
     scopeDecimCounter = 0;
+    published.write(MeterSnapshot {});
 }
 
 void MeteringDSP::process(const juce::AudioBuffer<float>& buffer, int numChannels)
 {
-    const int channels = juce::jlimit(0, ParamIDs::kMaxChannels, numChannels);
+    const int channels = juce::jlimit(0, juce::jmin(ParamIDs::kMaxChannels, buffer.getNumChannels()), numChannels);
     const int samples = buffer.getNumSamples();
     if (channels == 0 || samples == 0)
         return;
 
+    if (loudnessResetPending.exchange(false, std::memory_order_acq_rel))
+    {
+        loudnessHistogram.fill(0);
+        integratedLufs = kMinDb;
+        truePeakMaxDb = kMinDb;
+    }
+
+    // One pass per segment; segments end on 100 ms loudness block boundaries.
+    Accumulators acc;
+    int done = 0;
+    while (done < samples)
+    {
+        const int segment = juce::jmin(samples - done, loudnessBlockSamples - loudnessBlockFill);
+        for (int first = 0, g = 0; first < channels; first += kLanes, ++g)
+        {
+            const int lanes = juce::jmin(kLanes, channels - first);
+            const float* lanePointers[kLanes];
+            for (int lane = 0; lane < kLanes; ++lane)
+                lanePointers[lane] = buffer.getReadPointer(first + (lane < lanes ? lane : 0), done);
+            processLaneGroup(laneGroups[static_cast<size_t>(g)], lanePointers, lanes, first, segment, acc);
+        }
+
+        for (int ch = 0; ch < channels; ++ch)
+        {
+            loudnessBlockEnergy[static_cast<size_t>(ch)] += acc.loudnessSquares[static_cast<size_t>(ch)];
+            acc.loudnessSquares[static_cast<size_t>(ch)] = 0.0f;
+        }
+        loudnessBlockFill += segment;
+        done += segment;
+        if (loudnessBlockFill >= loudnessBlockSamples)
+            finishLoudnessBlock(channels);
+    }
+
     for (int ch = 0; ch < channels; ++ch)
     {
-        const auto* data = buffer.getReadPointer(ch);
-        const float rmsDb = computeRmsDb(data, samples);
-        const float peakDb = computePeakDb(data, samples);
-        channelStates[ch].rmsDb = smooth(channelStates[ch].rmsDb, rmsDb, rmsSmooth);
-        channelStates[ch].peakDb = smooth(channelStates[ch].peakDb, peakDb, peakSmooth);
+        const auto index = static_cast<size_t>(ch);
+        const float rms = std::sqrt(acc.sumSquares[index] / static_cast<float>(samples));
+        const float rmsDb = juce::Decibels::gainToDecibels(rms, kMinDb);
+        const float peakDb = juce::Decibels::gainToDecibels(acc.peak[index], kMinDb);
+        const float truePeakDb = juce::Decibels::gainToDecibels(acc.truePeak[index], kMinDb);
+        channelStates[index].rmsDb = smooth(channelStates[index].rmsDb, rmsDb, rmsSmooth);
+        channelStates[index].peakDb = smooth(channelStates[index].peakDb, peakDb, peakSmooth);
+        channelStates[index].truePeakDb = smooth(channelStates[index].truePeakDb, truePeakDb, peakSmooth);
+        truePeakMaxDb = juce::jmax(truePeakMaxDb, truePeakDb);
     }
 
     if (channels >= 2)
@@ -54,7 +218,6 @@ void MeteringDSP::process(const juce::AudioBuffer<float>& buffer, int numChannel
         double sumLR = 0.0;
         double sumL2 = 0.0;
         double sumR2 = 0.0;
-        int writePos = scopeWritePos.load(std::memory_order_relaxed);
 
         for (int i = 0; i < samples; ++i)
         {
@@ -63,57 +226,341 @@ void MeteringDSP::process(const juce::AudioBuffer<float>& buffer, int numChannel
             sumLR += l * r;
             sumL2 += l * l;
             sumR2 += r * r;
+        }
 
-            scopeDecimCounter++;
-            if (scopeDecimCounter >= kScopeDecim)
+        // Decimated mid/side points, staged in chunks and pushed to the FIFO (dropped if the UI lags).
+        const float* chunkPlanes[2] { scopeChunkMid.data(), scopeChunkSide.data() };
+        int chunkFill = 0;
+        for (int i = (kScopeDecimation - 1 - scopeDecimCounter); i < samples; i += kScopeDecimation)
+        {
+            scopeChunkMid[static_cast<size_t>(chunkFill)] = juce::jlimit(-1.0f, 1.0f, 0.5f * (left[i] + right[i]));
+            scopeChunkSide[static_cast<size_t>(chunkFill)] = juce::jlimit(-1.0f, 1.0f, 0.5f * (left[i] - right[i]));
+            if (++chunkFill == kScopeChunk)
             {
-                scopeDecimCounter = 0;
-                float x = static_cast<float>(0.5 * (l + r));
-                float y = static_cast<float>(0.5 * (l - r));
-                x = juce::jlimit(-1.0f, 1.0f, x);
-                y = juce::jlimit(-1.0f, 1.0f, y);
-                scopeX[static_cast<size_t>(writePos)] = x;
-                scopeY[static_cast<size_t>(writePos)] = y;
-                writePos = (writePos + 1) % kScopePoints;
+                scopeFifo.pushFrames(chunkPlanes, 2, chunkFill);
+                chunkFill = 0;
             }
         }
+        if (chunkFill > 0)
+            scopeFifo.pushFrames(chunkPlanes, 2, chunkFill);
+        scopeDecimCounter = (scopeDecimCounter + samples) % kScopeDecimation;
 
         const double denom = std::sqrt(sumL2 * sumR2) + kEpsilon;
         const float target = static_cast<float>(sumLR / denom);
         correlation = smooth(correlation, target, correlationSmooth);
-        scopeWritePos.store(writePos, std::memory_order_release);
     }
+
+    MeterSnapshot snapshot;
+    snapshot.numChannels = channels;
+    std::copy(channelStates.begin(), channelStates.begin() + channels, snapshot.channels.begin());
+    snapshot.momentaryLufs = momentaryLufs;
+    snapshot.shortTermLufs = shortTermLufs;
+    snapshot.integratedLufs = integratedLufs;
+    snapshot.truePeakMaxDb = truePeakMaxDb;
+    snapshot.correlation = correlation;
+    published.write(snapshot);
 }
 
-ChannelMeterState MeteringDSP::getChannelState(int channelIndex) const
+void MeteringDSP::processLaneGroup(LaneGroup& group, const float* const* channelData, int lanes,
+                                   int firstChannel, int numSamples, Accumulators& acc)
 {
-    const int index = juce::jlimit(0, ParamIDs::kMaxChannels - 1, channelIndex);
-    return channelStates[static_cast<size_t>(index)];
+    using Simd::Float4;
+    const Float4 sb0 = Float4::broadcast(shelf.b0);
+    const Float4 sb1 = Float4::broadcast(shelf.b1);
+    const Float4 sb2 = Float4::broadcast(shelf.b2);
+    const Float4 sa1 = Float4::broadcast(shelf.a1);
+    const Float4 sa2 = Float4::broadcast(shelf.a2);
+    const Float4 ha1 = Float4::broadcast(highPass.a1);
+    const Float4 ha2 = Float4::broadcast(highPass.a2);
+    Float4 tpEven[kTruePeakHalf];
+    Float4 tpOdd[kTruePeakHalf];
+    Float4 tpMid[kTruePeakHalf];
+    for (int j = 0; j < kTruePeakHalf; ++j)
+    {
+        tpEven[j] = Float4::broadcast(truePeakEven[static_cast<size_t>(j)]);
+        tpOdd[j] = Float4::broadcast(truePeakOdd[static_cast<size_t>(j)]);
+        tpMid[j] = Float4::broadcast(truePeakMid[static_cast<size_t>(j)]);
+    }
+
+    Float4 sumSquares = Float4::zero();
+    Float4 peak = Float4::zero();
+    Float4 truePeak = Float4::zero();
+    Float4 loudness = Float4::zero();
+    Float4 s1 = group.shelfZ1;
+    Float4 s2 = group.shelfZ2;
+    Float4 h1 = group.highPassZ1;
+    Float4 h2 = group.highPassZ2;
+    auto* history = group.history.data();
+    int historyPos = group.historyPos;
+    const bool oversample = truePeakFactor > 1 && truePeakAllowed;
+    const bool allPhases = truePeakFactor == 4;
+    const Float4 half = Float4::broadcast(0.5f);
+
+    // x holds one sample time across the four channel lanes.
+    auto kWeight = [&](Float4 x)
+    {
+        // Transposed direct form II; the RLB stage has b = {1, -2, 1}.
+        const Float4 y = sb0 * x + s1;
+        s1 = sb1 * x - sa1 * y + s2;
+        s2 = sb2 * x - sa2 * y;
+        const Float4 k = y + h1;
+        h1 = y * Float4::broadcast(-2.0f) - ha1 * k + h2;
+        h2 = y - ha2 * k;
+        loudness = loudness + k * k;
+    };
+
+    auto interpolatePeak = [&](Float4 x, bool interpolate)
+    {
+        history[historyPos] = x;
+        history[historyPos + kTruePeakTaps] = x;
+        if (++historyPos == kTruePeakTaps)
+            historyPos = 0;
+        if (! interpolate)
+            return;
+        const Float4* window = history + historyPos;
+        Float4 mid = Float4::zero();
+        if (! allPhases)
+        {
+            for (int j = 0; j < kTruePeakHalf; ++j)
+                mid = mid + tpMid[j] * (window[j] + window[kTruePeakTaps - 1 - j]);
+            truePeak = max(truePeak, abs(mid));
+            return;
+        }
+        Float4 even = Float4::zero();
+        Float4 odd = Float4::zero();
+        for (int j = 0; j < kTruePeakHalf; ++j)
+        {
+            const Float4 a = window[j];
+            const Float4 b = window[kTruePeakTaps - 1 - j];
+            const Float4 sum = a + b;
+            even = even + tpEven[j] * sum;
+            odd = odd + tpOdd[j] * (a - b);
+            mid = mid + tpMid[j] * sum;
+        }
+        truePeak = max(truePeak, max(abs(even + odd), max(abs(even - odd), abs(mid))));
+    };
+
+    // Single-sample path for segment edges; keeps the K-weighting pairs aligned across segments.
+    auto sampleStep = [&](Float4 x)
+    {
+        sumSquares = sumSquares + x * x;
+        peak = max(peak, abs(x));
+        if (! loudnessPairs)
+            kWeight(x);
+        else if (group.pairPending)
+            kWeight((group.pendingPair + x) * half);
+        else
+            group.pendingPair = x;
+        group.pairPending = loudnessPairs && ! group.pairPending;
+        if (oversample)
+            interpolatePeak(x, true);
+    };
+    auto loadColumn = [channelData](int index)
+    {
+        const float column[kLanes] { channelData[0][index], channelData[1][index], channelData[2][index],
+                                     channelData[3][index] };
+        return Float4::load(column);
+    };
+
+    // Sparse true peak: a chunk's interpolated points lie between the samples 5 and 9 back, i.e. in
+    // the previous two chunks, so the interpolator runs only when one of those holds a local maximum
+    // of |x| that could raise the running peak (true or sample) by kTruePeakCandidateMargin. The
+    // first two chunks of a segment always run.
+    const Float4 margin = Float4::broadcast(kTruePeakCandidateMargin);
+    const Float4 level = Float4::broadcast(1.0001f);
+    Float4 last[4] { Float4::zero(), Float4::zero(), Float4::zero(), Float4::zero() };
+    Float4 beforeLast = Float4::zero();
+    bool haveLast = false;
+    bool earlierCandidate = true;
+
+    int i = 0;
+    if (group.pairPending && numSamples > 0)
+        sampleStep(loadColumn(i++));
+    for (; i + 3 < numSamples; i += 4)
+    {
+        Float4 r0 = Float4::load(channelData[0] + i);
+        Float4 r1 = Float4::load(channelData[1] + i);
+        Float4 r2 = Float4::load(channelData[2] + i);
+        Float4 r3 = Float4::load(channelData[3] + i);
+        Float4::transpose(r0, r1, r2, r3);
+        sumSquares = sumSquares + r0 * r0 + r1 * r1 + r2 * r2 + r3 * r3;
+        const Float4 a0 = abs(r0);
+        const Float4 a1 = abs(r1);
+        const Float4 a2 = abs(r2);
+        const Float4 a3 = abs(r3);
+        peak = max(peak, max(max(a0, a1), max(a2, a3)));
+        if (loudnessPairs)
+        {
+            kWeight((r0 + r1) * half);
+            kWeight((r2 + r3) * half);
+        }
+        else
+        {
+            kWeight(r0);
+            kWeight(r1);
+            kWeight(r2);
+            kWeight(r3);
+        }
+        if (oversample)
+        {
+            bool lastCandidate = true;
+            if (haveLast)
+            {
+                // Positive where a sample is level with or above both neighbours and within the margin.
+                const Float4 running = max(truePeak, peak);
+                auto score = [&](Float4 x, Float4 left, Float4 right)
+                {
+                    return min(x * margin - running, x * level - max(left, right));
+                };
+                const Float4 best = max(max(score(last[0], beforeLast, last[1]), score(last[1], last[0], last[2])),
+                                        max(score(last[2], last[1], last[3]), score(last[3], last[2], a0)));
+                lastCandidate = anyGreater(best, Float4::zero());
+            }
+            const bool interpolate = lastCandidate || earlierCandidate;
+            earlierCandidate = lastCandidate;
+            beforeLast = last[3];
+            last[0] = a0;
+            last[1] = a1;
+            last[2] = a2;
+            last[3] = a3;
+            haveLast = true;
+            interpolatePeak(r0, interpolate);
+            interpolatePeak(r1, interpolate);
+            interpolatePeak(r2, interpolate);
+            interpolatePeak(r3, interpolate);
+        }
+    }
+    for (; i < numSamples; ++i)
+        sampleStep(loadColumn(i));
+
+    group.shelfZ1 = s1;
+    group.shelfZ2 = s2;
+    group.highPassZ1 = h1;
+    group.highPassZ2 = h2;
+    group.historyPos = historyPos;
+
+    float laneSquares[kLanes];
+    float lanePeak[kLanes];
+    float laneTruePeak[kLanes];
+    float laneLoudness[kLanes];
+    sumSquares.store(laneSquares);
+    peak.store(lanePeak);
+    max(truePeak, peak).store(laneTruePeak);
+    loudness.store(laneLoudness);
+    for (int lane = 0; lane < lanes; ++lane)
+    {
+        const auto index = static_cast<size_t>(firstChannel + lane);
+        acc.sumSquares[index] += laneSquares[lane];
+        acc.peak[index] = juce::jmax(acc.peak[index], lanePeak[lane]);
+        acc.truePeak[index] = juce::jmax(acc.truePeak[index], laneTruePeak[lane]);
+        // Pair mode filters half as many samples; scale back to a per-sample energy sum.
+        acc.loudnessSquares[index] += loudnessPairs ? 2.0f * laneLoudness[lane] : laneLoudness[lane];
+    }
 }
 
-float MeteringDSP::getCorrelation() const
+void MeteringDSP::finishLoudnessBlock(int channels)
 {
-    return correlation;
+    double energy = 0.0;
+    for (int ch = 0; ch < channels; ++ch)
+    {
+        const auto index = static_cast<size_t>(ch);
+        energy += loudnessWeights[index].load(std::memory_order_relaxed) * loudnessBlockEnergy[index];
+        loudnessBlockEnergy[index] = 0.0;
+    }
+    energy /= static_cast<double>(loudnessBlockSamples);
+    loudnessBlockFill = 0;
+
+    loudnessHistory[static_cast<size_t>(loudnessHistoryPos)] = energy;
+    if (++loudnessHistoryPos == kLoudnessBlocks)
+        loudnessHistoryPos = 0;
+    loudnessHistoryCount = juce::jmin(kLoudnessBlocks, loudnessHistoryCount + 1);
+
+    // Momentary: last 400 ms. Short-term: last 3 s. Both are means of 100 ms blocks.
+    double momentarySum = 0.0;
+    double shortTermSum = 0.0;
+    for (int i = 0; i < loudnessHistoryCount; ++i)
+    {
+        int index = loudnessHistoryPos - 1 - i;
+        if (index < 0)
+            index += kLoudnessBlocks;
+        const double blockEnergy = loudnessHistory[static_cast<size_t>(index)];
+        shortTermSum += blockEnergy;
+        if (i < kMomentaryBlocks)
+            momentarySum += blockEnergy;
+    }
+    const int momentaryCount = juce::jmin(kMomentaryBlocks, loudnessHistoryCount);
+    momentaryLufs = energyToLufs(momentarySum / momentaryCount);
+    shortTermLufs = energyToLufs(shortTermSum / loudnessHistoryCount);
+
+    // Gating blocks are 400 ms with 75% overlap, i.e. one per 100 ms once the window is full.
+    if (momentaryCount == kMomentaryBlocks && momentaryLufs > kAbsoluteGateLufs)
+    {
+        const int bin = juce::jlimit(0, kHistogramBins - 1,
+                                     static_cast<int>((momentaryLufs - kAbsoluteGateLufs) / kHistogramStepLu));
+        ++loudnessHistogram[static_cast<size_t>(bin)];
+        computeIntegrated();
+    }
 }
 
-int MeteringDSP::copyScopePoints(juce::Point<float>* dest, int maxPoints, int& writePos) const
+void MeteringDSP::computeIntegrated()
 {
-    if (dest == nullptr || maxPoints <= 0)
+    double count = 0.0;
+    double energy = 0.0;
+    for (int bin = 0; bin < kHistogramBins; ++bin)
     {
-        writePos = 0;
-        return 0;
+        const double n = loudnessHistogram[static_cast<size_t>(bin)];
+        count += n;
+        energy += n * histogramEnergy[static_cast<size_t>(bin)];
+    }
+    if (count <= 0.0)
+    {
+        integratedLufs = kMinDb;
+        return;
     }
 
-    const int count = juce::jmin(kScopePoints, maxPoints);
-    const int end = scopeWritePos.load(std::memory_order_acquire);
-    writePos = end;
-
-    for (int i = 0; i < count; ++i)
+    const double relativeGate = energyToLufs(energy / count) + kRelativeGateLu;
+    const int firstBin = juce::jlimit(0, kHistogramBins - 1,
+                                      static_cast<int>(std::ceil((relativeGate - kAbsoluteGateLufs) / kHistogramStepLu)));
+    count = 0.0;
+    energy = 0.0;
+    for (int bin = firstBin; bin < kHistogramBins; ++bin)
     {
-        const int idx = (end - count + i + kScopePoints) % kScopePoints;
-        dest[i] = { scopeX[static_cast<size_t>(idx)], scopeY[static_cast<size_t>(idx)] };
+        const double n = loudnessHistogram[static_cast<size_t>(bin)];
+        count += n;
+        energy += n * histogramEnergy[static_cast<size_t>(bin)];
     }
-    return count;
+    integratedLufs = count > 0.0 ? energyToLufs(energy / count) : kMinDb;
+}
+
+ChannelMeterState MeteringDSP::getChannelState(int channelIndex) const
+{
+    const int index = juce::jlimit(0, ParamIDs::kMaxChannels - 1, channelIndex);
+    MeterSnapshot snapshot;
+    if (! published.read(snapshot))
+        return {};
+    return snapshot.channels[static_cast<size_t>(index)];
+}
+
+float MeteringDSP::getCorrelation() const
+{
+    MeterSnapshot snapshot;
+    return published.read(snapshot) ? snapshot.correlation : 0.0f;
+}
+
+bool MeteringDSP::getSnapshot(MeterSnapshot& dest) const
+{
+    return published.read(dest);
+}
+
+int MeteringDSP::popScopePoints(float* destMid, float* destSide, int maxPoints)
+{
+    if (destMid == nullptr || destSide == nullptr || maxPoints <= 0)
+        return 0;
+
+    float* planes[2] { destMid, destSide };
+    // Always two planes; this only releases the writer after its first push.
+    scopeFifo.acknowledgeLayout();
+    return scopeFifo.pullFrames(planes, 2, maxPoints);
 }
 
 void MeteringDSP::setCorrelationPair(int channelA, int channelB)
@@ -122,23 +569,29 @@ void MeteringDSP::setCorrelationPair(int channelA, int channelB)
     corrB = channelB;
 }
 
-float MeteringDSP::computeRmsDb(const float* data, int numSamples) const
+void MeteringDSP::setLoudnessWeight(int channelIndex, float weight)
 {
-    double sum = 0.0;
-    for (int i = 0; i < numSamples; ++i)
-        sum += data[i] * data[i];
+    if (channelIndex >= 0 && channelIndex < ParamIDs::kMaxChannels)
+        loudnessWeights[static_cast<size_t>(channelIndex)].store(weight, std::memory_order_relaxed);
+}
 
-    const double rms = std::sqrt(sum / std::max(1, numSamples));
-    return juce::Decibels::gainToDecibels(static_cast<float>(rms), kMinDb);
+void MeteringDSP::requestLoudnessReset()
+{
+    loudnessResetPending.store(true, std::memory_order_release);
 }
 
-float MeteringDSP::computePeakDb(const float* data, int numSamples) const
+void MeteringDSP::setTruePeakAllowed(bool allowed)
 {
-    float peak = 0.0f;
-    for (int i = 0; i < numSamples; ++i)
-        peak = std::max(peak, std::abs(data[i]));
+    truePeakAllowed = allowed;
+}
 
-    return juce::Decibels::gainToDecibels(peak, kMinDb);
+float MeteringDSP::loudnessWeightForLabel(const juce::String& label)
+{
+    if (label.startsWithIgnoreCase("LFE"))
+        return 0.0f;
+    if (label == "Ls" || label == "Rs" || label == "Lrs" || label == "Rrs" || label == "Cs")
+        return 1.41f;
+    return 1.0f;
 }
 
 float MeteringDSP::smooth(float current, float target, float coeff) const
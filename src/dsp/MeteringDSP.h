@@ -4,6 +4,9 @@
 #include <atomic>
 #include <JuceHeader.h>
 #include "../util/ParamIDs.h"
+#include "../util/RingBuffer.h"
+#include "../util/SeqlockSnapshot.h"
+#include "../util/SimdSupport.h"
 
 namespace eqdsp
 {
@@ -12,13 +15,36 @@ struct ChannelMeterState
 {
     float rmsDb = -120.0f;
     float peakDb = -120.0f;
+    // Inter-sample peak: 4x oversampled below 88.2 kHz, 2x at 88.2/96 kHz; at 176.4 kHz and above
+    // the samples are already that dense and it equals peakDb.
+    float truePeakDb = -120.0f;
 };
 
-// Metering DSP for RMS, peak, correlation, and goniometer points.
+// Everything the meters display, published once per block.
+struct MeterSnapshot
+{
+    int numChannels = 0;
+    std::array<ChannelMeterState, ParamIDs::kMaxChannels> channels {};
+    // ITU-R BS.1770 / EBU R128 loudness (K-weighted, channel-weighted).
+    float momentaryLufs = -120.0f;
+    float shortTermLufs = -120.0f;
+    // Gated (-70 LUFS absolute, -10 LU relative) since the last reset.
+    float integratedLufs = -120.0f;
+    // Highest true peak since the last reset.
+    float truePeakMaxDb = -120.0f;
+    float correlation = 0.0f;
+};
+
+// Metering DSP for RMS, peak, true-peak, loudness, correlation, and goniometer points.
 class MeteringDSP
 {
 public:
-    static constexpr int kScopePoints = 512;
+    // Goniometer point FIFO capacity (about 340 ms of points at 48 kHz).
+    static constexpr int kScopeFifoPoints = 8192;
+    // One goniometer point per this many samples.
+    static constexpr int kScopeDecimation = 2;
+
+    MeteringDSP();
 
     // Prepare internal buffers and smoothers.
     void prepare(double sampleRate);
@@ -28,16 +54,67 @@ public:
     void process(const juce::AudioBuffer<float>& buffer, int numChannels);
     // Set which channels feed correlation/phase scope.
     void setCorrelationPair(int channelA, int channelB);
+    // BS.1770 channel weight (1.0 front, 1.41 surround, 0 LFE); safe from any thread.
+    void setLoudnessWeight(int channelIndex, float weight);
+    // Restart integrated loudness and true-peak max on the next block; safe from any thread.
+    void requestLoudnessReset();
+    // Audio thread: false measures true peak as sample peak (CPU governor).
+    void setTruePeakAllowed(bool allowed);
 
     // Readback current meter values.
     ChannelMeterState getChannelState(int channelIndex) const;
     float getCorrelation() const;
-    int copyScopePoints(juce::Point<float>* dest, int maxPoints, int& writePos) const;
+    // Consistent copy of the latest published values; false if none could be read.
+    bool getSnapshot(MeterSnapshot& dest) const;
+    // UI thread (single consumer): drain up to maxPoints mid/side points, oldest first.
+    int popScopePoints(float* destMid, float* destSide, int maxPoints);
+
+    // BS.1770 weight for a channel label from ChannelLayoutUtils.
+    static float loudnessWeightForLabel(const juce::String& label);
 
 private:
-    // Level computations.
-    float computeRmsDb(const float* data, int numSamples) const;
-    float computePeakDb(const float* data, int numSamples) const;
+    static constexpr int kLanes = 4;
+    static constexpr int kLaneGroups = ParamIDs::kMaxChannels / kLanes;
+    static constexpr int kTruePeakTaps = 12;
+    static constexpr int kTruePeakHalf = kTruePeakTaps / 2;
+    static constexpr int kLoudnessBlocks = 30;
+    static constexpr int kHistogramBins = 750;
+
+    struct Biquad
+    {
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+    };
+
+    // Filter state for up to four channels, one per SIMD lane.
+    struct LaneGroup
+    {
+        Simd::Float4 shelfZ1 = Simd::Float4::zero();
+        Simd::Float4 shelfZ2 = Simd::Float4::zero();
+        Simd::Float4 highPassZ1 = Simd::Float4::zero();
+        Simd::Float4 highPassZ2 = Simd::Float4::zero();
+        // Mirrored history so the interpolator reads one contiguous window.
+        std::array<Simd::Float4, kTruePeakTaps * 2> history {};
+        int historyPos = 0;
+        // First sample of a K-weighting pair left over by the previous segment (pair mode only).
+        Simd::Float4 pendingPair = Simd::Float4::zero();
+        bool pairPending = false;
+    };
+
+    // Block accumulators, one entry per channel.
+    struct Accumulators
+    {
+        std::array<float, ParamIDs::kMaxChannels> sumSquares {};
+        std::array<float, ParamIDs::kMaxChannels> peak {};
+        std::array<float, ParamIDs::kMaxChannels> truePeak {};
+        std::array<float, ParamIDs::kMaxChannels> loudnessSquares {};
+    };
+
+    // One pass over a segment: RMS, peak, true-peak and K-weighted energy for four channels.
+    void processLaneGroup(LaneGroup& group, const float* const* channelData, int lanes,
+                          int firstChannel, int numSamples, Accumulators& acc);
+    // Close a 100 ms loudness block and update momentary/short-term/integrated values.
+    void finishLoudnessBlock(int channels);
+    void computeIntegrated();
 
     // Smoothing helper.
     float smooth(float current, float target, float coeff) const;
@@ -45,15 +122,49 @@ private:
     double sampleRateHz = 48000.0;
     std::array<ChannelMeterState, ParamIDs::kMaxChannels> channelStates {};
 
+    Biquad shelf;
+    Biquad highPass;
+    // Interpolation factor for true peak (4, 2, or 1 = sample peak) from the sample rate.
+    int truePeakFactor = 4;
+    bool truePeakAllowed = true;
+    // At 176.4 kHz and above, K-weighting runs on averaged sample pairs at half the rate.
+    bool loudnessPairs = false;
+    // Folded polyphase interpolator (phase 0 is the input sample itself). Phase 3 is phase 1
+    // mirrored and phase 2 is symmetric, so each uses sums/differences of mirrored window taps.
+    std::array<float, kTruePeakHalf> truePeakEven {};
+    std::array<float, kTruePeakHalf> truePeakOdd {};
+    std::array<float, kTruePeakHalf> truePeakMid {};
+    std::array<LaneGroup, kLaneGroups> laneGroups {};
+
+    std::array<std::atomic<float>, ParamIDs::kMaxChannels> loudnessWeights;
+    std::atomic<bool> loudnessResetPending { false };
+    int loudnessBlockSamples = 4800;
+    int loudnessBlockFill = 0;
+    std::array<double, ParamIDs::kMaxChannels> loudnessBlockEnergy {};
+    std::array<double, kLoudnessBlocks> loudnessHistory {};
+    int loudnessHistoryPos = 0;
+    int loudnessHistoryCount = 0;
+    // Gating-block counts in 0.1 LU bins from -70 LUFS, and each bin's mean-square energy.
+    std::array<uint32_t, kHistogramBins> loudnessHistogram {};
+    std::array<double, kHistogramBins> histogramEnergy {};
+    float momentaryLufs = -120.0f;
+    float shortTermLufs = -120.0f;
+    float integratedLufs = -120.0f;
+    float truePeakMaxDb = -120.0f;
+
     float correlation = 0.0f;
     float correlationSmooth = 0.2f;
     float rmsSmooth = 0.2f;
     float peakSmooth = 0.2f;
     int corrA = 0;
     int corrB = 1;
-    std::array<float, kScopePoints> scopeX {};
-    std::array<float, kScopePoints> scopeY {};
-    std::atomic<int> scopeWritePos { 0 };
+    // Points are staged per block and pushed to the FIFO in chunks (no per-sample index math).
+    static constexpr int kScopeChunk = 256;
+    std::array<float, kScopeChunk> scopeChunkMid {};
+    std::array<float, kScopeChunk> scopeChunkSide {};
+    AudioFifo scopeFifo;
     int scopeDecimCounter = 0;
+
+    SeqlockSnapshot<MeterSnapshot> published;
 };
 } // namespace eqdsp
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <algorithm>
+
+namespace eqdsp
+{
+// Saturation kernels for the character modes (Gentle/Warm).
+// Kept free of JUCE so the kernels can be benchmarked and verified standalone.
+namespace Saturation
+{
+// Beyond this input the rational tanh is clamped to +/-1 (|error| <= 1.0e-4 over the full range).
+constexpr float kTanhClip = 4.97f;
+
+// Drive applied by a character mode (1 = Gentle, 2 = Warm).
+inline float characterDrive(int characterMode) noexcept
+{
+    return characterMode == 1 ? 1.5f : 2.5f;
+}
+
+// Rational (Pade 7/6) tanh approximation with bounded error; branch-free.
+inline float tanhRational(float x) noexcept
+{
+    x = std::max(-kTanhClip, std::min(kTanhClip, x));
+    const float x2 = x * x;
+    const float num = x * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)));
+    const float den = 135135.0f + x2 * (62370.0f + x2 * (3150.0f + x2 * 28.0f));
+    return std::max(-1.0f, std::min(1.0f, num / den));
+}
+
+// y = tanh(drive * x) * outputGain in place (SSE when available, vectorizable fallback otherwise).
+void processTanh(float* data, int numSamples, float drive, float outputGain) noexcept;
+} // namespace Saturation
+} // namespace eqdsp
@@ -0,0 +1,128 @@
+#include "SnapshotBuilder.h"
+
+namespace eqdsp
+{
+void routeBands(ParamSnapshot& snapshot, const std::vector<juce::String>& channelNames, int sourceChannel)
+{
+    const int numChannels = snapshot.numChannels;
+    snapshot.msTargets.fill(0);
+    snapshot.bandChannelMasks.fill(0);
+    if (numChannels <= 0)
+        return;
+    const uint32_t maskAll = (numChannels >= 32)
+        ? 0xFFFFFFFFu
+        : (numChannels > 0 ? ((1u << static_cast<uint32_t>(numChannels)) - 1u) : 0u);
+
+    auto findIndex = [&channelNames](const juce::String& name) -> int
+    {
+        for (int i = 0; i < static_cast<int>(channelNames.size()); ++i)
+            if (channelNames[static_cast<size_t>(i)] == name)
+                return i;
+        return -1;
+    };
+    auto maskForIndex = [&](int index) -> uint32_t
+    {
+        return (index >= 0 && index < numChannels) ? (1u << static_cast<uint32_t>(index)) : 0u;
+    };
+    auto maskFor = [&](const juce::String& name) -> uint32_t
+    {
+        const int idx = findIndex(name);
+        return maskForIndex(idx);
+    };
+    auto maskForPair = [&](const juce::String& left, const juce::String& right) -> uint32_t
+    {
+        return maskFor(left) | maskFor(right);
+    };
+    sourceChannel = juce::jlimit(0, numChannels - 1, sourceChannel);
+    const int lIndex = findIndex("L");
+    const int rIndex = findIndex("R");
+    const uint32_t maskL = maskForIndex(lIndex >= 0 ? lIndex : 0);
+    const uint32_t maskR = maskForIndex(rIndex >= 0 ? rIndex : (numChannels > 1 ? 1 : 0));
+    const uint32_t maskStereo = maskL | maskR;
+
+    for (int band = 0; band < ParamIDs::kBandsPerChannel; ++band)
+    {
+        const int target = snapshot.bands[sourceChannel][band].msTarget;
+        int msTarget = 0;
+        uint32_t mask = maskAll;
+
+        // Map UI selection to a channel mask and optional M/S target.
+        switch (target)
+        {
+            case kMsAll: mask = maskAll; break;
+            case kMsStereoFront: mask = maskStereo; break;
+            case kMsLeft: mask = maskL; break;
+            case kMsRight: mask = maskR; break;
+            case kMsMidFront: msTarget = 1; mask = maskStereo; break;
+            case kMsSideFront: msTarget = 2; mask = maskStereo; break;
+            case kMsCentre: mask = maskFor("C"); break;
+            case kMsLfe: mask = maskFor("LFE"); break;
+            case kMsStereoRear: mask = maskForPair("Ls", "Rs"); break;
+            case kMsLs: mask = maskFor("Ls"); break;
+            case kMsRs: mask = maskFor("Rs"); break;
+            case kMsMidRear: msTarget = 1; mask = maskForPair("Ls", "Rs"); break;
+            case kMsSideRear: msTarget = 2; mask = maskForPair("Ls", "Rs"); break;
+            case kMsStereoLateral: mask = maskForPair("Lrs", "Rrs"); break;
+            case kMsLrs: mask = maskFor("Lrs"); break;
+            case kMsRrs: mask = maskFor("Rrs"); break;
+            case kMsMidLateral: msTarget = 1; mask = maskForPair("Lrs", "Rrs"); break;
+            case kMsSideLateral: msTarget = 2; mask = maskForPair("Lrs", "Rrs"); break;
+            case kMsCs: mask = maskFor("Cs"); break;
+            case kMsStereoFrontWide: mask = maskForPair("Lw", "Rw"); break;
+            case kMsLw: mask = maskFor("Lw"); break;
+            case kMsRw: mask = maskFor("Rw"); break;
+            case kMsMidFrontWide: msTarget = 1; mask = maskForPair("Lw", "Rw"); break;
+            case kMsSideFrontWide: msTarget = 2; mask = maskForPair("Lw", "Rw"); break;
+            case kMsStereoTopFront: mask = maskForPair("TFL", "TFR"); break;
+            case kMsTfl: mask = maskFor("TFL"); break;
+            case kMsTfr: mask = maskFor("TFR"); break;
+            case kMsMidTopFront: msTarget = 1; mask = maskForPair("TFL", "TFR"); break;
+            case kMsSideTopFront: msTarget = 2; mask = maskForPair("TFL", "TFR"); break;
+            case kMsStereoTopRear: mask = maskForPair("TRL", "TRR"); break;
+            case kMsTrl: mask = maskFor("TRL"); break;
+            case kMsTrr: mask = maskFor("TRR"); break;
+            case kMsMidTopRear: msTarget = 1; mask = maskForPair("TRL", "TRR"); break;
+            case kMsSideTopRear: msTarget = 2; mask = maskForPair("TRL", "TRR"); break;
+            case kMsStereoTopMiddle: mask = maskForPair("TML", "TMR"); break;
+            case kMsTml: mask = maskFor("TML"); break;
+            case kMsTmr: mask = maskFor("TMR"); break;
+            case kMsMidTopMiddle: msTarget = 1; mask = maskForPair("TML", "TMR"); break;
+            case kMsSideTopMiddle: msTarget = 2; mask = maskForPair("TML", "TMR"); break;
+            default: mask = maskAll; break;
+        }
+
+        // Guard against missing channel labels: fall back to full mask.
+        if (mask == 0u)
+        {
+            mask = maskAll;
+            msTarget = 0;
+        }
+        const auto maskBitCount = [](uint32_t value)
+        {
+            int count = 0;
+            while (value != 0)
+            {
+                value &= (value - 1u);
+                ++count;
+            }
+            return count;
+        };
+        // Only allow MS targets when a stereo pair is present.
+        if (msTarget != 0 && maskBitCount(mask) < 2)
+            msTarget = 0;
+
+        snapshot.msTargets[band] = msTarget;
+        snapshot.bandChannelMasks[band] = mask;
+
+        // For multi-channel selections, mirror the band parameters to the covered channels.
+        if (maskBitCount(mask) > 1)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                if ((mask & (1u << static_cast<uint32_t>(ch))) != 0)
+                    snapshot.bands[ch][band] = snapshot.bands[sourceChannel][band];
+            }
+        }
+    }
+}
+} // namespace eqdsp
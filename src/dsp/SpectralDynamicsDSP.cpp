@@ -1,53 +1,162 @@
 #include "SpectralDynamicsDSP.h"
 #include <cmath>
 
+namespace
+{
+// Enable/disable crossfade length.
+constexpr double kFadeSeconds = 0.02;
+
+// dest += src * (linear ramp from startGain to endGain).
+void addWithRamp(float* dest, const float* src, float startGain, float endGain, int numSamples)
+{
+    if (startGain == endGain)
+    {
+        if (startGain != 0.0f)
+            juce::FloatVectorOperations::addWithMultiply(dest, src, startGain, numSamples);
+        return;
+    }
+
+    const float step = (endGain - startGain) / static_cast<float>(numSamples);
+    float gain = startGain;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        dest[i] += src[i] * gain;
+        gain += step;
+    }
+}
+
+float moveTowards(float value, float target, float delta)
+{
+    return value < target ? juce::jmin(target, value + delta) : juce::jmax(target, value - delta);
+}
+} // namespace
+
 namespace eqdsp
 {
 void SpectralDynamicsDSP::prepare(double sampleRate, int maxBlockSize, int channels)
 {
     juce::ignoreUnused(maxBlockSize);
     sampleRateHz = sampleRate;
-    fftOrder = 11;
+    fftOrder = requestedOrder;
     fftSize = 1 << fftOrder;
-    hopSize = fftSize / 2;
+    numBins = fftSize / 2 + 1;
     fft = std::make_unique<juce::dsp::FFT>(fftOrder);
 
-    window.assign(static_cast<size_t>(fftSize), 1.0f);
-    juce::dsp::WindowingFunction<float> windowFn(static_cast<size_t>(fftSize),
-                                                 juce::dsp::WindowingFunction<float>::hann, false);
-    windowFn.multiplyWithWindowingTable(window.data(), static_cast<size_t>(fftSize));
-    normalization = 1.0f / static_cast<float>(fftSize * 0.5f);
-
-    const int numChannels = juce::jmax(1, channels);
-    states.clear();
-    states.resize(static_cast<size_t>(numChannels));
-    for (auto& state : states)
+    // Periodic windows so the overlap-add sum is exactly constant. Both shapes are built here
+    // so overlap and window can change at runtime without allocating.
+    for (size_t type = 0; type < windowShapes.size(); ++type)
     {
-        state.circular.assign(static_cast<size_t>(fftSize), 0.0f);
-        state.ola.assign(static_cast<size_t>(fftSize), 0.0f);
-        state.fftData.assign(static_cast<size_t>(fftSize * 2), 0.0f);
-        state.gainDb.assign(static_cast<size_t>(fftSize / 2 + 1), 0.0f);
-        state.writeIndex = 0;
-        state.hopCounter = 0;
+        auto& shape = windowShapes[type];
+        shape.resize(static_cast<size_t>(fftSize));
+        double windowSum = 0.0;
+        double windowPowerSum = 0.0;
+        for (int n = 0; n < fftSize; ++n)
+        {
+            const double s = std::sin(juce::MathConstants<double>::pi * n / fftSize);
+            const double w = static_cast<WindowType>(type) == WindowType::hann ? s * s : s;
+            shape[static_cast<size_t>(n)] = static_cast<float>(w);
+            windowSum += w;
+            windowPowerSum += w * w;
+        }
+        windowSums[type] = windowSum;
+        windowPowerSums[type] = windowPowerSum;
     }
+    analysisWindow.resize(static_cast<size_t>(fftSize));
+    synthesisWindow.resize(static_cast<size_t>(fftSize));
+    applyFrameConfig();
+
+    fadeSamples = juce::jmax(1, juce::roundToInt(kFadeSeconds * sampleRateHz));
+    numPreparedChannels = juce::jmax(1, channels);
+    // Largest hop any overlap can use.
+    chunkScratch.assign(static_cast<size_t>(fftSize / 2), 0.0f);
+    inputRing.setSize(numPreparedChannels, fftSize * 2);
+    olaRing.setSize(numPreparedChannels, fftSize);
+    frames.setSize(numPreparedChannels, fftSize * 2);
+    binPower.setSize(numPreparedChannels, numBins);
+    gainState.setSize(numPreparedChannels, numBins);
+    detectPower.assign(static_cast<size_t>(numBins), 0.0f);
+    detectLevelDb.assign(static_cast<size_t>(numBins), 0.0f);
+    groupGainDb.assign(static_cast<size_t>(numBins), 0.0f);
+    groupGain.assign(static_cast<size_t>(numBins), 1.0f);
+    const double binHz = sampleRateHz / fftSize;
+    erbLayout.build(SpectralKernels::BandScale::erb, numBins, binHz);
+    barkLayout.build(SpectralKernels::BandScale::bark, numBins, binHz);
+    reset();
+}
+
+void SpectralDynamicsDSP::applyFrameConfig()
+{
+    activeOverlap = requestedOverlap;
+    activeWindow = requestedWindow;
+    hopSize = fftSize / activeOverlap;
+    const auto type = static_cast<size_t>(activeWindow);
+    const auto& shape = windowShapes[type];
+    juce::FloatVectorOperations::copy(analysisWindow.data(), shape.data(), fftSize);
+    // A full-scale sine peaks at sum(w) / 2 in its bin; offset the threshold so it reads 0 dBFS.
+    detectorOffsetDb = static_cast<float>(20.0 * std::log10(0.5 * windowSums[type]));
+    // The JUCE inverse FFT already scales by 1/fftSize; only the window overlap sum remains.
+    const float normalization = static_cast<float>(hopSize / windowPowerSums[type]);
+    juce::FloatVectorOperations::multiply(synthesisWindow.data(), shape.data(), normalization, fftSize);
 }
 
 void SpectralDynamicsDSP::reset()
 {
-    for (auto& state : states)
+    inputRing.clear();
+    olaRing.clear();
+    frames.clear();
+    binPower.clear();
+    gainState.clear();
+    ringPos = 0;
+    hopFill = 0;
+    active = false;
+    alignGain = 0.0f;
+    effectGain = 0.0f;
+    warmupRemaining = 0;
+    reportedLatency.store(enabled ? fftSize : 0, std::memory_order_relaxed);
+}
+
+void SpectralDynamicsDSP::activate()
+{
+    // The input ring kept running while inactive, so the delayed dry is valid from the first
+    // sample; only the overlap-add and the envelopes restart.
+    if (frameConfigPending())
+        applyFrameConfig();
+    olaRing.clear();
+    gainState.clear();
+    hopFill = 0;
+    active = true;
+    alignGain = 0.0f;
+    effectGain = 0.0f;
+    // The first fftSize output samples only carry partial overlap-add sums.
+    warmupRemaining = fftSize;
+}
+
+void SpectralDynamicsDSP::writeInputRing(const juce::AudioBuffer<float>& buffer, int numChannels)
+{
+    const int numSamples = buffer.getNumSamples();
+    int done = 0;
+    while (done < numSamples)
     {
-        std::fill(state.circular.begin(), state.circular.end(), 0.0f);
-        std::fill(state.ola.begin(), state.ola.end(), 0.0f);
-        std::fill(state.fftData.begin(), state.fftData.end(), 0.0f);
-        std::fill(state.gainDb.begin(), state.gainDb.end(), 0.0f);
-        state.writeIndex = 0;
-        state.hopCounter = 0;
+        const int chunk = juce::jmin(numSamples - done, fftSize - ringPos);
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const auto* src = buffer.getReadPointer(ch, done);
+            auto* in = inputRing.getWritePointer(ch);
+            juce::FloatVectorOperations::copy(in + ringPos, src, chunk);
+            juce::FloatVectorOperations::copy(in + ringPos + fftSize, src, chunk);
+        }
+        ringPos += chunk;
+        if (ringPos >= fftSize)
+            ringPos -= fftSize;
+        done += chunk;
     }
 }
 
 void SpectralDynamicsDSP::setEnabled(bool shouldEnable)
 {
     enabled = shouldEnable;
+    if (enabled)
+        reportedLatency.store(fftSize, std::memory_order_relaxed);
 }
 
 void SpectralDynamicsDSP::setParams(float threshDb, float ratioIn, float attack, float release, float mixIn)
@@ -59,83 +168,219 @@ void SpectralDynamicsDSP::setParams(float threshDb, float ratioIn, float attack,
     mix = juce::jlimit(0.0f, 1.0f, mixIn);
 }
 
-void SpectralDynamicsDSP::process(juce::AudioBuffer<float>& buffer)
+void SpectralDynamicsDSP::setFrameConfig(int order, int overlap, WindowType window)
+{
+    requestedOrder = juce::jlimit(8, 13, order);
+    requestedWindow = window;
+    // Hann x Hann only sums to a constant at 75% overlap.
+    requestedOverlap = (overlap >= 4 || window == WindowType::hann) ? 4 : 2;
+}
+
+void SpectralDynamicsDSP::updateGainParams()
 {
-    if (! enabled || fft == nullptr || states.empty())
+    // Envelope runs once per hop, so the time constants are expressed in hops.
+    const double hopsPerMs = 0.001 * sampleRateHz / hopSize;
+    gainParams.thresholdDb = thresholdDb + detectorOffsetDb;
+    gainParams.slope = 1.0f - 1.0f / ratio;
+    gainParams.attackCoeff = static_cast<float>(std::exp(-1.0 / (attackMs * hopsPerMs)));
+    gainParams.releaseCoeff = static_cast<float>(std::exp(-1.0 / (releaseMs * hopsPerMs)));
+}
+
+void SpectralDynamicsDSP::setDetection(LinkMode link, BandGrouping grouping)
+{
+    if (link == linkMode && grouping == bandGrouping)
         return;
 
+    // Gain rows change meaning (group and bin/band index), so start the envelopes from unity.
+    linkMode = link;
+    bandGrouping = grouping;
+    gainState.clear();
+}
+
+void SpectralDynamicsDSP::process(juce::AudioBuffer<float>& buffer)
+{
+    if (fft == nullptr || numPreparedChannels == 0)
+        return;
     const int numSamples = buffer.getNumSamples();
-    if (mix <= 0.0f || numSamples <= 0)
+    if (numSamples <= 0)
         return;
-    const int numChannels = juce::jmin(buffer.getNumChannels(), static_cast<int>(states.size()));
+    const int numChannels = juce::jmin(buffer.getNumChannels(), numPreparedChannels);
+    if (! active)
+    {
+        if (! enabled)
+        {
+            // Keep the dry delay line filled so enabling crossfades into real signal.
+            writeInputRing(buffer, numChannels);
+            return;
+        }
+        activate();
+    }
 
-    const float attackCoeff = std::exp(-1.0f / (0.001f * attackMs * sampleRateHz));
-    const float releaseCoeff = std::exp(-1.0f / (0.001f * releaseMs * sampleRateHz));
+    updateGainParams();
+    const float fadeStep = 1.0f / static_cast<float>(fadeSamples);
 
-    for (int ch = 0; ch < numChannels; ++ch)
+    int done = 0;
+    while (done < numSamples)
     {
-        auto& state = states[static_cast<size_t>(ch)];
-        auto* channelData = buffer.getWritePointer(ch);
-
-        for (int i = 0; i < numSamples; ++i)
+        // A frame config change waits for the effect to fade out at a hop boundary, then
+        // restarts the overlap-add like an enable does.
+        if (frameConfigPending() && effectGain <= 0.0f && hopFill == 0)
         {
-            const float input = channelData[i];
-            const float processed = state.ola[static_cast<size_t>(state.writeIndex)];
-            state.ola[static_cast<size_t>(state.writeIndex)] = 0.0f;
+            applyFrameConfig();
+            olaRing.clear();
+            gainState.clear();
+            warmupRemaining = fftSize;
+            updateGainParams();
+        }
 
-            channelData[i] = input * (1.0f - mix) + processed * mix;
-            state.circular[static_cast<size_t>(state.writeIndex)] = input;
+        // Chunks never cross a hop boundary; the ring split replaces per-sample modulo.
+        const int chunk = juce::jmin(numSamples - done, hopSize - hopFill);
+        const int first = juce::jmin(chunk, fftSize - ringPos);
+        const int second = chunk - first;
 
-            state.writeIndex = (state.writeIndex + 1) % fftSize;
-            if (++state.hopCounter < hopSize)
-                continue;
+        // Disable fades the effect out first, then the alignment; enable runs the other way.
+        const float alignTarget = (enabled || effectGain > 0.0f) ? 1.0f : 0.0f;
+        const float effectTarget = (enabled && warmupRemaining == 0 && ! frameConfigPending()) ? 1.0f : 0.0f;
+        const float alignStart = alignGain;
+        const float effectStart = effectGain;
+        alignGain = moveTowards(alignGain, alignTarget, fadeStep * static_cast<float>(chunk));
+        effectGain = moveTowards(effectGain, effectTarget, fadeStep * static_cast<float>(chunk));
+        warmupRemaining = juce::jmax(0, warmupRemaining - chunk);
 
-            state.hopCounter = 0;
-            int readIndex = state.writeIndex;
-            for (int n = 0; n < fftSize; ++n)
-            {
-                const float sample = state.circular[static_cast<size_t>(readIndex)];
-                state.fftData[static_cast<size_t>(n)] = sample * window[static_cast<size_t>(n)];
-                readIndex = (readIndex + 1) % fftSize;
-            }
+        // out = input * (1 - a) + a * (delayedDry * (1 - mix * e) + wet * mix * e)
+        const float inputStart = 1.0f - alignStart;
+        const float inputEnd = 1.0f - alignGain;
+        const float wetStart = alignStart * mix * effectStart;
+        const float wetEnd = alignGain * mix * effectGain;
+        const float dryStart = alignStart - wetStart;
+        const float dryEnd = alignGain - wetEnd;
+        const float wetSplit = wetStart + (wetEnd - wetStart) * static_cast<float>(first) / static_cast<float>(chunk);
 
-            std::fill(state.fftData.begin() + fftSize, state.fftData.end(), 0.0f);
-            fft->performRealOnlyForwardTransform(state.fftData.data());
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* io = buffer.getWritePointer(ch, done);
+            auto* in = inputRing.getWritePointer(ch);
+            auto* ola = olaRing.getWritePointer(ch);
 
-            const int bins = fftSize / 2;
-            for (int bin = 0; bin <= bins; ++bin)
+            juce::FloatVectorOperations::copy(chunkScratch.data(), io, chunk);
+            juce::FloatVectorOperations::clear(io, chunk);
+            // Dry is the input delayed by fftSize: the oldest samples of the mirrored ring.
+            addWithRamp(io, in + ringPos, dryStart, dryEnd, chunk);
+            addWithRamp(io, ola + ringPos, wetStart, wetSplit, first);
+            juce::FloatVectorOperations::clear(ola + ringPos, first);
+            if (second > 0)
             {
-                const int index = bin * 2;
-                const float re = state.fftData[static_cast<size_t>(index)];
-                const float im = state.fftData[static_cast<size_t>(index + 1)];
-                const float mag = std::sqrt(re * re + im * im) + 1.0e-8f;
-                const float magDb = juce::Decibels::gainToDecibels(mag, -120.0f);
-
-                float targetGainDb = 0.0f;
-                if (magDb > thresholdDb)
-                    targetGainDb = (thresholdDb + (magDb - thresholdDb) / ratio) - magDb;
-
-                float& gainDb = state.gainDb[static_cast<size_t>(bin)];
-                if (targetGainDb < gainDb)
-                    gainDb = attackCoeff * gainDb + (1.0f - attackCoeff) * targetGainDb;
-                else
-                    gainDb = releaseCoeff * gainDb + (1.0f - releaseCoeff) * targetGainDb;
-
-                const float gain = juce::Decibels::decibelsToGain(gainDb);
-                state.fftData[static_cast<size_t>(index)] = re * gain;
-                state.fftData[static_cast<size_t>(index + 1)] = im * gain;
+                addWithRamp(io + first, ola, wetSplit, wetEnd, second);
+                juce::FloatVectorOperations::clear(ola, second);
             }
+            addWithRamp(io, chunkScratch.data(), inputStart, inputEnd, chunk);
 
-            fft->performRealOnlyInverseTransform(state.fftData.data());
-
-            for (int n = 0; n < fftSize; ++n)
+            juce::FloatVectorOperations::copy(in + ringPos, chunkScratch.data(), first);
+            juce::FloatVectorOperations::copy(in + ringPos + fftSize, chunkScratch.data(), first);
+            if (second > 0)
             {
-                const float value = state.fftData[static_cast<size_t>(n)]
-                    * window[static_cast<size_t>(n)] * normalization;
-                const int outIndex = (state.writeIndex + n) % fftSize;
-                state.ola[static_cast<size_t>(outIndex)] += value;
+                juce::FloatVectorOperations::copy(in, chunkScratch.data() + first, second);
+                juce::FloatVectorOperations::copy(in + fftSize, chunkScratch.data() + first, second);
             }
         }
+
+        ringPos += chunk;
+        if (ringPos >= fftSize)
+            ringPos -= fftSize;
+        hopFill += chunk;
+        done += chunk;
+
+        if (hopFill == hopSize)
+        {
+            hopFill = 0;
+            processFrames(numChannels);
+        }
+    }
+
+    if (! enabled && alignGain <= 0.0f && effectGain <= 0.0f)
+    {
+        active = false;
+        reportedLatency.store(0, std::memory_order_relaxed);
+    }
+}
+
+void SpectralDynamicsDSP::processFrames(int numChannels)
+{
+    // Stage-major across channels keeps the window, twiddles and kernels hot in cache.
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto* frame = frames.getWritePointer(ch);
+        juce::FloatVectorOperations::multiply(frame, inputRing.getReadPointer(ch, ringPos),
+                                              analysisWindow.data(), fftSize);
+        juce::FloatVectorOperations::clear(frame + fftSize, fftSize);
+    }
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        fft->performRealOnlyForwardTransform(frames.getWritePointer(ch), true);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        SpectralKernels::powerSpectrum(frames.getReadPointer(ch), binPower.getWritePointer(ch), numBins);
+
+    // One detector and gain computer per link group; bands shrink the gain computer further.
+    const SpectralKernels::BandLayout* layout = bandGrouping == BandGrouping::erb ? &erbLayout
+        : bandGrouping == BandGrouping::bark ? &barkLayout : nullptr;
+    const int groupSize = linkMode == LinkMode::independent ? 1 : numChannels;
+    for (int first = 0, group = 0; first < numChannels; first += groupSize, ++group)
+    {
+        const float* power = computeGroupPower(first, groupSize);
+        auto* state = gainState.getWritePointer(group);
+        if (layout != nullptr)
+        {
+            const int numBands = layout->getNumBands();
+            layout->binsToBands(power, detectLevelDb.data());
+            SpectralKernels::powerToDecibels(detectLevelDb.data(), detectLevelDb.data(), numBands);
+            SpectralKernels::updateGainDb(detectLevelDb.data(), state, numBands, gainParams);
+            layout->bandsToBins(state, groupGainDb.data());
+            SpectralKernels::decibelsToGain(groupGainDb.data(), groupGain.data(), numBins);
+        }
+        else
+        {
+            SpectralKernels::powerToDecibels(power, detectLevelDb.data(), numBins);
+            SpectralKernels::updateGainDb(detectLevelDb.data(), state, numBins, gainParams);
+            SpectralKernels::decibelsToGain(state, groupGain.data(), numBins);
+        }
+
+        for (int ch = first; ch < first + groupSize; ++ch)
+            SpectralKernels::applyGain(groupGain.data(), frames.getWritePointer(ch), numBins);
+    }
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        fft->performRealOnlyInverseTransform(frames.getWritePointer(ch));
+
+    // The frame's first sample is due fftSize samples after it entered, i.e. at the ring position.
+    const int first = fftSize - ringPos;
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto* frame = frames.getWritePointer(ch);
+        auto* ola = olaRing.getWritePointer(ch);
+        juce::FloatVectorOperations::multiply(frame, synthesisWindow.data(), fftSize);
+        juce::FloatVectorOperations::add(ola + ringPos, frame, first);
+        if (ringPos > 0)
+            juce::FloatVectorOperations::add(ola, frame + first, ringPos);
+    }
+}
+
+const float* SpectralDynamicsDSP::computeGroupPower(int firstChannel, int count)
+{
+    if (count == 1)
+        return binPower.getReadPointer(firstChannel);
+
+    auto* linked = detectPower.data();
+    juce::FloatVectorOperations::copy(linked, binPower.getReadPointer(firstChannel), numBins);
+    for (int ch = firstChannel + 1; ch < firstChannel + count; ++ch)
+    {
+        if (linkMode == LinkMode::max)
+            juce::FloatVectorOperations::max(linked, linked, binPower.getReadPointer(ch), numBins);
+        else
+            juce::FloatVectorOperations::add(linked, binPower.getReadPointer(ch), numBins);
     }
+    if (linkMode == LinkMode::sum)
+        juce::FloatVectorOperations::multiply(linked, 1.0f / static_cast<float>(count), numBins);
+    return linked;
 }
 } // namespace eqdsp
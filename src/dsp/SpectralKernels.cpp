@@ -0,0 +1,256 @@
+#include "SpectralKernels.h"
+#include "../util/SimdSupport.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+// log2(1 + u) ~= u * P(u) on u in [0, 1) (least-squares fit).
+constexpr float kLog0 = 1.44253327f;
+constexpr float kLog1 = -0.716107192f;
+constexpr float kLog2 = 0.43954689f;
+constexpr float kLog3 = -0.225099039f;
+constexpr float kLog4 = 0.0592428557f;
+// 2^f ~= Q(f) on f in [0, 1) (least-squares fit).
+constexpr float kExp0 = 1.00000727f;
+constexpr float kExp1 = 0.692931415f;
+constexpr float kExp2 = 0.241709986f;
+constexpr float kExp3 = 0.0516670284f;
+constexpr float kExp4 = 0.0136765608f;
+constexpr float kExpLimit = 126.0f;
+// 10 * log10(2): power log2 -> dB.
+constexpr float kPowerLog2ToDb = 3.01029995664f;
+// log2(10) / 20: amplitude dB -> log2.
+constexpr float kDbToLog2 = 0.166096404744f;
+
+#if EQPRO_HAS_SSE2
+inline __m128 fastLog2Sse(__m128 x) noexcept
+{
+    const __m128i bits = _mm_castps_si128(x);
+    const __m128 exponent = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127)));
+    const __m128 mantissa = _mm_or_ps(_mm_and_ps(x, _mm_castsi128_ps(_mm_set1_epi32(0x007fffff))),
+                                      _mm_set1_ps(1.0f));
+    const __m128 u = _mm_sub_ps(mantissa, _mm_set1_ps(1.0f));
+    __m128 p = _mm_add_ps(_mm_set1_ps(kLog3), _mm_mul_ps(u, _mm_set1_ps(kLog4)));
+    p = _mm_add_ps(_mm_set1_ps(kLog2), _mm_mul_ps(u, p));
+    p = _mm_add_ps(_mm_set1_ps(kLog1), _mm_mul_ps(u, p));
+    p = _mm_add_ps(_mm_set1_ps(kLog0), _mm_mul_ps(u, p));
+    return _mm_add_ps(exponent, _mm_mul_ps(u, p));
+}
+
+inline __m128 fastExp2Sse(__m128 x) noexcept
+{
+    x = _mm_max_ps(_mm_set1_ps(-kExpLimit), _mm_min_ps(_mm_set1_ps(kExpLimit), x));
+    // floor() without SSE4.1: truncate, then step down where truncation rounded up.
+    __m128 whole = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+    whole = _mm_sub_ps(whole, _mm_and_ps(_mm_cmpgt_ps(whole, x), _mm_set1_ps(1.0f)));
+    const __m128 f = _mm_sub_ps(x, whole);
+    __m128 p = _mm_add_ps(_mm_set1_ps(kExp3), _mm_mul_ps(f, _mm_set1_ps(kExp4)));
+    p = _mm_add_ps(_mm_set1_ps(kExp2), _mm_mul_ps(f, p));
+    p = _mm_add_ps(_mm_set1_ps(kExp1), _mm_mul_ps(f, p));
+    p = _mm_add_ps(_mm_set1_ps(kExp0), _mm_mul_ps(f, p));
+    const __m128i scaleBits = _mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(whole), _mm_set1_epi32(127)), 23);
+    return _mm_mul_ps(p, _mm_castsi128_ps(scaleBits));
+}
+#endif
+} // namespace
+
+namespace eqdsp
+{
+namespace SpectralKernels
+{
+void BandLayout::build(BandScale scale, int numBins, double binHz)
+{
+    auto toScale = [scale](double hz)
+    {
+        if (scale == BandScale::erb)
+            return 21.4 * std::log10(1.0 + 0.00437 * hz);
+        return 13.0 * std::atan(0.00076 * hz) + 3.5 * std::atan((hz / 7500.0) * (hz / 7500.0));
+    };
+
+    // A new band starts wherever the integer scale index changes.
+    bandStart.clear();
+    int lastIndex = -1;
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+        const int index = static_cast<int>(toScale(bin * binHz));
+        if (index != lastIndex)
+        {
+            bandStart.push_back(bin);
+            lastIndex = index;
+        }
+    }
+    bandStart.push_back(numBins);
+
+    const int numBands = static_cast<int>(bandStart.size()) - 1;
+    bandCentre.resize(static_cast<size_t>(numBands));
+    for (int b = 0; b < numBands; ++b)
+        bandCentre[static_cast<size_t>(b)] = 0.5f * static_cast<float>(bandStart[static_cast<size_t>(b)]
+                                                                       + bandStart[static_cast<size_t>(b + 1)] - 1);
+
+    binLower.resize(static_cast<size_t>(numBins));
+    binUpper.resize(static_cast<size_t>(numBins));
+    binFraction.resize(static_cast<size_t>(numBins));
+    int lower = 0;
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+        while (lower + 1 < numBands && bandCentre[static_cast<size_t>(lower + 1)] <= static_cast<float>(bin))
+            ++lower;
+        const int upper = std::min(lower + 1, numBands - 1);
+        const float span = bandCentre[static_cast<size_t>(upper)] - bandCentre[static_cast<size_t>(lower)];
+        const float t = span > 0.0f ? (static_cast<float>(bin) - bandCentre[static_cast<size_t>(lower)]) / span : 0.0f;
+        binLower[static_cast<size_t>(bin)] = lower;
+        binUpper[static_cast<size_t>(bin)] = upper;
+        binFraction[static_cast<size_t>(bin)] = std::max(0.0f, std::min(1.0f, t));
+    }
+}
+
+void BandLayout::binsToBands(const float* binPower, float* bandPower) const noexcept
+{
+    const int numBands = getNumBands();
+    for (int b = 0; b < numBands; ++b)
+    {
+        const int start = bandStart[static_cast<size_t>(b)];
+        const int end = bandStart[static_cast<size_t>(b + 1)];
+        float sum = 0.0f;
+        for (int bin = start; bin < end; ++bin)
+            sum += binPower[bin];
+        bandPower[b] = sum / static_cast<float>(end - start);
+    }
+}
+
+void BandLayout::bandsToBins(const float* bandValues, float* binValues) const noexcept
+{
+    const int numBins = static_cast<int>(binFraction.size());
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+        const float lo = bandValues[binLower[static_cast<size_t>(bin)]];
+        const float hi = bandValues[binUpper[static_cast<size_t>(bin)]];
+        binValues[bin] = lo + binFraction[static_cast<size_t>(bin)] * (hi - lo);
+    }
+}
+
+float fastLog2(float x) noexcept
+{
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &x, sizeof(bits));
+    const float exponent = static_cast<float>(static_cast<int>((bits >> 23) & 0xffu) - 127);
+    bits = (bits & 0x007fffffu) | 0x3f800000u;
+    float mantissa = 0.0f;
+    std::memcpy(&mantissa, &bits, sizeof(mantissa));
+    const float u = mantissa - 1.0f;
+    return exponent + u * (kLog0 + u * (kLog1 + u * (kLog2 + u * (kLog3 + u * kLog4))));
+}
+
+float fastExp2(float x) noexcept
+{
+    x = std::max(-kExpLimit, std::min(kExpLimit, x));
+    const float whole = std::floor(x);
+    const float f = x - whole;
+    const float p = kExp0 + f * (kExp1 + f * (kExp2 + f * (kExp3 + f * kExp4)));
+    const std::uint32_t scaleBits = static_cast<std::uint32_t>(static_cast<int>(whole) + 127) << 23;
+    float scale = 0.0f;
+    std::memcpy(&scale, &scaleBits, sizeof(scale));
+    return p * scale;
+}
+
+void powerSpectrum(const float* spectrum, float* power, int numBins) noexcept
+{
+    int bin = 0;
+#if EQPRO_HAS_SSE2
+    for (; bin + 3 < numBins; bin += 4)
+    {
+        const __m128 a = _mm_loadu_ps(spectrum + 2 * bin);
+        const __m128 b = _mm_loadu_ps(spectrum + 2 * bin + 4);
+        const __m128 a2 = _mm_mul_ps(a, a);
+        const __m128 b2 = _mm_mul_ps(b, b);
+        const __m128 re2 = _mm_shuffle_ps(a2, b2, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 im2 = _mm_shuffle_ps(a2, b2, _MM_SHUFFLE(3, 1, 3, 1));
+        _mm_storeu_ps(power + bin, _mm_add_ps(re2, im2));
+    }
+#endif
+    for (; bin < numBins; ++bin)
+    {
+        const float re = spectrum[2 * bin];
+        const float im = spectrum[2 * bin + 1];
+        power[bin] = re * re + im * im;
+    }
+}
+
+void powerToDecibels(const float* power, float* levelDb, int numBins) noexcept
+{
+    int bin = 0;
+#if EQPRO_HAS_SSE2
+    const __m128 floorV = _mm_set1_ps(kPowerFloor);
+    const __m128 scaleV = _mm_set1_ps(kPowerLog2ToDb);
+    for (; bin + 3 < numBins; bin += 4)
+    {
+        const __m128 p = _mm_add_ps(_mm_loadu_ps(power + bin), floorV);
+        _mm_storeu_ps(levelDb + bin, _mm_mul_ps(fastLog2Sse(p), scaleV));
+    }
+#endif
+    for (; bin < numBins; ++bin)
+        levelDb[bin] = fastLog2(power[bin] + kPowerFloor) * kPowerLog2ToDb;
+}
+
+void updateGainDb(const float* levelDb, float* gainDb, int count, const GainParams& params) noexcept
+{
+    int i = 0;
+#if EQPRO_HAS_SSE2
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 thresholdV = _mm_set1_ps(params.thresholdDb);
+    const __m128 slopeV = _mm_set1_ps(params.slope);
+    const __m128 attackV = _mm_set1_ps(params.attackCoeff);
+    const __m128 releaseV = _mm_set1_ps(params.releaseCoeff);
+    for (; i + 3 < count; i += 4)
+    {
+        const __m128 level = _mm_loadu_ps(levelDb + i);
+        const __m128 target = _mm_min_ps(zero, _mm_mul_ps(_mm_sub_ps(thresholdV, level), slopeV));
+        const __m128 gain = _mm_loadu_ps(gainDb + i);
+        const __m128 attacking = _mm_cmplt_ps(target, gain);
+        const __m128 coeff = _mm_or_ps(_mm_and_ps(attacking, attackV), _mm_andnot_ps(attacking, releaseV));
+        _mm_storeu_ps(gainDb + i, _mm_add_ps(target, _mm_mul_ps(coeff, _mm_sub_ps(gain, target))));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        const float target = std::min(0.0f, (params.thresholdDb - levelDb[i]) * params.slope);
+        const float coeff = target < gainDb[i] ? params.attackCoeff : params.releaseCoeff;
+        gainDb[i] = target + coeff * (gainDb[i] - target);
+    }
+}
+
+void decibelsToGain(const float* gainDb, float* gain, int count) noexcept
+{
+    int i = 0;
+#if EQPRO_HAS_SSE2
+    const __m128 dbToLog2V = _mm_set1_ps(kDbToLog2);
+    for (; i + 3 < count; i += 4)
+        _mm_storeu_ps(gain + i, fastExp2Sse(_mm_mul_ps(_mm_loadu_ps(gainDb + i), dbToLog2V)));
+#endif
+    for (; i < count; ++i)
+        gain[i] = fastExp2(gainDb[i] * kDbToLog2);
+}
+
+void applyGain(const float* gain, float* spectrum, int numBins) noexcept
+{
+    int bin = 0;
+#if EQPRO_HAS_SSE2
+    for (; bin + 3 < numBins; bin += 4)
+    {
+        const __m128 g = _mm_loadu_ps(gain + bin);
+        float* pair = spectrum + 2 * bin;
+        _mm_storeu_ps(pair, _mm_mul_ps(_mm_loadu_ps(pair), _mm_unpacklo_ps(g, g)));
+        _mm_storeu_ps(pair + 4, _mm_mul_ps(_mm_loadu_ps(pair + 4), _mm_unpackhi_ps(g, g)));
+    }
+#endif
+    for (; bin < numBins; ++bin)
+    {
+        spectrum[2 * bin] *= gain[bin];
+        spectrum[2 * bin + 1] *= gain[bin];
+    }
+}
+} // namespace SpectralKernels
+} // namespace eqdsp
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <vector>
+
+namespace eqdsp
+{
+// Per-bin kernels for the spectral dynamics STFT (SSE when available, scalar fallback otherwise).
+// Spectra use the JUCE real-only FFT layout: interleaved re/im pairs for bins 0..fftSize/2.
+// Kept free of JUCE so the kernels can be benchmarked and verified standalone.
+namespace SpectralKernels
+{
+// Bins below this power (-120 dB) are treated as silence.
+constexpr float kPowerFloor = 1.0e-12f;
+
+// Gain-computer settings, precomputed once per block.
+struct GainParams
+{
+    float thresholdDb = -24.0f;
+    // 1 - 1/ratio: dB of reduction per dB above threshold.
+    float slope = 0.5f;
+    // Per-hop one-pole coefficients for increasing (attack) and decreasing (release) reduction.
+    float attackCoeff = 0.0f;
+    float releaseCoeff = 0.0f;
+};
+
+// Perceptual scales for grouping bins into bands (one band per ERB or Bark).
+enum class BandScale
+{
+    erb,
+    bark
+};
+
+// Bin -> band grouping plus the band -> bin interpolation map; built off the audio thread.
+struct BandLayout
+{
+    // Band b covers bins [bandStart[b], bandStart[b + 1]).
+    std::vector<int> bandStart;
+    // Band centres in (fractional) bins.
+    std::vector<float> bandCentre;
+    // Per bin: neighbouring band centres and the linear weight of the upper one.
+    std::vector<int> binLower;
+    std::vector<int> binUpper;
+    std::vector<float> binFraction;
+
+    int getNumBands() const noexcept { return static_cast<int>(bandCentre.size()); }
+    void build(BandScale scale, int numBins, double binHz);
+    // bandPower[b] = mean power of the band's bins.
+    void binsToBands(const float* binPower, float* bandPower) const noexcept;
+    // Linear interpolation between band centres (values are in dB, so gains stay smooth).
+    void bandsToBins(const float* bandValues, float* binValues) const noexcept;
+};
+
+// Fast log2/exp2 approximations (|log2 error| < 1.2e-4, exp2 relative error < 7.3e-6).
+float fastLog2(float x) noexcept;
+float fastExp2(float x) noexcept;
+
+// power[bin] = re^2 + im^2.
+void powerSpectrum(const float* spectrum, float* power, int numBins) noexcept;
+
+// levelDb[bin] = 10 * log10(power[bin] + kPowerFloor); may run in place.
+void powerToDecibels(const float* power, float* levelDb, int numBins) noexcept;
+
+// Log-domain gain computer: smooths gainDb toward min(0, (threshold - level) * slope).
+// Runs once per link group, on bins or on grouped bands.
+void updateGainDb(const float* levelDb, float* gainDb, int count, const GainParams& params) noexcept;
+
+// gain[i] = 10^(gainDb[i] / 20) via fast exp2; may run in place.
+void decibelsToGain(const float* gainDb, float* gain, int count) noexcept;
+
+// Multiplies each bin's re/im pair by gain[bin].
+void applyGain(const float* gain, float* spectrum, int numBins) noexcept;
+} // namespace SpectralKernels
+} // namespace eqdsp
@@ -0,0 +1,487 @@
+#include "AnalyzerWorker.h"
+#include <cstring>
+#include <algorithm>
+#include <limits>
+#include "../util/FFTUtils.h"
+
+namespace
+{
+constexpr float kAnalyzerMinDb = -60.0f;
+// Power floor matching kAnalyzerMinDb.
+constexpr float kMinPower = 1.0e-6f;
+// Usable fraction of the Nyquist band once the taps have decimated (half-band passband edge).
+constexpr double kDecimatedBandEdge = 0.83;
+// Multi-resolution stages take over below this fraction of their own rate (half-band passband, with margin).
+constexpr double kStageEdge = 0.4;
+// Multi-resolution: short transform for the top octaves, long ones on the decimated copies.
+constexpr int kShortOrder = 10;
+constexpr int kLongOrder = 12;
+constexpr int kMultiResStages = 4;
+// Hops older than this many per update slide through without a transform (backlog after a stall).
+constexpr int kMaxHopsPerUpdate = 16;
+constexpr float kPeakHoldSeconds = 1.0f;
+constexpr float kPeakFallDbPerSecond = 20.0f;
+
+float powerToDb(float power, float offsetDb)
+{
+    return juce::jmax(kAnalyzerMinDb, 10.0f * std::log10(juce::jmax(power, 1.0e-12f)) + offsetDb);
+}
+}
+
+AnalyzerWorker::AnalyzerWorker(AudioFifo& preFifo, AudioFifo& postFifo, AudioFifo& harmonicFifo,
+                               AudioFifo& externalFifo)
+    : juce::Thread("EQPro Analyzer")
+{
+    fifos = { &preFifo, &postFifo, &harmonicFifo, &externalFifo };
+    for (auto& curve : frame.curves)
+        curve.fill(kAnalyzerMinDb);
+    for (auto& curve : frame.peaks)
+        curve.fill(kAnalyzerMinDb);
+}
+
+AnalyzerWorker::~AnalyzerWorker()
+{
+    stop();
+}
+
+void AnalyzerWorker::retain()
+{
+    if (++users == 1 && ! isThreadRunning())
+        startThread(juce::Thread::Priority::low);
+}
+
+void AnalyzerWorker::release()
+{
+    jassert(users > 0);
+    if (users > 0 && --users == 0)
+        stop();
+}
+
+void AnalyzerWorker::stop()
+{
+    signalThreadShouldExit();
+    notify();
+    stopThread(1000);
+}
+
+void AnalyzerWorker::setSettings(const AnalyzerSettings& settings)
+{
+    settingsIn.write(settings);
+    notify();
+}
+
+bool AnalyzerWorker::fetchFrame(AnalyzerFrame& dest, uint32_t& lastVersion) const
+{
+    const auto version = published.getVersion();
+    if (version == lastVersion)
+        return false;
+    if (! published.read(dest))
+        return false;
+    lastVersion = version;
+    return true;
+}
+
+void AnalyzerWorker::run()
+{
+    double lastAnalyseMs = juce::Time::getMillisecondCounterHiRes();
+    while (! threadShouldExit())
+    {
+        AnalyzerSettings settings;
+        const bool haveSettings = settingsIn.read(settings);
+        const double startMs = juce::Time::getMillisecondCounterHiRes();
+
+        auto* sink = frameSink.load(std::memory_order_acquire);
+        if (haveSettings && settings.numPoints > 0 && (! settings.frozen || sink != nullptr))
+        {
+            // A frozen view keeps its last published frame; the sink still gets fresh analysis.
+            if (sink != nullptr)
+                for (int c = 0; c < AnalyzerFrame::kNumCurves; ++c)
+                    settings.wantCurve[static_cast<size_t>(c)] =
+                        settings.wantCurve[static_cast<size_t>(c)] || sink->wantsCurve(static_cast<AnalyzerCurve>(c));
+            const float elapsedSeconds = static_cast<float>(juce::jlimit(0.0, 1.0, (startMs - lastAnalyseMs) * 0.001));
+            analyse(settings, elapsedSeconds);
+            if (! settings.frozen)
+                published.write(frame);
+            if (sink != nullptr)
+                sink->analyzerFrameReady(frame);
+        }
+        lastAnalyseMs = startMs;
+
+        const int periodMs = 1000 / juce::jlimit(1, 200, settings.updateHz);
+        const int elapsedMs = static_cast<int>(juce::Time::getMillisecondCounterHiRes() - startMs);
+        wait(juce::jmax(1, periodMs - elapsedMs));
+    }
+}
+
+AnalyzerWorker::StageLayout AnalyzerWorker::makeLayout(const AnalyzerSettings& settings)
+{
+    const int hopDivisor = juce::jlimit(2, 16, settings.hopDivisor);
+    StageLayout layout;
+    if (! settings.multiResolution)
+    {
+        layout.numStages = 1;
+        layout.fftOrder[0] = kLongOrder;
+        layout.hopDivisor[0] = hopDivisor;
+        return layout;
+    }
+
+    // A 1024-point top stage plus three 4096-point stages at 1/2, 1/4 and 1/8 of the rate: the
+    // lowest octaves get the bin spacing of a 32768-point transform. Every stage hops twice as far
+    // as the overlap setting asks (50% at least), which keeps the total near one 4096-point STFT.
+    layout.numStages = kMultiResStages;
+    for (int s = 0; s < kMultiResStages; ++s)
+    {
+        layout.fftOrder[static_cast<size_t>(s)] = s == 0 ? kShortOrder : kLongOrder;
+        layout.hopDivisor[static_cast<size_t>(s)] = juce::jmax(2, hopDivisor / 2);
+    }
+    return layout;
+}
+
+void AnalyzerWorker::configure(CurveState& state, int channels, const StageLayout& layout)
+{
+    state.channels = channels;
+    state.layout = layout;
+    for (int s = 0; s < kMaxStages; ++s)
+    {
+        auto& stage = state.stages[static_cast<size_t>(s)];
+        const int size = s < layout.numStages ? 1 << layout.fftOrder[static_cast<size_t>(s)] : 0;
+        // Allocation happens here, on the worker, only when the source or layout changes.
+        stage.history.setSize(channels, size * 2, false, false, true);
+        stage.history.clear();
+        stage.writePos = size;
+        stage.sinceHop = 0;
+        stage.averagePower.fill(kMinPower);
+        stage.welchSum.fill(0.0f);
+        stage.welchCount = 0;
+        stage.hasAverage = false;
+    }
+    for (auto& stageDecimators : state.decimators)
+        for (auto& decimator : stageDecimators)
+            decimator.reset();
+}
+
+void AnalyzerWorker::transformStage(const StageState& stage, int channels, int order)
+{
+    const int size = 1 << order;
+    const int bins = size / 2;
+    auto& fft = order == kShortOrder ? fftShort : fftLong;
+    auto& window = order == kShortOrder ? windowShort : windowLong;
+    std::fill(hopPower.begin(), hopPower.begin() + bins, 0.0f);
+    // All-channel source: the per-channel power spectra are summed.
+    for (int ch = 0; ch < channels; ++ch)
+    {
+        std::memcpy(fftData.data(), stage.history.getReadPointer(ch, stage.writePos - size), sizeof(float) * static_cast<size_t>(size));
+        std::fill(fftData.begin() + size, fftData.begin() + size * 2, 0.0f);
+        window.multiplyWithWindowingTable(fftData.data(), static_cast<size_t>(size));
+        fft.performFrequencyOnlyForwardTransform(fftData.data());
+        for (int i = 0; i < bins; ++i)
+            hopPower[static_cast<size_t>(i)] += fftData[static_cast<size_t>(i)] * fftData[static_cast<size_t>(i)];
+    }
+}
+
+bool AnalyzerWorker::advance(CurveState& state, AudioFifo& fifo, const AnalyzerSettings& settings, double rate)
+{
+    const auto layout = makeLayout(settings);
+    const int frames = juce::jlimit(1, ParamIDs::kMaxChannels, juce::jmin(fifo.acknowledgeLayout(), fifo.getNumChannels()));
+    // Source or mode change: restart from silence rather than mixing layouts.
+    if (frames != state.channels || layout != state.layout)
+        configure(state, frames, layout);
+
+    // The top stage consumes the FIFO one hop at a time; deeper stages receive the decimated chunks.
+    const int chunk = (1 << layout.fftOrder[0]) / layout.hopDivisor[0];
+    std::array<float*, ParamIDs::kMaxChannels> chunkData {};
+    for (int ch = 0; ch < frames; ++ch)
+        chunkData[static_cast<size_t>(ch)] = chunkBuffer.getWritePointer(ch);
+
+    bool transformed = false;
+    int ready = fifo.getNumReady();
+    while (ready >= chunk)
+    {
+        int count = fifo.pullFrames(chunkData.data(), frames, chunk);
+        ready -= chunk;
+        const bool allowTransform = ready < chunk * kMaxHopsPerUpdate;
+
+        for (int s = 0; s < layout.numStages && count > 0; ++s)
+        {
+            auto& stage = state.stages[static_cast<size_t>(s)];
+            const int order = layout.fftOrder[static_cast<size_t>(s)];
+            const int size = 1 << order;
+            if (s > 0)
+            {
+                int decimated = 0;
+                for (int ch = 0; ch < frames; ++ch)
+                    decimated = state.decimators[static_cast<size_t>(s - 1)][static_cast<size_t>(ch)]
+                                    .process(chunkData[static_cast<size_t>(ch)], count);
+                count = decimated;
+                if (count == 0)
+                    break;
+            }
+
+            // Append; when the buffer is full, keep the last window and continue from the middle.
+            if (stage.writePos + count > size * 2)
+            {
+                for (int ch = 0; ch < frames; ++ch)
+                {
+                    auto* data = stage.history.getWritePointer(ch);
+                    std::memmove(data, data + stage.writePos - size, sizeof(float) * static_cast<size_t>(size));
+                }
+                stage.writePos = size;
+            }
+            for (int ch = 0; ch < frames; ++ch)
+                std::memcpy(stage.history.getWritePointer(ch, stage.writePos), chunkData[static_cast<size_t>(ch)],
+                            sizeof(float) * static_cast<size_t>(count));
+            stage.writePos += count;
+            stage.sinceHop += count;
+
+            const int hop = size / layout.hopDivisor[static_cast<size_t>(s)];
+            if (stage.sinceHop < hop)
+                continue;
+            stage.sinceHop -= hop;
+            if (! allowTransform)
+                continue;
+
+            transformStage(stage, frames, order);
+            transformed = true;
+            const int bins = size / 2;
+            const double stageRate = rate / static_cast<double>(1 << s);
+            const float alpha = 1.0f - std::exp(-static_cast<float>(hop)
+                                                / (juce::jmax(1.0f, settings.averagingMs) * 0.001f * static_cast<float>(stageRate)));
+            if (settings.averaging == AnalyzerAveraging::welch)
+            {
+                for (int i = 0; i < bins; ++i)
+                    stage.welchSum[static_cast<size_t>(i)] += hopPower[static_cast<size_t>(i)];
+                ++stage.welchCount;
+            }
+            else if (! stage.hasAverage)
+            {
+                std::copy(hopPower.begin(), hopPower.begin() + bins, stage.averagePower.begin());
+                stage.hasAverage = true;
+            }
+            else
+            {
+                for (int i = 0; i < bins; ++i)
+                {
+                    auto& avg = stage.averagePower[static_cast<size_t>(i)];
+                    avg += alpha * (hopPower[static_cast<size_t>(i)] - avg);
+                }
+            }
+        }
+    }
+
+    if (settings.averaging == AnalyzerAveraging::welch)
+    {
+        // Welch: the frame shows the mean periodogram of the hops since the previous frame.
+        for (int s = 0; s < layout.numStages; ++s)
+        {
+            auto& stage = state.stages[static_cast<size_t>(s)];
+            if (stage.welchCount == 0)
+                continue;
+            const int bins = (1 << layout.fftOrder[static_cast<size_t>(s)]) / 2;
+            const float scale = 1.0f / static_cast<float>(stage.welchCount);
+            for (int i = 0; i < bins; ++i)
+                stage.averagePower[static_cast<size_t>(i)] = stage.welchSum[static_cast<size_t>(i)] * scale;
+            stage.welchSum.fill(0.0f);
+            stage.welchCount = 0;
+            stage.hasAverage = true;
+        }
+    }
+    return transformed;
+}
+
+void AnalyzerWorker::updatePeaks(int curveIndex, int points, float elapsedSeconds)
+{
+    const auto& values = frame.curves[static_cast<size_t>(curveIndex)];
+    auto& peaks = frame.peaks[static_cast<size_t>(curveIndex)];
+    auto& holdLeft = peakHoldLeft[static_cast<size_t>(curveIndex)];
+    const float fall = kPeakFallDbPerSecond * elapsedSeconds;
+    for (int x = 0; x < points; ++x)
+    {
+        const float value = values[static_cast<size_t>(x)];
+        auto& peak = peaks[static_cast<size_t>(x)];
+        auto& hold = holdLeft[static_cast<size_t>(x)];
+        if (value >= peak)
+        {
+            peak = value;
+            hold = kPeakHoldSeconds;
+        }
+        else if (hold > 0.0f)
+        {
+            hold -= elapsedSeconds;
+        }
+        else
+        {
+            peak = juce::jmax(value, peak - fall);
+        }
+    }
+}
+
+void AnalyzerWorker::rebuildColumnMap(const AnalyzerSettings& settings, const StageLayout& layout, double rate)
+{
+    const int points = juce::jlimit(0, AnalyzerFrame::kMaxPoints, settings.numPoints);
+    const bool decimated = rate < settings.hostSampleRate * 0.99;
+    const double bandEdge = rate * 0.5 * (decimated ? kDecimatedBandEdge : 1.0);
+
+    // Per stage: bin spacing, first usable bin, and the offset that reads a sine at the same level
+    // whatever the transform size (power scales with size^2).
+    std::array<double, kMaxStages> binsPerHz {};
+    std::array<int, kMaxStages> firstBin {};
+    std::array<double, kMaxStages> stageTop {};
+    for (int s = 0; s < layout.numStages; ++s)
+    {
+        const auto su = static_cast<size_t>(s);
+        const int size = 1 << layout.fftOrder[su];
+        const double stageRate = rate / static_cast<double>(1 << s);
+        binsPerHz[su] = size / stageRate;
+        firstBin[su] = juce::jlimit(1, size / 2 - 1, static_cast<int>(std::ceil(settings.minFreq * size / stageRate)));
+        stageTop[su] = s == 0 ? std::numeric_limits<double>::max() : stageRate * kStageEdge;
+        stageLevelOffsetDb[su] = 20.0f * std::log10(static_cast<float>(kMaxFftSize) / static_cast<float>(size));
+    }
+
+    const double smoothingRatio = settings.smoothingOctaves > 0.0f
+        ? std::pow(2.0, 0.5 * settings.smoothingOctaves)
+        : 1.0;
+    const auto columnFreq = [&settings, points](double column)
+    {
+        return static_cast<double>(FFTUtils::normToFreq(static_cast<float>(column / points),
+                                                        settings.minFreq, settings.maxFreq));
+    };
+
+    validColumns = points;
+    for (int x = 0; x < points; ++x)
+    {
+        const double freq = columnFreq(x);
+        if (freq > bandEdge)
+        {
+            validColumns = x;
+            break;
+        }
+
+        // Deepest (finest) stage whose passband still contains this column.
+        int s = layout.numStages - 1;
+        while (s > 0 && freq > stageTop[static_cast<size_t>(s)])
+            --s;
+        const auto su = static_cast<size_t>(s);
+        const int lastBin = (1 << layout.fftOrder[su]) / 2 - 1;
+
+        // Bins whose centres fall inside the column, widened to the smoothing window if that is wider.
+        double loHz = columnFreq(x - 0.5);
+        double hiHz = columnFreq(x + 0.5);
+        if (settings.smoothingOctaves > 0.0f)
+        {
+            loHz = juce::jmin(loHz, freq / smoothingRatio);
+            hiHz = juce::jmax(hiHz, freq * smoothingRatio);
+        }
+
+        auto& column = columnMap[static_cast<size_t>(x)];
+        column.stage = s;
+        column.firstBin = juce::jlimit(firstBin[su], lastBin, static_cast<int>(std::ceil(loHz * binsPerHz[su])));
+        column.lastBin = juce::jlimit(firstBin[su], lastBin, static_cast<int>(std::floor(hiHz * binsPerHz[su])));
+        column.binPos = static_cast<float>(juce::jlimit(static_cast<double>(firstBin[su]), static_cast<double>(lastBin),
+                                                        freq * binsPerHz[su]));
+    }
+
+    mappedSettings = settings;
+    mappedRate = rate;
+}
+
+void AnalyzerWorker::analyse(const AnalyzerSettings& settings, float elapsedSeconds)
+{
+    const double rate = settings.analyzerSampleRate > 0.0 ? settings.analyzerSampleRate : 48000.0;
+    const int points = juce::jlimit(0, AnalyzerFrame::kMaxPoints, settings.numPoints);
+    const auto layout = makeLayout(settings);
+
+    // The column map only changes on resize, rate, range, resolution or smoothing changes.
+    const bool layoutChanged = points != frame.numPoints
+        || settings.minFreq != frame.minFreq || settings.maxFreq != frame.maxFreq;
+    if (layoutChanged || rate != mappedRate
+        || settings.hostSampleRate != mappedSettings.hostSampleRate
+        || settings.multiResolution != mappedSettings.multiResolution
+        || settings.smoothingOctaves != mappedSettings.smoothingOctaves)
+        rebuildColumnMap(settings, layout, rate);
+
+    // Peaks restart whenever the column layout changes or peak hold is switched on.
+    const bool resetPeaks = layoutChanged || ! frame.hasPeaks;
+    frame.numPoints = points;
+    frame.validPoints = validColumns;
+    frame.minFreq = settings.minFreq;
+    frame.maxFreq = settings.maxFreq;
+    frame.hasPeaks = settings.peakHold;
+    const bool smoothing = settings.smoothingOctaves > 0.0f;
+
+    for (int c = 0; c < AnalyzerFrame::kNumCurves; ++c)
+    {
+        auto& state = curveStates[static_cast<size_t>(c)];
+        const bool wanted = settings.wantCurve[static_cast<size_t>(c)];
+        frame.hasCurve[static_cast<size_t>(c)] = wanted;
+        if (! wanted)
+        {
+            // Curves that are off restart from the floor when they come back.
+            if (c == static_cast<int>(AnalyzerCurve::harmonic) && state.channels > 0)
+                configure(state, state.channels, state.layout);
+            continue;
+        }
+
+        const bool transformed = advance(state, *fifos[static_cast<size_t>(c)], settings, rate);
+        if (! transformed && ! layoutChanged && ! settings.peakHold)
+            continue;
+
+        if (smoothing)
+        {
+            for (int s = 0; s < layout.numStages; ++s)
+            {
+                const auto& power = state.stages[static_cast<size_t>(s)].averagePower;
+                auto& prefix = powerPrefix[static_cast<size_t>(s)];
+                prefix[0] = 0.0;
+                for (int i = 0; i < (1 << layout.fftOrder[static_cast<size_t>(s)]) / 2; ++i)
+                    prefix[static_cast<size_t>(i + 1)] = prefix[static_cast<size_t>(i)] + power[static_cast<size_t>(i)];
+            }
+        }
+
+        // One value (and one log) per column: the power average over the smoothing window, the max
+        // over the bins a column spans, or an interpolated read where columns are narrower than bins.
+        auto& values = frame.curves[static_cast<size_t>(c)];
+        for (int x = 0; x < validColumns; ++x)
+        {
+            const auto& column = columnMap[static_cast<size_t>(x)];
+            const auto su = static_cast<size_t>(column.stage);
+            const auto& power = state.stages[su].averagePower;
+            float columnPower = 0.0f;
+            if (column.lastBin > column.firstBin)
+            {
+                if (smoothing)
+                {
+                    const auto& prefix = powerPrefix[su];
+                    columnPower = static_cast<float>((prefix[static_cast<size_t>(column.lastBin + 1)]
+                                                      - prefix[static_cast<size_t>(column.firstBin)])
+                                                     / static_cast<double>(column.lastBin - column.firstBin + 1));
+                }
+                else
+                {
+                    columnPower = *std::max_element(power.begin() + column.firstBin, power.begin() + column.lastBin + 1);
+                }
+            }
+            else
+            {
+                const int lastBin = (1 << layout.fftOrder[su]) / 2 - 1;
+                const int bin = juce::jmin(lastBin - 1, static_cast<int>(column.binPos));
+                const float frac = column.binPos - static_cast<float>(bin);
+                columnPower = power[static_cast<size_t>(bin)]
+                    + frac * (power[static_cast<size_t>(bin + 1)] - power[static_cast<size_t>(bin)]);
+            }
+            values[static_cast<size_t>(x)] = powerToDb(columnPower, stageLevelOffsetDb[su]);
+        }
+
+        if (settings.peakHold)
+        {
+            if (resetPeaks)
+            {
+                frame.peaks[static_cast<size_t>(c)] = values;
+                peakHoldLeft[static_cast<size_t>(c)].fill(kPeakHoldSeconds);
+            }
+            else
+            {
+                updatePeaks(c, validColumns, elapsedSeconds);
+            }
+        }
+    }
+}
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include "../dsp/HalfBandDecimator.h"
+#include "../util/ParamIDs.h"
+#include "../util/RingBuffer.h"
+#include "../util/SeqlockSnapshot.h"
+
+// How successive STFT hops are combined.
+enum class AnalyzerAveraging
+{
+    exponential = 0,
+    welch
+};
+
+// Curves carried by an analyzer frame.
+enum class AnalyzerCurve
+{
+    pre = 0,
+    post,
+    harmonic,
+    external,
+    count
+};
+
+// One ready-to-draw analyzer frame: smoothed magnitudes (dB) at log-spaced display columns.
+struct AnalyzerFrame
+{
+    static constexpr int kMaxPoints = 4096;
+    static constexpr int kNumCurves = static_cast<int>(AnalyzerCurve::count);
+
+    int numPoints = 0;
+    // Columns at or past this index lie above the analyzer band (decimated taps) and are not drawn.
+    int validPoints = 0;
+    float minFreq = 10.0f;
+    float maxFreq = 20000.0f;
+    std::array<bool, kNumCurves> hasCurve {};
+    // Peak-hold traces are valid when hasPeaks is set.
+    bool hasPeaks = false;
+    std::array<std::array<float, kMaxPoints>, kNumCurves> curves {};
+    std::array<std::array<float, kMaxPoints>, kNumCurves> peaks {};
+
+    const std::array<float, kMaxPoints>& curve(AnalyzerCurve c) const { return curves[static_cast<size_t>(c)]; }
+    const std::array<float, kMaxPoints>& peak(AnalyzerCurve c) const { return peaks[static_cast<size_t>(c)]; }
+};
+
+// What the editor wants analysed; written by the message thread, read by the worker.
+struct AnalyzerSettings
+{
+    int numPoints = 0;
+    float minFreq = 10.0f;
+    float maxFreq = 20000.0f;
+    double hostSampleRate = 48000.0;
+    double analyzerSampleRate = 48000.0;
+    int updateHz = 30;
+    bool frozen = false;
+    // STFT hop = fftSize / hopDivisor (2 = 50%, 4 = 75%, 8 = 87.5% overlap).
+    int hopDivisor = 4;
+    AnalyzerAveraging averaging = AnalyzerAveraging::exponential;
+    // Exponential averaging time constant.
+    float averagingMs = 70.0f;
+    // Fractional-octave smoothing width (0 = off, e.g. 1/6 for 1/6 octave).
+    float smoothingOctaves = 0.0f;
+    bool peakHold = false;
+    // Constant-Q style: lows from long transforms of decimated copies, stitched per octave.
+    bool multiResolution = false;
+    std::array<bool, AnalyzerFrame::kNumCurves> wantCurve {};
+};
+
+// Optional second consumer of analysed frames (telemetry export). Called on the worker thread right
+// after each frame, so it must not block. The sink gets a frame every cycle, with its curves added to
+// the view's, even while the view is frozen.
+class AnalyzerFrameSink
+{
+public:
+    virtual ~AnalyzerFrameSink() = default;
+    virtual void analyzerFrameReady(const AnalyzerFrame& frame) = 0;
+    // Worker thread: curves the sink needs whatever the view shows.
+    virtual bool wantsCurve(AnalyzerCurve curve) const = 0;
+};
+
+// Background analysis thread: the only consumer of the analyzer FIFOs. Runs a sliding STFT (one FFT
+// per hop), averages hops, smooths and resamples to display columns so the editor only swaps frames
+// and draws. In multi-resolution mode each halving of the rate feeds another STFT stage.
+class AnalyzerWorker final : private juce::Thread
+{
+public:
+    AnalyzerWorker(AudioFifo& preFifo, AudioFifo& postFifo, AudioFifo& harmonicFifo, AudioFifo& externalFifo);
+    ~AnalyzerWorker() override;
+
+    // Message thread: the thread runs while at least one user (editor analyzer, telemetry export)
+    // holds it.
+    void retain();
+    void release();
+    // Sink for every published frame, or nullptr. Clear it (and release) before the sink goes away.
+    void setFrameSink(AnalyzerFrameSink* sink) { frameSink.store(sink, std::memory_order_release); }
+    // Message thread: publish new settings (wakes the worker).
+    void setSettings(const AnalyzerSettings& settings);
+    // Message thread: copy the latest frame if it is newer than lastVersion.
+    bool fetchFrame(AnalyzerFrame& dest, uint32_t& lastVersion) const;
+
+private:
+    static constexpr int kMaxStages = 4;
+    static constexpr int kMaxFftOrder = 12;
+    static constexpr int kMaxFftSize = 1 << kMaxFftOrder;
+    static constexpr int kMaxBins = kMaxFftSize / 2;
+
+    // Transform size and hop of each STFT stage; stage s runs at the analyzer rate / 2^s.
+    struct StageLayout
+    {
+        int numStages = 1;
+        std::array<int, kMaxStages> fftOrder {};
+        std::array<int, kMaxStages> hopDivisor {};
+
+        bool operator!=(const StageLayout& other) const
+        {
+            return numStages != other.numStages || fftOrder != other.fftOrder || hopDivisor != other.hopDivisor;
+        }
+    };
+
+    // Sliding analysis state for one stage of one curve.
+    struct StageState
+    {
+        // Per frame channel: 2 * fftSize samples; the analysis window is the fftSize before writePos.
+        juce::AudioBuffer<float> history;
+        int writePos = 0;
+        int sinceHop = 0;
+        // Exponential average, or the Welch mean of the last display frame.
+        std::array<float, kMaxBins> averagePower {};
+        std::array<float, kMaxBins> welchSum {};
+        int welchCount = 0;
+        bool hasAverage = false;
+    };
+
+    struct CurveState
+    {
+        int channels = 0;
+        StageLayout layout;
+        std::array<StageState, kMaxStages> stages;
+        // decimators[s][ch] feeds stage s + 1 from stage s.
+        std::array<std::array<eqdsp::HalfBandDecimator, ParamIDs::kMaxChannels>, kMaxStages - 1> decimators;
+    };
+
+    void run() override;
+    void stop();
+    void analyse(const AnalyzerSettings& settings, float elapsedSeconds);
+    static StageLayout makeLayout(const AnalyzerSettings& settings);
+    // Assign FFT bins (and stage) to display columns; rebuilt on resize, rate or mode changes.
+    void rebuildColumnMap(const AnalyzerSettings& settings, const StageLayout& layout, double rate);
+    // (Re)size and clear a curve's stages for a channel count and layout.
+    void configure(CurveState& state, int channels, const StageLayout& layout);
+    // Feed everything waiting in the FIFO through the stages; each completed hop costs one FFT per
+    // frame channel. Returns false if no hop was transformed.
+    bool advance(CurveState& state, AudioFifo& fifo, const AnalyzerSettings& settings, double rate);
+    // Windowed power spectrum of a stage's current window into hopPower.
+    void transformStage(const StageState& stage, int channels, int order);
+    void updatePeaks(int curveIndex, int points, float elapsedSeconds);
+
+    std::array<AudioFifo*, AnalyzerFrame::kNumCurves> fifos {};
+    std::array<CurveState, AnalyzerFrame::kNumCurves> curveStates;
+
+    juce::dsp::FFT fftShort { 10 };
+    juce::dsp::FFT fftLong { kMaxFftOrder };
+    juce::dsp::WindowingFunction<float> windowShort { 1 << 10, juce::dsp::WindowingFunction<float>::hann };
+    juce::dsp::WindowingFunction<float> windowLong { kMaxFftSize, juce::dsp::WindowingFunction<float>::hann };
+    std::array<float, kMaxFftSize * 2> fftData {};
+    std::array<float, kMaxBins> hopPower {};
+    // FIFO chunk scratch, decimated in place stage by stage.
+    juce::AudioBuffer<float> chunkBuffer { ParamIDs::kMaxChannels, kMaxFftSize };
+    // Per-frame scratch: each stage's power prefix sums (fractional-octave smoothing).
+    std::array<std::array<double, kMaxBins + 1>, kMaxStages> powerPrefix {};
+    // Bins feeding one display column.
+    struct ColumnBins
+    {
+        int stage = 0;
+        int firstBin = 1;
+        int lastBin = 1;
+        // Fractional bin at the column centre, read when the column is narrower than a bin.
+        float binPos = 1.0f;
+    };
+    std::array<ColumnBins, AnalyzerFrame::kMaxPoints> columnMap {};
+    int validColumns = 0;
+    std::array<float, kMaxStages> stageLevelOffsetDb {};
+    AnalyzerSettings mappedSettings;
+    double mappedRate = 0.0;
+    // Peak-hold time left per column.
+    std::array<std::array<float, AnalyzerFrame::kMaxPoints>, AnalyzerFrame::kNumCurves> peakHoldLeft {};
+
+    AnalyzerFrame frame;
+    SeqlockSnapshot<AnalyzerSettings> settingsIn;
+    SeqlockSnapshot<AnalyzerFrame> published;
+    std::atomic<AnalyzerFrameSink*> frameSink { nullptr };
+    int users = 0;
+};
@@ -4,13 +4,14 @@
 #include <optional>
 #include <atomic>
 #include "../util/ParamIDs.h"
+#include "FrameScheduler.h"
 #include "Theme.h"
 
 class EQProAudioProcessor;
 
 // Main per-band control panel (knobs, type, slope, channel, reset/copy).
 class BandControlsPanel final : public juce::Component,
-                                private juce::Timer
+                                public FrameScheduler::Client
 {
 public:
     explicit BandControlsPanel(EQProAudioProcessor& processor);
@@ -28,8 +29,9 @@ public:
 
     void paint(juce::Graphics&) override;
     void resized() override;
-    // Periodic UI sync + solo validation.
-    void timerCallback() override;
+    // Scheduler frame: UI sync + solo validation; repaints the detector meter.
+    int getFrameRateHz() const override { return hasBeenResized ? 30 : 0; }
+    juce::Rectangle<int> frameTick() override;
     void mouseDoubleClick(const juce::MouseEvent& event) override;
 
 private:
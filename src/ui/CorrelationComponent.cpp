@@ -1,13 +1,24 @@
 #include "CorrelationComponent.h"
 #include "../PluginProcessor.h"
+#include "../util/SimdSupport.h"
 #include <cmath>
 
 // Goniometer rendering and scope point capture.
 
+namespace
+{
+// Phosphor persistence (1/e time) and the intensity one point adds.
+constexpr double kPersistenceMs = 90.0;
+constexpr float kPointEnergy = 0.18f;
+// Intensities below this are cleared during decay (keeps the buffer free of denormals).
+constexpr float kIntensityFloor = 1.0e-3f;
+constexpr float kBaseGain = 0.75f;
+constexpr float kSoftClip = 1.6f;
+} // namespace
+
 CorrelationComponent::CorrelationComponent(EQProAudioProcessor& processor)
     : processorRef(processor)
 {
-    startTimerHz(30);
     scopeGainSmoothed.reset(30.0, 0.15);
     scopeGainSmoothed.setCurrentAndTargetValue(1.0f);
 }
@@ -35,9 +46,8 @@ void CorrelationComponent::paint(juce::Graphics& g)
     const auto corrBarArea = corrArea.removeFromTop(corrBarHeight);
     const auto corrTickArea = corrArea.removeFromBottom(corrTickHeight);
 
-    auto scopeArea = bounds.reduced(6.0f, 6.0f);
-    const float size = juce::jmin(scopeArea.getWidth(), scopeArea.getHeight());
-    scopeArea = scopeArea.withSizeKeepingCentre(size, size);
+    const auto scopeArea = getScopeArea();
+    const float size = scopeArea.getWidth();
 
     g.setColour(theme.panel.darker(0.1f));
     g.fillRect(scopeArea);
@@ -45,7 +55,6 @@ void CorrelationComponent::paint(juce::Graphics& g)
     g.drawRect(scopeArea, 1.2f);
 
     const auto centre = scopeArea.getCentre();
-    const float radius = size * 0.46f;
     g.setColour(theme.grid.withAlpha(0.5f));
     g.drawLine(centre.x, scopeArea.getY() + 4.0f, centre.x, scopeArea.getBottom() - 4.0f, 1.0f);
     g.drawLine(scopeArea.getX() + 4.0f, centre.y, scopeArea.getRight() - 4.0f, centre.y, 1.0f);
@@ -56,44 +65,8 @@ void CorrelationComponent::paint(juce::Graphics& g)
                scopeArea.getX() + 6.0f, scopeArea.getBottom() - 6.0f, 1.0f);
     g.drawEllipse(scopeArea.reduced(size * 0.07f), 1.0f);
 
-    if (scopePointCount > 1)
-    {
-        double sumSq = 0.0;
-        for (int i = 0; i < scopePointCount; ++i)
-        {
-            const auto& p = scopePoints[static_cast<size_t>(i)];
-            sumSq += static_cast<double>(p.x) * static_cast<double>(p.x);
-            sumSq += static_cast<double>(p.y) * static_cast<double>(p.y);
-        }
-        const double rms = std::sqrt(sumSq / static_cast<double>(scopePointCount * 2));
-        const float targetGain = rms > 1.0e-6
-            ? juce::jlimit(0.35f, 1.6f, static_cast<float>(0.6 / rms))
-            : 1.0f;
-        scopeGainSmoothed.setTargetValue(targetGain);
-        scopeGainSmoothed.skip(scopePointCount);
-        const float autoGain = scopeGainSmoothed.getCurrentValue();
-
-        juce::Path scopePath;
-        constexpr float kBaseGain = 0.75f;
-        constexpr float kSoftClip = 1.6f;
-        const float clipNorm = std::tanh(kSoftClip);
-        for (int i = 0; i < scopePointCount; ++i)
-        {
-            const auto& p = scopePoints[static_cast<size_t>(i)];
-            const float sx = std::tanh(p.x * kBaseGain * autoGain * kSoftClip) / clipNorm;
-            const float sy = std::tanh(p.y * kBaseGain * autoGain * kSoftClip) / clipNorm;
-            const float x = centre.x + sx * radius;
-            const float y = centre.y - sy * radius;
-            if (i == 0)
-                scopePath.startNewSubPath(x, y);
-            else
-                scopePath.lineTo(x, y);
-        }
-        g.setColour(theme.accent.withAlpha(0.35f));
-        g.strokePath(scopePath, juce::PathStrokeType(2.0f));
-        g.setColour(theme.accent.withAlpha(0.8f));
-        g.strokePath(scopePath, juce::PathStrokeType(1.1f));
-    }
+    if (phosphorImage.isValid())
+        g.drawImageAt(phosphorImage, juce::roundToInt(scopeArea.getX()), juce::roundToInt(scopeArea.getY()));
 
     g.setColour(theme.textMuted);
     g.setFont(12.0f);
@@ -143,6 +116,13 @@ void CorrelationComponent::paint(juce::Graphics& g)
 
 void CorrelationComponent::resized()
 {
+    const int size = static_cast<int>(getScopeArea().getWidth());
+    if (size != phosphorSize)
+    {
+        phosphorSize = size;
+        intensity.assign(static_cast<size_t>(juce::jmax(0, size * size)), 0.0f);
+        phosphorImage = {};
+    }
 }
 
 void CorrelationComponent::setTheme(const ThemeColors& newTheme)
@@ -151,12 +131,120 @@ void CorrelationComponent::setTheme(const ThemeColors& newTheme)
     repaint();
 }
 
-void CorrelationComponent::timerCallback()
+juce::Rectangle<int> CorrelationComponent::frameTick()
 {
-    int writePos = 0;
-    scopePointCount = processorRef.getGoniometerPoints(scopePoints.data(),
-                                                       static_cast<int>(scopePoints.size()),
-                                                       writePos);
-    juce::ignoreUnused(writePos);
-    repaint();
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    const double elapsedMs = lastTickMs > 0.0 ? juce::jlimit(0.0, 500.0, nowMs - lastTickMs) : 33.0;
+    lastTickMs = nowMs;
+
+    const int numPoints = processorRef.popGoniometerPoints(pointMid.data(), pointSide.data(), kMaxFramePoints);
+    if (numPoints > 0)
+    {
+        double sumSq = 0.0;
+        for (int i = 0; i < numPoints; ++i)
+        {
+            sumSq += static_cast<double>(pointMid[static_cast<size_t>(i)]) * pointMid[static_cast<size_t>(i)];
+            sumSq += static_cast<double>(pointSide[static_cast<size_t>(i)]) * pointSide[static_cast<size_t>(i)];
+        }
+        const double rms = std::sqrt(sumSq / static_cast<double>(numPoints * 2));
+        const float targetGain = rms > 1.0e-6
+            ? juce::jlimit(0.35f, 1.6f, static_cast<float>(0.6 / rms))
+            : 1.0f;
+        scopeGainSmoothed.setTargetValue(targetGain);
+        scopeGainSmoothed.skip(juce::jmax(1, juce::roundToInt(elapsedMs * 30.0 / 1000.0)));
+    }
+
+    const float decay = static_cast<float>(std::exp(-elapsedMs / kPersistenceMs));
+    accumulatePoints(numPoints, decay, scopeGainSmoothed.getCurrentValue());
+    renderPhosphor();
+    return getLocalBounds();
+}
+
+juce::Rectangle<float> CorrelationComponent::getScopeArea() const
+{
+    auto bounds = getLocalBounds().toFloat().reduced(8.0f, 8.0f);
+    bounds.removeFromTop(18.0f);
+    // Correlation label, bar, ticks and padding (see paint).
+    bounds.removeFromBottom(14.0f + 10.0f + 12.0f + 6.0f);
+    auto scopeArea = bounds.reduced(6.0f, 6.0f);
+    const float size = std::floor(juce::jmax(0.0f, juce::jmin(scopeArea.getWidth(), scopeArea.getHeight())));
+    return scopeArea.withSizeKeepingCentre(size, size);
+}
+
+void CorrelationComponent::accumulatePoints(int numPoints, float decay, float gain)
+{
+    if (phosphorSize <= 1)
+        return;
+
+    // Fade: i = max(0, i * decay - floor), four pixels per step.
+    const int total = phosphorSize * phosphorSize;
+    float* data = intensity.data();
+    const auto decayV = Simd::Float4::broadcast(decay);
+    const auto floorV = Simd::Float4::broadcast(kIntensityFloor);
+    const auto zero = Simd::Float4::zero();
+    int i = 0;
+    for (; i + 3 < total; i += 4)
+        max(Simd::Float4::load(data + i) * decayV - floorV, zero).store(data + i);
+    for (; i < total; ++i)
+        data[i] = juce::jmax(0.0f, data[i] * decay - kIntensityFloor);
+
+    // Splat: soft-clipped mid/side to pixels, energy shared bilinearly over four neighbours.
+    const float half = static_cast<float>(phosphorSize) * 0.5f;
+    const float radius = static_cast<float>(phosphorSize) * 0.46f;
+    const float clipNorm = std::tanh(kSoftClip);
+    const float scale = kBaseGain * gain * kSoftClip;
+    const float maxPos = static_cast<float>(phosphorSize) - 1.001f;
+    for (int p = 0; p < numPoints; ++p)
+    {
+        const float sx = std::tanh(pointMid[static_cast<size_t>(p)] * scale) / clipNorm;
+        const float sy = std::tanh(pointSide[static_cast<size_t>(p)] * scale) / clipNorm;
+        const float px = juce::jlimit(0.0f, maxPos, half + sx * radius - 0.5f);
+        const float py = juce::jlimit(0.0f, maxPos, half - sy * radius - 0.5f);
+        const int x0 = static_cast<int>(px);
+        const int y0 = static_cast<int>(py);
+        const float fx = px - static_cast<float>(x0);
+        const float fy = py - static_cast<float>(y0);
+        float* row = data + y0 * phosphorSize + x0;
+        row[0] += kPointEnergy * (1.0f - fx) * (1.0f - fy);
+        row[1] += kPointEnergy * fx * (1.0f - fy);
+        row[phosphorSize] += kPointEnergy * (1.0f - fx) * fy;
+        row[phosphorSize + 1] += kPointEnergy * fx * fy;
+    }
+}
+
+void CorrelationComponent::renderPhosphor()
+{
+    if (phosphorSize <= 1)
+        return;
+    if (! phosphorImage.isValid() || phosphorImage.getWidth() != phosphorSize)
+        phosphorImage = juce::Image(juce::Image::ARGB, phosphorSize, phosphorSize, true);
+
+    // Tone map: alpha = i / (1 + i) in the accent colour, running to white where points pile up.
+    const auto colour = theme.accent;
+    const float baseR = colour.getFloatRed();
+    const float baseG = colour.getFloatGreen();
+    const float baseB = colour.getFloatBlue();
+    juce::Image::BitmapData pixels(phosphorImage, juce::Image::BitmapData::writeOnly);
+    for (int y = 0; y < phosphorSize; ++y)
+    {
+        const float* src = intensity.data() + y * phosphorSize;
+        auto* dest = reinterpret_cast<juce::PixelARGB*>(pixels.getLinePointer(y));
+        for (int x = 0; x < phosphorSize; ++x)
+        {
+            const float value = src[x];
+            if (value <= 0.0f)
+            {
+                dest[x].setARGB(0, 0, 0, 0);
+                continue;
+            }
+            const float alpha = value / (1.0f + value);
+            const float white = juce::jlimit(0.0f, 1.0f, (value - 1.0f) * 0.25f);
+            // Premultiplied components.
+            const auto channel = [alpha, white](float base)
+            {
+                return static_cast<juce::uint8>(255.0f * alpha * (base + (1.0f - base) * white));
+            };
+            dest[x].setARGB(static_cast<juce::uint8>(255.0f * alpha), channel(baseR), channel(baseG), channel(baseB));
+        }
+    }
 }
@@ -0,0 +1,284 @@
+#include "CurveMath.h"
+#include <algorithm>
+#include <complex>
+#include <cmath>
+#include "../dsp/EQBand.h"
+#include "../dsp/SpectralKernels.h"
+#include "../util/SimdSupport.h"
+
+namespace CurveMath
+{
+void computeBandResponse(const BandShape& band, double sampleRate, const float* frequencies, int count,
+                         float* re, float* im)
+{
+    if (band.bypassed)
+    {
+        std::fill(re, re + count, 1.0f);
+        std::fill(im, im + count, 0.0f);
+        return;
+    }
+
+    const float gainDb = band.gainDb;
+    const float q = std::max(0.1f, band.q);
+    const float freq = band.frequencyHz;
+    const int type = band.type;
+    const float slopeDb = band.slopeDb;
+
+    const double nyquist = sampleRate * 0.5;
+    const double clampedFreq = juce::jlimit(10.0, nyquist * 0.99, static_cast<double>(freq));
+    const double omega = 2.0 * juce::MathConstants<double>::pi * clampedFreq / sampleRate;
+    const double sinW = std::sin(omega);
+    const double cosW = std::cos(omega);
+
+    // Normalised biquad coefficients; computed once per band, evaluated per pixel.
+    struct Section
+    {
+        double b0 = 1.0;
+        double b1 = 0.0;
+        double b2 = 0.0;
+        double a1 = 0.0;
+        double a2 = 0.0;
+    };
+
+    auto makeSection = [&](eqdsp::FilterType filterType,
+                           double gainDbForType,
+                           double qOverride)
+    {
+        const double qLocal = (qOverride > 0.0) ? qOverride : q;
+        const double alphaLocal = sinW / (2.0 * qLocal);
+        const double aLocal = std::pow(10.0, gainDbForType / 40.0);
+        double b0 = 1.0;
+        double b1 = 0.0;
+        double b2 = 0.0;
+        double a0 = 1.0;
+        double a1 = 0.0;
+        double a2 = 0.0;
+
+        switch (filterType)
+        {
+            case eqdsp::FilterType::bell:
+                b0 = 1.0 + alphaLocal * aLocal;
+                b1 = -2.0 * cosW;
+                b2 = 1.0 - alphaLocal * aLocal;
+                a0 = 1.0 + alphaLocal / aLocal;
+                a1 = -2.0 * cosW;
+                a2 = 1.0 - alphaLocal / aLocal;
+                break;
+            case eqdsp::FilterType::lowShelf:
+            {
+                const double beta = std::sqrt(aLocal) / qLocal;
+                b0 = aLocal * ((aLocal + 1.0) - (aLocal - 1.0) * cosW + beta * sinW);
+                b1 = 2.0 * aLocal * ((aLocal - 1.0) - (aLocal + 1.0) * cosW);
+                b2 = aLocal * ((aLocal + 1.0) - (aLocal - 1.0) * cosW - beta * sinW);
+                a0 = (aLocal + 1.0) + (aLocal - 1.0) * cosW + beta * sinW;
+                a1 = -2.0 * ((aLocal - 1.0) + (aLocal + 1.0) * cosW);
+                a2 = (aLocal + 1.0) + (aLocal - 1.0) * cosW - beta * sinW;
+                break;
+            }
+            case eqdsp::FilterType::highShelf:
+            {
+                const double beta = std::sqrt(aLocal) / qLocal;
+                b0 = aLocal * ((aLocal + 1.0) + (aLocal - 1.0) * cosW + beta * sinW);
+                b1 = -2.0 * aLocal * ((aLocal - 1.0) + (aLocal + 1.0) * cosW);
+                b2 = aLocal * ((aLocal + 1.0) + (aLocal - 1.0) * cosW - beta * sinW);
+                a0 = (aLocal + 1.0) - (aLocal - 1.0) * cosW + beta * sinW;
+                a1 = 2.0 * ((aLocal - 1.0) - (aLocal + 1.0) * cosW);
+                a2 = (aLocal + 1.0) - (aLocal - 1.0) * cosW - beta * sinW;
+                break;
+            }
+            case eqdsp::FilterType::lowPass:
+                b0 = (1.0 - cosW) * 0.5;
+                b1 = 1.0 - cosW;
+                b2 = (1.0 - cosW) * 0.5;
+                a0 = 1.0 + alphaLocal;
+                a1 = -2.0 * cosW;
+                a2 = 1.0 - alphaLocal;
+                break;
+            case eqdsp::FilterType::highPass:
+                b0 = (1.0 + cosW) * 0.5;
+                b1 = -(1.0 + cosW);
+                b2 = (1.0 + cosW) * 0.5;
+                a0 = 1.0 + alphaLocal;
+                a1 = -2.0 * cosW;
+                a2 = 1.0 - alphaLocal;
+                break;
+            case eqdsp::FilterType::notch:
+                b0 = 1.0;
+                b1 = -2.0 * cosW;
+                b2 = 1.0;
+                a0 = 1.0 + alphaLocal;
+                a1 = -2.0 * cosW;
+                a2 = 1.0 - alphaLocal;
+                break;
+            case eqdsp::FilterType::bandPass:
+                b0 = alphaLocal;
+                b1 = 0.0;
+                b2 = -alphaLocal;
+                a0 = 1.0 + alphaLocal;
+                a1 = -2.0 * cosW;
+                a2 = 1.0 - alphaLocal;
+                break;
+            case eqdsp::FilterType::allPass:
+                b0 = 1.0 - alphaLocal;
+                b1 = -2.0 * cosW;
+                b2 = 1.0 + alphaLocal;
+                a0 = 1.0 + alphaLocal;
+                a1 = -2.0 * cosW;
+                a2 = 1.0 - alphaLocal;
+                break;
+            case eqdsp::FilterType::tilt:
+            case eqdsp::FilterType::flatTilt:
+                break;
+        }
+
+        const double invA0 = 1.0 / a0;
+        return Section { b0 * invA0, b1 * invA0, b2 * invA0, a1 * invA0, a2 * invA0 };
+    };
+
+    auto evaluate = [](const Section& s, std::complex<double> z, std::complex<double> z2)
+    {
+        const std::complex<double> numerator = s.b0 + s.b1 * z + s.b2 * z2;
+        const std::complex<double> denominator = 1.0 + s.a1 * z + s.a2 * z2;
+        return numerator / denominator;
+    };
+
+    const auto filterType = static_cast<eqdsp::FilterType>(type);
+    const bool isTilt = filterType == eqdsp::FilterType::tilt || filterType == eqdsp::FilterType::flatTilt;
+    const bool isPass = filterType == eqdsp::FilterType::lowPass || filterType == eqdsp::FilterType::highPass;
+
+    Section primary;
+    Section secondary;
+    if (isTilt)
+    {
+        const double qOverride = (filterType == eqdsp::FilterType::flatTilt) ? 0.5 : -1.0;
+        primary = makeSection(eqdsp::FilterType::lowShelf, gainDb * 0.5, qOverride);
+        secondary = makeSection(eqdsp::FilterType::highShelf, -gainDb * 0.5, qOverride);
+    }
+    else
+    {
+        primary = makeSection(filterType, gainDb, -1.0);
+    }
+
+    // HP/LP slopes: cascaded biquads per 12 dB/oct plus a one-pole for the odd 6 dB.
+    int stages = 0;
+    bool useOnePole = false;
+    float resonanceMix = 0.0f;
+    Section resonance;
+    double onePoleA = 0.0;
+    if (isPass)
+    {
+        const float clamped = juce::jlimit(6.0f, 96.0f, slopeDb);
+        stages = static_cast<int>(std::floor(clamped / 12.0f));
+        const float remainder = clamped - static_cast<float>(stages) * 12.0f;
+        useOnePole = (remainder >= 6.0f) || stages == 0;
+        const double cutoff = juce::jlimit(10.0, sampleRate * 0.5 * 0.99, static_cast<double>(freq));
+        onePoleA = std::exp(-2.0 * juce::MathConstants<double>::pi * cutoff / sampleRate);
+        if (stages == 0 && useOnePole)
+        {
+            resonanceMix = juce::jlimit(0.0f, 0.8f, (q - 0.707f) / 6.0f);
+            if (resonanceMix > 0.0f)
+                resonance = makeSection(eqdsp::FilterType::bandPass, 0.0, -1.0);
+        }
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        const double frequency = static_cast<double>(frequencies[i]);
+        const double w = 2.0 * juce::MathConstants<double>::pi
+            * juce::jlimit(10.0, nyquist * 0.99, frequency) / sampleRate;
+        const std::complex<double> z = std::exp(std::complex<double>(0.0, -w));
+        const std::complex<double> z2 = z * z;
+
+        std::complex<double> response = evaluate(primary, z, z2);
+        if (isTilt)
+            response *= evaluate(secondary, z, z2);
+
+        if (isPass)
+        {
+            if (stages > 0)
+            {
+                response = std::pow(response, stages);
+            }
+            else
+            {
+                // 6 dB/oct uses only the one-pole stage (no biquad contribution).
+                response = { 1.0, 0.0 };
+            }
+            if (useOnePole)
+            {
+                const std::complex<double> z1 = std::exp(std::complex<double>(
+                    0.0, -2.0 * juce::MathConstants<double>::pi * frequency / sampleRate));
+                if (filterType == eqdsp::FilterType::lowPass)
+                    response *= (1.0 - onePoleA) / (1.0 - onePoleA * z1);
+                else
+                    response *= ((1.0 + onePoleA) * 0.5) * (1.0 - z1) / (1.0 - onePoleA * z1);
+            }
+            if (resonanceMix > 0.0f)
+                response += evaluate(resonance, z, z2) * static_cast<double>(resonanceMix);
+        }
+
+        re[i] = static_cast<float>(response.real());
+        im[i] = static_cast<float>(response.imag());
+    }
+}
+
+void applyCurveMix(const float* srcRe, const float* srcIm, float* destRe, float* destIm,
+                   float wet, int count) noexcept
+{
+    int i = 0;
+    const auto one = Simd::Float4::broadcast(1.0f);
+    const auto wetV = Simd::Float4::broadcast(wet);
+    for (; i + 3 < count; i += 4)
+    {
+        (one + wetV * (Simd::Float4::load(srcRe + i) - one)).store(destRe + i);
+        (wetV * Simd::Float4::load(srcIm + i)).store(destIm + i);
+    }
+    for (; i < count; ++i)
+    {
+        destRe[i] = 1.0f + wet * (srcRe[i] - 1.0f);
+        destIm[i] = wet * srcIm[i];
+    }
+}
+
+void multiplyCurves(float* accRe, float* accIm, const float* re, const float* im, int count) noexcept
+{
+    int i = 0;
+    for (; i + 3 < count; i += 4)
+    {
+        const auto ar = Simd::Float4::load(accRe + i);
+        const auto ai = Simd::Float4::load(accIm + i);
+        const auto br = Simd::Float4::load(re + i);
+        const auto bi = Simd::Float4::load(im + i);
+        (ar * br - ai * bi).store(accRe + i);
+        (ar * bi + ai * br).store(accIm + i);
+    }
+    for (; i < count; ++i)
+    {
+        const float ar = accRe[i];
+        accRe[i] = ar * re[i] - accIm[i] * im[i];
+        accIm[i] = ar * im[i] + accIm[i] * re[i];
+    }
+}
+
+void responseToDecibels(const float* re, const float* im, float* db, int count, float floorDb) noexcept
+{
+    int i = 0;
+    for (; i + 3 < count; i += 4)
+    {
+        const auto r = Simd::Float4::load(re + i);
+        const auto m = Simd::Float4::load(im + i);
+        (r * r + m * m).store(db + i);
+    }
+    for (; i < count; ++i)
+        db[i] = re[i] * re[i] + im[i] * im[i];
+
+    eqdsp::SpectralKernels::powerToDecibels(db, db, count);
+
+    i = 0;
+    const auto floorV = Simd::Float4::broadcast(floorDb);
+    for (; i + 3 < count; i += 4)
+        max(Simd::Float4::load(db + i), floorV).store(db + i);
+    for (; i < count; ++i)
+        db[i] = std::max(db[i], floorDb);
+}
+} // namespace CurveMath
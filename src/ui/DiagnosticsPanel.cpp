@@ -0,0 +1,146 @@
+#include "DiagnosticsPanel.h"
+#include "../PluginProcessor.h"
+
+namespace
+{
+constexpr int kHeaderHeight = 22;
+constexpr int kRowHeight = 12;
+constexpr int kNameWidth = 86;
+constexpr int kValueWidth = 52;
+
+juce::String formatUs(double us)
+{
+    return us >= 1000.0 ? juce::String(us / 1000.0, 2) + "ms" : juce::String(us, us >= 100.0 ? 0 : 1);
+}
+} // namespace
+
+DiagnosticsPanel::DiagnosticsPanel(EQProAudioProcessor& processor)
+    : processorRef(processor)
+{
+    resetButton.setButtonText("RESET");
+    resetButton.setTooltip("Clear profiler histograms");
+    resetButton.onClick = [this]
+    {
+        processorRef.resetProfiler();
+        statusText.clear();
+    };
+    addAndMakeVisible(resetButton);
+
+    jsonButton.setButtonText("JSON");
+    jsonButton.setTooltip("Write the profiler report to the log folder");
+    jsonButton.onClick = [this]
+    {
+        const auto file = processorRef.dumpProfile();
+        statusText = file == juce::File() ? juce::String("JSON write failed") : file.getFileName();
+        repaint();
+    };
+    addAndMakeVisible(jsonButton);
+}
+
+void DiagnosticsPanel::setTheme(const ThemeColors& newTheme)
+{
+    theme = newTheme;
+    for (auto* button : { &resetButton, &jsonButton })
+    {
+        button->setColour(juce::TextButton::textColourOffId, theme.textMuted);
+        button->setColour(juce::TextButton::buttonColourId, theme.panel);
+    }
+    repaint();
+}
+
+juce::Rectangle<int> DiagnosticsPanel::frameTick()
+{
+    report = processorRef.getProfiler().getReport();
+    governorSteps = processorRef.getGovernor().getAppliedSteps();
+    governorLoad = processorRef.getGovernor().getPredictedLoad();
+    return getLocalBounds();
+}
+
+void DiagnosticsPanel::resized()
+{
+    auto header = getLocalBounds().removeFromTop(kHeaderHeight);
+    jsonButton.setBounds(header.removeFromRight(48).reduced(2));
+    resetButton.setBounds(header.removeFromRight(52).reduced(2));
+}
+
+void DiagnosticsPanel::paint(juce::Graphics& g)
+{
+    auto area = getLocalBounds();
+    auto header = area.removeFromTop(kHeaderHeight).withTrimmedRight(104);
+    g.setFont(juce::FontOptions(11.0f, juce::Font::bold));
+    g.setColour(theme.text);
+    const auto overrunPercent = report.blocks > 0 ? 100.0 * report.overruns / report.blocks : 0.0;
+    g.drawText("PROFILER  blocks " + juce::String(static_cast<juce::int64>(report.blocks)) + "  overruns "
+                   + juce::String(static_cast<juce::int64>(report.overruns)) + " ("
+                   + juce::String(overrunPercent, 2) + "%)  budget " + formatUs(report.budgetUs) + "us"
+                   + (statusText.isNotEmpty() ? "  " + statusText : juce::String()),
+               header, juce::Justification::centredLeft, true);
+
+    g.setFont(juce::FontOptions(10.0f));
+    juce::StringArray shed;
+    for (int step = 0; step < eqdsp::CpuGovernor::numSteps; ++step)
+        if ((governorSteps & (1u << step)) != 0)
+            shed.add(eqdsp::CpuGovernor::getStepName(step));
+    g.setColour(shed.isEmpty() ? theme.textMuted : theme.meterPeak);
+    g.drawText("governor: predicted load " + juce::String(100.0f * governorLoad, 1) + "%  shedding: "
+                   + (shed.isEmpty() ? juce::String("none") : shed.joinIntoString(", ")),
+               area.removeFromTop(kRowHeight), juce::Justification::centredLeft, true);
+
+    auto columns = area.removeFromTop(kRowHeight);
+    g.setColour(theme.textMuted);
+    auto drawRow = [&g](juce::Rectangle<int> row, const juce::StringArray& cells)
+    {
+        g.drawText(cells[0], row.removeFromLeft(kNameWidth), juce::Justification::centredLeft, true);
+        for (int i = 1; i < cells.size(); ++i)
+            g.drawText(cells[i], row.removeFromLeft(kValueWidth), juce::Justification::centredRight, true);
+    };
+    drawRow(columns, { "stage (us)", "mean", "p50", "p99", "max", "% budget", "blame" });
+
+    const double budget = juce::jmax(1.0e-9, report.budgetUs);
+    for (int s = 0; s < StageProfiler::numStages && area.getHeight() >= kRowHeight; ++s)
+    {
+        const auto& stats = report.stages[static_cast<size_t>(s)];
+        if (stats.count == 0)
+            continue;
+        auto row = area.removeFromTop(kRowHeight);
+        const bool blamed = stats.overrunBlame > 0;
+        g.setColour(blamed ? theme.meterPeak : (s == StageProfiler::total ? theme.text : theme.textMuted));
+        drawRow(row, { StageProfiler::getStageName(s), formatUs(stats.meanUs), formatUs(stats.p50Us),
+                       formatUs(stats.p99Us), formatUs(stats.maxUs),
+                       juce::String(100.0 * stats.p99Us / budget, 1),
+                       juce::String(static_cast<juce::int64>(stats.overrunBlame)) });
+
+        // Histogram sparkline over the occupied bin range.
+        auto spark = row.withTrimmedLeft(kNameWidth + 6 * kValueWidth + 8).reduced(0, 1);
+        if (spark.getWidth() < 16)
+            continue;
+        int first = StageProfiler::kNumBins;
+        int last = -1;
+        uint32_t peak = 0;
+        for (int b = 0; b < StageProfiler::kNumBins; ++b)
+        {
+            const auto count = stats.bins[static_cast<size_t>(b)];
+            if (count == 0)
+                continue;
+            first = juce::jmin(first, b);
+            last = b;
+            peak = juce::jmax(peak, count);
+        }
+        if (last < first || peak == 0)
+            continue;
+        const int span = last - first + 1;
+        const float barWidth = static_cast<float>(spark.getWidth()) / static_cast<float>(span);
+        g.setColour(theme.accent.withAlpha(0.8f));
+        for (int b = first; b <= last; ++b)
+        {
+            const auto count = stats.bins[static_cast<size_t>(b)];
+            if (count == 0)
+                continue;
+            // Square-root scale keeps rare slow blocks visible next to the common case.
+            const float h = std::sqrt(static_cast<float>(count) / static_cast<float>(peak))
+                * static_cast<float>(spark.getHeight());
+            g.fillRect(spark.getX() + barWidth * static_cast<float>(b - first), spark.getBottom() - h,
+                       juce::jmax(1.0f, barWidth - 1.0f), h);
+        }
+    }
+}
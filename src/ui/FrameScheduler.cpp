@@ -0,0 +1,98 @@
+#include "FrameScheduler.h"
+
+// Single-clock UI refresh: vblank-driven ticks with a timer fallback and hidden-window throttling.
+
+FrameScheduler::FrameScheduler(juce::Component& hostComponent)
+    : host(hostComponent)
+{
+}
+
+FrameScheduler::~FrameScheduler()
+{
+    stop();
+}
+
+void FrameScheduler::addClient(Client& client, juce::Component* repaintTarget)
+{
+    // Fixed-size after construction; clients are registered once by the editor.
+    entries.push_back({ &client, repaintTarget, 0.0, {} });
+}
+
+void FrameScheduler::start()
+{
+    if (running)
+        return;
+    running = true;
+    lastVBlankMs = 0.0;
+    vblank = std::make_unique<juce::VBlankAttachment>(&host, [this] { onVBlank(); });
+    startTimerHz(kIdleTimerHz);
+}
+
+void FrameScheduler::stop()
+{
+    running = false;
+    stopTimer();
+    vblank.reset();
+}
+
+void FrameScheduler::onVBlank()
+{
+    lastVBlankMs = juce::Time::getMillisecondCounterHiRes();
+    // Display refresh is back; the timer only needs to watch for stalls again.
+    if (getTimerInterval() != 1000 / kIdleTimerHz)
+        startTimerHz(kIdleTimerHz);
+    tick(lastVBlankMs);
+}
+
+void FrameScheduler::timerCallback()
+{
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    if (nowMs - lastVBlankMs < kVBlankStallMs)
+        return;
+
+    // No vblank: drive frames from the timer, at full rate only if someone can see them.
+    const int wantedHz = isHostVisible() ? kFallbackTimerHz : kIdleTimerHz;
+    if (getTimerInterval() != 1000 / wantedHz)
+        startTimerHz(wantedHz);
+    tick(nowMs);
+}
+
+bool FrameScheduler::isHostVisible() const
+{
+    if (! host.isShowing())
+        return false;
+    if (auto* peer = host.getPeer())
+        return ! peer->isMinimised();
+    return false;
+}
+
+void FrameScheduler::tick(double nowMs)
+{
+    if (! running)
+        return;
+
+    const bool visible = isHostVisible();
+    for (auto& entry : entries)
+    {
+        int rateHz = entry.client->getFrameRateHz();
+        if (rateHz <= 0)
+            continue;
+        if (! visible && entry.client->isVisualClient())
+            rateHz = juce::jmin(rateHz, kHiddenRateHz);
+
+        if (nowMs + kDueToleranceMs < entry.nextDueMs)
+            continue;
+        // Keep the long-run rate on a quantised clock, but never bank a backlog after a stall.
+        const double intervalMs = 1000.0 / static_cast<double>(rateHz);
+        entry.nextDueMs = juce::jmax(entry.nextDueMs + intervalMs, nowMs + intervalMs * 0.5);
+        entry.dirty = entry.client->frameTick();
+    }
+
+    // Flush after every client has ticked so the peer merges this frame into one paint pass.
+    for (auto& entry : entries)
+    {
+        if (! entry.dirty.isEmpty() && entry.target != nullptr)
+            entry.target->repaint(entry.dirty);
+        entry.dirty = {};
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+// One display-synced clock per editor. Clients tick on the message thread in registration order and
+// report what they need repainted; a frame's repaints are issued together so the peer paints once.
+class FrameScheduler final : private juce::Timer
+{
+public:
+    class Client
+    {
+    public:
+        virtual ~Client() = default;
+        // Desired tick rate (0 = paused); read every frame so clients can retune themselves.
+        virtual int getFrameRateHz() const = 0;
+        // Advance one frame; returns the client-local area to repaint (empty when nothing changed).
+        virtual juce::Rectangle<int> frameTick() = 0;
+        // Housekeeping clients keep their rate while the window is hidden; visual ones are throttled.
+        virtual bool isVisualClient() const { return true; }
+    };
+
+    explicit FrameScheduler(juce::Component& host);
+    ~FrameScheduler() override;
+
+    // repaintTarget receives the area returned by the client's frameTick (may be nullptr).
+    void addClient(Client& client, juce::Component* repaintTarget);
+    void start();
+    void stop();
+
+private:
+    // Visual clients run at most at this rate while the editor is hidden, minimised or occluded.
+    static constexpr int kHiddenRateHz = 2;
+    // Fallback clock while vblank callbacks are not arriving (no peer, occluded, unsupported).
+    static constexpr int kIdleTimerHz = 4;
+    static constexpr int kFallbackTimerHz = 60;
+    static constexpr double kVBlankStallMs = 250.0;
+    // A tick this close to its due time runs now rather than a whole refresh later.
+    static constexpr double kDueToleranceMs = 2.0;
+
+    struct Entry
+    {
+        Client* client = nullptr;
+        juce::Component::SafePointer<juce::Component> target;
+        double nextDueMs = 0.0;
+        juce::Rectangle<int> dirty;
+    };
+
+    void timerCallback() override;
+    void onVBlank();
+    void tick(double nowMs);
+    bool isHostVisible() const;
+
+    juce::Component& host;
+    std::vector<Entry> entries;
+    std::unique_ptr<juce::VBlankAttachment> vblank;
+    double lastVBlankMs = 0.0;
+    bool running = false;
+};
@@ -8,6 +8,12 @@ namespace
 // v4.4 beta: Digital domain - 0 dBFS is maximum (not +6 dB)
 constexpr float kMinDb = -60.0f;
 constexpr float kMaxDb = 0.0f;
+constexpr float kLoudnessRowHeight = 14.0f;
+
+juce::String formatLufs(float lufs)
+{
+    return lufs <= -70.0f ? juce::String("--") : juce::String(lufs, 1);
+}
 
 juce::String formatDolbyLabel(const juce::String& label)
 {
@@ -50,7 +56,6 @@ juce::String formatDolbyLabel(const juce::String& label)
 MetersComponent::MetersComponent(EQProAudioProcessor& processor)
     : processorRef(processor)
 {
-    startTimerHz(30);
 }
 
 void MetersComponent::setSelectedChannel(int channelIndex)
@@ -89,6 +94,13 @@ void MetersComponent::paint(juce::Graphics& g)
     g.drawRoundedRectangle(bounds.reduced(2.5f), 6.0f, 1.0f);
 
     auto meterArea = bounds.reduced(8.0f, 12.0f);
+    const auto loudnessRow = meterArea.removeFromBottom(kLoudnessRowHeight);
+    meterArea.removeFromBottom(4.0f);
+    g.setColour(theme.textMuted);
+    g.setFont(juce::Font(9.5f, juce::Font::plain));
+    g.drawFittedText("M " + formatLufs(momentaryLufs) + "  S " + formatLufs(shortTermLufs)
+                         + "  I " + formatLufs(integratedLufs) + " LUFS",
+                     loudnessRow.toNearestInt(), juce::Justification::centred, 1);
     // v4.4 beta: Removed peakArea box at bottom - peak values now shown at top of bars
     
     // v4.4 beta: Add dB value labels on the left side of the meter scale
@@ -265,9 +277,16 @@ void MetersComponent::paint(juce::Graphics& g)
 
 void MetersComponent::resized()
 {
+    loudnessArea = getLocalBounds().reduced(8, 12).removeFromBottom(static_cast<int>(kLoudnessRowHeight));
 }
 
-void MetersComponent::timerCallback()
+void MetersComponent::mouseDown(const juce::MouseEvent& event)
+{
+    if (loudnessArea.contains(event.getPosition()))
+        processorRef.resetLoudness();
+}
+
+juce::Rectangle<int> MetersComponent::frameTick()
 {
     const int totalChannels = juce::jmax(1, processorRef.getTotalNumInputChannels());
     if (static_cast<int>(rmsDb.size()) != totalChannels)
@@ -277,11 +296,19 @@ void MetersComponent::timerCallback()
         peakHoldDb.assign(static_cast<size_t>(totalChannels), kMinDb);
     }
 
+    // One snapshot per tick keeps all channels and loudness values from the same audio block.
+    eqdsp::MeterSnapshot snapshot;
+    if (! processorRef.getMeterSnapshot(snapshot))
+        return {};
+    momentaryLufs = snapshot.momentaryLufs;
+    shortTermLufs = snapshot.shortTermLufs;
+    integratedLufs = snapshot.integratedLufs;
+
     for (int ch = 0; ch < totalChannels; ++ch)
     {
-        const auto state = processorRef.getMeterState(ch);
+        const auto& state = snapshot.channels[static_cast<size_t>(juce::jmin(ch, ParamIDs::kMaxChannels - 1))];
         rmsDb[static_cast<size_t>(ch)] = state.rmsDb;
-        peakDb[static_cast<size_t>(ch)] = state.peakDb;
+        peakDb[static_cast<size_t>(ch)] = state.truePeakDb;
         const float currentPeak = peakDb[static_cast<size_t>(ch)];
         float& hold = peakHoldDb[static_cast<size_t>(ch)];
         if (currentPeak >= hold || hold <= kMinDb + 0.1f)
@@ -290,7 +317,7 @@ void MetersComponent::timerCallback()
             hold = juce::jmax(currentPeak, hold - 0.7f);
     }
 
-    repaint();
+    return getLocalBounds();
 }
 
 float MetersComponent::dbToY(float db) const
@@ -39,6 +39,13 @@ SpectralDynamicsPanel::SpectralDynamicsPanel(juce::AudioProcessorValueTreeState&
     attackAttachment = setupSlider(attackSlider, ParamIDs::spectralAttack);
     releaseAttachment = setupSlider(releaseSlider, ParamIDs::spectralRelease);
     mixAttachment = setupSlider(mixSlider, ParamIDs::spectralMix);
+
+    linkBox.addItemList(juce::StringArray("Link Off", "Link Sum", "Link Max"), 1);
+    addAndMakeVisible(linkBox);
+    linkAttachment = std::make_unique<ComboBoxAttachment>(parameters, ParamIDs::spectralLink, linkBox);
+    bandsBox.addItemList(juce::StringArray("Bins", "ERB", "Bark"), 1);
+    addAndMakeVisible(bandsBox);
+    bandsAttachment = std::make_unique<ComboBoxAttachment>(parameters, ParamIDs::spectralBands, bandsBox);
 }
 
 void SpectralDynamicsPanel::setTheme(const ThemeColors& newTheme)
@@ -62,6 +69,10 @@ void SpectralDynamicsPanel::resized()
     auto bounds = getLocalBounds().reduced(10);
     auto header = bounds.removeFromTop(20);
     titleLabel.setBounds(header.removeFromLeft(150));
+    bandsBox.setBounds(header.removeFromRight(80));
+    header.removeFromRight(4);
+    linkBox.setBounds(header.removeFromRight(90));
+    header.removeFromRight(4);
     enableButton.setBounds(header);
 
     bounds.removeFromTop(6);
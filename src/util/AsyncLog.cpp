@@ -0,0 +1,424 @@
+#include "AsyncLog.h"
+#include <array>
+#include <atomic>
+#include <cstring>
+
+namespace
+{
+constexpr int kTextBytes = 88;
+constexpr int kFlushIntervalMs = 100;
+// Token bucket per event: burst, then this many lines per second.
+constexpr double kRateBurst = 100.0;
+constexpr double kRatePerSecond = 20.0;
+
+static_assert((AsyncLog::kQueueSize & (AsyncLog::kQueueSize - 1)) == 0, "queue size must be a power of two");
+
+// One 128-byte cell. The first record of a message carries the header; continuation records only
+// carry text. sequence follows the bounded MPMC scheme (Vyukov): == position when free, position + 1
+// once published.
+struct alignas(64) Record
+{
+    std::atomic<uint32_t> sequence { 0 };
+    uint16_t event = 0;
+    uint8_t numArgs = 0;
+    // Records in this message (1 + continuations); 0 on continuation records.
+    uint8_t numRecords = 0;
+    double timeMs = 0.0;
+    float args[AsyncLog::kMaxArgs] {};
+    char text[kTextBytes] {};
+};
+static_assert(sizeof(Record) == 128, "log record should stay one pair of cache lines");
+
+const char* eventName(AsyncLog::Event event)
+{
+    switch (event)
+    {
+        case AsyncLog::Event::text: return "text";
+        case AsyncLog::Event::rmsDelta: return "RMS delta";
+        case AsyncLog::Event::adaptiveQuality: return "adaptive quality";
+        case AsyncLog::Event::firSchedule: return "FIR schedule";
+        case AsyncLog::Event::firRebuild: return "FIR rebuild";
+        case AsyncLog::Event::impulseFallback: return "impulse fallback";
+        case AsyncLog::Event::dryDelay: return "dry delay";
+        case AsyncLog::Event::bandVerify: return "band verify";
+        case AsyncLog::Event::governor: return "CPU governor";
+        case AsyncLog::Event::numEvents: break;
+    }
+    return "unknown";
+}
+
+juce::String formatEvent(AsyncLog::Event event, const float* args, const juce::String& text)
+{
+    const auto i = [args](int index) { return juce::String(juce::roundToInt(args[index])); };
+    switch (event)
+    {
+        case AsyncLog::Event::rmsDelta:
+            return "RMS delta: mode=" + i(0) + " quality=" + i(1) + " pre=" + juce::String(args[2], 2)
+                + " dB post=" + juce::String(args[3], 2) + " dB delta=" + juce::String(args[3] - args[2], 2)
+                + " dB";
+        case AsyncLog::Event::adaptiveQuality:
+            return "Adaptive quality offset: " + i(0);
+        case AsyncLog::Event::firSchedule:
+            return "LinearPhase: scheduling FIR rebuild (mode=" + i(0) + ", quality=" + i(1) + ", window="
+                + i(2) + ")";
+        case AsyncLog::Event::firRebuild:
+            return "LinearPhase rebuild: mode=" + i(0) + " quality=" + i(1) + " offset=" + i(2) + " taps="
+                + i(3) + " window=" + i(4);
+        case AsyncLog::Event::impulseFallback:
+            return "LinearPhase: impulse fallback -> delta (" + text + ")";
+        case AsyncLog::Event::dryDelay:
+            return "GlobalMix dry-delay: latency=" + i(0) + " samples, maxBlock=" + i(1) + ", channels=" + i(2);
+        case AsyncLog::Event::governor:
+            return "CPU governor: " + juce::String(args[0] > 0.5f ? "shed " : "restore ") + text
+                + " (predicted load " + juce::String(args[1] * 100.0f, 1) + "%, steps=0x"
+                + juce::String::toHexString(juce::roundToInt(args[2])) + ")";
+        case AsyncLog::Event::text:
+        case AsyncLog::Event::bandVerify:
+        case AsyncLog::Event::numEvents:
+            break;
+    }
+    return text;
+}
+
+// Routes juce::Logger::writeToLog() into the queue.
+class QueueLogger final : public juce::Logger
+{
+public:
+    void logMessage(const juce::String& message) override
+    {
+        AsyncLog::post(AsyncLog::Event::text, message);
+    }
+};
+
+class Pipeline final : private juce::Thread
+{
+public:
+    Pipeline() : juce::Thread("EQPro Log")
+    {
+        for (uint32_t i = 0; i < static_cast<uint32_t>(AsyncLog::kQueueSize); ++i)
+            records[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    void start(const juce::File& target)
+    {
+        const juce::ScopedLock lock(controlLock);
+        if (users++ > 0)
+            return;
+        file = target;
+        stream = std::make_unique<juce::FileOutputStream>(file);
+        if (stream->failedToOpen())
+            stream.reset();
+        else
+            stream->writeText("EQ Pro log\n" + juce::Time::getCurrentTime().toString(true, true) + "\n\n",
+                              false, false, "\n");
+        dropped.store(0);
+        reportedDropped = 0;
+        buckets.fill({ kRateBurst, 0.0, 0 });
+        running.store(true);
+        juce::Logger::setCurrentLogger(&logger);
+        startThread(juce::Thread::Priority::background);
+    }
+
+    void stop()
+    {
+        const juce::ScopedLock lock(controlLock);
+        if (users == 0 || --users > 0)
+            return;
+        if (juce::Logger::getCurrentLogger() == &logger)
+            juce::Logger::setCurrentLogger(nullptr);
+        signalThreadShouldExit();
+        notify();
+        stopThread(2000);
+        running.store(false);
+        drain();
+        stream.reset();
+        file = juce::File();
+        for (auto& mirror : mirrors)
+            mirror = juce::File();
+    }
+
+    bool isRunning() const { return running.load(std::memory_order_relaxed); }
+
+    juce::File getFile() const
+    {
+        const juce::ScopedLock lock(controlLock);
+        return file;
+    }
+
+    void setMirrorFile(AsyncLog::Event event, const juce::File& mirror)
+    {
+        const juce::ScopedLock lock(controlLock);
+        mirrors[static_cast<size_t>(event)] = mirror;
+    }
+
+    bool push(AsyncLog::Event event, const char* text, size_t textLength, const float* args, size_t numArgs) noexcept
+    {
+        if (! isRunning())
+            return false;
+
+        const auto numRecords = static_cast<uint32_t>(juce::jlimit<size_t>(
+            1, AsyncLog::kMaxRecordsPerMessage, (textLength + kTextBytes - 1) / kTextBytes));
+        textLength = juce::jmin(textLength, static_cast<size_t>(numRecords) * kTextBytes);
+
+        // Claim numRecords consecutive cells. The consumer frees cells in order, so the last one
+        // being free means all of them are.
+        uint32_t position = enqueuePosition.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            const auto& last = records[(position + numRecords - 1) & kMask];
+            const auto sequence = last.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<int32_t>(sequence - (position + numRecords - 1));
+            if (diff == 0)
+            {
+                if (enqueuePosition.compare_exchange_weak(position, position + numRecords,
+                                                          std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                dropped.fetch_add(numRecords, std::memory_order_relaxed);
+                return false;
+            }
+            else
+            {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        const double timeMs = juce::Time::getMillisecondCounterHiRes();
+        for (uint32_t r = 0; r < numRecords; ++r)
+        {
+            auto& record = records[(position + r) & kMask];
+            record.event = static_cast<uint16_t>(event);
+            record.numRecords = r == 0 ? static_cast<uint8_t>(numRecords) : 0;
+            record.numArgs = r == 0 ? static_cast<uint8_t>(numArgs) : 0;
+            record.timeMs = timeMs;
+            if (r == 0 && numArgs > 0)
+                std::memcpy(record.args, args, numArgs * sizeof(float));
+            const size_t offset = static_cast<size_t>(r) * kTextBytes;
+            const size_t chunk = offset < textLength ? juce::jmin<size_t>(kTextBytes, textLength - offset) : 0;
+            if (chunk > 0)
+                std::memcpy(record.text, text + offset, chunk);
+            if (chunk < kTextBytes)
+                record.text[chunk] = 0;
+        }
+        // Publish in order so the consumer never sees a message with unpublished continuations.
+        for (uint32_t r = 0; r < numRecords; ++r)
+            records[(position + r) & kMask].sequence.store(position + r + 1, std::memory_order_release);
+        return true;
+    }
+
+    uint64_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    void writeNow(const juce::String& text)
+    {
+        // Crash path: do not wait on a writer that may be the crashing thread.
+        const juce::ScopedTryLock lock(writeLock);
+        if (lock.isLocked())
+            drainLocked();
+        if (stream != nullptr)
+        {
+            stream->writeText(text + "\n", false, false, "\n");
+            stream->flush();
+        }
+    }
+
+private:
+    static constexpr uint32_t kMask = static_cast<uint32_t>(AsyncLog::kQueueSize - 1);
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            drain();
+            wait(kFlushIntervalMs);
+        }
+    }
+
+    void drain()
+    {
+        const juce::ScopedLock lock(writeLock);
+        drainLocked();
+    }
+
+    void drainLocked()
+    {
+        juce::MemoryOutputStream out;
+        std::array<juce::MemoryOutputStream, static_cast<size_t>(AsyncLog::Event::numEvents)> mirrorOut;
+
+        const auto totalDropped = dropped.load(std::memory_order_relaxed);
+        if (totalDropped != reportedDropped)
+        {
+            out << "Log queue full: " << juce::String(static_cast<juce::int64>(totalDropped - reportedDropped))
+                << " records dropped\n";
+            reportedDropped = totalDropped;
+        }
+
+        for (;;)
+        {
+            auto& head = records[dequeuePosition & kMask];
+            if (head.sequence.load(std::memory_order_acquire) != dequeuePosition + 1)
+                break;
+            const uint32_t numRecords = juce::jmax<uint32_t>(1, head.numRecords);
+            // Continuations are published after the header; wait for the next pass if one is late.
+            const auto& tail = records[(dequeuePosition + numRecords - 1) & kMask];
+            if (tail.sequence.load(std::memory_order_acquire) != dequeuePosition + numRecords)
+                break;
+
+            const auto event = static_cast<AsyncLog::Event>(head.event);
+            float args[AsyncLog::kMaxArgs] {};
+            std::memcpy(args, head.args, sizeof(args));
+            const double timeMs = head.timeMs;
+            std::string text;
+            for (uint32_t r = 0; r < numRecords; ++r)
+            {
+                auto& record = records[(dequeuePosition + r) & kMask];
+                text.append(record.text, ::strnlen(record.text, kTextBytes));
+                record.sequence.store(dequeuePosition + r + AsyncLog::kQueueSize, std::memory_order_release);
+            }
+            dequeuePosition += numRecords;
+
+            const auto eventIndex = static_cast<size_t>(event);
+            if (eventIndex >= buckets.size())
+                continue;
+            if (! admit(eventIndex, timeMs))
+                continue;
+
+            juce::String line = formatTime(timeMs) + " ";
+            auto& bucket = buckets[eventIndex];
+            if (bucket.suppressed > 0)
+            {
+                line << "(" << juce::String(bucket.suppressed) << " " << eventName(event)
+                     << " messages suppressed) ";
+                bucket.suppressed = 0;
+            }
+            const auto message = formatEvent(event, args, juce::String::fromUTF8(text.data(),
+                                                                               static_cast<int>(text.size())));
+            line << message << "\n";
+            out << line;
+            if (mirrors[eventIndex] != juce::File())
+                mirrorOut[eventIndex] << message << "\n";
+        }
+
+        if (stream != nullptr && out.getDataSize() > 0)
+        {
+            stream->write(out.getData(), out.getDataSize());
+            stream->flush();
+        }
+        for (size_t e = 0; e < mirrorOut.size(); ++e)
+            if (mirrorOut[e].getDataSize() > 0)
+                mirrors[e].appendData(mirrorOut[e].getData(), mirrorOut[e].getDataSize());
+    }
+
+    bool admit(size_t eventIndex, double timeMs)
+    {
+        // Verification output is requested explicitly and must stay complete.
+        if (eventIndex == static_cast<size_t>(AsyncLog::Event::bandVerify))
+            return true;
+        auto& bucket = buckets[eventIndex];
+        if (bucket.lastMs > 0.0)
+            bucket.tokens = juce::jmin(kRateBurst, bucket.tokens + (timeMs - bucket.lastMs) * 0.001 * kRatePerSecond);
+        bucket.lastMs = juce::jmax(bucket.lastMs, timeMs);
+        if (bucket.tokens < 1.0)
+        {
+            ++bucket.suppressed;
+            return false;
+        }
+        bucket.tokens -= 1.0;
+        return true;
+    }
+
+    juce::String formatTime(double timeMs) const
+    {
+        // Map the monotonic record time onto wall-clock time.
+        const auto age = static_cast<juce::int64>(juce::Time::getMillisecondCounterHiRes() - timeMs);
+        const auto wallMs = juce::Time::currentTimeMillis() - age;
+        return juce::Time(wallMs).formatted("%H:%M:%S") + juce::String::formatted(".%03d", static_cast<int>(wallMs % 1000));
+    }
+
+    struct Bucket
+    {
+        double tokens;
+        double lastMs;
+        int suppressed;
+    };
+
+    std::array<Record, AsyncLog::kQueueSize> records;
+    alignas(64) std::atomic<uint32_t> enqueuePosition { 0 };
+    alignas(64) uint32_t dequeuePosition = 0;
+    std::atomic<uint64_t> dropped { 0 };
+    uint64_t reportedDropped = 0;
+    std::atomic<bool> running { false };
+
+    juce::CriticalSection controlLock;
+    juce::CriticalSection writeLock;
+    int users = 0;
+    juce::File file;
+    std::unique_ptr<juce::FileOutputStream> stream;
+    std::array<juce::File, static_cast<size_t>(AsyncLog::Event::numEvents)> mirrors;
+    std::array<Bucket, static_cast<size_t>(AsyncLog::Event::numEvents)> buckets {};
+    QueueLogger logger;
+};
+
+Pipeline& getPipeline()
+{
+    // Never destroyed: producers on other threads may still post during static destruction.
+    static auto* pipeline = new Pipeline();
+    return *pipeline;
+}
+} // namespace
+
+namespace AsyncLog
+{
+void start(const juce::File& file)
+{
+    getPipeline().start(file);
+}
+
+void stop()
+{
+    getPipeline().stop();
+}
+
+bool isRunning()
+{
+    return getPipeline().isRunning();
+}
+
+juce::File getFile()
+{
+    return getPipeline().getFile();
+}
+
+void setMirrorFile(Event event, const juce::File& file)
+{
+    getPipeline().setMirrorFile(event, file);
+}
+
+bool post(Event event, std::initializer_list<float> args) noexcept
+{
+    return post(event, nullptr, args);
+}
+
+bool post(Event event, const char* text, std::initializer_list<float> args) noexcept
+{
+    const auto numArgs = juce::jmin(args.size(), static_cast<size_t>(kMaxArgs));
+    return getPipeline().push(event, text, text != nullptr ? std::strlen(text) : 0, args.begin(), numArgs);
+}
+
+bool post(Event event, const juce::String& text) noexcept
+{
+    const auto* utf8 = text.toRawUTF8();
+    return getPipeline().push(event, utf8, text.getNumBytesAsUTF8(), nullptr, 0);
+}
+
+void writeNow(const juce::String& text)
+{
+    getPipeline().writeNow(text);
+}
+
+uint64_t getDroppedCount()
+{
+    return getPipeline().getDroppedCount();
+}
+} // namespace AsyncLog
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <cstdint>
+#include <initializer_list>
+
+// Process-wide asynchronous log. Producers push fixed-size binary records (event id, a few numeric
+// arguments, optional text) into a bounded lock-free MPSC queue; nothing is formatted or written on
+// the calling thread. A background writer drains the queue, formats each event, rate-limits noisy
+// events and appends to the log file in batches, so a slow disk only delays the writer. When the
+// queue is full, records are dropped and counted rather than blocking the producer.
+//
+// juce::Logger::writeToLog() is routed into the queue while the log is running, so existing calls
+// (EqEngine, panels) become non-blocking as well.
+namespace AsyncLog
+{
+enum class Event : uint16_t
+{
+    text = 0,
+    rmsDelta,        // mode, quality, pre dB, post dB
+    adaptiveQuality, // offset
+    firSchedule,     // mode, quality, window
+    firRebuild,      // mode, quality, offset, taps, window
+    impulseFallback, // text: tag
+    dryDelay,        // latency, max block, channels
+    bandVerify,      // text
+    governor,        // text: step; shed (1) / restore (0), predicted load, applied step mask
+    numEvents
+};
+
+constexpr int kQueueSize = 4096;
+constexpr int kMaxArgs = 6;
+// Text longer than one record spans up to kMaxRecordsPerMessage consecutive records.
+constexpr int kMaxRecordsPerMessage = 16;
+
+// Reference counted: the first start opens file (appending) and starts the writer thread, the last
+// stop drains the queue and closes it. Message thread / module load.
+void start(const juce::File& file);
+void stop();
+bool isRunning();
+juce::File getFile();
+
+// Also append events of this type to a second file (e.g. a debug verification log).
+void setMirrorFile(Event event, const juce::File& file);
+
+// Realtime safe: no allocation, no locks, no formatting. Returns false if dropped.
+bool post(Event event, std::initializer_list<float> args) noexcept;
+// Copies the UTF-8 text (truncated to the multi-record limit). Does not allocate; safe on any thread
+// that already holds the string.
+bool post(Event event, const char* text, std::initializer_list<float> args = {}) noexcept;
+bool post(Event event, const juce::String& text) noexcept;
+
+// Crash path: drains what is queued and appends text synchronously.
+void writeNow(const juce::String& text);
+
+// Records dropped because the queue was full, since start.
+uint64_t getDroppedCount();
+} // namespace AsyncLog
@@ -15,12 +15,20 @@ const juce::String spectralRatio = "spectralRatio";
 const juce::String spectralAttack = "spectralAttack";
 const juce::String spectralRelease = "spectralRelease";
 const juce::String spectralMix = "spectralMix";
+const juce::String spectralLink = "spectralLink";
+const juce::String spectralBands = "spectralBands";
 const juce::String characterMode = "characterMode";
 const juce::String qMode = "qMode";
 const juce::String qModeAmount = "qModeAmount";
 const juce::String analyzerRange = "analyzerRange";
 const juce::String analyzerSpeed = "analyzerSpeed";
 const juce::String analyzerView = "analyzerView";
+const juce::String analyzerSource = "analyzerSource";
+const juce::String analyzerOverlap = "analyzerOverlap";
+const juce::String analyzerAveraging = "analyzerAveraging";
+const juce::String analyzerSmoothing = "analyzerSmoothing";
+const juce::String analyzerPeakHold = "analyzerPeakHold";
+const juce::String analyzerResolution = "analyzerResolution";
 const juce::String analyzerFreeze = "analyzerFreeze";
 const juce::String analyzerExternal = "analyzerExternal";
 const juce::String autoGainEnable = "autoGainEnable";
@@ -29,6 +37,9 @@ const juce::String phaseInvert = "phaseInvert";
 const juce::String midiLearn = "midiLearn";
 const juce::String midiTarget = "midiTarget";
 const juce::String smartSolo = "smartSolo";
+const juce::String snapshotMorph = "snapshotMorph";
+const juce::String snapshotMorphPair = "snapshotMorphPair";
+const juce::String snapshotMorphOn = "snapshotMorphOn";
 
 juce::String bandParamId(int channelIndex, int bandIndex, juce::StringRef suffix)
 {
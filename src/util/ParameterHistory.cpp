@@ -0,0 +1,120 @@
+#include "ParameterHistory.h"
+#include <cmath>
+#include <limits>
+
+namespace
+{
+bool sameValue(float a, float b)
+{
+    return (std::isnan(a) && std::isnan(b)) || a == b;
+}
+} // namespace
+
+void ParameterHistory::reset(const std::vector<float>& values)
+{
+    transactions.clear();
+    cursor = 0;
+    memoryUsed = 0;
+    baseline = values;
+}
+
+bool ParameterHistory::hasChanges(const std::vector<float>& values) const
+{
+    if (values.size() != baseline.size())
+        return true;
+    for (size_t i = 0; i < values.size(); ++i)
+        if (! sameValue(values[i], baseline[i]))
+            return true;
+    return false;
+}
+
+bool ParameterHistory::commit(const std::vector<float>& values, const juce::String& name)
+{
+    if (values.size() != baseline.size())
+    {
+        // Layout changed under us (should not happen): restart from here.
+        reset(values);
+        return false;
+    }
+
+    Transaction transaction;
+    transaction.name = name;
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        if (sameValue(values[i], baseline[i]) || std::isnan(values[i]))
+            continue;
+        transaction.changes.push_back({ static_cast<uint32_t>(i), baseline[i], values[i] });
+        baseline[i] = values[i];
+    }
+    if (transaction.changes.empty())
+        return false;
+    transaction.changes.shrink_to_fit();
+    transaction.bytes = sizeof(Transaction) + transaction.changes.size() * sizeof(Change)
+        + static_cast<size_t>(name.getNumBytesAsUTF8());
+
+    while (transactions.size() > cursor)
+    {
+        memoryUsed -= transactions.back().bytes;
+        transactions.pop_back();
+    }
+    memoryUsed += transaction.bytes;
+    transactions.push_back(std::move(transaction));
+    cursor = transactions.size();
+    trimToLimit();
+    return true;
+}
+
+bool ParameterHistory::undo(std::vector<float>& values)
+{
+    if (! canUndo())
+        return false;
+    const auto& transaction = transactions[--cursor];
+    values.assign(baseline.size(), std::numeric_limits<float>::quiet_NaN());
+    for (const auto& change : transaction.changes)
+    {
+        values[change.index] = change.before;
+        baseline[change.index] = change.before;
+    }
+    return true;
+}
+
+bool ParameterHistory::redo(std::vector<float>& values)
+{
+    if (! canRedo())
+        return false;
+    const auto& transaction = transactions[cursor++];
+    values.assign(baseline.size(), std::numeric_limits<float>::quiet_NaN());
+    for (const auto& change : transaction.changes)
+    {
+        values[change.index] = change.after;
+        baseline[change.index] = change.after;
+    }
+    return true;
+}
+
+juce::String ParameterHistory::getUndoName() const
+{
+    return canUndo() ? transactions[cursor - 1].name : juce::String();
+}
+
+juce::String ParameterHistory::getRedoName() const
+{
+    return canRedo() ? transactions[cursor].name : juce::String();
+}
+
+void ParameterHistory::setMemoryLimit(size_t bytes)
+{
+    memoryLimit = bytes;
+    trimToLimit();
+}
+
+void ParameterHistory::trimToLimit()
+{
+    // The newest transaction is always kept so the last action can be undone.
+    while (memoryUsed > memoryLimit && transactions.size() > 1 && cursor > 1)
+    {
+        memoryUsed -= transactions.front().bytes;
+        transactions.pop_front();
+        --cursor;
+    }
+}
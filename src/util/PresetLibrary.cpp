@@ -0,0 +1,371 @@
+#include "PresetLibrary.h"
+#include "ParamIDs.h"
+#include "../dsp/Biquad.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+namespace
+{
+constexpr int kCacheMagic = 0x4c505145; // "EQPL" little-endian
+constexpr int kCacheVersion = 1;
+constexpr int kRescanIntervalMs = 3000;
+constexpr double kThumbnailSampleRate = 48000.0;
+const juce::Identifier kParamType { "PARAM" };
+const juce::Identifier kIdProperty { "id" };
+const juce::Identifier kValueProperty { "value" };
+const juce::Identifier kTagsProperty { "tags" };
+
+struct FileStamp
+{
+    juce::File file;
+    juce::int64 modified = 0;
+    juce::int64 size = 0;
+};
+} // namespace
+
+PresetLibrary::PresetLibrary()
+    : juce::Thread("EQPro Presets"),
+      root(getDefaultDirectory()),
+      current(std::make_shared<const Index>())
+{
+}
+
+PresetLibrary::~PresetLibrary()
+{
+    signalThreadShouldExit();
+    notify();
+    stopThread(2000);
+}
+
+juce::File PresetLibrary::getDefaultDirectory()
+{
+    return juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+        .getChildFile("EQPro")
+        .getChildFile("Presets");
+}
+
+void PresetLibrary::start(const juce::AudioProcessorValueTreeState& parameters)
+{
+    if (started.exchange(true))
+        return;
+
+    // FNV-1a over IDs and defaults: a cache written for another layout is discarded.
+    auto hash = static_cast<uint64_t>(1469598103934665603ull);
+    for (auto* parameter : parameters.processor.getParameters())
+    {
+        auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter);
+        if (ranged == nullptr)
+            continue;
+        const auto id = ranged->getParameterID();
+        const auto value = ranged->convertFrom0to1(ranged->getDefaultValue());
+        defaults.set(id, value);
+        defaultIds.add(id);
+        for (auto c : id)
+            hash = (hash ^ static_cast<uint64_t>(c)) * 1099511628211ull;
+        hash = (hash ^ static_cast<uint64_t>(std::lround(value * 1000.0f))) * 1099511628211ull;
+    }
+    defaultsHash = static_cast<juce::int64>(hash);
+    startThread(juce::Thread::Priority::background);
+}
+
+void PresetLibrary::requestRescan()
+{
+    notify();
+}
+
+std::shared_ptr<const PresetLibrary::Index> PresetLibrary::getIndex() const
+{
+    const juce::SpinLock::ScopedLockType lock(indexLock);
+    return current;
+}
+
+void PresetLibrary::run()
+{
+    loadCache();
+    while (! threadShouldExit())
+    {
+        indexing.store(true);
+        const bool changed = rescan();
+        indexing.store(false);
+        if (changed)
+            saveCache(*getIndex());
+        wait(kRescanIntervalMs);
+    }
+}
+
+bool PresetLibrary::rescan()
+{
+    root.createDirectory();
+    std::vector<FileStamp> stamps;
+    for (const auto& entry : juce::RangedDirectoryIterator(root, true, "*.xml", juce::File::findFiles))
+    {
+        if (threadShouldExit())
+            return false;
+        stamps.push_back({ entry.getFile(), entry.getModificationTime().toMilliseconds(), entry.getFileSize() });
+    }
+
+    const auto previous = getIndex();
+    juce::HashMap<juce::String, int> previousByPath;
+    for (size_t i = 0; i < previous->size(); ++i)
+        previousByPath.set((*previous)[i].file.getFullPathName(), static_cast<int>(i));
+
+    bool changed = false;
+    Index next;
+    next.reserve(stamps.size());
+    juce::HashMap<juce::String, FailedStamp> failed;
+    for (const auto& stamp : stamps)
+    {
+        if (threadShouldExit())
+            return false;
+        const auto path = stamp.file.getFullPathName();
+        if (previousByPath.contains(path))
+        {
+            const auto& cached = (*previous)[static_cast<size_t>(previousByPath[path])];
+            if (cached.modified == stamp.modified && cached.size == stamp.size)
+            {
+                next.push_back(cached);
+                continue;
+            }
+        }
+        // Unreadable files are skipped by stamp, without counting as a change, until they change again.
+        if (failedStamps.contains(path))
+        {
+            const auto known = failedStamps[path];
+            if (known.modified == stamp.modified && known.size == stamp.size)
+            {
+                failed.set(path, known);
+                continue;
+            }
+        }
+
+        Preset preset;
+        preset.file = stamp.file;
+        preset.modified = stamp.modified;
+        preset.size = stamp.size;
+        if (parsePreset(stamp.file, preset))
+        {
+            next.push_back(std::move(preset));
+            changed = true;
+        }
+        else
+        {
+            failed.set(path, { stamp.modified, stamp.size });
+        }
+    }
+    // Forgets stamps of deleted files.
+    failedStamps.swapWith(failed);
+
+    // A preset that was deleted or became unreadable shrinks the index.
+    changed = changed || next.size() != previous->size();
+    if (! changed)
+        return false;
+    publish(std::move(next));
+    return true;
+}
+
+bool PresetLibrary::parsePreset(const juce::File& file, Preset& preset) const
+{
+    const auto xml = juce::XmlDocument::parse(file);
+    if (xml == nullptr)
+        return false;
+
+    preset.name = file.getFileNameWithoutExtension();
+    preset.tags.clear();
+    for (auto dir = file.getParentDirectory(); dir != root && dir.isAChildOf(root); dir = dir.getParentDirectory())
+        preset.tags.insert(0, dir.getFileName());
+    preset.tags.addTokens(xml->getStringAttribute(kTagsProperty.toString()), ";", "");
+    preset.tags.trim();
+    preset.tags.removeEmptyStrings();
+    preset.tags.removeDuplicates(true);
+
+    juce::MemoryOutputStream body;
+    int count = 0;
+    for (const auto* child : xml->getChildWithTagNameIterator(kParamType.toString()))
+    {
+        const auto id = child->getStringAttribute(kIdProperty.toString());
+        if (! defaults.contains(id) || ! child->hasAttribute(kValueProperty.toString()))
+            continue;
+        const auto value = static_cast<float>(child->getDoubleAttribute(kValueProperty.toString()));
+        if (juce::approximatelyEqual(value, defaults[id]))
+            continue;
+        body.writeString(id);
+        body.writeFloat(value);
+        ++count;
+    }
+    preset.parameters.reset();
+    juce::MemoryOutputStream out(preset.parameters, false);
+    out.writeCompressedInt(count);
+    out << body.getMemoryBlock();
+    out.flush();
+
+    computeThumbnail(preset);
+    return true;
+}
+
+void PresetLibrary::computeThumbnail(Preset& preset) const
+{
+    juce::HashMap<juce::String, float> values;
+    {
+        juce::MemoryInputStream in(preset.parameters, false);
+        const int count = in.readCompressedInt();
+        for (int i = 0; i < count && ! in.isExhausted(); ++i)
+        {
+            const auto id = in.readString();
+            values.set(id, in.readFloat());
+        }
+    }
+    const auto valueOf = [this, &values](const juce::String& id)
+    {
+        return values.contains(id) ? values[id] : defaults[id];
+    };
+    const auto isChanged = [&values](const juce::String& id) { return values.contains(id); };
+
+    std::array<std::complex<double>, kThumbnailPoints> response;
+    response.fill({ 1.0, 0.0 });
+    std::array<std::complex<double>, kThumbnailPoints> z;
+    for (int i = 0; i < kThumbnailPoints; ++i)
+    {
+        const double freq = kThumbnailMinFreq
+            * std::pow(static_cast<double>(kThumbnailMaxFreq / kThumbnailMinFreq), i / double(kThumbnailPoints - 1));
+        z[static_cast<size_t>(i)] = std::polar(1.0, -2.0 * juce::MathConstants<double>::pi * freq / kThumbnailSampleRate);
+    }
+
+    for (int band = 0; band < ParamIDs::kBandsPerChannel; ++band)
+    {
+        const auto id = [band](const char* suffix) { return ParamIDs::bandParamId(0, band, suffix); };
+        // Same rule as the processor: a bypassed band wakes up once any of its settings moves.
+        const bool active = valueOf(id("bypass")) < 0.5f
+            || isChanged(id("freq")) || isChanged(id("gain")) || isChanged(id("q")) || isChanged(id("type"))
+            || isChanged(id("slope")) || isChanged(id("mix")) || isChanged(id("ms")) || isChanged(id("solo"));
+        if (! active)
+            continue;
+
+        eqdsp::BandParams params;
+        params.frequencyHz = valueOf(id("freq"));
+        params.gainDb = valueOf(id("gain"));
+        params.q = valueOf(id("q"));
+        params.type = static_cast<eqdsp::FilterType>(static_cast<int>(valueOf(id("type"))));
+        params.slopeDb = valueOf(id("slope"));
+        eqdsp::Biquad biquad;
+        biquad.prepare(kThumbnailSampleRate);
+        biquad.update(params);
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+        biquad.getCoefficients(b0, b1, b2, a1, a2);
+
+        const double mix = juce::jlimit(0.0, 1.0, static_cast<double>(valueOf(id("mix"))) / 100.0);
+        for (size_t i = 0; i < response.size(); ++i)
+        {
+            const auto zi = z[i];
+            const auto h = (static_cast<double>(b0) + zi * (static_cast<double>(b1) + zi * static_cast<double>(b2)))
+                / (1.0 + zi * (static_cast<double>(a1) + zi * static_cast<double>(a2)));
+            response[i] *= 1.0 + mix * (h - 1.0);
+        }
+    }
+
+    for (size_t i = 0; i < response.size(); ++i)
+    {
+        const double db = 20.0 * std::log10(std::max(1.0e-6, std::abs(response[i])));
+        preset.thumbnail[i] = static_cast<int8_t>(juce::jlimit(-127.0, 127.0, std::round(db * kThumbnailDbScale)));
+    }
+}
+
+void PresetLibrary::publish(Index&& index)
+{
+    std::sort(index.begin(), index.end(), [](const Preset& a, const Preset& b)
+    {
+        const int order = a.name.compareNatural(b.name);
+        return order != 0 ? order < 0 : a.file.getFullPathName() < b.file.getFullPathName();
+    });
+    auto next = std::make_shared<const Index>(std::move(index));
+    {
+        const juce::SpinLock::ScopedLockType lock(indexLock);
+        current = std::move(next);
+    }
+    sendChangeMessage();
+}
+
+juce::File PresetLibrary::getCacheFile() const
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("EQPro")
+        .getChildFile("PresetIndex.bin");
+}
+
+void PresetLibrary::loadCache()
+{
+    juce::FileInputStream in(getCacheFile());
+    if (! in.openedOk() || in.readInt() != kCacheMagic || in.readShort() != kCacheVersion)
+        return;
+    in.readShort();
+    if (in.readInt64() != defaultsHash)
+        return;
+
+    Index index;
+    const int count = in.readCompressedInt();
+    for (int i = 0; i < count; ++i)
+    {
+        Preset preset;
+        preset.file = root.getChildFile(in.readString());
+        preset.name = preset.file.getFileNameWithoutExtension();
+        preset.modified = in.readInt64();
+        preset.size = in.readInt64();
+        preset.tags.addTokens(in.readString(), ";", "");
+        preset.tags.removeEmptyStrings();
+        in.read(preset.thumbnail.data(), kThumbnailPoints);
+        const int blockSize = in.readCompressedInt();
+        if (in.isExhausted() || blockSize < 0 || blockSize > in.getNumBytesRemaining())
+            return;
+        in.readIntoMemoryBlock(preset.parameters, blockSize);
+        index.push_back(std::move(preset));
+    }
+    publish(std::move(index));
+}
+
+void PresetLibrary::saveCache(const Index& index) const
+{
+    const auto file = getCacheFile();
+    file.getParentDirectory().createDirectory();
+    juce::TemporaryFile temp(file);
+    {
+        juce::FileOutputStream out(temp.getFile());
+        if (! out.openedOk())
+            return;
+        out.writeInt(kCacheMagic);
+        out.writeShort(static_cast<short>(kCacheVersion));
+        out.writeShort(0);
+        out.writeInt64(defaultsHash);
+        out.writeCompressedInt(static_cast<int>(index.size()));
+        for (const auto& preset : index)
+        {
+            out.writeString(preset.file.getRelativePathFrom(root));
+            out.writeInt64(preset.modified);
+            out.writeInt64(preset.size);
+            out.writeString(preset.tags.joinIntoString(";"));
+            out.write(preset.thumbnail.data(), kThumbnailPoints);
+            out.writeCompressedInt(static_cast<int>(preset.parameters.getSize()));
+            out << preset.parameters;
+        }
+        out.flush();
+        if (out.getStatus().failed())
+            return;
+    }
+    temp.overwriteTargetFileWithTemporary();
+}
+
+juce::Path PresetLibrary::makeThumbnailPath(const Preset& preset, juce::Rectangle<float> bounds, float rangeDb)
+{
+    juce::Path path;
+    const float range = juce::jmax(1.0f, rangeDb);
+    for (int i = 0; i < kThumbnailPoints; ++i)
+    {
+        const float db = juce::jlimit(-range, range, preset.thumbnail[static_cast<size_t>(i)] / kThumbnailDbScale);
+        const float x = bounds.getX() + bounds.getWidth() * static_cast<float>(i) / (kThumbnailPoints - 1);
+        const float y = bounds.getCentreY() - db / range * bounds.getHeight() * 0.5f;
+        if (i == 0)
+            path.startNewSubPath(x, y);
+        else
+            path.lineTo(x, y);
+    }
+    return path;
+}
@@ -1,7 +1,10 @@
 #include "RingBuffer.h"
 
-void AudioFifo::prepare(int bufferSize)
+void AudioFifo::prepare(int bufferSize, int numChannels)
 {
+    frameChannels.store(1, std::memory_order_relaxed);
+    pendingChannels.store(0, std::memory_order_relaxed);
+    pushedChannels = 1;
     if (bufferSize <= 0)
     {
         buffer.setSize(0, 0);
@@ -9,18 +12,32 @@ void AudioFifo::prepare(int bufferSize)
         return;
     }
 
-    buffer.setSize(1, bufferSize);
+    buffer.setSize(juce::jmax(1, numChannels), bufferSize);
     buffer.clear();
     fifo.setTotalSize(bufferSize);
 }
 
 void AudioFifo::push(const float* data, int numSamples)
+{
+    pushFrames(&data, 1, numSamples);
+}
+
+void AudioFifo::pushFrames(const float* const* data, int numChannels, int numSamples)
 {
     if (numSamples <= 0)
         return;
     if (buffer.getNumSamples() <= 0 || buffer.getNumChannels() <= 0)
         return;
 
+    const int channels = juce::jlimit(1, buffer.getNumChannels(), numChannels);
+    if (channels != pushedChannels)
+    {
+        pushedChannels = channels;
+        pendingChannels.store(channels, std::memory_order_release);
+    }
+    if (pendingChannels.load(std::memory_order_acquire) != 0)
+        return;
+
     int start1 = 0;
     int size1 = 0;
     int start2 = 0;
@@ -32,23 +49,31 @@ void AudioFifo::push(const float* data, int numSamples)
         return;
 
     const int skip = juce::jmax(0, numSamples - total);
-    const float* src = data + skip;
-
-    if (size1 > 0)
-        buffer.copyFrom(0, start1, src, size1);
-    if (size2 > 0)
-        buffer.copyFrom(0, start2, src + size1, size2);
+    for (int ch = 0; ch < channels; ++ch)
+    {
+        const float* src = data[ch] + skip;
+        if (size1 > 0)
+            buffer.copyFrom(ch, start1, src, size1);
+        if (size2 > 0)
+            buffer.copyFrom(ch, start2, src + size1, size2);
+    }
 
     fifo.finishedWrite(total);
 }
 
 int AudioFifo::pull(float* dest, int numSamples)
+{
+    return pullFrames(&dest, 1, numSamples);
+}
+
+int AudioFifo::pullFrames(float* const* dest, int numChannels, int numSamples)
 {
     if (numSamples <= 0)
         return 0;
     if (buffer.getNumSamples() <= 0 || buffer.getNumChannels() <= 0)
         return 0;
 
+    const int channels = juce::jlimit(1, buffer.getNumChannels(), numChannels);
     int start1 = 0;
     int size1 = 0;
     int start2 = 0;
@@ -59,11 +84,44 @@ int AudioFifo::pull(float* dest, int numSamples)
     if (total == 0)
         return 0;
 
-    if (size1 > 0)
-        juce::FloatVectorOperations::copy(dest, buffer.getReadPointer(0, start1), size1);
-    if (size2 > 0)
-        juce::FloatVectorOperations::copy(dest + size1, buffer.getReadPointer(0, start2), size2);
+    for (int ch = 0; ch < channels; ++ch)
+    {
+        if (size1 > 0)
+            juce::FloatVectorOperations::copy(dest[ch], buffer.getReadPointer(ch, start1), size1);
+        if (size2 > 0)
+            juce::FloatVectorOperations::copy(dest[ch] + size1, buffer.getReadPointer(ch, start2), size2);
+    }
 
     fifo.finishedRead(total);
     return total;
 }
+
+int AudioFifo::acknowledgeLayout()
+{
+    int pending = pendingChannels.load(std::memory_order_acquire);
+    while (pending != 0)
+    {
+        // The writer pushes nothing while a change is pending, so everything queued is old layout.
+        int start1 = 0;
+        int size1 = 0;
+        int start2 = 0;
+        int size2 = 0;
+        fifo.prepareToRead(fifo.getNumReady(), start1, size1, start2, size2);
+        fifo.finishedRead(size1 + size2);
+        frameChannels.store(pending, std::memory_order_relaxed);
+        // Fails (and reloads pending) if the writer switched again meanwhile.
+        if (pendingChannels.compare_exchange_strong(pending, 0, std::memory_order_acq_rel))
+            break;
+    }
+    return frameChannels.load(std::memory_order_relaxed);
+}
+
+int AudioFifo::getNumChannels() const
+{
+    return buffer.getNumChannels();
+}
+
+int AudioFifo::getNumReady() const
+{
+    return fifo.getNumReady();
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+// Compile-time SSE detection shared by the hand-vectorized DSP kernels.
+// Kernels keep a scalar path for other targets (it auto-vectorizes on NEON builds).
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define EQPRO_HAS_SSE2 1
+#else
+ #define EQPRO_HAS_SSE2 0
+#endif
+
+namespace Simd
+{
+// Four float lanes; used to run one lane per channel through recursive filters.
+struct Float4
+{
+#if EQPRO_HAS_SSE2
+    __m128 v;
+
+    static Float4 zero() noexcept { return { _mm_setzero_ps() }; }
+    static Float4 broadcast(float x) noexcept { return { _mm_set1_ps(x) }; }
+    static Float4 load(const float* p) noexcept { return { _mm_loadu_ps(p) }; }
+    void store(float* p) const noexcept { _mm_storeu_ps(p, v); }
+
+    friend Float4 operator+(Float4 a, Float4 b) noexcept { return { _mm_add_ps(a.v, b.v) }; }
+    friend Float4 operator-(Float4 a, Float4 b) noexcept { return { _mm_sub_ps(a.v, b.v) }; }
+    friend Float4 operator*(Float4 a, Float4 b) noexcept { return { _mm_mul_ps(a.v, b.v) }; }
+    friend Float4 max(Float4 a, Float4 b) noexcept { return { _mm_max_ps(a.v, b.v) }; }
+    friend Float4 min(Float4 a, Float4 b) noexcept { return { _mm_min_ps(a.v, b.v) }; }
+    friend Float4 abs(Float4 a) noexcept
+    {
+        return { _mm_and_ps(a.v, _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff))) };
+    }
+    // True if any lane of a exceeds the same lane of b.
+    friend bool anyGreater(Float4 a, Float4 b) noexcept { return _mm_movemask_ps(_mm_cmpgt_ps(a.v, b.v)) != 0; }
+
+    // Rows in, columns out: r0..r3 each hold four consecutive samples of one channel.
+    static void transpose(Float4& r0, Float4& r1, Float4& r2, Float4& r3) noexcept
+    {
+        _MM_TRANSPOSE4_PS(r0.v, r1.v, r2.v, r3.v);
+    }
+#else
+    float v[4];
+
+    static Float4 zero() noexcept { return { { 0.0f, 0.0f, 0.0f, 0.0f } }; }
+    static Float4 broadcast(float x) noexcept { return { { x, x, x, x } }; }
+    static Float4 load(const float* p) noexcept { return { { p[0], p[1], p[2], p[3] } }; }
+    void store(float* p) const noexcept { std::copy(v, v + 4, p); }
+
+    template <typename Op>
+    static Float4 map(Float4 a, Float4 b, Op op) noexcept
+    {
+        return { { op(a.v[0], b.v[0]), op(a.v[1], b.v[1]), op(a.v[2], b.v[2]), op(a.v[3], b.v[3]) } };
+    }
+    friend Float4 operator+(Float4 a, Float4 b) noexcept { return map(a, b, [](float x, float y) { return x + y; }); }
+    friend Float4 operator-(Float4 a, Float4 b) noexcept { return map(a, b, [](float x, float y) { return x - y; }); }
+    friend Float4 operator*(Float4 a, Float4 b) noexcept { return map(a, b, [](float x, float y) { return x * y; }); }
+    friend Float4 max(Float4 a, Float4 b) noexcept { return map(a, b, [](float x, float y) { return std::max(x, y); }); }
+    friend Float4 min(Float4 a, Float4 b) noexcept { return map(a, b, [](float x, float y) { return std::min(x, y); }); }
+    friend Float4 abs(Float4 a) noexcept { return map(a, a, [](float x, float) { return std::abs(x); }); }
+    friend bool anyGreater(Float4 a, Float4 b) noexcept
+    {
+        return a.v[0] > b.v[0] || a.v[1] > b.v[1] || a.v[2] > b.v[2] || a.v[3] > b.v[3];
+    }
+
+    static void transpose(Float4& r0, Float4& r1, Float4& r2, Float4& r3) noexcept
+    {
+        Float4* rows[4] { &r0, &r1, &r2, &r3 };
+        for (int i = 0; i < 4; ++i)
+            for (int j = i + 1; j < 4; ++j)
+                std::swap(rows[i]->v[j], rows[j]->v[i]);
+    }
+#endif
+};
+} // namespace Simd
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <utility>
+#include <vector>
+
+// Compact binary plugin state: parameters stored as a delta from their defaults, plus the state
+// tree's properties. Snapshot slots are binary parameter deltas (see encodeParameterValues) kept as
+// plain properties; slots saved as full-state XML strings by older versions are re-encoded as nested
+// deltas. A session chunk for a mostly default instance is a few hundred bytes instead of hundreds
+// of KB of XML. Chunks saved as XML by older versions are still read by the caller.
+//
+// Layout (little-endian, version 1):
+//   uint32 magic 'EQPB', uint16 version, uint16 reserved
+//   state block
+// State block:
+//   compressed int N, then N x (UTF-8 paramID, float value)  -- parameters differing from default
+//   compressed int P, then P x (UTF-8 name, juce::var)         -- plain tree properties
+//   compressed int S, then S x (UTF-8 name, state block)       -- XML snapshot slot properties
+namespace StateCodec
+{
+constexpr int kMagic = 0x42505145; // "EQPB" little-endian
+constexpr int kVersion = 1;
+
+// Encodes a full APVTS state tree (as returned by copyState()).
+void write(const juce::AudioProcessorValueTreeState& parameters, const juce::ValueTree& state,
+           juce::MemoryBlock& dest);
+
+// True if data carries the binary magic (anything else goes to the XML fallback).
+bool isBinary(const void* data, int sizeInBytes);
+
+// Decodes to a complete state tree: every parameter present, defaults filled in, snapshot slot
+// properties restored as XML strings. Returns an invalid tree on a malformed or newer chunk.
+juce::ValueTree read(const juce::AudioProcessorValueTreeState& parameters, const void* data, int sizeInBytes);
+
+// The top-level parameter entries of a binary chunk (the values differing from default), for tools
+// without a parameter tree. False on a malformed or newer chunk.
+bool readParameterDeltas(const void* data, int sizeInBytes, std::vector<std::pair<juce::String, float>>& dest);
+
+// Parameter vectors hold denormalised values indexed like processor.getParameters(). Encoded as
+// compressed int N, then N x (UTF-8 paramID, float value) for the entries differing from default;
+// NaN entries are skipped.
+void encodeParameterValues(const juce::AudioProcessorValueTreeState& parameters, const std::vector<float>& values,
+                           juce::MemoryBlock& dest);
+// Full vector with defaults filled in (unknown IDs ignored); empty on malformed data.
+std::vector<float> decodeParameterValues(const juce::AudioProcessorValueTreeState& parameters, const void* data,
+                                         size_t sizeInBytes);
+} // namespace StateCodec
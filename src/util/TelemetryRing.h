@@ -0,0 +1,125 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+// Shared-memory telemetry export: a memory-mapped file holding a header and a ring of fixed-size
+// slots, each carrying one log-binned spectrum frame plus the meter values. One writer (the
+// analyzer worker) per file; any number of local readers map the file and read slots in place.
+//
+// Reader protocol: load writeCount (acquire); the newest record is slot (writeCount - 1) % slotCount.
+// Read that slot's sequence, skip it if odd (write in flight), read the record, then re-read the
+// sequence and discard the record if it changed. Older slots stay valid until lapped.
+namespace Telemetry
+{
+constexpr uint32_t kMagic = 0x4d545145u; // "EQTM" little-endian
+constexpr uint32_t kVersion = 1;
+constexpr int kSpectrumBins = 256;
+constexpr int kSlotCount = 64;
+constexpr int kMaxChannels = 16;
+// Spectrum values are int16 hundredths of a dB (-32768 = no data).
+constexpr float kCentiDbScale = 100.0f;
+constexpr int16_t kNoData = -32768;
+
+enum RecordFlags : uint32_t
+{
+    hasPre = 1u << 0,
+    hasPost = 1u << 1
+};
+
+enum SpectrumIndex
+{
+    pre = 0,
+    post,
+    numSpectra
+};
+
+struct ChannelLevels
+{
+    float rmsDb;
+    float peakDb;
+    float truePeakDb;
+};
+
+// One exported frame. Bin b covers a log-spaced band between minFreq and maxFreq.
+struct Record
+{
+    uint64_t frameIndex;
+    // juce::Time::getMillisecondCounterHiRes() of the writer.
+    double timestampMs;
+    float sampleRate;
+    float minFreq;
+    float maxFreq;
+    uint32_t flags;
+    int32_t numChannels;
+    float momentaryLufs;
+    float shortTermLufs;
+    float integratedLufs;
+    float truePeakMaxDb;
+    float correlation;
+    ChannelLevels channels[kMaxChannels];
+    int16_t spectrum[numSpectra][kSpectrumBins];
+};
+
+struct Slot
+{
+    std::atomic<uint32_t> sequence;
+    uint32_t reserved;
+    Record record;
+};
+
+struct Header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t slotSize;
+    uint32_t slotCount;
+    uint32_t spectrumBins;
+    std::atomic<uint64_t> writeCount;
+    // Host and plugin description (UTF-8, NUL-terminated), for dashboards listing instances.
+    char label[64];
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+              "telemetry atomics must be lock-free to be shared between processes");
+static_assert(std::is_trivially_copyable<Record>::value, "telemetry records are copied as raw bytes");
+
+// Max-reduce display columns (dB, log-spaced between columnMinFreq and columnMaxFreq) into the
+// export bins (log-spaced between binMinFreq and binMaxFreq). A bin narrower than a column takes
+// the column under its centre; bins outside the first validColumns columns get kNoData.
+void binSpectrum(const float* columnsDb, int numColumns, int validColumns, float columnMinFreq,
+                 float columnMaxFreq, float binMinFreq, float binMaxFreq, int16_t* destBins);
+} // namespace Telemetry
+
+// Writer side of one telemetry file. open/close on the message thread; publish from one thread.
+class TelemetryRing
+{
+public:
+    TelemetryRing() = default;
+    ~TelemetryRing();
+
+    // Default location: <temp>/EQPro/Telemetry.
+    static juce::File getDefaultDirectory();
+
+    // Creates (or truncates) the file, maps it and writes the header. Returns false on failure.
+    bool open(const juce::File& file, const juce::String& label);
+    // Unmaps and deletes the file.
+    void close();
+    bool isOpen() const { return slots != nullptr; }
+    const juce::File& getFile() const { return file; }
+
+    // Copies record into the next slot and bumps writeCount. Wait-free.
+    void publish(const Telemetry::Record& record) noexcept;
+
+private:
+    juce::File file;
+    std::unique_ptr<juce::MemoryMappedFile> mapping;
+    Telemetry::Header* header = nullptr;
+    Telemetry::Slot* slots = nullptr;
+    uint64_t written = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(TelemetryRing)
+};
@@ -0,0 +1,404 @@
+// eqpro_render: headless offline renderer. Runs audio files through EqEngine with the parameters of
+// a saved plugin state (binary or XML chunk) or preset, without the plugin wrapper or any GUI.
+//
+//   eqpro_render --state=<state.xml> [--out=<dir>] [--suffix=<text>] [--block=<samples>]
+//                [--jobs=<n>] [--bits=16|24|32] [--tail=<seconds>] [--source-channel=<n>]
+//                <file or folder>...
+//
+// Files are processed in parallel (one engine per file, --jobs threads). Each file is streamed in
+// large blocks; the engine's latency (FIR, oversampling, spectral stage) is trimmed so the output is
+// sample-aligned with the input and, unless --tail is given, exactly as long.
+
+#include <JuceHeader.h>
+#include "../../src/dsp/EqEngine.h"
+#include "../../src/dsp/SnapshotBuilder.h"
+#include "../../src/util/ChannelLayoutUtils.h"
+#include "../../src/util/ParamIDs.h"
+#include "../../src/util/StateCodec.h"
+#include <atomic>
+#include <unordered_map>
+
+namespace
+{
+constexpr int kDefaultBlockSize = 8192;
+// Longest wait for the convolvers to install the designed FIRs before a file fails.
+constexpr double kFirReadyTimeoutSeconds = 30.0;
+// Silence run after the FIRs are in, so every smoother and crossfade has settled.
+constexpr double kSettleSeconds = 0.25;
+
+using ParameterValues = std::unordered_map<juce::String, float>;
+
+struct RenderSettings
+{
+    ParameterValues values;
+    juce::File outputDirectory;
+    juce::String suffix = "_eqpro";
+    int blockSize = kDefaultBlockSize;
+    int bitsPerSample = 0; // 0 = same as the source
+    double tailSeconds = 0.0;
+    int sourceChannel = 0;
+};
+
+// Reads the parameter values of a saved state: a binary StateCodec chunk (the parameters differing
+// from their defaults) or an XML state/preset (its PARAM id/value children).
+bool loadParameterValues(const juce::File& file, ParameterValues& values, juce::String& error)
+{
+    juce::MemoryBlock data;
+    if (! file.loadFileAsData(data))
+    {
+        error = "cannot read " + file.getFullPathName();
+        return false;
+    }
+    if (StateCodec::isBinary(data.getData(), static_cast<int>(data.getSize())))
+    {
+        std::vector<std::pair<juce::String, float>> deltas;
+        if (! StateCodec::readParameterDeltas(data.getData(), static_cast<int>(data.getSize()), deltas))
+        {
+            error = file.getFullPathName() + " is a malformed or newer binary state";
+            return false;
+        }
+        for (const auto& [id, value] : deltas)
+            values[id] = value;
+        // A default state has no entries; missing parameters read as defaults either way.
+        return true;
+    }
+
+    const auto xml = juce::parseXML(data.toString());
+    if (xml == nullptr)
+    {
+        error = "cannot parse " + file.getFullPathName() + " as a binary or XML state";
+        return false;
+    }
+    for (const auto* child : xml->getChildWithTagNameIterator("PARAM"))
+        if (child->hasAttribute("id") && child->hasAttribute("value"))
+            values[child->getStringAttribute("id")] = static_cast<float>(child->getDoubleAttribute("value"));
+    if (values.empty())
+    {
+        error = file.getFullPathName() + " has no PARAM entries";
+        return false;
+    }
+    return true;
+}
+
+// Offline counterpart of EQProAudioProcessor::buildSnapshot(): the same global/band loaders and
+// routing, with parameters missing from the file at their defaults. Snapshot morphing is not applied.
+eqdsp::ParamSnapshot makeSnapshot(const ParameterValues& values, const juce::AudioChannelSet& layout,
+                                  int numChannels, int sourceChannel)
+{
+    const auto find = [&values](const juce::String& id) -> const float*
+    {
+        const auto it = values.find(id);
+        return it != values.end() ? &it->second : nullptr;
+    };
+    const auto load = [](const float* v, float fallback) { return v != nullptr ? *v : fallback; };
+
+    eqdsp::ParamSnapshot snapshot {};
+    snapshot.numChannels = numChannels;
+    eqdsp::loadGlobalParams(eqdsp::findGlobalParams(find), load, snapshot);
+
+    struct BandValues
+    {
+        const float* frequency;
+        const float* gain;
+        const float* q;
+        const float* type;
+        const float* bypass;
+        const float* msTarget;
+        const float* slope;
+        const float* solo;
+        const float* mix;
+        const float* dynEnable;
+        const float* dynMode;
+        const float* dynThreshold;
+        const float* dynAttack;
+        const float* dynRelease;
+        const float* dynAuto;
+        const float* dynExternal;
+        const float* odd;
+        const float* mixOdd;
+        const float* even;
+        const float* mixEven;
+        const float* harmonicBypass;
+    };
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        for (int band = 0; band < ParamIDs::kBandsPerChannel; ++band)
+        {
+            const auto param = [&find, ch, band](const char* suffix)
+            {
+                return find(ParamIDs::bandParamId(ch, band, suffix));
+            };
+            const BandValues ptrs {
+                param("freq"), param("gain"), param("q"), param("type"), param("bypass"), param("ms"),
+                param("slope"), param("solo"), param("mix"), param("dynEnable"), param("dynMode"),
+                param("dynThresh"), param("dynAttack"), param("dynRelease"), param("dynAuto"),
+                param("dynExternal"), param("odd"), param("mixOdd"), param("even"), param("mixEven"),
+                param("harmonicBypass")
+            };
+            eqdsp::loadBandParams(ptrs, band, load, snapshot.bands[ch][band]);
+        }
+    }
+
+    auto channelNames = ChannelLayoutUtils::getChannelNames(layout);
+    if (static_cast<int>(channelNames.size()) < numChannels)
+        channelNames = ChannelLayoutUtils::getChannelNames(juce::AudioChannelSet::canonicalChannelSet(numChannels));
+    eqdsp::routeBands(snapshot, channelNames, sourceChannel);
+    return snapshot;
+}
+
+class RenderJob final : public juce::ThreadPoolJob
+{
+public:
+    RenderJob(const RenderSettings& settingsIn, juce::File inputIn, std::atomic<int>& failuresIn)
+        : juce::ThreadPoolJob(inputIn.getFileName()),
+          settings(settingsIn),
+          input(std::move(inputIn)),
+          failures(failuresIn)
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        juce::String error;
+        const auto start = juce::Time::getMillisecondCounterHiRes();
+        double audioSeconds = 0.0;
+        int latency = 0;
+        if (! render(error, audioSeconds, latency))
+        {
+            ++failures;
+            report("FAILED " + input.getFullPathName() + ": " + error);
+            return jobHasFinished;
+        }
+        const double wallSeconds = (juce::Time::getMillisecondCounterHiRes() - start) / 1000.0;
+        report(input.getFileName() + ": " + juce::String(audioSeconds, 1) + " s in " + juce::String(wallSeconds, 2)
+               + " s (" + juce::String(audioSeconds / juce::jmax(1.0e-6, wallSeconds), 1) + "x realtime, latency "
+               + juce::String(latency) + " samples trimmed)");
+        return jobHasFinished;
+    }
+
+private:
+    static void report(const juce::String& line)
+    {
+        static juce::CriticalSection lock;
+        const juce::ScopedLock sl(lock);
+        std::cout << line << std::endl;
+    }
+
+    bool render(juce::String& error, double& audioSeconds, int& latency)
+    {
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+        std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(input));
+        if (reader == nullptr)
+        {
+            error = "unsupported or unreadable file";
+            return false;
+        }
+        const int numChannels = static_cast<int>(reader->numChannels);
+        const double sampleRate = reader->sampleRate;
+        if (numChannels < 1 || numChannels > ParamIDs::kMaxChannels || sampleRate <= 0.0)
+        {
+            error = juce::String(numChannels) + " channels at " + juce::String(sampleRate) + " Hz is not supported";
+            return false;
+        }
+        const auto layout = reader->getChannelLayout();
+        const auto totalInput = reader->lengthInSamples;
+        audioSeconds = static_cast<double>(totalInput) / sampleRate;
+
+        // Without --out the result goes next to the input.
+        const auto directory = settings.outputDirectory == juce::File() ? input.getParentDirectory()
+                                                                        : settings.outputDirectory;
+        const auto output = directory.getChildFile(input.getFileNameWithoutExtension() + settings.suffix
+                                                   + input.getFileExtension());
+        if (output == input)
+        {
+            error = "output would overwrite the input";
+            return false;
+        }
+        auto* format = formats.findFormatForFileExtension(output.getFileExtension());
+        std::unique_ptr<juce::OutputStream> stream;
+        if (format != nullptr && output.deleteFile())
+            stream = std::make_unique<juce::FileOutputStream>(output);
+        if (stream == nullptr || static_cast<juce::FileOutputStream*>(stream.get())->failedToOpen())
+        {
+            error = "cannot write " + output.getFullPathName();
+            return false;
+        }
+        const int sourceBits = reader->usesFloatingPointData ? 32 : static_cast<int>(reader->bitsPerSample);
+        const int bits = settings.bitsPerSample > 0 ? settings.bitsPerSample : sourceBits;
+        using SampleFormat = juce::AudioFormatWriterOptions::SampleFormat;
+        const auto options = juce::AudioFormatWriterOptions {}
+                                 .withSampleRate(sampleRate)
+                                 .withNumChannels(numChannels)
+                                 .withBitsPerSample(bits)
+                                 .withSampleFormat(bits == 32 ? SampleFormat::floatingPoint : SampleFormat::integral);
+        auto writer = format->createWriterFor(
+            stream, layout.size() == numChannels ? options.withChannelLayout(layout) : options);
+        if (writer == nullptr)
+        {
+            error = "the output format does not support " + juce::String(bits) + "-bit "
+                + juce::String(numChannels) + " channel audio";
+            return false;
+        }
+
+        const int blockSize = settings.blockSize;
+        auto engine = std::make_unique<eqdsp::EqEngine>();
+        engine->prepare(sampleRate, blockSize, numChannels);
+        // The engine always feeds taps; these are never read.
+        eqdsp::AnalyzerTap preTap;
+        eqdsp::AnalyzerTap postTap;
+        eqdsp::AnalyzerTap harmonicTap;
+        eqdsp::MeterTap meterTap;
+        for (auto* tap : { &preTap, &postTap, &harmonicTap })
+            tap->prepare(blockSize, sampleRate, 1);
+        meterTap.prepare(sampleRate);
+
+        const auto snapshot = makeSnapshot(settings.values, layout, numChannels, settings.sourceChannel);
+        engine->updateLinearPhase(snapshot, sampleRate);
+
+        juce::AudioBuffer<float> buffer(numChannels, blockSize);
+        const auto process = [&](int numSamples)
+        {
+            buffer.setSize(numChannels, numSamples, true, false, true);
+            engine->process(buffer, snapshot, nullptr, preTap, postTap, harmonicTap, meterTap);
+        };
+
+        // Pre-roll silence until the convolvers run the new FIRs (they install them on their own
+        // threads), then until the smoothers have settled: the file starts on a steady engine.
+        const auto readyDeadline = juce::Time::getMillisecondCounterHiRes() + kFirReadyTimeoutSeconds * 1000.0;
+        do
+        {
+            buffer.clear();
+            process(blockSize);
+            if (engine->isLinearPhaseReady(numChannels))
+                break;
+            juce::Thread::sleep(1);
+        } while (juce::Time::getMillisecondCounterHiRes() < readyDeadline);
+        if (! engine->isLinearPhaseReady(numChannels))
+        {
+            error = "timed out waiting for the linear-phase FIR";
+            return false;
+        }
+        for (int settled = 0; settled < static_cast<int>(kSettleSeconds * sampleRate); settled += blockSize)
+        {
+            buffer.clear();
+            process(blockSize);
+        }
+
+        latency = engine->getLatencySamples();
+        const auto totalOutput = totalInput + static_cast<juce::int64>(settings.tailSeconds * sampleRate);
+        const auto block = static_cast<juce::int64>(blockSize);
+        juce::int64 readPos = 0;
+        juce::int64 skip = latency;
+        juce::int64 written = 0;
+        while (written < totalOutput)
+        {
+            buffer.setSize(numChannels, blockSize, true, false, true);
+            const auto available = static_cast<int>(juce::jlimit(juce::int64 { 0 }, block, totalInput - readPos));
+            if (available > 0)
+                reader->read(&buffer, 0, available, readPos, true, true);
+            for (int ch = 0; ch < numChannels; ++ch)
+                buffer.clear(ch, available, blockSize - available);
+            readPos += blockSize;
+            process(blockSize);
+
+            const int dropped = static_cast<int>(juce::jmin(skip, block));
+            skip -= dropped;
+            const int count = static_cast<int>(juce::jmin(block - dropped, totalOutput - written));
+            if (count > 0 && ! writer->writeFromAudioSampleBuffer(buffer, dropped, count))
+            {
+                error = "write failed for " + output.getFullPathName();
+                return false;
+            }
+            written += juce::jmax(0, count);
+        }
+        return true;
+    }
+
+    const RenderSettings& settings;
+    juce::File input;
+    std::atomic<int>& failures;
+};
+
+void printUsage()
+{
+    std::cout << "usage: eqpro_render --state=<state.xml> [--out=<dir>] [--suffix=<text>] [--block=<samples>]\n"
+                 "                    [--jobs=<n>] [--bits=16|24|32] [--tail=<seconds>] [--source-channel=<n>]\n"
+                 "                    <file or folder>...\n";
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    // ArgumentList accessors report bad or missing values by throwing; print those and exit 1.
+    return juce::ConsoleApplication::invokeCatchingFailures([argc, argv]
+    {
+        const juce::ArgumentList args(argc, argv);
+        if (args.size() == 0 || args.containsOption("--help|-h"))
+        {
+            printUsage();
+            return args.size() == 0 ? 1 : 0;
+        }
+
+        RenderSettings settings;
+        const auto stateFile = args.getExistingFileForOption("--state");
+        juce::String error;
+        if (! loadParameterValues(stateFile, settings.values, error))
+        {
+            std::cerr << error << std::endl;
+            return 1;
+        }
+        if (args.containsOption("--out"))
+            settings.outputDirectory = args.getFileForOption("--out");
+        if (args.containsOption("--suffix"))
+            settings.suffix = args.getValueForOption("--suffix");
+        if (args.containsOption("--block"))
+            settings.blockSize = juce::jlimit(64, 65536, args.getValueForOption("--block").getIntValue());
+        if (args.containsOption("--bits"))
+            settings.bitsPerSample = args.getValueForOption("--bits").getIntValue();
+        if (args.containsOption("--tail"))
+            settings.tailSeconds = juce::jmax(0.0, args.getValueForOption("--tail").getDoubleValue());
+        if (args.containsOption("--source-channel"))
+            settings.sourceChannel = juce::jmax(0, args.getValueForOption("--source-channel").getIntValue() - 1);
+        const int jobs = args.containsOption("--jobs")
+            ? juce::jmax(1, args.getValueForOption("--jobs").getIntValue())
+            : juce::SystemStats::getNumCpus();
+
+        // Non-option arguments are inputs; folders contribute their audio files.
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+        const auto wildcard = formats.getWildcardForAllFormats();
+        juce::Array<juce::File> inputs;
+        for (const auto& arg : args.arguments)
+        {
+            if (arg.isOption())
+                continue;
+            const auto file = arg.resolveAsFile();
+            if (file.isDirectory())
+                inputs.addArray(file.findChildFiles(juce::File::findFiles, false, wildcard));
+            else if (file.existsAsFile())
+                inputs.add(file);
+            else
+                std::cerr << "skipping " << file.getFullPathName() << ": not found" << std::endl;
+        }
+        if (inputs.isEmpty())
+        {
+            printUsage();
+            return 1;
+        }
+        if (settings.outputDirectory != juce::File() && ! settings.outputDirectory.createDirectory())
+        {
+            std::cerr << "cannot create " << settings.outputDirectory.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        std::atomic<int> failures { 0 };
+        juce::ThreadPool pool(juce::ThreadPoolOptions {}.withThreadName("eqpro_render").withNumberOfThreads(jobs));
+        for (const auto& input : inputs)
+            pool.addJob(new RenderJob(settings, input, failures), true);
+        while (pool.getNumJobs() > 0)
+            juce::Thread::sleep(20);
+
+        return failures.load() > 0 ? 2 : 0;
+    });
+}